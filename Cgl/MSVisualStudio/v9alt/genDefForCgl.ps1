@@ -27,7 +27,7 @@ $tgtBase = $Args[1]
 switch ($tgtBase)
 { "CglBase"
   { $fileNames = "CglCutGenerator.obj","CglMessage.obj","CglParam.obj"
-    $fileNames += "CglStored.obj","CglTreeInfo.obj"
+    $fileNames += "CglStored.obj","CglTableauProvider.obj","CglThreads.obj","CglTreeInfo.obj"
     $babyString = ".*Cgl.*"
     break }
   "CglAllDifferent"
@@ -88,6 +88,10 @@ switch ($tgtBase)
   { $fileNames = "CglRedSplit.obj","CglRedSplitParam.obj"
     $babyString = ".*CglRedSplit.*"
     break }
+  "CglReducedCostFixing"
+  { $fileNames = "CglReducedCostFixing.obj"
+    $babyString = ".*CglReducedCostFixing.*"
+    break }
   "CglResidualCapacity"
   { $fileNames = "CglResidualCapacity.obj"
     $babyString = ".*CglResidualCapacity.*"
@@ -0,0 +1,127 @@
+// $Id$
+// Copyright (C) 2026, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+//-----------------------------------------------------
+// Times the lift-and-project cut generator.
+//
+// This sample program solves the continuous relaxation
+// of a given problem and then calls CglLandP on the
+// optimal basis a number of times, reporting the cuts
+// found and the cpu time per call.  Most of the time
+// in CglLandP goes in choosing the pivot row, so this
+// is the driver to run under a profiler when changing
+// CglLandPSimplex::fastFindCutImprovingPivotRow.
+//
+// usage:
+//   landp_timing mpsFileName numberCalls
+// where:
+//   mpsFileName: Name of an mps file (without the
+//                file extension)
+//   numberCalls: Number of times generateCuts is
+//                called
+// example:
+//   landp_timing ../../Data/Sample/p0201 20
+//-----------------------------------------------------
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "CoinError.hpp"
+#include "CoinFinite.hpp"
+#include "CoinTime.hpp"
+#include "OsiCuts.hpp"
+#include "OsiClpSolverInterface.hpp"
+
+#include "CglLandP.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::string;
+
+int main(int argc, const char *argv[])
+{
+  // If no parms specified then use these
+  string mpsFileName;
+#if defined(SAMPLEDIR)
+  mpsFileName = SAMPLEDIR "/p0201.mps";
+#else
+  if (argc == 1) {
+    fprintf(stderr, "Do not know where to find sample MPS files.\n");
+    exit(1);
+  }
+#endif
+  int numberCalls = 10;
+
+  // Make sure a file name and number of calls or nothing
+  // were specified
+  if ( argc!=1 && argc!=3 ) {
+    cerr <<"Incorrect number of command line parameters." <<endl;
+    cerr <<"  usage:" <<endl;
+    cerr <<"    "<<argv[0] <<" mpsFileName numberCalls" <<endl;
+    cerr <<"  where:" <<endl;
+    cerr <<"    mpsFileName: Name of an mps file" <<endl;
+    cerr <<"                 without \".mps\" file extension" <<endl;
+    cerr <<"    numberCalls: Number of times generateCuts is called" <<endl;
+    return 1;
+  }
+
+  if (argc==3) {
+    mpsFileName = argv[1];
+    numberCalls = atoi(argv[2]);
+    if (numberCalls<1) {
+      cerr <<"Number of calls must be positive" <<endl;
+      cerr <<"  specified value: \"" <<argv[2] <<"\"" <<endl;
+      return 1;
+    }
+  }
+
+  try {
+    OsiClpSolverInterface si;
+    si.messageHandler()->setLogLevel(0);
+
+    // Read file describing problem
+    si.readMps(mpsFileName.c_str(),"mps");
+
+    // Solve continuous problem
+    si.initialSolve();
+    if (!si.isProvenOptimal()) {
+      cerr <<"Continuous relaxation not solved to optimality" <<endl;
+      return 1;
+    }
+    cout <<mpsFileName <<": " <<si.getNumRows() <<" rows, "
+	 <<si.getNumCols() <<" columns, lp objective "
+	 <<si.getObjValue() <<endl;
+
+    // Each call starts from the same optimal basis so the
+    // calls do the same work
+    CglLandP landp;
+    int numberCuts = 0;
+    double bestTime = COIN_DBL_MAX;
+    double totalTime = 0.0;
+    for (int iCall=0;iCall<numberCalls;iCall++) {
+      OsiCuts cuts;
+      double time1 = CoinCpuTime();
+      landp.generateCuts(si,cuts);
+      double time = CoinCpuTime()-time1;
+      totalTime += time;
+      if (time<bestTime)
+	bestTime = time;
+      if (!iCall)
+	numberCuts = cuts.sizeRowCuts();
+      else if (numberCuts != cuts.sizeRowCuts())
+	cerr <<"Call " <<iCall <<" gave " <<cuts.sizeRowCuts()
+	     <<" cuts instead of " <<numberCuts <<endl;
+    }
+    cout <<numberCuts <<" cuts per call, " <<numberCalls <<" calls took "
+	 <<totalTime <<" seconds (best " <<bestTime <<", average "
+	 <<totalTime/numberCalls <<")" <<endl;
+  }
+  catch ( CoinError e ) {
+    cout <<e.className() <<"::" <<e.methodName() <<" - " <<e.message() <<endl;
+  }
+
+  return 0;
+}
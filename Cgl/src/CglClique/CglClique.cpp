@@ -4,12 +4,18 @@
 // This code is licensed under the terms of the Eclipse Public License (EPL).
 
 #include <cstdio>
+#include <cstring>
 #include <cassert>
+#include <vector>
+#include <algorithm>
 
 #include "CoinHelperFunctions.hpp"
+#include "CoinSort.hpp"
 #include "OsiCuts.hpp"
 #include "OsiRowCut.hpp"
 #include "CglClique.hpp"
+#include "CglThreads.hpp"
+#include "../CglProbing/CglProbing.hpp"
 
 /*****************************************************************************/
 
@@ -26,7 +32,24 @@ CglClique::CglClique(bool setPacking, bool justOriginalRows) :
    sp_col_ind(0),
    sp_row_start(0),
    sp_row_ind(0),
+   useConflictGraph_(false),
+   conflictColumns_(0),
+   numberConflictCliques_(0),
+   conflictStart_(0),
+   conflictLiteral_(0),
+   literalStart_(0),
+   literalClique_(0),
+   conflictRows_(0),
+   conflictHash_(0),
+   conflictLower_(0),
+   conflictUpper_(0),
+   mergeCliques_(false),
+   maxMergedLength_(100),
+   numberMergedRows_(0),
+   numberDominatedRows_(0),
    node_node(0),
+   node_node_words(0),
+   maxNodeNodeColumns_(5000),
    petol(-1.0),
    do_row_clique(true),
    do_star_clique(true),
@@ -35,12 +58,7 @@ CglClique::CglClique(bool setPacking, bool justOriginalRows) :
    scl_report_result(true),
    rcl_candidate_length_threshold(12),
    rcl_report_result(true),
-   cl_perm_indices(0),
-   cl_perm_length(0),
-   cl_indices(0),
-   cl_length(0),
-   cl_del_indices(0),
-   cl_del_length(0)
+   numberThreads_(1)
 {}
 // Copy constructor
 CglClique::CglClique(const CglClique& rhs)
@@ -56,7 +74,24 @@ CglClique::CglClique(const CglClique& rhs)
     sp_col_ind(rhs.sp_col_ind),
     sp_row_start(rhs.sp_row_start),
     sp_row_ind(rhs.sp_row_ind),
+    useConflictGraph_(rhs.useConflictGraph_),
+    conflictColumns_(0),
+    numberConflictCliques_(0),
+    conflictStart_(0),
+    conflictLiteral_(0),
+    literalStart_(0),
+    literalClique_(0),
+    conflictRows_(0),
+    conflictHash_(0),
+    conflictLower_(0),
+    conflictUpper_(0),
+    mergeCliques_(rhs.mergeCliques_),
+    maxMergedLength_(rhs.maxMergedLength_),
+    numberMergedRows_(rhs.numberMergedRows_),
+    numberDominatedRows_(rhs.numberDominatedRows_),
     node_node(rhs.node_node),
+    node_node_words(rhs.node_node_words),
+    maxNodeNodeColumns_(rhs.maxNodeNodeColumns_),
     petol(rhs.petol),
     do_row_clique(rhs.do_row_clique),
     do_star_clique(rhs.do_star_clique),
@@ -65,13 +100,44 @@ CglClique::CglClique(const CglClique& rhs)
     scl_report_result(rhs.scl_report_result),
     rcl_candidate_length_threshold(rhs.rcl_candidate_length_threshold),
     rcl_report_result(rhs.rcl_report_result),
-    cl_perm_indices(rhs.cl_perm_indices),
-    cl_perm_length(rhs.cl_perm_length),
-    cl_indices(rhs.cl_indices),
-    cl_length(rhs.cl_length),
-    cl_del_indices(rhs.cl_del_indices),
-    cl_del_length(rhs.cl_del_length)
+    numberThreads_(rhs.numberThreads_)
+{
+   copyConflictGraph(rhs);
+}
+
+// Destructor
+CglClique::~CglClique()
 {
+   deleteConflictGraph();
+}
+
+// Assignment operator
+CglClique &
+CglClique::operator=(const CglClique& rhs)
+{
+   if (this != &rhs) {
+      CglCutGenerator::operator=(rhs);
+      setPacking_ = rhs.setPacking_;
+      justOriginalRows_ = rhs.justOriginalRows_;
+      petol = rhs.petol;
+      do_row_clique = rhs.do_row_clique;
+      do_star_clique = rhs.do_star_clique;
+      scl_next_node_rule = rhs.scl_next_node_rule;
+      scl_candidate_length_threshold = rhs.scl_candidate_length_threshold;
+      scl_report_result = rhs.scl_report_result;
+      rcl_candidate_length_threshold = rhs.rcl_candidate_length_threshold;
+      rcl_report_result = rhs.rcl_report_result;
+      numberThreads_ = rhs.numberThreads_;
+      maxNodeNodeColumns_ = rhs.maxNodeNodeColumns_;
+      useConflictGraph_ = rhs.useConflictGraph_;
+      mergeCliques_ = rhs.mergeCliques_;
+      maxMergedLength_ = rhs.maxMergedLength_;
+      numberMergedRows_ = rhs.numberMergedRows_;
+      numberDominatedRows_ = rhs.numberDominatedRows_;
+      deleteConflictGraph();
+      copyConflictGraph(rhs);
+   }
+   return *this;
 }
 
 /*****************************************************************************/
@@ -91,33 +157,45 @@ CglClique::generateCuts(const OsiSolverInterface& si, OsiCuts & cs,
    if (info.inTree&&justOriginalRows_)
      numberOriginalRows = info.formulation_rows;
    int numberRowCutsBefore = cs.sizeRowCuts();
-   // First select which rows/columns we are interested in.
-   if (!setPacking_) {
+   // Conflict graph is built at root so valid everywhere - refreshSolver
+   // checks it fully if problem has been changed so just check size
+   if (conflictColumns_ && (conflictColumns_ != si.getNumCols() ||
+			    conflictRows_ > si.getNumRows()))
+      deleteConflictGraph();
+   if (useConflictGraph_ && !conflictColumns_ && !info.inTree)
+      buildConflictGraph(si, numberOriginalRows);
+   // Stronger set packing rows can replace old ones
+   if (mergeCliques_ && info.strengthenRow && !info.inTree)
+      mergeCliqueRows(si, info.strengthenRow, numberOriginalRows);
+   if (conflictColumns_ && conflictColumns_ == si.getNumCols()) {
+      // Conflicts known - just take subgraph on fractional variables
       selectFractionalBinaries(si);
-      if (!sp_orig_row_ind) {
-	 selectRowCliques(si,numberOriginalRows);
-      }
+      createConflictSubMatrix();
    } else {
-      selectFractionals(si);
-      delete[] sp_orig_row_ind;
-      sp_numrows = numberOriginalRows;
-      //sp_numcols = si.getNumCols();
-      sp_orig_row_ind = new int[sp_numrows];
-      for (i = 0; i < sp_numrows; ++i)
-	 sp_orig_row_ind[i] = i;
-   }
-   // Just original rows
-   if (justOriginalRows_&&info.inTree) 
-     sp_numrows = CoinMin(info.formulation_rows,sp_numrows);
-     
-
-   createSetPackingSubMatrix(si);
+      // First select which rows/columns we are interested in.
+      if (!setPacking_) {
+	 selectFractionalBinaries(si);
+	 if (!sp_orig_row_ind) {
+	    selectRowCliques(si,numberOriginalRows);
+	 }
+      } else {
+	 selectFractionals(si);
+	 delete[] sp_orig_row_ind;
+	 sp_numrows = numberOriginalRows;
+	 //sp_numcols = si.getNumCols();
+	 sp_orig_row_ind = new int[sp_numrows];
+	 for (i = 0; i < sp_numrows; ++i)
+	    sp_orig_row_ind[i] = i;
+      }
+      // Just original rows
+      if (justOriginalRows_&&info.inTree) 
+	 sp_numrows = CoinMin(info.formulation_rows,sp_numrows);
+
+      createSetPackingSubMatrix(si);
+   }
    fgraph.edgenum = createNodeNode();
    createFractionalGraph();
 
-   cl_indices = new int[sp_numcols];
-   cl_del_indices = new int[sp_numcols];
-
    if (do_row_clique)
       find_rcl(cs);
    if (do_star_clique)
@@ -128,9 +206,6 @@ CglClique::generateCuts(const OsiSolverInterface& si, OsiCuts & cs,
        cs.rowCutPtr(i)->setGloballyValid();
    }
 
-   delete[] cl_indices;     cl_indices = 0;
-   delete[] cl_del_indices; cl_del_indices = 0;
-
    deleteFractionalGraph();
    delete[] node_node;      node_node = 0;
    deleteSetPackingSubMatrix();
@@ -140,6 +215,66 @@ CglClique::generateCuts(const OsiSolverInterface& si, OsiCuts & cs,
 }
 
 /*****************************************************************************/
+
+/* Rows (or stars) are split into blocks which can be searched in parallel.
+   Each block puts its cliques into its own OsiCuts and these are merged in
+   order at the end, so the cuts found do not depend on the number of
+   threads. */
+typedef struct {
+   const CglClique * clique;
+   /* first row (or star) of each task */
+   const int * taskStart;
+   /* cuts for each task (just one which is the real one if one task) */
+   OsiCuts * cuts;
+   /* counts for each task */
+   int * found;
+   int * found2;
+   int * largest;
+   /* work space for each thread */
+   CoinUInt64 ** space;
+   int ** indices;
+   int ** degrees;
+   /* stars - center, start in starIndices, number of nodes deleted before
+      and whether to be done greedily */
+   const int * starNode;
+   const int * starStart;
+   const int * starIndices;
+   const int * starDeleted;
+   const char * starGreedy;
+   /* nodes in order deleted and position of each node in that */
+   const int * deleted;
+   const int * deletedPosition;
+} CglCliqueSearchInfo;
+
+/* Number of tasks for this number of threads and blocks */
+static int numberCliqueTasks(int numberThreads, int numberBlocks)
+{
+   // a few tasks per thread to even out load
+   return (numberThreads > 1) ? CoinMin(4*numberThreads, numberBlocks) : 1;
+}
+
+/* Size of work space for a search - candidates (in rcl), common
+   neighbours, work and adjacency of up to threshold nodes to be
+   enumerated */
+static int cliqueSpaceSize(int words, int threshold)
+{
+   threshold = CoinMax(threshold, 1);
+   return 3*words + (threshold+1)*((threshold+63)>>6);
+}
+
+/* Merges cuts of tasks (in order) into cs */
+static void mergeCliqueCuts(int numberTasks, OsiCuts * cuts, OsiCuts & cs)
+{
+   if (numberTasks > 1) {
+      CoinAbsFltEq equal(1.0e-12);
+      for (int iTask = 0; iTask < numberTasks; iTask++) {
+	 for (int i = 0; i < cuts[iTask].sizeRowCuts(); i++)
+	    cs.insertIfNotDuplicate(*cuts[iTask].rowCutPtr(i), equal);
+      }
+      delete[] cuts;
+   }
+}
+
 /*===========================================================================*
  * Find violated row cliques.
  *
@@ -149,36 +284,114 @@ CglClique::generateCuts(const OsiSolverInterface& si, OsiCuts & cs,
  * (enumerate all or try to find one greedily, depending on the size of the
  * candidate set). When a violated maximal clique is found, it is recorded in
  * the cut set.
+ *
+ * Rows are independent so blocks of rows are done by rcl_task, possibly in
+ * parallel.
  *===========================================================================*/
 
 void
 CglClique::find_rcl(OsiCuts& cs)
 {
    const int nodenum = fgraph.nodenum;
-   const fnode *nodes = fgraph.nodes;
 
-   /* A flag for each column that might be used to extend the current row
+   int clique_count = 0;
+   int largest_length = 0;
+
+   if (nodenum && sp_numrows) {
+      const int numberThreads = CglNumberThreads(numberThreads_, sp_numrows);
+      const int numberTasks = numberCliqueTasks(numberThreads, sp_numrows);
+      int iTask, iThread;
+      int *taskStart = new int[numberTasks+1];
+      for (iTask = 0; iTask <= numberTasks; iTask++)
+	 taskStart[iTask] = (sp_numrows * iTask) / numberTasks;
+      CglCliqueSearchInfo info;
+      memset(&info, 0, sizeof(info));
+      info.clique = this;
+      info.taskStart = taskStart;
+      info.cuts = (numberTasks > 1) ? new OsiCuts[numberTasks] : &cs;
+      info.found = new int[numberTasks];
+      info.largest = new int[numberTasks];
+      const int spaceSize = cliqueSpaceSize(node_node_words,
+					    rcl_candidate_length_threshold);
+      info.space = new CoinUInt64 * [numberThreads];
+      info.indices = new int * [numberThreads];
+      info.degrees = new int * [numberThreads];
+      for (iThread = 0; iThread < numberThreads; iThread++) {
+	 info.space[iThread] = new CoinUInt64[spaceSize];
+	 info.indices[iThread] = new int[nodenum];
+	 info.degrees[iThread] = new int[nodenum];
+      }
+      CglRunTasks(numberThreads, numberTasks, rcl_task, &info);
+      for (iTask = 0; iTask < numberTasks; iTask++) {
+	 clique_count += info.found[iTask];
+	 largest_length = CoinMax(largest_length, info.largest[iTask]);
+      }
+      mergeCliqueCuts(numberTasks, info.cuts, cs);
+      for (iThread = 0; iThread < numberThreads; iThread++) {
+	 delete[] info.space[iThread];
+	 delete[] info.indices[iThread];
+	 delete[] info.degrees[iThread];
+      }
+      delete[] info.space;
+      delete[] info.indices;
+      delete[] info.degrees;
+      delete[] info.found;
+      delete[] info.largest;
+      delete[] taskStart;
+   }
+
+   if (rcl_report_result) {
+      printf("\nrcl Found %i new violated cliques with the row-clique method",
+	     clique_count);
+      printf("\nrcl The largest admissible number was %i (threshold %i)\n",
+	     largest_length, rcl_candidate_length_threshold);
+      if (largest_length < rcl_candidate_length_threshold)
+	 printf("rcl    all row cliques have been enumerated\n");
+      else
+	 printf("rcl    not all row cliques have been eliminated\n");
+   }
+}
+
+/*===========================================================================*
+ * Find violated row cliques for one block of rows (see find_rcl)
+ *===========================================================================*/
+
+void
+CglClique::rcl_task(void* voidInfo, int iTask, int iThread)
+{
+   CglCliqueSearchInfo * info =
+      reinterpret_cast<CglCliqueSearchInfo *> (voidInfo);
+   const CglClique & clique = *info->clique;
+   const fnode *nodes = clique.fgraph.nodes;
+   const int *sp_row_start = clique.sp_row_start;
+   const int *sp_row_ind = clique.sp_row_ind;
+
+   /* A bit for each column that might be used to extend the current row
       clique */
-   bool *cand = new bool[nodenum];
+   const int words = clique.node_node_words;
+   CoinUInt64 *cand = info->space[iThread];
    /* In cl_indices we'll list the indices of the 'true' entries in cand */
+   int *cl_indices = info->indices[iThread];
    /* The degree of each candidate (those listed in cl_indices) */
-   int *degrees = new int[nodenum];
-
-   /** An array used in the recursive complete enumeration of maximal cliques.
-       The first cl_length entries are used. */
-   bool* label = new bool[nodenum];
+   int *degrees = info->degrees[iThread];
 
    int i, j, k;
 
-   /* initialize global variables */
-   cl_del_length = 0;
-   cl_length = 0;
+   cl_search search;
+   search.cl_indices = cl_indices;
+   search.cl_del_indices = NULL;
+   search.cl_del_length = 0;
+   search.cl_del_position = NULL;
+   search.cs = info->cuts + iTask;
+   search.common = cand + words;
+   search.work = cand + 2*words;
+   search.cl_label = cand + 3*words;
 
    int clique_count = 0;
    int largest_length = 0;
 
-   /* for each row of the matrix */
-   for (j = 0; j < sp_numrows; j++) {
+   /* for each row of the block */
+   for (j = info->taskStart[iTask]; j < info->taskStart[iTask+1]; j++) {
 
       /* if the row is of zero length, take the next row */
       const int len = sp_row_start[j+1] - sp_row_start[j];
@@ -188,58 +401,42 @@ CglClique::find_rcl(OsiCuts& cs)
       /* the beginning of the row to be considered */
       const int *row = sp_row_ind + sp_row_start[j];
 
-      /* copy the row of node_node corresponding to the first column in 'row'
-	 into cand, and take the AND of this vector with every row of
-	 node_node corresponding to the rest of the columns in 'row' to
-	 determine those columns that are non-orthog to every column in row */
-      std::copy(node_node + row[0]*nodenum, node_node + (row[0]+1)*nodenum,
-		cand);
-      for (i = 1; i < len; i++) {
-	 const bool* node_node_col = node_node + row[i] * nodenum;
-	 for (k = 0; k < nodenum; k++)
-	    cand[k] &= node_node_col[k];
-      }
-      cl_length = 0;
-      for (k = 0; k < nodenum; k++)
-	 if (cand[k])
-	    cl_indices[cl_length++] = k;
+      /* put the neighbours of the first column in 'row' into cand, and
+	 take the AND of this with the neighbours of the rest of the
+	 columns in 'row' to determine those columns that are non-orthog
+	 to every column in row.  Stop as soon as nothing is left. */
+      clique.setNeighbours(row[0], cand);
+      bool any = true;
+      for (i = 1; i < len && any; i++)
+	 any = clique.andNeighbours(row[i], cand, search.work);
+      int cl_length = 0;
+      for (k = 0; k < words && any; k++)
+	 for (CoinUInt64 word = cand[k]; word; word &= word-1)
+	    cl_indices[cl_length++] = (k << 6) + firstBit(word);
       largest_length = CoinMax(cl_length, largest_length);
 
       /* if there is anything in indices, enumerate (or greedily find)
 	 maximal cliques */
       if (cl_length > 0) {
-	 cl_perm_length = len;
-	 cl_perm_indices = row;
-	 if (cl_length <= rcl_candidate_length_threshold) {
-	    for (i = 0; i < cl_length; i++)
-	       label[i] = false;
+	 search.cl_perm_length = len;
+	 search.cl_perm_indices = row;
+	 search.cl_length = cl_length;
+	 if (cl_length <= clique.rcl_candidate_length_threshold) {
+	    clique.prepareEnumeration(search);
 	    int pos = 0;
-	    clique_count += enumerate_maximal_cliques(pos, label, cs);
+	    clique_count += clique.enumerate_maximal_cliques(search, pos);
 	 } else {
 	    /* order cl_indices into decreasing order of their degrees */
 	    for (i = 0; i < cl_length; i++)
 	       degrees[i] = nodes[cl_indices[i]].degree;
 	    CoinSort_2(degrees, degrees + cl_length, cl_indices,
 		       CoinFirstGreater_2<int,int>());
-	    clique_count += greedy_maximal_clique(cs);
+	    clique_count += clique.greedy_maximal_clique(search);
 	 }
       }
    }
-
-   if (rcl_report_result) {
-      printf("\nrcl Found %i new violated cliques with the row-clique method",
-	     clique_count);
-      printf("\nrcl The largest admissible number was %i (threshold %i)\n",
-	     largest_length, rcl_candidate_length_threshold);
-      if (largest_length < rcl_candidate_length_threshold)
-	 printf("rcl    all row cliques have been enumerated\n");
-      else
-	 printf("rcl    not all row cliques have been eliminated\n");
-   }
-
-   delete[] degrees;
-   delete[] cand;
-   delete[] label;
+   info->found[iTask] = clique_count;
+   info->largest[iTask] = largest_length;
 }
 
 /*****************************************************************************/
@@ -250,15 +447,21 @@ CglClique::find_rcl(OsiCuts& cs)
  * Algorithm: Take min degree node. Check for violated cuts in the subgraph
  * consisting of this node and its neighbors (the "star" of this node). Then
  * delete the node and continue with the now min degree node.
- * 
+ *
  * Implementation: Two arrays are defined, one contains the indices the other
  * the degrees of all the nodes still in the graph. If the min degree is 0
  * or 1 then the min degree node can be deleted at once.
  * All cliques are enumerated in v U star(v) if the min degree is smaller
  * than the threshold  scl_candidate_length_threshold, otherwise attemp to
  * find maximal clique greedily.
- * 
+ *
+ * Which stars are looked at does not depend on the cliques found, so first
+ * the stars (and the nodes deleted before each) are collected and then
+ * blocks of stars are searched by scl_task, possibly in parallel.
+ *
  * Note: Indices in current_indices are always kept in increasing order.
+ * The nodes still in the graph are also kept as bits in current so that a
+ * star is the AND of that with the neighbours of the center.
  *===========================================================================*/
 
 void
@@ -270,116 +473,178 @@ CglClique::find_scl(OsiCuts& cs)
    // Return at once if no nodes - otherwise we get invalid reads
    if (!nodenum)
      return;
+   const int words = node_node_words;
    int *current_indices = new int[nodenum];
+   /* degree of each node (indexed by node) */
    int *current_degrees = new int[nodenum];
-   double *current_values = new double[nodenum];
+   CoinUInt64 *current = new CoinUInt64[words];
+
+   /* nodes in the order they are deleted (and position of each node in
+      that) */
+   int *cl_del_indices = new int[nodenum];
+   int *cl_del_position = new int[nodenum];
+   int cl_del_length = 0;
+
+   /* the stars to be searched - a star is at most the degree of its
+      center */
+   int *starNode = new int[nodenum];
+   int *starStart = new int[nodenum+1];
+   int *starIndices = new int[2*fgraph.edgenum+1];
+   int *starDeleted = new int[nodenum];
+   char *starGreedy = new char[nodenum];
+   int numberStars = 0;
+   starStart[0] = 0;
 
-   int *star = cl_indices;
    int *star_deg = new int[nodenum];
 
-   /** An array used in the recursive complete enumeration of maximal cliques.
-       The first cl_length entries are used. */
-   bool* label = new bool[nodenum];
-
    int i, cnt1 = 0, cnt2 = 0, cnt3 = 0;
    int clique_cnt_e = 0, clique_cnt_g = 0;
    int largest_star_size = 0;
 
-   /* initialize global variables */
-   cl_del_length = 0;
-
-   /* initialize current_nodes, current_degrees and current_values */
+   /* initialize current_nodes, current_degrees and current */
    int current_nodenum = nodenum;
    for (i = 0; i < nodenum; i++) {
       current_indices[i] = i;
       current_degrees[i] = nodes[i].degree;
-      current_values[i] = nodes[i].val;
+      cl_del_position[i] = nodenum;
    }
-   
+   CoinFillN(current, words, ~static_cast<CoinUInt64>(0));
+   if (nodenum & 63)
+      current[words-1] = (static_cast<CoinUInt64>(1) << (nodenum & 63)) - 1;
+
    /* find first node to be checked */
    int best_ind = scl_choose_next_node(current_nodenum, current_indices,
-				       current_degrees, current_values);
+				       current_degrees);
 
    int v = current_indices[best_ind];
-   int v_deg = current_degrees[best_ind];
-   double v_val = current_values[best_ind];
-      
+   int v_deg = current_degrees[v];
+   double v_val = nodes[v].val;
+
    /* while there are nodes left in the graph ... (more precisely, while
       there are at least 3 nodes in the graph) */
    while (current_nodenum > 2) {
 
       /* if the best node is of degree < 2 then it can be deleted */
       if (v_deg < 2) {
+	 cl_del_position[v] = cl_del_length;
 	 cl_del_indices[cl_del_length++] = v;
 	 scl_delete_node(best_ind, current_nodenum,
-			 current_indices, current_degrees, current_values);
+			 current_indices, current_degrees, current);
 	 best_ind = scl_choose_next_node(current_nodenum, current_indices,
-					 current_degrees, current_values);
+					 current_degrees);
 	 v = current_indices[best_ind];
-	 v_deg = current_degrees[best_ind];
-	 v_val = current_values[best_ind];
+	 v_deg = current_degrees[v];
+	 v_val = nodes[v].val;
 	 largest_star_size = CoinMax(largest_star_size, v_deg);
 	 continue;
       }
 
-      /* star will contain the indices of v's neighbors (but not v's index) */
-      const bool* node_node_start = node_node + nodenum * v;
-      int& star_length = cl_length;
-      star_length = 0;
+      /* star will contain the indices of v's neighbors (but not v's index)
+	 still in the graph - in increasing order */
+      int *star = starIndices + starStart[numberStars];
+      int star_length = 0;
       double star_val = v_val;
-      for (i = 0; i < current_nodenum; i++) {
-	 const int other_node = current_indices[i];
-	 if (node_node_start[other_node]) {
-	    star[star_length] = other_node;
-	    star_deg[star_length++] = current_degrees[i];
-	    star_val += current_values[i];
+      if (node_node) {
+	 const CoinUInt64 *node_node_v = node_node + v * words;
+	 for (int k = 0; k < words; k++) {
+	    for (CoinUInt64 word = node_node_v[k] & current[k]; word;
+		 word &= word-1) {
+	       const int other_node = (k << 6) + firstBit(word);
+	       star[star_length] = other_node;
+	       star_deg[star_length++] = current_degrees[other_node];
+	       star_val += nodes[other_node].val;
+	    }
+	 }
+      } else {
+	 for (i = 0; i < nodes[v].degree; i++) {
+	    const int other_node = nodes[v].nbrs[i];
+	    if (testBit(current, other_node)) {
+	       star[star_length] = other_node;
+	       star_deg[star_length++] = current_degrees[other_node];
+	       star_val += nodes[other_node].val;
+	    }
 	 }
       }
 
       /* quick check: if sum of values for the star does not exceed 1 then
 	 there won't be a violated clique in the star */
       if (star_val >= 1 + petol) {
-	 /* node whose star we're evaluating is always in */
-	 cl_perm_length = 1;
-	 cl_perm_indices = &v;
-
 	 /* find maximal violated cliques in star. cliques found here might not
 	    be maximal wrt to entire fractional graph, only for the current
 	    subset of it (some nodes might be already deleted...)
-	    Note that star is the same as cl_indices and start_length is
-	    cl_length... 
 	 */
+	 starNode[numberStars] = v;
+	 starDeleted[numberStars] = cl_del_length;
 	 if (v_deg < scl_candidate_length_threshold) { // par
 	    /* enumerate if v_deg is small enough */
-	    for (i = 0; i < star_length; i++)
-	       label[i] = false;
-	    int pos = 0;
-	    clique_cnt_e += enumerate_maximal_cliques(pos, label, cs);
+	    starGreedy[numberStars] = 0;
 	    cnt1++;
 	 } else {
 	    /* greedily find if v_deg is too big */
 	    /* order nodes in *decreasing* order of their degrees in star */
 	    CoinSort_2(star_deg, star_deg + star_length, star,
 		       CoinFirstGreater_2<int,int>());
-	    /* find maxl clique greedily, including v */
-	    clique_cnt_g += greedy_maximal_clique(cs);
+	    starGreedy[numberStars] = 1;
 	    cnt2++;
 	 }
+	 starStart[numberStars+1] = starStart[numberStars] + star_length;
+	 numberStars++;
       } else {
 	 cnt3++;
       }
       /* delete v from current_indices */
+      cl_del_position[v] = cl_del_length;
       cl_del_indices[cl_del_length++] = v;
       scl_delete_node(best_ind, current_nodenum,
-		      current_indices, current_degrees, current_values);
+		      current_indices, current_degrees, current);
       best_ind = scl_choose_next_node(current_nodenum, current_indices,
-				      current_degrees, current_values);
+				      current_degrees);
       v = current_indices[best_ind];
-      v_deg = current_degrees[best_ind];
-      v_val = current_values[best_ind];
+      v_deg = current_degrees[v];
+      v_val = nodes[v].val;
       largest_star_size = CoinMax(largest_star_size, v_deg);
    }
 
+   if (numberStars) {
+      const int numberThreads = CglNumberThreads(numberThreads_, numberStars);
+      const int numberTasks = numberCliqueTasks(numberThreads, numberStars);
+      int iTask, iThread;
+      int *taskStart = new int[numberTasks+1];
+      for (iTask = 0; iTask <= numberTasks; iTask++)
+	 taskStart[iTask] = (numberStars * iTask) / numberTasks;
+      CglCliqueSearchInfo info;
+      memset(&info, 0, sizeof(info));
+      info.clique = this;
+      info.taskStart = taskStart;
+      info.cuts = (numberTasks > 1) ? new OsiCuts[numberTasks] : &cs;
+      info.found = new int[numberTasks];
+      info.found2 = new int[numberTasks];
+      const int spaceSize = cliqueSpaceSize(words,
+					    scl_candidate_length_threshold);
+      info.space = new CoinUInt64 * [numberThreads];
+      for (iThread = 0; iThread < numberThreads; iThread++)
+	 info.space[iThread] = new CoinUInt64[spaceSize];
+      info.starNode = starNode;
+      info.starStart = starStart;
+      info.starIndices = starIndices;
+      info.starDeleted = starDeleted;
+      info.starGreedy = starGreedy;
+      info.deleted = cl_del_indices;
+      info.deletedPosition = cl_del_position;
+      CglRunTasks(numberThreads, numberTasks, scl_task, &info);
+      for (iTask = 0; iTask < numberTasks; iTask++) {
+	 clique_cnt_e += info.found[iTask];
+	 clique_cnt_g += info.found2[iTask];
+      }
+      mergeCliqueCuts(numberTasks, info.cuts, cs);
+      for (iThread = 0; iThread < numberThreads; iThread++)
+	 delete[] info.space[iThread];
+      delete[] info.space;
+      delete[] info.found;
+      delete[] info.found2;
+      delete[] taskStart;
+   }
+
    const int clique_cnt = clique_cnt_e + clique_cnt_g;
 
    if (scl_report_result) {
@@ -402,53 +667,107 @@ CglClique::find_scl(OsiCuts& cs)
 
    delete[] current_indices;
    delete[] current_degrees;
-   delete[] current_values;
+   delete[] current;
+   delete[] cl_del_indices;
+   delete[] cl_del_position;
+   delete[] starNode;
+   delete[] starStart;
+   delete[] starIndices;
+   delete[] starDeleted;
+   delete[] starGreedy;
    delete[] star_deg;
-   delete[] label;
+}
+
+/*===========================================================================*
+ * Find violated star cliques for one block of stars (see find_scl). The
+ * center of the star is always in the clique.
+ *===========================================================================*/
+
+void
+CglClique::scl_task(void* voidInfo, int iTask, int iThread)
+{
+   CglCliqueSearchInfo * info =
+      reinterpret_cast<CglCliqueSearchInfo *> (voidInfo);
+   const CglClique & clique = *info->clique;
+   const int words = clique.node_node_words;
+   CoinUInt64 *space = info->space[iThread];
+
+   cl_search search;
+   search.cl_perm_length = 1;
+   search.cl_del_indices = info->deleted;
+   search.cl_del_position = info->deletedPosition;
+   search.cs = info->cuts + iTask;
+   search.common = space + words;
+   search.work = space + 2*words;
+   search.cl_label = space + 3*words;
+
+   int clique_cnt_e = 0, clique_cnt_g = 0;
+   for (int iStar = info->taskStart[iTask]; iStar < info->taskStart[iTask+1];
+	iStar++) {
+      search.cl_perm_indices = info->starNode + iStar;
+      search.cl_indices = info->starIndices + info->starStart[iStar];
+      search.cl_length = info->starStart[iStar+1] - info->starStart[iStar];
+      search.cl_del_length = info->starDeleted[iStar];
+      if (!info->starGreedy[iStar]) {
+	 clique.prepareEnumeration(search);
+	 int pos = 0;
+	 clique_cnt_e += clique.enumerate_maximal_cliques(search, pos);
+      } else {
+	 clique_cnt_g += clique.greedy_maximal_clique(search);
+      }
+   }
+   info->found[iTask] = clique_cnt_e;
+   info->found2[iTask] = clique_cnt_g;
 }
 
 /*****************************************************************************/
 
 /*===========================================================================*
  * returns the index of the "best" node wrt current_indices, etc.
+ * (current_degrees is indexed by node)
  *===========================================================================*/
 
 int
 CglClique::scl_choose_next_node(const int current_nodenum,
-				const int * /* current_indices */,
-				const int *current_degrees,
-				const double *current_values)
+				const int *current_indices,
+				const int *current_degrees)
 {
+   const fnode *nodes = fgraph.nodes;
    int best = 0;
-   int best_deg = current_degrees[0];
-   double best_val = current_values[0];
+   int best_deg = current_degrees[current_indices[0]];
+   double best_val = nodes[current_indices[0]].val;
    int i;
 
    switch (scl_next_node_rule) { // p->par.scl_which_node
    case SCL_MIN_DEGREE: // NOTE: could use stl::min_element
-      for (i = 1; i < current_nodenum; i++)
-	 if (current_degrees[i] < best_deg) {
+      for (i = 1; i < current_nodenum; i++) {
+	 const int deg = current_degrees[current_indices[i]];
+	 if (deg < best_deg) {
 	    best = i;
-	    best_deg = current_degrees[i];
+	    best_deg = deg;
 	 }
+      }
       break;
    case SCL_MAX_DEGREE: // NOTE: could use stl::max_element
-      for (i = 1; i < current_nodenum; i++)
-	 if (current_degrees[i] > best_deg) {
+      for (i = 1; i < current_nodenum; i++) {
+	 const int deg = current_degrees[current_indices[i]];
+	 if (deg > best_deg) {
 	    best = i;
-	    best_deg = current_degrees[i];
+	    best_deg = deg;
 	 }
+      }
       break;
    case SCL_MAX_XJ_MAX_DEG:
       for (i = 1; i < current_nodenum; i++) {
-	 if (current_values[i] > best_val) {
+	 const int deg = current_degrees[current_indices[i]];
+	 const double val = nodes[current_indices[i]].val;
+	 if (val > best_val) {
 	    best = i;
-	    best_val = current_values[i];
-	    best_deg = current_degrees[i];
-	 } else if (current_values[i] == best_val &&
-		    current_degrees[i] > best_deg) {
+	    best_val = val;
+	    best_deg = deg;
+	 } else if (val == best_val && deg > best_deg) {
 	    best = i;
-	    best_deg = current_degrees[i];
+	    best_deg = deg;
 	 }
       }
       break;
@@ -463,8 +782,8 @@ CglClique::scl_choose_next_node(const int current_nodenum,
 
 /*===========================================================================*
  * Delete the node of index del_ind (this index is wrt current_indices) from
- * the list current_indices (current_degrees and current_values) and based on
- * the graph stored in fgraph decrease the degrees of its neighbors.
+ * the list current_indices (and current) and based on the graph stored in
+ * fgraph decrease the degrees of its neighbors.
  *
  * There are at least 3 nodes in the graph when this function is invoked.
  *
@@ -476,36 +795,110 @@ CglClique::scl_choose_next_node(const int current_nodenum,
  * del_ind: IN, the index of the node to be deleted (wrt to current_indices)
  * pcurrent_nodenum: INOUT, pointer to the current number of nodes
  * current_indices: INOUT, array of current node indices
- * current_degrees: INOUT, array of current node degrees, in the dame order
- *                  as in current_indices
- * current_values: INOUT, array of solution values
+ * current_degrees: INOUT, array of current node degrees (indexed by node)
+ * current: INOUT, nodes still in graph as bits
  *===========================================================================*/
 
 void
 CglClique::scl_delete_node(const int del_ind, int& current_nodenum,
 			   int *current_indices, int *current_degrees,
-			   double *current_values)
+			   CoinUInt64 *current)
 {
    const int v = current_indices[del_ind];
 
-   /* delete the entry corresponding to del_ind from current_indices, 
-      current_degrees and current_values */
+   /* delete the entry corresponding to del_ind from current_indices and
+      current */
    memmove(reinterpret_cast<char *>(current_indices + del_ind),
 	   reinterpret_cast<char *>(current_indices + (del_ind+1)),
 	   (current_nodenum-del_ind-1) * sizeof(int));
-   memmove(reinterpret_cast<char *>(current_degrees + del_ind),
-	   reinterpret_cast<char *>(current_degrees + (del_ind+1)),
-	   (current_nodenum-del_ind-1) * sizeof(int));
-   memmove(reinterpret_cast<char *>(current_values + del_ind),
-	   reinterpret_cast<char *>(current_values + (del_ind+1)),
-	   (current_nodenum-del_ind-1) * sizeof(double));
    current_nodenum--;
+   current[v >> 6] &= ~(static_cast<CoinUInt64>(1) << (v & 63));
    
-   /* decrease the degrees of v's neighbors by 1 */
-   const bool* node_node_start = node_node + (fgraph.nodenum * v);
-   for (int i = 0; i < current_nodenum; ++i)
-      if (node_node_start[current_indices[i]])
-	 current_degrees[i]--;
+   /* decrease the degrees of v's neighbors still in graph by 1 */
+   if (node_node) {
+      const CoinUInt64 *node_node_v = node_node + v * node_node_words;
+      for (int k = 0; k < node_node_words; k++)
+	 for (CoinUInt64 word = node_node_v[k] & current[k]; word;
+	      word &= word-1)
+	    current_degrees[(k << 6) + firstBit(word)]--;
+   } else {
+      const fnode& node = fgraph.nodes[v];
+      for (int i = 0; i < node.degree; i++)
+	 if (testBit(current, node.nbrs[i]))
+	    current_degrees[node.nbrs[i]]--;
+   }
+}
+
+/*****************************************************************************/
+
+/*===========================================================================*
+ * Put the neighbours of node into bits (node_node_words words).
+ *===========================================================================*/
+
+void
+CglClique::setNeighbours(int node, CoinUInt64* bits) const
+{
+   if (node_node) {
+      CoinMemcpyN(node_node + node * node_node_words, node_node_words, bits);
+   } else {
+      CoinZeroN(bits, node_node_words);
+      const fnode& thisNode = fgraph.nodes[node];
+      for (int i = 0; i < thisNode.degree; i++) {
+	 const int j = thisNode.nbrs[i];
+	 bits[j >> 6] |= static_cast<CoinUInt64>(1) << (j & 63);
+      }
+   }
+}
+
+/*===========================================================================*
+ * AND the neighbours of node into bits.  Without node_node the neighbours
+ * are first put into work.  Returns false if nothing is left.
+ *===========================================================================*/
+
+bool
+CglClique::andNeighbours(int node, CoinUInt64* bits, CoinUInt64* work) const
+{
+   const CoinUInt64* neighbours;
+   if (node_node) {
+      neighbours = node_node + node * node_node_words;
+   } else {
+      setNeighbours(node, work);
+      neighbours = work;
+   }
+   CoinUInt64 any = 0;
+   for (int k = 0; k < node_node_words; k++) {
+      bits[k] &= neighbours[k];
+      any |= bits[k];
+   }
+   return any != 0;
+}
+
+/*===========================================================================*
+ * Before enumeration the adjacency of the candidates to each other is
+ * packed into bits (cl_words words for each) so that whether a candidate
+ * can be added to the clique is an AND of words.
+ *===========================================================================*/
+
+void
+CglClique::prepareEnumeration(cl_search& search) const
+{
+   const int* cl_indices = search.cl_indices;
+   const int cl_length = search.cl_length;
+   const int cl_words = (cl_length + 63) >> 6;
+   search.cl_words = cl_words;
+   search.cl_adjacent = search.cl_label + cl_words;
+   CoinUInt64* cl_adjacent = search.cl_adjacent;
+   CoinZeroN(search.cl_label, cl_words);
+   CoinZeroN(cl_adjacent, cl_length * cl_words);
+   const CoinUInt64 one = 1;
+   for (int i = 0; i < cl_length; i++) {
+      for (int j = i + 1; j < cl_length; j++) {
+	 if (adjacent(cl_indices[i], cl_indices[j])) {
+	    cl_adjacent[i * cl_words + (j >> 6)] |= one << (j & 63);
+	    cl_adjacent[j * cl_words + (i >> 6)] |= one << (i & 63);
+	 }
+      }
+   }
 }
 
 /*****************************************************************************/
@@ -517,6 +910,8 @@ CglClique::scl_delete_node(const int del_ind, int& current_nodenum,
  *
  * Data members used from CglClique
  *   fgraph: IN, the description of the intersection graph
+ *
+ * Members of search used
  *   cl_perm_length: IN, the length of cl_perm_indices
  *   cl_perm_indices: IN, indices of nodes that MUST be in the clique, these
  *                    nodes are supposed to be connected to all nodes in
@@ -528,34 +923,45 @@ CglClique::scl_delete_node(const int del_ind, int& current_nodenum,
  *                   nodes are tested whether they can be added to a max
  *                   clique discovered in scl_indices. if any of them can be
  *                   added then the clique is not maximal after all...
+ *   cl_adjacent: IN, adjacency of nodes in cl_indices (see
+ *                prepareEnumeration)
+ *   cl_label: INOUT, bits for nodes in cl_indices in the clique at the
+ *             moment
  *
  * Arguments:
- *   label: INOUT, indicates which nodes are in the clique at the moment
+ *   search: IN, the candidates and where violated cliques go
  *   pos: INOUT, position within cl_indices (and label), nodes up to
  *        position pos in cl_indices are permanently labeled (backtrack cannot
  *        change labels)
  *===========================================================================*/
 
 int
-CglClique::enumerate_maximal_cliques(int& pos, bool* label, OsiCuts& cs)
+CglClique::enumerate_maximal_cliques(cl_search& search, int& pos) const
 {
    const fnode *nodes = fgraph.nodes;
-   const int nodenum = fgraph.nodenum;
+   const int* cl_indices = search.cl_indices;
+   const int cl_length = search.cl_length;
+   const int cl_words = search.cl_words;
+   const CoinUInt64* cl_adjacent = search.cl_adjacent;
+   CoinUInt64* label = search.cl_label;
+   const CoinUInt64 one = 1;
 
    int i, j, k, cnt;
 
    /* starting from position pos, find the first node in cl_indices that
-      can be added to the clique, and label it with true */
+      can be added to the clique (is adjacent to all labeled ones), and
+      label it */
    while (pos < cl_length) {
-      label[pos] = true;
-      const bool* node_node_start = node_node + cl_indices[pos] * nodenum;
-      for (j = 0; j < pos; j++)
-	 if (label[j] && ! node_node_start[cl_indices[j]]) {
-	    label[pos] = false;
+      const CoinUInt64* adjacent_pos = cl_adjacent + pos * cl_words;
+      for (k = 0; k < cl_words; k++)
+	 if (label[k] & ~adjacent_pos[k])
 	    break;
-	 }
-      if (label[pos++] == true)
+      if (k == cl_words) {
+	 label[pos >> 6] |= one << (pos & 63);
+	 pos++;
 	 break;
+      }
+      pos++;
    }
 
    /* found counts the number of maximal violated cliques that have been sent
@@ -566,16 +972,16 @@ CglClique::enumerate_maximal_cliques(int& pos, bool* label, OsiCuts& cs)
       labeled true once to true and once to false;
       otherwise check whether the clique found is maximal and violated */
    if (pos < cl_length) {
-      found += enumerate_maximal_cliques(pos, label, cs);
-      label[pos-1] = false;
-      found += enumerate_maximal_cliques(pos, label, cs);
+      found += enumerate_maximal_cliques(search, pos);
+      label[(pos-1) >> 6] &= ~(one << ((pos-1) & 63));
+      found += enumerate_maximal_cliques(search, pos);
    } else {
       /* check if the clique can be extended on cl_indices */
 
       /* copy indices of the clique into coef (not user inds, coef is a tmp) */
-      int* coef = new int[cl_length + cl_perm_length];
+      int* coef = new int[cl_length + search.cl_perm_length];
       for (j = cl_length - 1, cnt = 0; j >= 0; j--)
-	 if (label[j])
+	 if (testBit(label, j))
 	    coef[cnt++] = cl_indices[j];
       if (!cnt) {
 	 delete[] coef;
@@ -584,14 +990,14 @@ CglClique::enumerate_maximal_cliques(int& pos, bool* label, OsiCuts& cs)
       
       /* check if the clique can be extended on cl_indices */
       for (k = cl_length - 1; k >= 0; k--) {
-	 if (!label[k]) {
-	    const bool* node_node_start = node_node + cl_indices[k] * nodenum;
-	    for (i = cnt - 1; i >= 0; i--)
-	       if (!node_node_start[coef[i]])
+	 if (!testBit(label, k)) {
+	    const CoinUInt64* adjacent_k = cl_adjacent + k * cl_words;
+	    for (i = 0; i < cl_words; i++)
+	       if (label[i] & ~adjacent_k[i])
 		  break;
 	    /* if k can be added to the clique, return (the clique is not
 	       maximal, so it will be or was recorded) */
-	    if (i < 0) {
+	    if (i == cl_words) {
 	       delete[] coef;
 	       return(found);
 	    }
@@ -600,8 +1006,8 @@ CglClique::enumerate_maximal_cliques(int& pos, bool* label, OsiCuts& cs)
 
       /* now the clique is maximal on cl_indices.
 	 fill relative indices into coef */
-      for (j = 0; j < cl_perm_length; j++)
-	 coef[cnt++] = cl_perm_indices[j];
+      for (j = 0; j < search.cl_perm_length; j++)
+	 coef[cnt++] = search.cl_perm_indices[j];
       
       /* check if clique is violated */
       double lhs = 0;
@@ -613,20 +1019,27 @@ CglClique::enumerate_maximal_cliques(int& pos, bool* label, OsiCuts& cs)
       }
       
       /* if clique can be extended on cl_del_indices then it can be
-	 discarded (was already counted) */
-      for (i = 0; i < cl_del_length; i++) {
-	 const bool* node_node_start = node_node + cl_del_indices[i]*nodenum;
-	 for (j = cnt - 1; j >= 0; j--)
-	    if (!node_node_start[coef[j]])
-	       break;
-	 /* if cl_del_indices[i] can be added to the clique, return */
-	 if (j < 0) {
-	    delete[] coef;
-	    return(found);
+	 discarded (was already counted) - so look for a deleted node in
+	 the common neighbours of the clique */
+      if (search.cl_del_length) {
+	 CoinUInt64* common = search.common;
+	 setNeighbours(coef[0], common);
+	 bool any = true;
+	 for (j = 1; j < cnt && any; j++)
+	    any = andNeighbours(coef[j], common, search.work);
+	 for (k = 0; k < node_node_words && any; k++) {
+	    for (CoinUInt64 word = common[k]; word; word &= word-1) {
+	       const int node = (k << 6) + firstBit(word);
+	       /* if node can be added to the clique, return */
+	       if (search.cl_del_position[node] < search.cl_del_length) {
+		  delete[] coef;
+		  return(found);
+	       }
+	    }
 	 }
       }
 
-      recordClique(cnt, coef, cs);
+      recordClique(cnt, coef, *search.cs);
       delete[] coef;
       
       ++found;
@@ -645,28 +1058,31 @@ CglClique::enumerate_maximal_cliques(int& pos, bool* label, OsiCuts& cs)
  *===========================================================================*/
 
 int
-CglClique::greedy_maximal_clique(OsiCuts& cs)
+CglClique::greedy_maximal_clique(cl_search& search) const
 {
+   const int* cl_indices = search.cl_indices;
+   const int cl_length = search.cl_length;
    assert(cl_length > 0);
    const fnode *nodes = fgraph.nodes;
-   const int nodenum = fgraph.nodenum;
-   int i, j;
+   int j;
 
-   int * coef = new int[cl_length + cl_perm_length];
+   int * coef = new int[cl_length + search.cl_perm_length];
    coef[0] = cl_indices[0];
    int cnt = 1;
-   for (j = 1; j < cl_length; j++) {
+   /* common neighbours of the clique so far */
+   CoinUInt64* common = search.common;
+   setNeighbours(coef[0], common);
+   bool any = true;
+   for (j = 1; j < cl_length && any; j++) {
       const int var = cl_indices[j];
-      const bool* node_node_start = node_node + var * nodenum;
-      for (i = cnt-1; i >= 0; i--)
-	 if (!node_node_start[coef[i]])
-	    break;
-      if (i < 0)
+      if (testBit(common, var)) {
 	 coef[cnt++] = var;
+	 any = andNeighbours(var, common, search.work);
+      }
    }
 
-   for (j = 0; j < cl_perm_length; j++)
-      coef[cnt++] = cl_perm_indices[j];
+   for (j = 0; j < search.cl_perm_length; j++)
+      coef[cnt++] = search.cl_perm_indices[j];
 
    /* now coef contains the clique */
    /* only cliques of size at least 3 are interesting */
@@ -681,7 +1097,7 @@ CglClique::greedy_maximal_clique(OsiCuts& cs)
       lhs += nodes[coef[j]].val;
 
    if (lhs > 1 + petol) {
-      recordClique(cnt, coef, cs);
+      recordClique(cnt, coef, *search.cs);
       delete[] coef;
       return(1);
    }
@@ -696,22 +1112,759 @@ CglClique::greedy_maximal_clique(OsiCuts& cs)
  *===========================================================================*/
 
 void
-CglClique::recordClique(const int len, int* indices, OsiCuts& cs)
+CglClique::recordClique(const int len, int* indices, OsiCuts& cs) const
 {
-   /* transform relative indices into user indices and order them */
-   for (int j = len - 1; j >= 0; j--)
-      indices[j] = sp_orig_col_ind[indices[j]];
-   std::sort(indices, indices + len);
-   OsiRowCut rowcut;
+   /* transform relative indices into user indices and order them.
+      Complements (from conflict graph) are -1-index and go in as -x. */
    double* coef = new double[len];
-   std::fill(coef, coef + len, 1.0);
-   rowcut.setRow(len, indices, coef);
-   rowcut.setUb(1.0);
-   CoinAbsFltEq equal(1.0e-12);
-   cs.insertIfNotDuplicate(rowcut,equal);
+   double rhs = 1.0;
+   int j;
+   for (j = len - 1; j >= 0; j--) {
+      const int index = sp_orig_col_ind[indices[j]];
+      if (index >= 0) {
+	 indices[j] = index;
+	 coef[j] = 1.0;
+      } else {
+	 indices[j] = -1 - index;
+	 coef[j] = -1.0;
+	 rhs -= 1.0;
+      }
+   }
+   CoinSort_2(indices, indices + len, coef);
+   /* x and its complement together cancel out */
+   int n = 0;
+   for (j = 0; j < len; j++) {
+      if (n && indices[n-1] == indices[j]) {
+	 coef[n-1] += coef[j];
+	 if (!coef[n-1])
+	    n--;
+      } else {
+	 indices[n] = indices[j];
+	 coef[n++] = coef[j];
+      }
+   }
+   if (n) {
+      OsiRowCut rowcut;
+      rowcut.setRow(n, indices, coef);
+      rowcut.setUb(rhs);
+      CoinAbsFltEq equal(1.0e-12);
+      cs.insertIfNotDuplicate(rowcut,equal);
+   }
    delete[] coef;
 }
 
+/*****************************************************************************/
+
+/*===========================================================================*
+ * Build the global conflict graph from the rows.
+ *
+ * Each side of a row is taken as sum a_j x_j <= b. A binary with a_j > 0
+ * adds a_j to the activity when x_j is one and one with a_j < 0 adds -a_j
+ * when its complement is one. Two such literals can not both be one if
+ * their weights add up to more than b less the minimum activity. Sorting
+ * on decreasing weight, the largest clique is the longest prefix in which
+ * the last two are in conflict.
+ *===========================================================================*/
+
+/* Hash of coefficients and bounds of first numberRows rows so that a
+   conflict graph is not used with a changed matrix */
+static CoinUInt64
+hashRows(const OsiSolverInterface& si, int numberRows)
+{
+   const CoinPackedMatrix& mrow = *si.getMatrixByRow();
+   const double* elements = mrow.getElements();
+   const int* indices = mrow.getIndices();
+   const CoinBigIndex* starts = mrow.getVectorStarts();
+   const int* lengths = mrow.getVectorLengths();
+   const double* rlb = si.getRowLower();
+   const double* rub = si.getRowUpper();
+   CoinUInt64 hash = numberRows;
+   for (int i = 0; i < numberRows; ++i) {
+      double values[2] = {rlb[i], rub[i]};
+      CoinUInt64 bits;
+      for (int k = 0; k < 2; ++k) {
+	 memcpy(&bits, values + k, sizeof(bits));
+	 hash = hash * 31 + bits;
+      }
+      hash = hash * 31 + lengths[i];
+      for (CoinBigIndex j = starts[i]; j < starts[i] + lengths[i]; ++j) {
+	 memcpy(&bits, elements + j, sizeof(bits));
+	 hash = (hash * 31 + bits) * 31 + indices[j];
+      }
+   }
+   return hash;
+}
+
+bool
+CglClique::conflictGraphValid(const OsiSolverInterface& si) const
+{
+   if (!conflictColumns_ || conflictColumns_ != si.getNumCols() ||
+       conflictRows_ > si.getNumRows())
+      return false;
+   const double* collb = si.getColLower();
+   const double* colub = si.getColUpper();
+   for (int j = 0; j < conflictColumns_; ++j) {
+      if (collb[j] < conflictLower_[j] || colub[j] > conflictUpper_[j])
+	 return false;
+   }
+   return hashRows(si, conflictRows_) == conflictHash_;
+}
+
+void
+CglClique::buildConflictGraph(const OsiSolverInterface& si, int numberRows)
+{
+   deleteConflictGraph();
+   const int numcols = si.getNumCols();
+   if (numberRows < 0 || numberRows > si.getNumRows())
+      numberRows = si.getNumRows();
+   conflictColumns_ = numcols;
+   conflictRows_ = numberRows;
+   conflictHash_ = hashRows(si, numberRows);
+   conflictLower_ = CoinCopyOfArray(si.getColLower(), numcols);
+   conflictUpper_ = CoinCopyOfArray(si.getColUpper(), numcols);
+   // Need index even if no cliques
+   literalStart_ = new int[2*numcols+1];
+   CoinZeroN(literalStart_, 2*numcols+1);
+   const CoinPackedMatrix& mrow = *si.getMatrixByRow();
+   const double* collb = si.getColLower();
+   const double* colub = si.getColUpper();
+   const double* rlb = si.getRowLower();
+   const double* rub = si.getRowUpper();
+   // be safe - only take conflicts which are clear
+   const double tolerance = 1.0e-6;
+   std::vector<int> starts(1, 0);
+   std::vector<int> literals;
+   int* literal = new int[numcols];
+   double* weight = new double[numcols];
+   char* binary = new char[numcols];
+   int i, j;
+   for (j = 0; j < numcols; ++j)
+      binary[j] = si.isBinary(j) ? 1 : 0;
+   for (i = 0; i < numberRows; ++i) {
+      const CoinShallowPackedVector& vec = mrow.getVector(i);
+      const int len = vec.getNumElements();
+      if (len < 2)
+	 continue;
+      const int* ind = vec.getIndices();
+      const double* elem = vec.getElements();
+      // <= side then >= side (as -row <= -lower)
+      for (int side = 0; side < 2; ++side) {
+	 const double sign = side ? -1.0 : 1.0;
+	 const double rhs = side ? -rlb[i] : rub[i];
+	 if (rhs > 1.0e20)
+	    continue;
+	 double minActivity = 0.0;
+	 int n = 0;
+	 for (j = 0; j < len; ++j) {
+	    const int iColumn = ind[j];
+	    const double value = sign * elem[j];
+	    if (binary[iColumn]) {
+	       if (value > 0.0) {
+		  literal[n] = 2*iColumn;
+		  weight[n++] = value;
+	       } else if (value < 0.0) {
+		  minActivity += value;
+		  literal[n] = 2*iColumn+1;
+		  weight[n++] = -value;
+	       }
+	    } else if (value > 0.0) {
+	       if (collb[iColumn] < -1.0e20)
+		  break;
+	       minActivity += value * collb[iColumn];
+	    } else if (value < 0.0) {
+	       if (colub[iColumn] > 1.0e20)
+		  break;
+	       minActivity += value * colub[iColumn];
+	    }
+	 }
+	 if (j < len || n < 2)
+	    continue;
+	 const double slack = rhs - minActivity + tolerance;
+	 CoinSort_2(weight, weight + n, literal,
+		    CoinFirstGreater_2<double,int>());
+	 int size = 1;
+	 while (size < n && weight[size-1] + weight[size] > slack)
+	    size++;
+	 if (size < 2)
+	    continue;
+	 std::sort(literal, literal + size);
+	 literals.insert(literals.end(), literal, literal + size);
+	 starts.push_back(static_cast<int>(literals.size()));
+      }
+   }
+   delete[] literal;
+   delete[] weight;
+   delete[] binary;
+   const int numberCliques = static_cast<int>(starts.size()) - 1;
+   if (numberCliques)
+      addConflictCliques(numberCliques, &starts[0], &literals[0]);
+}
+
+/*===========================================================================*
+ * Add the cliques found by probing. An entry which fixes others when one
+ * is x_j, otherwise it is the complement 1-x_j.
+ *===========================================================================*/
+
+void
+CglClique::addProbingCliques(const CglProbing& probing)
+{
+   const int numberCliques = probing.numberCliques();
+   if (!conflictColumns_ || !numberCliques)
+      return;
+   const int* cliqueStart = probing.cliqueStart();
+   const CliqueEntry* entry = probing.cliqueEntry();
+   const int numberEntries = cliqueStart[numberCliques];
+   int* literal = new int[numberEntries];
+   for (int j = 0; j < numberEntries; ++j) {
+      const int iColumn = sequenceInCliqueEntry(entry[j]);
+      assert (iColumn < conflictColumns_);
+      literal[j] = oneFixesInCliqueEntry(entry[j]) ? 2*iColumn : 2*iColumn+1;
+   }
+   addConflictCliques(numberCliques, cliqueStart, literal);
+   delete[] literal;
+}
+
+/*===========================================================================*
+ * Add implications x_i = a => x_k = b as conflicts between the literal
+ * which is one when x_i = a and the one which is one when x_k = 1-b.
+ * Pairs already in a clique are skipped.
+ *===========================================================================*/
+
+void
+CglClique::addImplications(CglTreeProbingInfo& info)
+{
+   const int numberIntegers = info.numberIntegers();
+   if (!conflictColumns_ || !numberIntegers)
+      return;
+   const CliqueEntry* entry = info.fixEntries();
+   const int* toZero = info.toZero();
+   const int* toOne = info.toOne();
+   const int* integerVariable = info.integerVariable();
+   std::vector<std::pair<int,int> > pairs;
+   for (int jColumn = 0; jColumn < numberIntegers; ++jColumn) {
+      const int iColumn = integerVariable[jColumn];
+      if (iColumn >= conflictColumns_)
+	 continue;
+      for (int j = toZero[jColumn]; j < toZero[jColumn+1]; ++j) {
+	 // fixes on variables which are not 0-1 are after integers
+	 const int kInteger = sequenceInCliqueEntry(entry[j]);
+	 if (kInteger >= numberIntegers)
+	    continue;
+	 const int kColumn = integerVariable[kInteger];
+	 if (kColumn >= conflictColumns_)
+	    continue;
+	 // first lot are for x_i going to zero
+	 const int iLiteral = (j < toOne[jColumn]) ? 2*iColumn+1 : 2*iColumn;
+	 const int kLiteral =
+	    oneFixesInCliqueEntry(entry[j]) ? 2*kColumn+1 : 2*kColumn;
+	 if (conflictAdjacent(iLiteral, kLiteral))
+	    continue;
+	 pairs.push_back(std::make_pair(CoinMin(iLiteral, kLiteral),
+					CoinMax(iLiteral, kLiteral)));
+      }
+   }
+   std::sort(pairs.begin(), pairs.end());
+   pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+   const int numberPairs = static_cast<int>(pairs.size());
+   if (!numberPairs)
+      return;
+   int* starts = new int[numberPairs+1];
+   int* literal = new int[2*numberPairs];
+   for (int i = 0; i < numberPairs; ++i) {
+      starts[i] = 2*i;
+      literal[2*i] = pairs[i].first;
+      literal[2*i+1] = pairs[i].second;
+   }
+   starts[numberPairs] = 2*numberPairs;
+   addConflictCliques(numberPairs, starts, literal);
+   delete[] starts;
+   delete[] literal;
+}
+
+/*===========================================================================*
+ * Append cliques (of at least two literals) and redo index by literal.
+ *===========================================================================*/
+
+void
+CglClique::addConflictCliques(int numberCliques, const int* starts,
+			      const int* literals)
+{
+   const int numberLiterals = 2*conflictColumns_;
+   const int oldCliques = numberConflictCliques_;
+   const int oldEntries = oldCliques ? conflictStart_[oldCliques] : 0;
+   const int maxEntries = oldEntries + starts[numberCliques] - starts[0];
+   int* newStart = new int[oldCliques+numberCliques+1];
+   int* newLiteral = new int[maxEntries];
+   if (oldCliques) {
+      CoinMemcpyN(conflictStart_, oldCliques+1, newStart);
+      CoinMemcpyN(conflictLiteral_, oldEntries, newLiteral);
+   } else {
+      newStart[0] = 0;
+   }
+   int n = oldCliques;
+   int nEntries = oldEntries;
+   for (int i = 0; i < numberCliques; ++i) {
+      if (starts[i+1] - starts[i] < 2)
+	 continue;
+      const int first = nEntries;
+      for (int j = starts[i]; j < starts[i+1]; ++j) {
+	 assert (literals[j] >= 0 && literals[j] < numberLiterals);
+	 newLiteral[nEntries++] = literals[j];
+      }
+      std::sort(newLiteral + first, newLiteral + nEntries);
+      newStart[++n] = nEntries;
+   }
+   delete[] conflictStart_;
+   delete[] conflictLiteral_;
+   conflictStart_ = newStart;
+   conflictLiteral_ = newLiteral;
+   numberConflictCliques_ = n;
+   // index by literal - cliques go in increasing order
+   delete[] literalClique_;
+   CoinZeroN(literalStart_, numberLiterals+1);
+   for (int j = 0; j < nEntries; ++j)
+      literalStart_[conflictLiteral_[j]+1]++;
+   for (int i = 0; i < numberLiterals; ++i)
+      literalStart_[i+1] += literalStart_[i];
+   literalClique_ = new int[nEntries];
+   int* put = CoinCopyOfArray(literalStart_, numberLiterals);
+   for (int i = 0; i < n; ++i) {
+      for (int j = conflictStart_[i]; j < conflictStart_[i+1]; ++j)
+	 literalClique_[put[conflictLiteral_[j]]++] = i;
+   }
+   delete[] put;
+}
+
+/*===========================================================================*
+ * Whether two literals share a clique - merge of sorted clique lists.
+ *===========================================================================*/
+
+bool
+CglClique::conflictAdjacent(int literal0, int literal1) const
+{
+   int j0 = literalStart_[literal0];
+   const int end0 = literalStart_[literal0+1];
+   int j1 = literalStart_[literal1];
+   const int end1 = literalStart_[literal1+1];
+   while (j0 < end0 && j1 < end1) {
+      if (literalClique_[j0] == literalClique_[j1])
+	 return true;
+      if (literalClique_[j0] < literalClique_[j1])
+	 ++j0;
+      else
+	 ++j1;
+   }
+   return false;
+}
+
+/*===========================================================================*
+ * Merging set packing rows.
+ *
+ * Each set packing row is extended greedily by literals in conflict with
+ * all of the row (found among the neighbours of the literal of the row in
+ * fewest cliques), taking those in most cliques first. Rows are done in
+ * blocks by merge_task and then each merged row is checked against the
+ * others by dominated_task. A row is dominated if its merged clique is
+ * strictly contained in another one, or is the same as one of an earlier
+ * row, so there is always a row left which implies it.
+ *===========================================================================*/
+
+typedef struct {
+   const CglClique * clique;
+   /* first candidate row of each task */
+   const int * taskStart;
+   /* candidate rows */
+   const int * whichRow;
+   /* row copy */
+   const CoinBigIndex * rowStart;
+   const int * rowLength;
+   const int * column;
+   /* whether column is binary */
+   const char * binary;
+   /* merged rows for each task, then all of them */
+   std::vector<int> * merged;
+   const int * allMerged;
+   /* for each candidate - start (in task's merged and then allMerged)
+      and length */
+   int * mergedStart;
+   int * mergedLength;
+   /* candidates containing each literal */
+   const int * literalStart;
+   const int * literalRow;
+   /* result */
+   char * dominated;
+   /* work space for each thread */
+   char ** mark;
+   int ** candidate;
+   int ** key;
+} CglCliqueMergeInfo;
+
+void
+CglClique::mergeCliqueRows(const OsiSolverInterface& si,
+			   OsiRowCut** strengthenRow, int numberRows)
+{
+   const int numcols = si.getNumCols();
+   if (!conflictGraphValid(si)) {
+      // Do with conflict graph for this solver (but keep ours)
+      CglClique temp;
+      temp.maxMergedLength_ = maxMergedLength_;
+      temp.numberThreads_ = numberThreads_;
+      temp.buildConflictGraph(si, numberRows);
+      temp.mergeCliqueRows(si, strengthenRow, numberRows);
+      numberMergedRows_ = temp.numberMergedRows_;
+      numberDominatedRows_ = temp.numberDominatedRows_;
+      return;
+   }
+   numberMergedRows_ = 0;
+   numberDominatedRows_ = 0;
+   if (numberRows < 0 || numberRows > si.getNumRows())
+      numberRows = si.getNumRows();
+   const CoinPackedMatrix& mrow = *si.getMatrixByRow();
+   const double* elementByRow = mrow.getElements();
+   const int* column = mrow.getIndices();
+   const CoinBigIndex* rowStart = mrow.getVectorStarts();
+   const int* rowLength = mrow.getVectorLengths();
+   const double* rlb = si.getRowLower();
+   const double* rub = si.getRowUpper();
+   char* binary = new char[numcols];
+   int i, j, k;
+   for (j = 0; j < numcols; ++j)
+      binary[j] = si.isBinary(j) ? 1 : 0;
+   // Set packing rows not already strengthened
+   int* whichRow = new int[numberRows];
+   int numberCandidates = 0;
+   for (i = 0; i < numberRows; ++i) {
+      if (strengthenRow[i] || rub[i] != 1.0 || rlb[i] > 0.0 ||
+	  rowLength[i] < 2)
+	 continue;
+      const CoinBigIndex end = rowStart[i] + rowLength[i];
+      CoinBigIndex jj;
+      for (jj = rowStart[i]; jj < end; ++jj) {
+	 if (elementByRow[jj] != 1.0 || !binary[column[jj]])
+	    break;
+      }
+      if (jj == end)
+	 whichRow[numberCandidates++] = i;
+   }
+   if (!numberCandidates) {
+      delete[] binary;
+      delete[] whichRow;
+      return;
+   }
+   const int numberLiterals = 2*numcols;
+   const int numberThreads = CglNumberThreads(numberThreads_,
+					      numberCandidates);
+   const int numberTasks = numberCliqueTasks(numberThreads, numberCandidates);
+   int iTask, iThread;
+   int* taskStart = new int[numberTasks+1];
+   for (iTask = 0; iTask <= numberTasks; iTask++)
+      taskStart[iTask] = (numberCandidates * iTask) / numberTasks;
+   CglCliqueMergeInfo info;
+   memset(&info, 0, sizeof(info));
+   info.clique = this;
+   info.taskStart = taskStart;
+   info.whichRow = whichRow;
+   info.rowStart = rowStart;
+   info.rowLength = rowLength;
+   info.column = column;
+   info.binary = binary;
+   info.merged = new std::vector<int> [numberTasks];
+   info.mergedStart = new int[numberCandidates];
+   info.mergedLength = new int[numberCandidates];
+   info.mark = new char * [numberThreads];
+   info.candidate = new int * [numberThreads];
+   info.key = new int * [numberThreads];
+   for (iThread = 0; iThread < numberThreads; iThread++) {
+      info.mark[iThread] = new char[numberLiterals];
+      CoinZeroN(info.mark[iThread], numberLiterals);
+      info.candidate[iThread] = new int[numberLiterals];
+      info.key[iThread] = new int[numberLiterals];
+   }
+   CglRunTasks(numberThreads, numberTasks, merge_task, &info);
+   // put together and index by literal
+   int numberEntries = 0;
+   for (iTask = 0; iTask < numberTasks; iTask++)
+      numberEntries += static_cast<int>(info.merged[iTask].size());
+   int* allMerged = new int[numberEntries];
+   numberEntries = 0;
+   for (iTask = 0; iTask < numberTasks; iTask++) {
+      const std::vector<int>& merged = info.merged[iTask];
+      if (merged.size())
+	 CoinMemcpyN(&merged[0], static_cast<int>(merged.size()),
+		     allMerged + numberEntries);
+      for (k = taskStart[iTask]; k < taskStart[iTask+1]; k++)
+	 info.mergedStart[k] += numberEntries;
+      numberEntries += static_cast<int>(merged.size());
+   }
+   delete[] info.merged;
+   info.merged = NULL;
+   int* literalStart = new int[numberLiterals+1];
+   CoinZeroN(literalStart, numberLiterals+1);
+   for (j = 0; j < numberEntries; j++)
+      literalStart[allMerged[j]+1]++;
+   for (j = 0; j < numberLiterals; j++)
+      literalStart[j+1] += literalStart[j];
+   int* literalRow = new int[numberEntries];
+   int* put = CoinCopyOfArray(literalStart, numberLiterals);
+   for (k = 0; k < numberCandidates; k++) {
+      const int* merged = allMerged + info.mergedStart[k];
+      for (j = 0; j < info.mergedLength[k]; j++)
+	 literalRow[put[merged[j]]++] = k;
+   }
+   delete[] put;
+   char* dominated = new char[numberCandidates];
+   info.allMerged = allMerged;
+   info.literalStart = literalStart;
+   info.literalRow = literalRow;
+   info.dominated = dominated;
+   CglRunTasks(numberThreads, numberTasks, dominated_task, &info);
+   // Put in stronger rows (and empty ones for dominated)
+   int* index = new int[numcols+1];
+   double* element = new double[numcols+1];
+   for (k = 0; k < numberCandidates; k++) {
+      const int iRow = whichRow[k];
+      OsiRowCut rc;
+      rc.setLb(-COIN_DBL_MAX);
+      if (dominated[k]) {
+	 rc.setUb(1.0);
+	 numberDominatedRows_++;
+      } else if (info.mergedLength[k] > rowLength[iRow]) {
+	 const int* merged = allMerged + info.mergedStart[k];
+	 const int n = info.mergedLength[k];
+	 double rhs = 1.0;
+	 for (j = 0; j < n; j++) {
+	    index[j] = merged[j] >> 1;
+	    if (merged[j] & 1) {
+	       element[j] = -1.0;
+	       rhs -= 1.0;
+	    } else {
+	       element[j] = 1.0;
+	    }
+	 }
+	 rc.setRow(n, index, element, false);
+	 rc.setUb(rhs);
+	 numberMergedRows_++;
+      } else {
+	 continue;
+      }
+      rc.setEffectiveness(1.0);
+      strengthenRow[iRow] = rc.clone();
+   }
+   delete[] index;
+   delete[] element;
+   for (iThread = 0; iThread < numberThreads; iThread++) {
+      delete[] info.mark[iThread];
+      delete[] info.candidate[iThread];
+      delete[] info.key[iThread];
+   }
+   delete[] info.mark;
+   delete[] info.candidate;
+   delete[] info.key;
+   delete[] info.mergedStart;
+   delete[] info.mergedLength;
+   delete[] allMerged;
+   delete[] literalStart;
+   delete[] literalRow;
+   delete[] dominated;
+   delete[] taskStart;
+   delete[] binary;
+   delete[] whichRow;
+}
+
+/*===========================================================================*
+ * Extend one block of set packing rows (see mergeCliqueRows)
+ *===========================================================================*/
+
+void
+CglClique::merge_task(void* voidInfo, int iTask, int iThread)
+{
+   CglCliqueMergeInfo * info =
+      reinterpret_cast<CglCliqueMergeInfo *> (voidInfo);
+   const CglClique & clique = *info->clique;
+   const int* literalStart = clique.literalStart_;
+   const int* literalClique = clique.literalClique_;
+   const int* conflictStart = clique.conflictStart_;
+   const int* conflictLiteral = clique.conflictLiteral_;
+   const int maxLength = clique.maxMergedLength_;
+   /* 1 if column in row, 2 if literal already a candidate */
+   char* mark = info->mark[iThread];
+   int* candidate = info->candidate[iThread];
+   int* key = info->key[iThread];
+   std::vector<int>& merged = info->merged[iTask];
+   int i, j;
+   for (int k = info->taskStart[iTask]; k < info->taskStart[iTask+1]; k++) {
+      const int iRow = info->whichRow[k];
+      const int* row = info->column + info->rowStart[iRow];
+      const int length = info->rowLength[iRow];
+      const int first = static_cast<int>(merged.size());
+      info->mergedStart[k] = first;
+      // literal of row in fewest cliques
+      int pivot = -1;
+      int best = COIN_INT_MAX;
+      for (j = 0; j < length; j++) {
+	 const int literal = 2*row[j];
+	 merged.push_back(literal);
+	 mark[literal] = 1;
+	 mark[literal+1] = 1;
+	 const int n = literalStart[literal+1] - literalStart[literal];
+	 if (n < best) {
+	    best = n;
+	    pivot = literal;
+	 }
+      }
+      if (length < maxLength) {
+	 // neighbours of pivot
+	 int numberCandidates = 0;
+	 for (i = literalStart[pivot]; i < literalStart[pivot+1]; i++) {
+	    const int iClique = literalClique[i];
+	    for (j = conflictStart[iClique]; j < conflictStart[iClique+1];
+		 j++) {
+	       const int literal = conflictLiteral[j];
+	       if (!mark[literal] && info->binary[literal>>1]) {
+		  mark[literal] = 2;
+		  candidate[numberCandidates++] = literal;
+	       }
+	    }
+	 }
+	 // keep those in conflict with all of row
+	 int n = 0;
+	 for (i = 0; i < numberCandidates; i++) {
+	    const int literal = candidate[i];
+	    mark[literal] = 0;
+	    for (j = 0; j < length; j++) {
+	       const int other = 2*row[j];
+	       if (other != pivot && !clique.conflictAdjacent(literal, other))
+		  break;
+	    }
+	    if (j == length) {
+	       key[n] = literalStart[literal] - literalStart[literal+1];
+	       candidate[n++] = literal;
+	    }
+	 }
+	 // greedily - most cliques first
+	 CoinSort_2(key, key + n, candidate);
+	 for (i = 0; i < n; i++) {
+	    if (static_cast<int>(merged.size()) - first >= maxLength)
+	       break;
+	    const int literal = candidate[i];
+	    const int size = static_cast<int>(merged.size());
+	    for (j = first + length; j < size; j++) {
+	       const int other = merged[j];
+	       // not both x and 1-x
+	       if ((other^literal) == 1 ||
+		   !clique.conflictAdjacent(literal, other))
+		  break;
+	    }
+	    if (j == size)
+	       merged.push_back(literal);
+	 }
+      }
+      for (j = 0; j < length; j++) {
+	 mark[2*row[j]] = 0;
+	 mark[2*row[j]+1] = 0;
+      }
+      std::sort(merged.begin() + first, merged.end());
+      info->mergedLength[k] = static_cast<int>(merged.size()) - first;
+   }
+}
+
+/*===========================================================================*
+ * Find which of one block of merged rows are dominated (see
+ * mergeCliqueRows). Only rows with the literal of fewest rows need to be
+ * looked at and both are in increasing order.
+ *===========================================================================*/
+
+void
+CglClique::dominated_task(void* voidInfo, int iTask, int /*iThread*/)
+{
+   CglCliqueMergeInfo * info =
+      reinterpret_cast<CglCliqueMergeInfo *> (voidInfo);
+   const int* allMerged = info->allMerged;
+   const int* mergedStart = info->mergedStart;
+   const int* mergedLength = info->mergedLength;
+   const int* literalStart = info->literalStart;
+   const int* literalRow = info->literalRow;
+   for (int k = info->taskStart[iTask]; k < info->taskStart[iTask+1]; k++) {
+      info->dominated[k] = 0;
+      const int* merged = allMerged + mergedStart[k];
+      const int length = mergedLength[k];
+      int pivot = merged[0];
+      int j;
+      for (j = 1; j < length; j++) {
+	 const int literal = merged[j];
+	 if (literalStart[literal+1] - literalStart[literal] <
+	     literalStart[pivot+1] - literalStart[pivot])
+	    pivot = literal;
+      }
+      for (j = literalStart[pivot]; j < literalStart[pivot+1]; j++) {
+	 const int i = literalRow[j];
+	 const int otherLength = mergedLength[i];
+	 if (i == k || otherLength < length ||
+	     (otherLength == length && i > k))
+	    continue;
+	 // is merged a subset of other
+	 const int* other = allMerged + mergedStart[i];
+	 int n = 0;
+	 for (int m = 0; m < otherLength && n < length; m++) {
+	    if (other[m] == merged[n])
+	       n++;
+	    else if (other[m] > merged[n])
+	       break;
+	 }
+	 if (n == length) {
+	    info->dominated[k] = 1;
+	    break;
+	 }
+      }
+   }
+}
+
+void
+CglClique::deleteConflictGraph()
+{
+   delete[] conflictStart_;   conflictStart_ = 0;
+   delete[] conflictLiteral_; conflictLiteral_ = 0;
+   delete[] literalStart_;    literalStart_ = 0;
+   delete[] literalClique_;   literalClique_ = 0;
+   delete[] conflictLower_;   conflictLower_ = 0;
+   delete[] conflictUpper_;   conflictUpper_ = 0;
+   conflictColumns_ = 0;
+   conflictRows_ = 0;
+   conflictHash_ = 0;
+   numberConflictCliques_ = 0;
+}
+
+void
+CglClique::copyConflictGraph(const CglClique& rhs)
+{
+   if (!rhs.conflictColumns_)
+      return;
+   conflictColumns_ = rhs.conflictColumns_;
+   conflictRows_ = rhs.conflictRows_;
+   conflictHash_ = rhs.conflictHash_;
+   conflictLower_ = CoinCopyOfArray(rhs.conflictLower_, conflictColumns_);
+   conflictUpper_ = CoinCopyOfArray(rhs.conflictUpper_, conflictColumns_);
+   numberConflictCliques_ = rhs.numberConflictCliques_;
+   const int numberLiterals = 2*conflictColumns_;
+   literalStart_ = CoinCopyOfArray(rhs.literalStart_, numberLiterals+1);
+   literalClique_ = CoinCopyOfArray(rhs.literalClique_,
+				    rhs.literalStart_[numberLiterals]);
+   if (numberConflictCliques_) {
+      conflictStart_ = CoinCopyOfArray(rhs.conflictStart_,
+				       numberConflictCliques_+1);
+      conflictLiteral_ = CoinCopyOfArray(rhs.conflictLiteral_,
+				 rhs.conflictStart_[numberConflictCliques_]);
+   }
+}
+
+// Conflict graph may not be valid for new solver
+void
+CglClique::refreshSolver(OsiSolverInterface * solver)
+{
+   if (!solver || !conflictGraphValid(*solver))
+      deleteConflictGraph();
+}
+
 //-------------------------------------------------------------------
 // Clone
 //-------------------------------------------------------------------
@@ -777,6 +1930,22 @@ CglClique::generateCpp( FILE * fp)
     fprintf(fp,"3  clique.setMinViolation(%g);\n",petol);
   else
     fprintf(fp,"4  clique.setMinViolation(%g);\n",petol);
+  if (useConflictGraph_!=other.useConflictGraph_)
+    fprintf(fp,"3  clique.setUseConflictGraph(%s);\n",
+	    useConflictGraph_ ? "true" : "false");
+  else
+    fprintf(fp,"4  clique.setUseConflictGraph(%s);\n",
+	    useConflictGraph_ ? "true" : "false");
+  if (mergeCliques_!=other.mergeCliques_)
+    fprintf(fp,"3  clique.setMergeCliques(%s);\n",
+	    mergeCliques_ ? "true" : "false");
+  else
+    fprintf(fp,"4  clique.setMergeCliques(%s);\n",
+	    mergeCliques_ ? "true" : "false");
+  if (maxMergedLength_!=other.maxMergedLength_)
+    fprintf(fp,"3  clique.setMaxMergedLength(%d);\n",maxMergedLength_);
+  else
+    fprintf(fp,"4  clique.setMaxMergedLength(%d);\n",maxMergedLength_);
   if (getAggressiveness()!=other.getAggressiveness())
     fprintf(fp,"3  clique.setAggressiveness(%d);\n",getAggressiveness());
   else
@@ -785,7 +1954,6 @@ CglClique::generateCpp( FILE * fp)
 }
 /*****************************************************************************/
 
-#include "../CglProbing/CglProbing.hpp"
 CglFakeClique::CglFakeClique(OsiSolverInterface * solver, bool setPacking) :
   CglClique(setPacking,true)
 {
@@ -6,10 +6,15 @@
 #ifndef _CglClique_h_
 #define _CglClique_h_
 
+#include <algorithm>
+
 #include "CglCutGenerator.hpp"
+#include "CoinTypes.hpp"
 
 //class OsiCuts;
 //class OsiSolverInterface;
+class CglProbing;
+class CglTreeProbingInfo;
 
 class CglClique : public CglCutGenerator {
 
@@ -52,12 +57,84 @@ public:
     */
     CglClique(bool setPacking = false, bool justOriginalRows = false);
     /// Destructor
-    virtual ~CglClique() {}
+    virtual ~CglClique();
     /// Create C++ lines to get to current state
     virtual std::string generateCpp( FILE * fp);
+    /** Conflict graph is deleted unless still valid for solver (it is
+	built again at next root node if setUseConflictGraph).  This is
+	where a changed problem is noticed - generateCuts only checks
+	that the size is the same. */
+    virtual void refreshSolver(OsiSolverInterface * solver);
 
     void considerRows(const int numRows, const int* rowInd);
 
+    /**@name Global conflict graph
+
+       Conflicts do not change between calls - only the fractional
+       variables do.  So a conflict graph over all binary variables and
+       their complements can be kept as a list of cliques.  If there is one
+       (and the number of columns is the same) generateCuts just takes the
+       subgraph induced by the fractional variables rather than scanning
+       the matrix.  Cuts may then have complemented variables i.e.
+       x_j + ... + (1-x_k) <= 1.
+    */
+    //@{
+    /** Build conflict graph from rows of si.  From each row the largest
+	set of binaries (or complements) of which no two can be one
+	together is taken - for a set packing row that is all of it.
+	Bounds should be global ones as conflict graph is used at all
+	nodes.  Only first numberRows rows are looked at (all if -1).
+    */
+    void buildConflictGraph(const OsiSolverInterface& si, int numberRows = -1);
+    /// Add cliques from probing (conflict graph must exist)
+    void addProbingCliques(const CglProbing& probing);
+    /// Add implications between binaries (conflict graph must exist)
+    void addImplications(CglTreeProbingInfo& info);
+    /// Delete conflict graph
+    void deleteConflictGraph();
+    /** Whether conflict graph can be used with si - same columns, rows it
+	was built from unchanged and bounds no looser.  Used by
+	refreshSolver and mergeCliqueRows - it looks at every row so is
+	not done on each call to generateCuts. */
+    bool conflictGraphValid(const OsiSolverInterface& si) const;
+    /// Number of cliques in conflict graph
+    inline int numberConflictCliques() const
+    { return numberConflictCliques_; }
+    /** If true generateCuts builds conflict graph from solver the first
+	time it is called at root node */
+    void setUseConflictGraph(bool yesno = true) { useConflictGraph_ = yesno; }
+    bool getUseConflictGraph() const { return useConflictGraph_; }
+    //@}
+
+    /**@name Merging set packing rows
+
+       A set packing row (all coefficients one on binaries and '<= 1') can
+       be extended to a larger clique from the conflict graph, and a row
+       whose clique is then contained in another one is not needed.  This
+       is done in generateCuts at root node if asked for and the
+       CglTreeInfo has strengthenRow (as in CglPreProcess).
+    */
+    //@{
+    /** Extend each set packing row of the first numberRows rows of si (all
+	if -1) to a maximal clique - taking at most maxMergedLength
+	literals.  Where a row is not in strengthenRow already a stronger
+	row goes in there or an empty row if it is dominated.  Conflict
+	graph is built if there is not one.
+    */
+    void mergeCliqueRows(const OsiSolverInterface& si,
+			 OsiRowCut** strengthenRow, int numberRows = -1);
+    /// If true generateCuts merges set packing rows (see above)
+    void setMergeCliques(bool yesno = true) { mergeCliques_ = yesno; }
+    bool getMergeCliques() const { return mergeCliques_; }
+    /// Maximum length of merged row
+    void setMaxMergedLength(int value) { maxMergedLength_ = value; }
+    int getMaxMergedLength() const { return maxMergedLength_; }
+    /// Number of rows made longer by last merge
+    inline int numberMergedRows() const { return numberMergedRows_; }
+    /// Number of rows found to be dominated by last merge
+    inline int numberDominatedRows() const { return numberDominatedRows_; }
+    //@}
+
 public:
     /** possible choices for selecting the next node in the star clique search
      */
@@ -87,6 +164,18 @@ public:
     void setMinViolation(double minviol) { petol = minviol; }
     double getMinViolation() const { return petol; }
 
+    /** Set number of threads used to search rows and stars (only used if
+	compiled with CGL_THREAD). Cuts are the same whatever the number. */
+    void setNumberThreads(int value) { numberThreads_ = value; }
+    int numberThreads() const { return numberThreads_; }
+
+    /** Set maximum number of fractional columns for which adjacency is
+	kept as a bit matrix (which needs columns*columns/8 bytes).  Above
+	that sorted adjacency lists are used.  Cuts are the same either
+	way. */
+    void setMaxNodeNodeColumns(int value) { maxNodeNodeColumns_ = value; }
+    int getMaxNodeNodeColumns() const { return maxNodeNodeColumns_; }
+
 private:
 
     struct frac_graph ;
@@ -133,6 +222,44 @@ private:
 	    nodes(0), all_nbr(0), all_edgecost(0) {}
     };
 
+    /** A search for maximal cliques in a candidate list. Searches are
+	independent so several can be done at once (one for each thread). */
+    struct cl_search {
+	/** List of indices that must be in the to be created clique. This is
+	    just a pointer, it is never new'd and therefore does not need to
+	    be delete[]'d either. */
+	const int* cl_perm_indices;
+	/** The length of cl_perm_indices */
+	int cl_perm_length;
+	/** List of indices that should be considered for extending the ones
+	    listed in cl_perm_indices. */
+	const int* cl_indices;
+	/** The length of cl_indices */
+	int cl_length;
+	/** An array of nodes discarded from the candidate list. These are
+	    rechecked when a maximal clique is found just to make sure that
+	    the clique is really maximal. */
+	const int* cl_del_indices;
+	/** The length of cl_del_indices */
+	int cl_del_length;
+	/** Where violated cliques go */
+	OsiCuts* cs;
+	/** For each node its position in cl_del_indices (only looked at if
+	    cl_del_length) */
+	const int* cl_del_position;
+	/** Work space - node_node_words words each */
+	CoinUInt64* common;
+	CoinUInt64* work;
+	/** Number of words for a bit for each node in cl_indices */
+	int cl_words;
+	/** Adjacency of nodes in cl_indices to each other - cl_words words
+	    for each (only for enumeration) */
+	CoinUInt64* cl_adjacent;
+	/** Nodes of cl_indices in the clique at the moment (cl_words
+	    words) */
+	CoinUInt64* cl_label;
+    };
+
 protected:
     /** An indicator showing whether the whole matrix in the solverinterface is
 	a set packing problem or not */
@@ -150,10 +277,57 @@ protected:
     int* sp_row_start;
     int* sp_row_ind;
 
+    /** Global conflict graph as cliques of literals - literal 2*j is x_j
+	and 2*j+1 is its complement 1-x_j */
+    /**@{*/
+    /** whether to build conflict graph at root node */
+    bool useConflictGraph_;
+    /** number of columns conflict graph is for (0 if none) */
+    int conflictColumns_;
+    /** number of cliques in conflict graph */
+    int numberConflictCliques_;
+    /** start of each clique in conflictLiteral_ */
+    int* conflictStart_;
+    /** literals in each clique (in increasing order) */
+    int* conflictLiteral_;
+    /** start of each literal in literalClique_ (2*conflictColumns_+1) */
+    int* literalStart_;
+    /** cliques for each literal (in increasing order) */
+    int* literalClique_;
+    /** number of rows conflict graph was built from */
+    int conflictRows_;
+    /** hash of coefficients and bounds of those rows */
+    CoinUInt64 conflictHash_;
+    /** column bounds when conflict graph was built (conflicts stay valid
+	if bounds are tightened but not if they are relaxed) */
+    double* conflictLower_;
+    double* conflictUpper_;
+    /**@}*/
+
+    /** Merging set packing rows */
+    /**@{*/
+    /** whether to merge set packing rows at root node */
+    bool mergeCliques_;
+    /** maximum length of merged row */
+    int maxMergedLength_;
+    /** number of rows made longer by last merge */
+    int numberMergedRows_;
+    /** number of rows dominated in last merge */
+    int numberDominatedRows_;
+    /**@}*/
+
     /** the intersection graph corresponding to the set packing problem */
     frac_graph fgraph;
-    /** the node-node incidence matrix of the intersection graph. */
-    bool* node_node;
+    /** the node-node incidence matrix of the intersection graph, packed
+	into bits - node_node_words words for each node.  Zero if there
+	are more than maxNodeNodeColumns_ nodes (then the adjacency lists
+	in fgraph are used). */
+    CoinUInt64* node_node;
+    /** number of words for each node in node_node (or any set of
+	nodes) */
+    int node_node_words;
+    /** maximum number of nodes for which node_node is created */
+    int maxNodeNodeColumns_;
 
     /** The primal tolerance in the solverinterface. */
     double petol;
@@ -184,33 +358,53 @@ protected:
     int rcl_candidate_length_threshold;
     /** whether to give a detailed statistics on the row clique method */
     bool rcl_report_result;
-    /**@}*/
-
-    /** variables/arrays that are used across many methods */
-    /**@{*/
-    /** List of indices that must be in the to be created clique. This is just
-	a pointer, it is never new'd and therefore does not need to be
-	delete[]'d either. */
-    const int* cl_perm_indices;
-    /** The length of cl_perm_indices */
-    int cl_perm_length;
-
-    /** List of indices that should be considered for extending the ones listed
-	in cl_perm_indices. */
-    int* cl_indices;
-    /** The length of cl_indices */
-    int cl_length;
-
-    /** An array of nodes discarded from the candidate list. These are
-	rechecked when a maximal clique is found just to make sure that the
-	clique is really maximal. */
-    int* cl_del_indices;
-    /** The length of cl_del_indices */
-    int cl_del_length;
-
+    /** Number of threads to search rows and stars with (only used if
+	compiled with CGL_THREAD) */
+    int numberThreads_;
     /**@}*/
 
 private:
+    /** whether nodes i and j are adjacent in the intersection graph */
+    inline bool adjacent(int i, int j) const {
+	if (node_node)
+	    return ((node_node[i*node_node_words+(j>>6)]>>(j&63))&1)!=0;
+	// adjacency lists are in increasing order
+	const fnode& node = fgraph.nodes[i];
+	return std::binary_search(node.nbrs, node.nbrs + node.degree, j);
+    }
+    /** whether bit j is set */
+    static inline bool testBit(const CoinUInt64* bits, int j) {
+	return ((bits[j>>6]>>(j&63))&1)!=0;
+    }
+    /** Put neighbours of node into bits (node_node_words words) */
+    void setNeighbours(int node, CoinUInt64* bits) const;
+    /** AND neighbours of node into bits (work is used if no node_node).
+	Returns false if no bits left. */
+    bool andNeighbours(int node, CoinUInt64* bits, CoinUInt64* work) const;
+    /** number of bits set in word */
+    static inline int bitCount(CoinUInt64 word) {
+#ifdef __GNUC__
+	return __builtin_popcountll(word);
+#else
+	int n = 0;
+	for (; word; word &= word-1)
+	    n++;
+	return n;
+#endif
+    }
+    /** position of lowest bit set in word (which must not be zero) */
+    static inline int firstBit(CoinUInt64 word) {
+#ifdef __GNUC__
+	return __builtin_ctzll(word);
+#else
+	int n = 0;
+	while (!(word&1)) {
+	    word >>= 1;
+	    n++;
+	}
+	return n;
+#endif
+    }
     /** Scan through the variables and select those that are binary and are at
 	a fractional level. */
     void selectFractionalBinaries(const OsiSolverInterface& si);
@@ -221,6 +415,18 @@ private:
     void selectRowCliques(const OsiSolverInterface& si,int numOriginalRows);
     /**  */
     void createSetPackingSubMatrix(const OsiSolverInterface& si);
+    /** Create the set packing submatrix from the conflict graph. The
+	columns are the literals of the fractional binaries
+	(sp_orig_col_ind is -1-j for complement of x_j) and the rows are the
+	cliques with at least two of them. */
+    void createConflictSubMatrix();
+    /** Add cliques to conflict graph */
+    void addConflictCliques(int numberCliques, const int* starts,
+			    const int* literals);
+    /** Whether two literals are in a clique of the conflict graph */
+    bool conflictAdjacent(int literal0, int literal1) const;
+    /** Copy conflict graph from rhs (this one must be empty) */
+    void copyConflictGraph(const CglClique& rhs);
     /**  */
     void createFractionalGraph();
     /**  */
@@ -236,18 +442,28 @@ private:
     /**  */
     int scl_choose_next_node(const int current_nodenum,
 			     const int *current_indices,
-			     const int *current_degrees,
-			     const double *current_values);
+			     const int *current_degrees);
     /**  */
     void scl_delete_node(const int del_ind, int& current_nodenum,
 			 int *current_indices, int *current_degrees,
-			 double *current_values);
+			 CoinUInt64 *current);
+    /** Set up cl_adjacent and clear cl_label for enumeration */
+    void prepareEnumeration(cl_search& search) const;
     /**  */
-    int enumerate_maximal_cliques(int& pos, bool* scl_label, OsiCuts& cs);
+    int enumerate_maximal_cliques(cl_search& search, int& pos) const;
     /**  */
-    int greedy_maximal_clique(OsiCuts& cs);
+    int greedy_maximal_clique(cl_search& search) const;
     /**  */
-    void recordClique(const int len, int* indices, OsiCuts& cs);
+    void recordClique(const int len, int* indices, OsiCuts& cs) const;
+    /** Search one block of rows for row cliques (task for CglRunTasks) */
+    static void rcl_task(void* info, int iTask, int iThread);
+    /** Search one block of stars for star cliques (task for CglRunTasks) */
+    static void scl_task(void* info, int iTask, int iThread);
+    /** Extend one block of set packing rows (task for CglRunTasks) */
+    static void merge_task(void* info, int iTask, int iThread);
+    /** Find which of one block of merged rows are dominated (task for
+	CglRunTasks) */
+    static void dominated_task(void* info, int iTask, int iThread);
 };
 //#############################################################################
 /** A function that tests the methods in the CglClique class. The
@@ -258,7 +474,6 @@ private:
 void CglCliqueUnitTest(const OsiSolverInterface * siP,
 		       const std::string mpdDir);
 /// This works on a fake solver i.e. invented rows
-class CglProbing;
 class CglFakeClique : public CglClique {
   
 public:
@@ -6,6 +6,7 @@
 #include <numeric>
 #include <cassert>
 
+#include "CoinHelperFunctions.hpp"
 #include "CoinPackedMatrix.hpp"
 #include "OsiSolverInterface.hpp"
 #include "CglClique.hpp"
@@ -182,14 +183,12 @@ CglClique::createSetPackingSubMatrix(const OsiSolverInterface& si)
    assert(nzcnt == sp_row_start[sp_numrows]);
 /*
   Now create the vectors with row indices for each column (sp_col_ind) and
-  column indices for each row (sp_row_ind). It turns out that
-  CoinIsOrthogonal assumes that the row indices for a given column are listed
-  in ascending order. This is *not* a solver-independent assumption! At best,
-  one can hope that the underlying solver will produce an index vector that's
-  either ascending or descending. Under that assumption, compare the first
-  and last entries and proceed accordingly. Eventually some solver will come
-  along that hands back an index vector in random order, and CoinIsOrthogonal
-  will break.  Until then, try and avoid the cost of a sort.
+  column indices for each row (sp_row_ind). The row indices for a given
+  column are wanted in ascending order. This is *not* a solver-independent
+  assumption! At best, one can hope that the underlying solver will produce
+  an index vector that's either ascending or descending. Under that
+  assumption, compare the first and last entries and proceed accordingly;
+  the sort below catches any solver that hands back a random order.
 */
    sp_col_ind = new int[nzcnt];
    sp_row_ind = new int[nzcnt];
@@ -232,21 +231,125 @@ CglClique::createSetPackingSubMatrix(const OsiSolverInterface& si)
 
 /*****************************************************************************/
 
-static inline bool
-CoinIsOrthogonal(const int* first0, const int* last0,
-		 const int* first1, const int* last1)
+/*===========================================================================*
+  Create the set packing submatrix from the global conflict graph. Only the
+  cliques containing the literals of the fractional binaries are looked at.
+  A column with both literals in use also gets a row {x_j, 1-x_j} as they
+  are always in conflict.
+ *===========================================================================*/
+void
+CglClique::createConflictSubMatrix()
 {
-   while (first0 != last0 && first1 != last1) {
-      if (*first0 == *first1)
-	 return false;
-      if (*first0 < *first1)
-	 ++first0;
-      else
-	 ++first1;
+   int i, j, k;
+
+   /* nodes are the literals (in increasing order) of the fractional
+      columns which are in some clique */
+   int* node_col = new int[2*sp_numcols];
+   double* node_sol = new double[2*sp_numcols];
+   int* node_literal = new int[2*sp_numcols];
+   int nodenum = 0;
+   for (j = 0; j < sp_numcols; ++j) {
+      const int iColumn = sp_orig_col_ind[j];
+      const int literal = 2*iColumn;
+      if (literalStart_[literal] < literalStart_[literal+1]) {
+	 node_literal[nodenum] = literal;
+	 node_col[nodenum] = iColumn;
+	 node_sol[nodenum++] = sp_colsol[j];
+      }
+      if (literalStart_[literal+1] < literalStart_[literal+2]) {
+	 node_literal[nodenum] = literal+1;
+	 node_col[nodenum] = -1 - iColumn;
+	 node_sol[nodenum++] = 1.0 - sp_colsol[j];
+      }
+   }
+   delete[] sp_orig_col_ind;
+   delete[] sp_colsol;
+   sp_orig_col_ind = node_col;
+   sp_colsol = node_sol;
+   sp_numcols = nodenum;
+
+   /* count the nodes in each clique touched */
+   int* count = new int[numberConflictCliques_];
+   CoinZeroN(count, numberConflictCliques_);
+   int* touched = new int[numberConflictCliques_];
+   int numberTouched = 0;
+   for (i = 0; i < nodenum; ++i) {
+      const int literal = node_literal[i];
+      for (k = literalStart_[literal]; k < literalStart_[literal+1]; ++k) {
+	 const int iClique = literalClique_[k];
+	 if (!count[iClique]++)
+	    touched[numberTouched++] = iClique;
+      }
+   }
+   std::sort(touched, touched + numberTouched);
+
+   /* rows are cliques with at least two nodes - count becomes row number
+      (or -1) - then pairs of literals of same column */
+   sp_orig_row_ind = new int[numberTouched + nodenum];
+   sp_row_start = new int[numberTouched + nodenum + 1];
+   sp_numrows = 0;
+   int nzcnt = 0;
+   for (k = 0; k < numberTouched; ++k) {
+      const int iClique = touched[k];
+      if (count[iClique] >= 2) {
+	 sp_row_start[sp_numrows] = nzcnt;
+	 nzcnt += count[iClique];
+	 sp_orig_row_ind[sp_numrows] = iClique;
+	 count[iClique] = sp_numrows++;
+      } else {
+	 count[iClique] = -1;
+      }
+   }
+   const int numberCliqueRows = sp_numrows;
+   for (i = 1; i < nodenum; ++i) {
+      if (node_literal[i] == node_literal[i-1]+1 && (node_literal[i]&1)) {
+	 sp_row_start[sp_numrows] = nzcnt;
+	 nzcnt += 2;
+	 sp_orig_row_ind[sp_numrows++] = -1;
+      }
+   }
+   sp_row_start[sp_numrows] = nzcnt;
+
+   /* fill rows - going through nodes in order keeps each row sorted */
+   sp_row_ind = new int[nzcnt];
+   int* put = CoinCopyOfArray(sp_row_start, sp_numrows);
+   int pairRow = numberCliqueRows;
+   for (i = 0; i < nodenum; ++i) {
+      const int literal = node_literal[i];
+      for (k = literalStart_[literal]; k < literalStart_[literal+1]; ++k) {
+	 const int row = count[literalClique_[k]];
+	 if (row >= 0)
+	    sp_row_ind[put[row]++] = i;
+      }
+      if (i && literal == node_literal[i-1]+1 && (literal&1)) {
+	 sp_row_ind[put[pairRow]++] = i-1;
+	 sp_row_ind[put[pairRow++]++] = i;
+      }
    }
-   return true;
+   delete[] put;
+
+   /* and columns - going through rows in order keeps each column sorted */
+   sp_col_start = new int[nodenum+1];
+   CoinZeroN(sp_col_start, nodenum+1);
+   for (k = 0; k < nzcnt; ++k)
+      sp_col_start[sp_row_ind[k]+1]++;
+   for (i = 0; i < nodenum; ++i)
+      sp_col_start[i+1] += sp_col_start[i];
+   sp_col_ind = new int[nzcnt];
+   put = CoinCopyOfArray(sp_col_start, nodenum);
+   for (j = 0; j < sp_numrows; ++j) {
+      for (k = sp_row_start[j]; k < sp_row_start[j+1]; ++k)
+	 sp_col_ind[put[sp_row_ind[k]]++] = j;
+   }
+   delete[] put;
+
+   delete[] count;
+   delete[] touched;
+   delete[] node_literal;
 }
 
+/*****************************************************************************/
+
 /*===========================================================================*
   Build up the fractional graph
  *===========================================================================*/
@@ -276,18 +379,40 @@ CglClique::createFractionalGraph()
       non-orthogonal.
     *========================================================================*/
 
+   // without node_node mark which nodes are already neighbours
+   int *mark = node_node ? NULL : new int[sp_numcols];
+   if (mark)
+      CoinFillN(mark, sp_numcols, -1);
    for ( i = 0, total_deg = 0; i < sp_numcols; i++ ) {
       old_total = total_deg;
-      const bool* node_node_i = node_node + i * sp_numcols;
-      for ( j = 0; j < sp_numcols; j++ ) {
-	 if ( node_node_i[j] ) {
-	    all_nbr[total_deg++] = j;
+      if (node_node) {
+	 const CoinUInt64* node_node_i = node_node + i * node_node_words;
+	 for ( j = 0; j < node_node_words; j++ ) {
+	    for (CoinUInt64 word = node_node_i[j]; word; word &= word-1) {
+	       all_nbr[total_deg++] = (j << 6) + firstBit(word);
+	    }
+	 }
+      } else {
+	 // neighbours are the other columns in the rows of column i
+	 mark[i] = i;
+	 for (int k = sp_col_start[i]; k < sp_col_start[i+1]; k++) {
+	    const int row = sp_col_ind[k];
+	    for (j = sp_row_start[row]; j < sp_row_start[row+1]; j++) {
+	       const int other = sp_row_ind[j];
+	       if (mark[other] != i) {
+		  mark[other] = i;
+		  all_nbr[total_deg++] = other;
+	       }
+	    }
 	 }
+	 // kept in increasing order (as with node_node)
+	 std::sort(all_nbr + old_total, all_nbr + total_deg);
       }
       nodes[i].val = sp_colsol[i];
       nodes[i].degree = total_deg - old_total;
       nodes[i].nbrs = all_nbr + old_total;
    }
+   delete[] mark;
 
    fgraph.density = static_cast<double> (total_deg) / (sp_numcols * (sp_numcols-1));
 
@@ -316,28 +441,60 @@ CglClique::createFractionalGraph()
 
 /*===========================================================================*
  * Construct the node-node incidence matrix from the fractional graph.
+ * Two columns are non-orthogonal iff they share a row, so the edges are
+ * generated from pairs within the rows rather than from all pairs of
+ * columns. The matrix is packed into bits.
+ * If there are more than maxNodeNodeColumns_ columns the matrix would be
+ * too big so it is not created - the edges are just counted (and
+ * createFractionalGraph makes adjacency lists from the rows).
  *===========================================================================*/
 int
 CglClique::createNodeNode()
 {
-   node_node = new bool[sp_numcols * sp_numcols];
-   std::fill(node_node, node_node + sp_numcols * sp_numcols, false);
-
-   int i, j;
-   int edgenum = 0;
-   for (i = 0; i < sp_numcols; ++i) {
-      for (j = i+1; j < sp_numcols; ++j) {
-	 if (! CoinIsOrthogonal(sp_col_ind + sp_col_start[i],
-				sp_col_ind + sp_col_start[i+1],
-				sp_col_ind + sp_col_start[j],
-				sp_col_ind + sp_col_start[j+1]) ) {
-	    node_node[i * sp_numcols + j] = true;
-	    node_node[j * sp_numcols + i] = true;
-	    ++edgenum;
+   node_node_words = (sp_numcols + 63) >> 6;
+   int i, j, k;
+   if (sp_numcols > maxNodeNodeColumns_) {
+      node_node = 0;
+      int *mark = new int[sp_numcols];
+      CoinFillN(mark, sp_numcols, -1);
+      int edgenum = 0;
+      for (i = 0; i < sp_numcols; ++i) {
+	 mark[i] = i;
+	 for (k = sp_col_start[i]; k < sp_col_start[i+1]; ++k) {
+	    const int row = sp_col_ind[k];
+	    for (j = sp_row_start[row]; j < sp_row_start[row+1]; ++j) {
+	       if (mark[sp_row_ind[j]] != i) {
+		  mark[sp_row_ind[j]] = i;
+		  edgenum++;
+	       }
+	    }
 	 }
       }
+      delete[] mark;
+      return edgenum / 2;
    }
-   return edgenum;
+   const int size = sp_numcols * node_node_words;
+   node_node = new CoinUInt64[size];
+   std::fill(node_node, node_node + size, static_cast<CoinUInt64>(0));
+
+   const CoinUInt64 one = 1;
+   for (k = 0; k < sp_numrows; ++k) {
+      const int* row = sp_row_ind + sp_row_start[k];
+      const int len = sp_row_start[k+1] - sp_row_start[k];
+      for (i = 0; i < len; ++i) {
+	 CoinUInt64* node_node_i = node_node + row[i] * node_node_words;
+	 for (j = 0; j < len; ++j)
+	    node_node_i[row[j] >> 6] |= one << (row[j] & 63);
+      }
+   }
+   // no node is adjacent to itself
+   for (i = 0; i < sp_numcols; ++i)
+      node_node[i * node_node_words + (i >> 6)] &= ~(one << (i & 63));
+
+   int edgenum = 0;
+   for (i = 0; i < size; ++i)
+      edgenum += bitCount(node_node[i]);
+   return edgenum / 2;
 }
 
 /*****************************************************************************/
@@ -12,6 +12,7 @@
 #include <cassert>
 #include "CoinPragma.hpp"
 #include "CglClique.hpp"
+#include "../CglPreProcess/CglPreProcess.hpp"
 
 
 void
@@ -29,14 +30,153 @@ CglCliqueUnitTest(const OsiSolverInterface *baseSiP,
     {
       CglClique bGenerator;
       CglClique cGenerator(bGenerator);
-      //rhs=bGenerator;
+      rhs=bGenerator;
     }
   }
 
   // Test get/set methods
   {
     CglClique getset;
-    // None to test
+    assert (!getset.getUseConflictGraph());
+    getset.setUseConflictGraph(true);
+    assert (getset.getUseConflictGraph());
+    assert (!getset.numberConflictCliques());
+    assert (getset.numberThreads() == 1);
+    getset.setNumberThreads(4);
+    assert (getset.numberThreads() == 4);
+    getset.setMaxNodeNodeColumns(100);
+    assert (getset.getMaxNodeNodeColumns() == 100);
+    assert (!getset.getMergeCliques());
+    getset.setMergeCliques(true);
+    assert (getset.getMergeCliques());
+    getset.setMaxMergedLength(10);
+    assert (getset.getMaxMergedLength() == 10);
+  }
+
+  // Test merging set packing rows
+  {
+    // x0+x1<=1, x1+x2<=1, x0+x2<=1 and x2+x3<=1
+    const int numberColumns = 4;
+    const int numberRows = 4;
+    CoinBigIndex start[] = {0, 2, 4, 7, 8};
+    int row[] = {0, 2, 0, 1, 1, 2, 3, 3};
+    double element[] = {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+    double columnLower[] = {0.0, 0.0, 0.0, 0.0};
+    double columnUpper[] = {1.0, 1.0, 1.0, 1.0};
+    double rowLower[] = {-COIN_DBL_MAX, -COIN_DBL_MAX, -COIN_DBL_MAX,
+			 -COIN_DBL_MAX};
+    double rowUpper[] = {1.0, 1.0, 1.0, 1.0};
+    OsiSolverInterface  *siP = baseSiP->clone();
+    siP->loadProblem(numberColumns, numberRows, start, row, element,
+		     columnLower, columnUpper, NULL, rowLower, rowUpper);
+    for (int i = 0; i < numberColumns; i++)
+      siP->setInteger(i);
+    OsiRowCut * whichCut[numberRows];
+    for (int i = 0; i < numberRows; i++)
+      whichCut[i] = NULL;
+    CglClique merge;
+    merge.mergeCliqueRows(*siP, whichCut);
+    // first row becomes triangle and next two are not needed
+    assert (merge.numberMergedRows() == 1);
+    assert (merge.numberDominatedRows() == 2);
+    assert (whichCut[0] && whichCut[0]->row().getNumElements() == 3);
+    assert (whichCut[0]->ub() == 1.0);
+    assert (whichCut[1] && !whichCut[1]->row().getNumElements());
+    assert (whichCut[2] && !whichCut[2]->row().getNumElements());
+    assert (!whichCut[3]);
+    for (int i = 0; i < numberRows; i++)
+      delete whichCut[i];
+    delete siP;
+  }
+
+  // Test merged rows replace originals in CglPreProcess (which also gets
+  // clique cuts as solution is fractional)
+  {
+    // two triangles x0,x1,x2 and x3,x4,x5 as pairs
+    const int numberColumns = 6;
+    const int numberRows = 6;
+    CoinBigIndex start[] = {0, 2, 4, 6, 8, 10, 12};
+    int row[] = {0, 2, 0, 1, 1, 2, 3, 5, 3, 4, 4, 5};
+    double element[] = {1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
+			1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+    double columnLower[] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    double columnUpper[] = {1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+    double objective[] = {-1.0, -1.1, -1.2, -1.0, -1.1, -1.2};
+    double rowLower[numberRows];
+    double rowUpper[numberRows];
+    for (int i = 0; i < numberRows; i++) {
+      rowLower[i] = -COIN_DBL_MAX;
+      rowUpper[i] = 1.0;
+    }
+    OsiSolverInterface  *siP = baseSiP->clone();
+    siP->loadProblem(numberColumns, numberRows, start, row, element,
+		     columnLower, columnUpper, objective, rowLower, rowUpper);
+    for (int i = 0; i < numberColumns; i++)
+      siP->setInteger(i);
+    siP->initialSolve();
+    CglPreProcess process;
+    CglClique merge;
+    merge.setStarCliqueReport(false);
+    merge.setRowCliqueReport(false);
+    merge.setMergeCliques(true);
+    process.addCutGenerator(&merge);
+    OsiSolverInterface * processed =
+      process.preProcessNonDefault(*siP, 0, 5);
+    assert (processed);
+    // no pair is left - just triangles
+    const CoinPackedMatrix * rowCopy = processed->getMatrixByRow();
+    int numberTriangles = 0;
+    for (int i = 0; i < processed->getNumRows(); i++) {
+      assert (rowCopy->getVectorSize(i) != 2);
+      if (rowCopy->getVectorSize(i) == 3)
+	numberTriangles++;
+    }
+    assert (numberTriangles == 2);
+    delete siP;
+  }
+
+  // Test conflict graph is not used after problem changes
+  {
+    // x0+x1<=1, x1+x2<=1 and x0+x2<=1
+    const int numberColumns = 3;
+    const int numberRows = 3;
+    CoinBigIndex start[] = {0, 2, 4, 6};
+    int row[] = {0, 2, 0, 1, 1, 2};
+    double element[] = {1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+    double columnLower[] = {0.0, 0.0, 0.0};
+    double columnUpper[] = {1.0, 1.0, 1.0};
+    double rowLower[] = {-COIN_DBL_MAX, -COIN_DBL_MAX, -COIN_DBL_MAX};
+    double rowUpper[] = {1.0, 1.0, 1.0};
+    double solution[] = {0.5, 0.5, 0.5};
+    OsiSolverInterface  *siP = baseSiP->clone();
+    siP->loadProblem(numberColumns, numberRows, start, row, element,
+		     columnLower, columnUpper, NULL, rowLower, rowUpper);
+    for (int i = 0; i < numberColumns; i++)
+      siP->setInteger(i);
+    siP->setColSolution(solution);
+    CglClique gct;
+    gct.setUseConflictGraph(true);
+    gct.setStarCliqueReport(false);
+    gct.setRowCliqueReport(false);
+    OsiCuts cs;
+    gct.generateCuts(*siP, cs);
+    assert (gct.numberConflictCliques() == 3);
+    // x0+x1+x2<=1
+    assert (cs.sizeRowCuts() == 1);
+    // refreshSolver keeps conflict graph if problem is unchanged
+    gct.refreshSolver(siP);
+    assert (gct.numberConflictCliques() == 3);
+    // same number of columns but x0 and x2 can now both be one -
+    // refreshSolver drops conflict graph
+    siP->setRowUpper(2, 2.0);
+    gct.refreshSolver(siP);
+    assert (!gct.numberConflictCliques());
+    siP->setColSolution(solution);
+    OsiCuts cs2;
+    gct.generateCuts(*siP, cs2);
+    assert (gct.numberConflictCliques() == 2);
+    assert (!cs2.sizeRowCuts());
+    delete siP;
   }
 
   // Test generateCuts
@@ -61,6 +201,60 @@ CglCliqueUnitTest(const OsiSolverInterface *baseSiP,
       int nRowCuts = cs.sizeRowCuts();
       std::cout<<"There are "<<nRowCuts<<" Clique cuts"<<std::endl;
       assert(cs.sizeRowCuts() > 0);
+      // same cuts whatever number of threads
+      CglClique threaded(gct);
+      threaded.setNumberThreads(4);
+      OsiCuts cs2;
+      threaded.generateCuts(*siP, cs2);
+      assert(cs2.sizeRowCuts() == nRowCuts);
+      // and with adjacency lists instead of bit matrix
+      CglClique sparse(gct);
+      sparse.setMaxNodeNodeColumns(0);
+      OsiCuts cs3;
+      sparse.generateCuts(*siP, cs3);
+      assert(cs3.sizeRowCuts() == nRowCuts);
+      for (int i = 0; i < nRowCuts; i++)
+	assert(cs3.rowCut(i) == cs.rowCut(i));
+      OsiSolverInterface::ApplyCutsReturnCode rc = siP->applyCuts(cs);
+      
+      siP->resolve();
+      
+      double lpRelaxAfter= siP->getObjValue(); 
+      std::cout<<"Initial LP value: "<<lpRelax<<std::endl;
+      std::cout<<"LP value with cuts: "<<lpRelaxAfter<<std::endl;
+      assert( lpRelax < lpRelaxAfter );
+      assert(lpRelaxAfter < 4722.1);
+    }
+    delete siP;
+  }
+
+  // Test generateCuts with conflict graph
+  {
+    CglClique gct;
+    gct.setUseConflictGraph(true);
+    OsiSolverInterface  *siP = baseSiP->clone();
+    std::string fn = mpsDir+"l152lav";
+    std::string fn2 = mpsDir+"l152lav.mps";
+    FILE *in_f = fopen(fn2.c_str(), "r");
+    if(in_f == NULL) {
+      std::cout<<"Can not open file "<<fn2<<std::endl<<"Skip test of CglClique::generateCuts() with conflict graph"<<std::endl;
+    }
+    else {
+      fclose(in_f);
+      siP->readMps(fn.c_str(),"mps");
+ 
+      siP->initialSolve();
+      double lpRelax = siP->getObjValue();
+      
+      OsiCuts cs;
+      gct.generateCuts(*siP, cs);
+      assert(gct.numberConflictCliques() > 0);
+      // copy has same graph
+      CglClique copy(gct);
+      assert(copy.numberConflictCliques() == gct.numberConflictCliques());
+      int nRowCuts = cs.sizeRowCuts();
+      std::cout<<"There are "<<nRowCuts<<" Clique cuts using conflict graph"<<std::endl;
+      assert(cs.sizeRowCuts() > 0);
       OsiSolverInterface::ApplyCutsReturnCode rc = siP->applyCuts(cs);
       
       siP->resolve();
@@ -8,7 +8,9 @@
 #include <cmath>
 #include <cfloat>
 #include <cassert>
+#include <cstring>
 #include <iostream>
+#include <algorithm>
 //#define PRINT_DEBUG
 //#define CGL_DEBUG
 #include "CoinPragma.hpp"
@@ -18,6 +20,30 @@
 #include "OsiRowCutDebugger.hpp"
 #include "CglDuplicateRow.hpp"
 #include "CglStored.hpp"
+#include "CglThreads.hpp"
+/* Rows after iRow which have at least one of the nn columns
+   in which in them - returned sorted */
+static int laterRows(int iRow, int nn, const int * which,
+		     const int * row, const CoinBigIndex * columnStart,
+		     const int * columnLength, char * mark, int * candidate)
+{
+  int n=0;
+  for (int j=0;j<nn;j++) {
+    int iColumn = which[j];
+    for (CoinBigIndex jj=columnStart[iColumn];
+	 jj<columnStart[iColumn]+columnLength[iColumn];jj++) {
+      int kRow = row[jj];
+      if (kRow>iRow&&!mark[kRow]) {
+	mark[kRow]=1;
+	candidate[n++]=kRow;
+      }
+    }
+  }
+  for (int j=0;j<n;j++)
+    mark[candidate[j]]=0;
+  std::sort(candidate,candidate+n);
+  return n;
+}
 //-------------------------------------------------------------------
 // Generate duplicate row column cuts
 //------------------------------------------------------------------- 
@@ -515,6 +541,31 @@ void CglDuplicateRow::generateCuts12(const OsiSolverInterface & si, OsiCuts & cs
       effectiveRhs[i]=-1000;
     }
   }
+  /* Identical set partitioning rows can be found quickly
+     by hashing - later ones are marked as duplicates of first */
+  char * rowMark = new char[numberRows];
+  int * candidate = new int[numberRows];
+  int nPartitioning=0;
+  for (i=0;i<numberRows;i++) {
+    if (effectiveRhs[i]==1&&duplicate_[i]==-1&&effectiveLower[i]==rhs_[i]) {
+      rowMark[i]=1;
+      nPartitioning++;
+    } else {
+      rowMark[i]=0;
+    }
+  }
+  if (nPartitioning>1&&
+      findDuplicates(matrixByRow_,candidate,rowMark)) {
+    for (i=0;i<numberRows;i++) {
+      if (candidate[i]>=0) {
+	if (logLevel_)
+	  printf("row %d identical to row %d\n",
+		 i,candidate[i]);
+	duplicate_[i]=candidate[i];
+      }
+    }
+  }
+  memset(rowMark,0,numberRows);
   // Look at <= rows
   for (i=0;i<numberRows;i++) {
     // initially just one
@@ -531,7 +582,17 @@ void CglDuplicateRow::generateCuts12(const OsiSolverInterface & si, OsiCuts & cs
           which2[nn++]=iColumn;
         }
       }
-      for ( k=i+1;k<numberRows;k++) {
+      if (!nn) {
+	// nothing free - redundant if can be at zero
+	if (effectiveLower[i]<=0)
+	  duplicate_[i]=-2;
+	continue;
+      }
+      // only rows sharing a free column can be subsets or supersets
+      int nCandidate = laterRows(i,nn,which2,row,columnStart,columnLength,
+				 rowMark,candidate);
+      for (int iCandidate=0;iCandidate<nCandidate;iCandidate++) {
+	k=candidate[iCandidate];
         if (effectiveRhs[k]==1&&duplicate_[k]==-1) {
           int nn2=0;
           int nnsame=0;
@@ -672,7 +733,10 @@ void CglDuplicateRow::generateCuts12(const OsiSolverInterface & si, OsiCuts & cs
           which2[nn++]=iColumn;
         }
       }
-      for ( k=i+1;k<numberRows;k++) {
+      int nCandidate = laterRows(i,nn,which2,row,columnStart,columnLength,
+				 rowMark,candidate);
+      for (int iCandidate=0;iCandidate<nCandidate;iCandidate++) {
+	k=candidate[iCandidate];
         if (duplicate_[k]==-4) {
           int nn2=0;
           int nnsame=0;
@@ -836,6 +900,8 @@ void CglDuplicateRow::generateCuts12(const OsiSolverInterface & si, OsiCuts & cs
   }
   delete [] check;
   delete [] which2;
+  delete [] rowMark;
+  delete [] candidate;
   delete [] colUpper2;
   int nRow=0;
   sizeDynamic_=1;
@@ -1056,19 +1122,43 @@ void CglDuplicateRow::generateCuts4(const OsiSolverInterface & si, OsiCuts & cs,
     double loC1[4];
     double upC1[4];
     int allowed1[8];
+    // rows which may contain row i
+    int * candidate = new int [nRow2];
     for (int i=nRowStart;i<nRowLook;i++) {
       int start0 = rowStart[i];
       int n=rowStart[i+1]-start0;
       const int * column0 = column+start0;
       const double * element0 = elementByRow+start0;
       int nInt=0;
+      int shortColumn=-1;
+      int shortLength=COIN_INT_MAX;
       for (int j=0;j<n;j++) {
 	int iColumn = column0[j];
 	if ((columnFlag[iColumn]&(2+4))==2)
 	  nInt++;
 	mark[iColumn] =1;
+	int length = columnStart[iColumn+1]-columnStart[iColumn];
+	if (length<shortLength) {
+	  shortLength=length;
+	  shortColumn=iColumn;
+	}
       }
-      for (int k=i+1;k<nRow2;k++) {
+      /* Only rows with all of row i in them can match so
+	 just look at rows in shortest column */
+      int nCandidate=0;
+      if (shortColumn>=0) {
+	for (int jj=columnStart[shortColumn];jj<columnStart[shortColumn+1];jj++) {
+	  int k=row[jj];
+	  if (k>i&&k<nRow2)
+	    candidate[nCandidate++]=k;
+	}
+	std::sort(candidate,candidate+nCandidate);
+      } else {
+	for (int k=i+1;k<nRow2;k++)
+	  candidate[nCandidate++]=k;
+      }
+      for (int iCandidate=0;iCandidate<nCandidate;iCandidate++) {
+	int k=candidate[iCandidate];
 	if (duplicate_[k]==-2)
 	  continue;
 	if (duplicate_[i]==-2)
@@ -2136,6 +2226,7 @@ void CglDuplicateRow::generateCuts4(const OsiSolverInterface & si, OsiCuts & cs,
       for (int j=0;j<n;j++) 
 	mark[column0[j]] =0;
     }
+    delete [] candidate;
   }
   if (0) {
     // Column copy
@@ -3114,7 +3205,8 @@ CglDuplicateRow::CglDuplicateRow ()
   maximumRhs_(1),
   sizeDynamic_(COIN_INT_MAX),
   mode_(3),
-  logLevel_(0)
+  logLevel_(0),
+  numberThreads_(1)
 {
 }
 // Useful constructor
@@ -3128,7 +3220,8 @@ CglDuplicateRow::CglDuplicateRow(OsiSolverInterface * solver)
     maximumRhs_(1),
     sizeDynamic_(COIN_INT_MAX),
     mode_(3),
-    logLevel_(0)
+    logLevel_(0),
+    numberThreads_(1)
 {
   refreshSolver(solver);
 }
@@ -3146,7 +3239,8 @@ CglDuplicateRow::CglDuplicateRow (  const CglDuplicateRow & rhs)
   maximumRhs_(rhs.maximumRhs_),
   sizeDynamic_(rhs.sizeDynamic_),
   mode_(rhs.mode_),
-  logLevel_(rhs.logLevel_)
+  logLevel_(rhs.logLevel_),
+  numberThreads_(rhs.numberThreads_)
 {  
   int numberRows=matrix_.getNumRows();
   rhs_ = CoinCopyOfArray(rhs.rhs_,numberRows);
@@ -3198,6 +3292,7 @@ CglDuplicateRow::operator=(
     sizeDynamic_ = rhs.sizeDynamic_;
     mode_ = rhs.mode_;
     logLevel_ = rhs.logLevel_;
+    numberThreads_ = rhs.numberThreads_;
     int numberRows=matrix_.getNumRows();
     rhs_ = CoinCopyOfArray(rhs.rhs_,numberRows);
     duplicate_ = CoinCopyOfArray(rhs.duplicate_,numberRows);
@@ -3361,6 +3456,197 @@ CglDuplicateRow::outDuplicates( OsiSolverInterface * solver)
   }
   return storedCuts_;
 }
+// Mixes bits for hashing
+static inline unsigned int hashMix(unsigned int value)
+{
+  value ^= value >> 16;
+  value *= 0x7feb352dU;
+  value ^= value >> 15;
+  value *= 0x846ca68bU;
+  value ^= value >> 16;
+  return value;
+}
+// Multiplier to make element with smallest index one
+static double scaleFactor(const int * index, const double * element,
+			  CoinBigIndex start, CoinBigIndex end)
+{
+  int smallest=COIN_INT_MAX;
+  double value=1.0;
+  for (CoinBigIndex j=start;j<end;j++) {
+    if (index[j]<smallest&&element[j]) {
+      smallest=index[j];
+      value=element[j];
+    }
+  }
+  return 1.0/value;
+}
+// Information for comparing vectors within buckets
+typedef struct {
+  const CoinPackedMatrix * matrix;
+  const int * sorted; // vectors in bucket order
+  const int * bucketStart;
+  const int * taskStart; // first bucket for each task
+  double ** work; // dense values (COIN_DBL_MAX if not there) for each thread
+  int * duplicate;
+  bool scale;
+} CglDuplicateInfo;
+// Compares vectors within buckets of one task
+static void compareBuckets(void * voidInfo, int iTask, int iThread)
+{
+  CglDuplicateInfo * info = reinterpret_cast<CglDuplicateInfo *> (voidInfo);
+  const double * element = info->matrix->getElements();
+  const int * index = info->matrix->getIndices();
+  const CoinBigIndex * start = info->matrix->getVectorStarts();
+  const int * length = info->matrix->getVectorLengths();
+  const int * sorted = info->sorted;
+  const int * bucketStart = info->bucketStart;
+  double * work = info->work[iThread];
+  int * duplicate = info->duplicate;
+  bool scale = info->scale;
+  for (int iBucket=info->taskStart[iTask];
+       iBucket<info->taskStart[iTask+1];iBucket++) {
+    int last = bucketStart[iBucket+1];
+    for (int i=bucketStart[iBucket];i<last-1;i++) {
+      int iVector = sorted[i];
+      if (duplicate[iVector]>=0)
+	continue;
+      // first one not matched goes into work
+      CoinBigIndex startI = start[iVector];
+      CoinBigIndex endI = startI+length[iVector];
+      double multiplier = scale ? scaleFactor(index,element,startI,endI) : 1.0;
+      for (CoinBigIndex j=startI;j<endI;j++)
+	work[index[j]]=element[j]*multiplier;
+      for (int k=i+1;k<last;k++) {
+	int kVector = sorted[k];
+	if (duplicate[kVector]>=0)
+	  continue;
+	CoinBigIndex startK = start[kVector];
+	CoinBigIndex endK = startK+length[kVector];
+	bool same=true;
+	if (!scale) {
+	  for (CoinBigIndex j=startK;j<endK;j++) {
+	    if (work[index[j]]!=element[j]) {
+	      same=false;
+	      break;
+	    }
+	  }
+	} else {
+	  double multiplierK = scaleFactor(index,element,startK,endK);
+	  for (CoinBigIndex j=startK;j<endK;j++) {
+	    double value = work[index[j]];
+	    if (value==COIN_DBL_MAX||
+		fabs(value-element[j]*multiplierK)>1.0e-12*(1.0+fabs(value))) {
+	      same=false;
+	      break;
+	    }
+	  }
+	}
+	if (same)
+	  duplicate[kVector]=iVector;
+      }
+      for (CoinBigIndex j=startI;j<endI;j++)
+	work[index[j]]=COIN_DBL_MAX;
+    }
+  }
+}
+/* Finds identical vectors (rows if row copy, columns if column copy).
+   Vectors are put in buckets by length and a hash of indices (and
+   elements if not scaling) and then only compared within buckets */
+int 
+CglDuplicateRow::findDuplicates(const CoinPackedMatrix & matrix,
+				int * duplicate, const char * consider,
+				bool scale) const
+{
+  int numberVectors = matrix.getMajorDim();
+  int numberMinor = matrix.getMinorDim();
+  const double * element = matrix.getElements();
+  const int * index = matrix.getIndices();
+  const CoinBigIndex * start = matrix.getVectorStarts();
+  const int * length = matrix.getVectorLengths();
+  double * key = new double [numberVectors];
+  int * sorted = new int [numberVectors];
+  int n=0;
+  for (int i=0;i<numberVectors;i++) {
+    duplicate[i]=-1;
+    if ((consider&&!consider[i])||!length[i])
+      continue;
+    // sum so order of elements does not matter
+    unsigned int hash=0;
+    for (CoinBigIndex j=start[i];j<start[i]+length[i];j++) {
+      unsigned int value = hashMix(static_cast<unsigned int> (index[j])+1);
+      if (!scale) {
+	unsigned int bits[2];
+	memcpy(bits,element+j,sizeof(double));
+	value = hashMix(value^bits[0])+hashMix(value^bits[1]);
+      }
+      hash += value;
+    }
+    key[n]=static_cast<double> (length[i])*4294967296.0+hash;
+    sorted[n++]=i;
+  }
+  CoinSort_2(key,key+n,sorted);
+  // keep buckets with more than one vector (in order so deterministic)
+  int * bucketStart = new int [n+1];
+  int numberBuckets=0;
+  int nIn=0;
+  for (int i=0;i<n;) {
+    int last=i+1;
+    while (last<n&&key[last]==key[i])
+      last++;
+    if (last>i+1) {
+      std::sort(sorted+i,sorted+last);
+      bucketStart[numberBuckets++]=nIn;
+      for (int k=i;k<last;k++)
+	sorted[nIn++]=sorted[k];
+    }
+    i=last;
+  }
+  bucketStart[numberBuckets]=nIn;
+  delete [] key;
+  int numberFound=0;
+  if (numberBuckets) {
+    int numberThreads = CglNumberThreads(numberThreads_,numberBuckets);
+    // a few tasks per thread of about same size
+    int numberTasks = (numberThreads>1) ? 
+      CoinMin(4*numberThreads,numberBuckets) : 1;
+    int * taskStart = new int [numberTasks+1];
+    taskStart[0]=0;
+    int iBucket=0;
+    for (int iTask=1;iTask<numberTasks;iTask++) {
+      int target = static_cast<int> ((static_cast<double> (nIn)*iTask)/numberTasks);
+      while (iBucket<numberBuckets&&bucketStart[iBucket]<target)
+	iBucket++;
+      taskStart[iTask]=iBucket;
+    }
+    taskStart[numberTasks]=numberBuckets;
+    double ** work = new double * [numberThreads];
+    for (int iThread=0;iThread<numberThreads;iThread++) {
+      work[iThread] = new double [numberMinor];
+      for (int i=0;i<numberMinor;i++)
+	work[iThread][i]=COIN_DBL_MAX;
+    }
+    CglDuplicateInfo info;
+    info.matrix = &matrix;
+    info.sorted = sorted;
+    info.bucketStart = bucketStart;
+    info.taskStart = taskStart;
+    info.work = work;
+    info.duplicate = duplicate;
+    info.scale = scale;
+    CglRunTasks(numberThreads,numberTasks,compareBuckets,&info);
+    for (int iThread=0;iThread<numberThreads;iThread++)
+      delete [] work[iThread];
+    delete [] work;
+    delete [] taskStart;
+    for (int i=0;i<nIn;i++) {
+      if (duplicate[sorted[i]]>=0)
+	numberFound++;
+    }
+  }
+  delete [] bucketStart;
+  delete [] sorted;
+  return numberFound;
+}
 // Create C++ lines to get to current state
 std::string
 CglDuplicateRow::generateCpp( FILE * fp) 
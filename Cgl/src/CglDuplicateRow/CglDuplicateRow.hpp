@@ -71,6 +71,20 @@ public:
   */
   CglStored * outDuplicates( OsiSolverInterface * solver);
 
+  /** Finds identical vectors of matrix - rows if a row copy, columns
+      if a column copy.  Only vectors with consider nonzero are looked
+      at (all if consider NULL).  If scale then vectors which are
+      multiples of each other are treated as identical.
+
+      Vectors are hashed into buckets which can be compared in parallel
+      (see setNumberThreads).  On return duplicate[i] is -1 or the first
+      vector identical to i.  Returns number of duplicates found.
+      Only identical vectors are found - generateCuts uses it for set
+      partitioning rows and finds dominated rows through the column copy.
+  */
+  int findDuplicates(const CoinPackedMatrix & matrix, int * duplicate,
+		     const char * consider=NULL, bool scale=false) const;
+
   //@}
 
   /**@name Get information on size of problem */
@@ -123,6 +137,12 @@ public:
   /// Set mode
   inline void setMode(int value)
   { mode_=value;}
+  /// Get number of threads used for comparing buckets
+  inline int numberThreads() const
+  { return numberThreads_;}
+  /// Set number of threads (only used if compiled with CGL_THREAD)
+  inline void setNumberThreads(int value)
+  { numberThreads_=value;}
   //@}
 
   /**@name Constructors and destructors */
@@ -184,6 +204,18 @@ protected:
   int mode_;
   /// Controls print out
   int logLevel_;
+  /// Number of threads to use
+  int numberThreads_;
   //@}
 };
+
+//#############################################################################
+/** A function that tests the methods in the CglDuplicateRow class. The
+    only reason for it not to be a member method is that this way it doesn't
+    have to be compiled into the library. And that's a gain, because the
+    library should be compiled with optimization on, but this method should be
+    compiled with debugging. */
+void CglDuplicateRowUnitTest(const OsiSolverInterface * siP,
+			     const std::string mpdDir );
+
 #endif
@@ -0,0 +1,124 @@
+// $Id$
+// Copyright (C) 2026, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cstdio>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+
+#include "CoinPragma.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "OsiSolverInterface.hpp"
+#include "OsiCuts.hpp"
+#include "CglDuplicateRow.hpp"
+
+//--------------------------------------------------------------------------
+void
+CglDuplicateRowUnitTest(
+  const OsiSolverInterface * baseSiP,
+  const std::string /*mpsDir*/ )
+{
+  // Test default constructor
+  {
+    CglDuplicateRow aGenerator;
+    assert (aGenerator.numberThreads()==1);
+  }
+
+  // Test copy & assignment
+  {
+    CglDuplicateRow rhs;
+    {
+      CglDuplicateRow bGenerator;
+      bGenerator.setNumberThreads(4);
+      CglDuplicateRow cGenerator(bGenerator);
+      assert (cGenerator.numberThreads()==4);
+      rhs=bGenerator;
+    }
+    assert (rhs.numberThreads()==4);
+  }
+
+  // Test findDuplicates on rows and columns of a small matrix.
+  // Row 2 is row 0 with elements in another order, row 3 is twice
+  // row 0 and row 4 is row 1.  Column 1 is column 0, column 2 is
+  // twice column 0 and column 4 is column 3.
+  {
+    const int nRows=5;
+    const int nCols=5;
+    const int nEls=13;
+    const double elemByRow[]={1,1,2, 1,1, 2,1,1, 2,2,4, 1,1};
+    const int column[]={0,1,2, 3,4, 2,0,1, 0,1,2, 4,3};
+    const CoinBigIndex rowStart[]={0,3,5,8,11};
+    const int rowLength[]={3,2,3,3,2};
+    CoinPackedMatrix rowCopy(false,nCols,nRows,nEls,elemByRow,column,
+			     rowStart,rowLength);
+    const double elemByCol[]={1,1,2, 1,1,2, 2,2,4, 1,1, 1,1};
+    const int row[]={0,2,3, 0,2,3, 0,2,3, 1,4, 1,4};
+    const CoinBigIndex columnStart[]={0,3,6,9,11};
+    const int columnLength[]={3,3,3,2,2};
+    CoinPackedMatrix columnCopy(true,nRows,nCols,nEls,elemByCol,row,
+				columnStart,columnLength);
+    const int rowSame[]={-1,-1,0,-1,1};
+    const int rowScaled[]={-1,-1,0,0,1};
+    const int columnSame[]={-1,0,-1,-1,3};
+    const int columnScaled[]={-1,0,0,-1,3};
+    int duplicate[5];
+    // same answer whatever the number of threads (without CGL_THREAD
+    // buckets are still split into tasks)
+    for (int numberThreads=1;numberThreads<=4;numberThreads*=2) {
+      CglDuplicateRow test;
+      test.setNumberThreads(numberThreads);
+      int i;
+      assert (test.findDuplicates(rowCopy,duplicate)==2);
+      for (i=0;i<nRows;i++)
+	assert (duplicate[i]==rowSame[i]);
+      assert (test.findDuplicates(rowCopy,duplicate,NULL,true)==3);
+      for (i=0;i<nRows;i++)
+	assert (duplicate[i]==rowScaled[i]);
+      // rows not considered are never duplicates
+      const char consider[]={1,1,0,1,1};
+      assert (test.findDuplicates(rowCopy,duplicate,consider)==1);
+      for (i=0;i<nRows;i++)
+	assert (duplicate[i]==((i==4) ? 1 : -1));
+      assert (test.findDuplicates(columnCopy,duplicate)==2);
+      for (i=0;i<nCols;i++)
+	assert (duplicate[i]==columnSame[i]);
+      assert (test.findDuplicates(columnCopy,duplicate,NULL,true)==3);
+      for (i=0;i<nCols;i++)
+	assert (duplicate[i]==columnScaled[i]);
+    }
+  }
+
+  // Test generateCuts finds identical set partitioning rows (rows 0
+  // and 1) and leaves others alone
+  {
+    const int nRows=3;
+    const int nCols=4;
+    const double elem[]={1,1,1, 1,1, 1,1, 1};
+    const int row[]={0,1,2, 0,1, 0,1, 2};
+    const CoinBigIndex start[]={0,3,5,7,8};
+    const double columnLower[]={0,0,0,0};
+    const double columnUpper[]={1,1,1,1};
+    const double rowLower[]={1,1,1};
+    const double rowUpper[]={1,1,1};
+    for (int numberThreads=1;numberThreads<=4;numberThreads*=2) {
+      OsiSolverInterface * siP = baseSiP->clone();
+      siP->loadProblem(nCols,nRows,start,row,elem,columnLower,columnUpper,
+		       NULL,rowLower,rowUpper);
+      for (int iColumn=0;iColumn<nCols;iColumn++)
+	siP->setInteger(iColumn);
+      CglDuplicateRow test(siP);
+      test.setNumberThreads(numberThreads);
+      OsiCuts cs;
+      test.generateCuts(*siP,cs);
+      const int * duplicate = test.duplicate();
+      assert (duplicate[0]==-1);
+      assert (duplicate[1]==0);
+      assert (duplicate[2]==-1);
+      delete siP;
+    }
+  }
+}
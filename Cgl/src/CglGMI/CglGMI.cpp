@@ -15,6 +15,7 @@
 #include <cassert>
 #include <iostream>
 #include <climits>
+#include <algorithm>
 
 #include "CoinPragma.hpp"
 #include "CoinHelperFunctions.hpp"
@@ -25,7 +26,63 @@
 #include "OsiRowCutDebugger.hpp"
 #include "CoinFactorization.hpp"
 #include "CglGMI.hpp"
+#include "CglTableauProvider.hpp"
 #include "CoinFinite.hpp"
+#include "CglThreads.hpp"
+
+/* Information shared by tasks computing cuts for a block of rows of the
+   simplex tableau; workspace is per thread, rows and cuts are per task */
+typedef struct {
+  // generator for each thread
+  CglGMI** generator;
+  // basic integer variable for each row
+  const int* basicVar;
+  // row of basis inverse for task is piStart[iTask] to tableauStart[iTask]
+  // and column part of row of tableau (if packed) is from there to
+  // piStart[iTask+1]
+  const int* piStart;
+  const int* tableauStart;
+  const int* packedIndex;
+  const double* packedElem;
+  // false if task computes column part of row of tableau
+  bool tableauPacked;
+  const int* colBasisIndex;
+  const double* slackVal;
+  // workspace for each thread
+  CoinIndexedVector* pi;
+  CoinIndexedVector* tableauRow;
+  double** cut;
+  int** cutList;
+  double** cutElem;
+  int** cutIndex;
+  // cut (or NULL) for each task
+  OsiRowCut** rowCut;
+} CglGMIInfo;
+
+/* Appends nonzeros of vector to packed storage, which is made larger if
+   necessary */
+static void packVector(const CoinIndexedVector& vector, int*& packedIndex,
+		       double*& packedElem, int& numPacked, int& maxPacked)
+{
+  int n = vector.getNumElements();
+  const int* index = vector.getIndices();
+  const double* elem = vector.denseVector();
+  if (numPacked + n > maxPacked) {
+    maxPacked = 2*maxPacked + n;
+    int* tempIndex = new int[maxPacked];
+    CoinMemcpyN(packedIndex, numPacked, tempIndex);
+    delete[] packedIndex;
+    packedIndex = tempIndex;
+    double* tempElem = new double[maxPacked];
+    CoinMemcpyN(packedElem, numPacked, tempElem);
+    delete[] packedElem;
+    packedElem = tempElem;
+  }
+  for (int k = 0; k < n; ++k) {
+    packedIndex[numPacked] = index[k];
+    packedElem[numPacked++] = elem[index[k]];
+  }
+}
 
 //-------------------------------------------------------------------
 // Generate GMI cuts
@@ -46,6 +103,8 @@ CglGMI::CglGMI() :
   cstat(NULL),
   rstat(NULL),
   solver(NULL),
+  tableauProvider(NULL),
+  numberThreads(1),
   xlp(NULL),
   rowActivity(NULL),
   byRow(NULL),
@@ -82,6 +141,8 @@ CglGMI::CglGMI(const CglGMIParam &parameters) :
   cstat(NULL),
   rstat(NULL),
   solver(NULL),
+  tableauProvider(NULL),
+  numberThreads(1),
   xlp(NULL),
   rowActivity(NULL),
   byRow(NULL),
@@ -118,6 +179,8 @@ CglGMI::CglGMI(const CglGMI& rhs) :
   cstat(rhs.cstat),
   rstat(rhs.rstat),
   solver(rhs.solver),
+  tableauProvider(rhs.tableauProvider),
+  numberThreads(rhs.numberThreads),
   xlp(rhs.xlp),
   rowActivity(rhs.rowActivity),
   byRow(rhs.byRow),
@@ -155,6 +218,8 @@ CglGMI & CglGMI::operator=(const CglGMI& rhs) {
     cstat = rhs.cstat;
     rstat = rhs.rstat;
     solver = rhs.solver;
+    tableauProvider = rhs.tableauProvider;
+    numberThreads = rhs.numberThreads;
     xlp = rhs.xlp;
     rowActivity = rhs.rowActivity;
     byRow = rhs.byRow;
@@ -288,6 +353,7 @@ inline double CglGMI::computeCutCoefficient(double rowElem, int index) {
 
 /************************************************************************/
 inline void CglGMI::eliminateSlack(double cutElem, int index, double* cut,
+				   int* cutList, int& cutListNz,
 				   double& cutRhs, const double *elements, 
 				   const int *rowStart, const int *indices, 
 				   const int *rowLength, const double *rhs) {
@@ -304,7 +370,13 @@ inline void CglGMI::eliminateSlack(double cutElem, int index, double* cut,
 
     int upto = rowStart[rowpos] + rowLength[rowpos];
     for (int j = rowStart[rowpos]; j < upto; ++j) {
-      cut[indices[j]] -= cutElem * elements[j];      
+      int col = indices[j];
+      double value = cut[col] - cutElem * elements[j];
+      if (!cut[col]) {
+	cutList[cutListNz++] = col;
+      }
+      // keep in list even if cancelled
+      cut[col] = value ? value : COIN_DBL_MIN;
     }
     cutRhs -= cutElem * rhs[rowpos];
   }
@@ -348,18 +420,208 @@ inline void CglGMI::unflipSlack(double& rowElem, int index, double& rowRhs,
 } /* unflipSlack */
 
 /************************************************************************/
-inline void CglGMI::packRow(double* row, double* rowElem, int* rowIndex,
-			     int& rowNz) {
+inline void CglGMI::packRow(double* row, int* rowList, int rowListNz,
+			     double* rowElem, int* rowIndex, int& rowNz) {
+  // same order as dense row
+  std::sort(rowList, rowList + rowListNz);
   rowNz = 0;
-  for (int i = 0; i < ncol; ++i) {
+  for (int k = 0; k < rowListNz; ++k) {
+    int i = rowList[k];
     if (!isZero(fabs(row[i]))) {
       rowElem[rowNz] = row[i];
       rowIndex[rowNz] = i;
       rowNz++;
     }
+    row[i] = 0.0;
+  }
+}
+
+/************************************************************************/
+int CglGMI::computeTableauRow(const CoinIndexedVector& pi,
+			      CoinIndexedVector& tableauRow,
+			      const double *elements, const int *rowStart,
+			      const int *indices, const int *rowLength) {
+  // only rows with nonzero in row of B^-1 contribute
+  const int *piIndex = pi.getIndices();
+  const double *piElem = pi.denseVector();
+  int piNz = pi.getNumElements();
+  tableauRow.clear();
+  int *rowIndex = tableauRow.getIndices();
+  double *rowElem = tableauRow.denseVector();
+  int rowNz = 0;
+  for (int i = 0; i < piNz; ++i) {
+    int iRow = piIndex[i];
+    double value = piElem[iRow];
+    int upto = rowStart[iRow] + rowLength[iRow];
+    for (int j = rowStart[iRow]; j < upto; ++j) {
+      int col = indices[j];
+      double value2 = rowElem[col] + value * elements[j];
+      if (!rowElem[col]) {
+	rowIndex[rowNz++] = col;
+      }
+      // keep in list even if cancelled
+      rowElem[col] = value2 ? value2 : COIN_DBL_MIN;
+    }
   }
+  tableauRow.setNumElements(rowNz);
+  tableauRow.setPackedMode(false);
+  return rowNz;
 }
 
+/************************************************************************/
+void CglGMI::cutTask(void* voidInfo, int iTask, int iThread) {
+  CglGMIInfo* info = reinterpret_cast<CglGMIInfo*> (voidInfo);
+  CglGMI* gmi = info->generator[iThread];
+  const int* packedIndex = info->packedIndex;
+  const double* packedElem = info->packedElem;
+  // unpack row of basis inverse
+  CoinIndexedVector& pi = info->pi[iThread];
+  int* piIndex = pi.getIndices();
+  double* piElem = pi.denseVector();
+  int start = info->piStart[iTask];
+  int end = info->tableauStart[iTask];
+  for (int k = start; k < end; ++k) {
+    int i = packedIndex[k];
+    piIndex[k-start] = i;
+    piElem[i] = packedElem[k];
+  }
+  pi.setNumElements(end - start);
+  // column part of row of tableau
+  CoinIndexedVector& tableauRow = info->tableauRow[iThread];
+  if (info->tableauPacked) {
+    int* rowIndex = tableauRow.getIndices();
+    double* rowElem = tableauRow.denseVector();
+    start = end;
+    end = info->piStart[iTask+1];
+    for (int k = start; k < end; ++k) {
+      int j = packedIndex[k];
+      rowIndex[k-start] = j;
+      rowElem[j] = packedElem[k];
+    }
+    tableauRow.setNumElements(end - start);
+  }
+  else {
+    const CoinPackedMatrix* byRow = gmi->byRow;
+    gmi->computeTableauRow(pi, tableauRow, byRow->getElements(),
+			   byRow->getVectorStarts(), byRow->getIndices(),
+			   byRow->getVectorLengths());
+  }
+  info->rowCut[iTask] =
+    gmi->cutFromTableauRow(info->basicVar[iTask], pi, tableauRow,
+			   info->colBasisIndex, info->slackVal,
+			   info->cut[iThread], info->cutList[iThread],
+			   info->cutElem[iThread], info->cutIndex[iThread]);
+  pi.clear();
+  tableauRow.clear();
+} /* cutTask */
+
+/************************************************************************/
+OsiRowCut* CglGMI::cutFromTableauRow(int basicVar,
+				     const CoinIndexedVector& pi,
+				     const CoinIndexedVector& tableauRow,
+				     const int* colBasisIndex,
+				     const double* slackVal,
+				     double* cut, int* cutList,
+				     double* cutElem, int* cutIndex) {
+  // fractionality has been checked by caller; this sets f0 etc.
+  double cutRhs;
+  computeCutFractionality(xlp[basicVar], cutRhs);
+
+  // Matrix elements by row for slack substitution
+  const double *elements = byRow->getElements();
+  const int *rowStart = byRow->getVectorStarts();
+  const int *indices = byRow->getIndices();
+  const int *rowLength = byRow->getVectorLengths(); 
+
+  const int * arrayRows = pi.getIndices();
+  const double * arrayElements = pi.denseVector();
+  int numberInArray = pi.getNumElements();
+  const int * tableauIndex = tableauRow.getIndices();
+  const double * tableauElements = tableauRow.denseVector();
+  int numberInRow = tableauRow.getNumElements();
+
+  // Indices of slack variables, and cut elements
+  int slackIndex;
+  double cutCoeff;
+  double rowElem;
+
+  // cut is empty
+  int cutListNz = 0;
+  int cutNz = 0;
+
+  // columns: only look at nonzeros in row of tableau
+  for (int k = 0; k < numberInRow; ++k) {
+    int j = tableauIndex[k];
+    if ((colBasisIndex[j] >= 0) || 
+	(areEqual(colLower[j], colUpper[j], 
+		  param.getEPS(), param.getEPS()))) {
+      // Basic or fixed variable -- skip
+      continue;
+    }
+    rowElem = tableauElements[j];
+    if (!isZero(fabs(rowElem))) {
+      // compute cut coefficient
+      flip(rowElem, j);
+      cutCoeff = computeCutCoefficient(rowElem, j);
+      if (isZero(cutCoeff)) {
+	continue;
+      }
+      unflipOrig(cutCoeff, j, cutRhs);
+      // same marker as eliminateSlack so j is never listed twice
+      cut[j] = cutCoeff ? cutCoeff : COIN_DBL_MIN;
+      cutList[cutListNz++] = j;
+#if defined GMI_TRACE
+      printf("var %d, row %f, cut %f\n", j, rowElem, cutCoeff);
+#endif
+    }
+  }
+
+  // now do slacks part
+  for (int j = 0 ; j < numberInArray ; ++j) {
+    // index of the row corresponding to the slack variable
+    slackIndex = arrayRows[j];
+    rowElem = arrayElements[slackIndex];
+    if (!isZero(fabs(rowElem))) {
+      slackIndex += ncol;
+      // compute cut coefficient
+      flip(rowElem, slackIndex);
+      cutCoeff = computeCutCoefficient(rowElem, slackIndex);
+      if (isZero(fabs(cutCoeff))) {
+	continue;
+      }
+      unflipSlack(cutCoeff, slackIndex, cutRhs, slackVal);
+      eliminateSlack(cutCoeff, slackIndex, cut, cutList, cutListNz, cutRhs,
+		     elements, rowStart, indices, rowLength, rowRhs);
+#if defined GMI_TRACE
+      printf("var %d, row %f, cut %f\n", slackIndex, rowElem, cutCoeff);
+#endif
+    }
+  }
+
+  packRow(cut, cutList, cutListNz, cutElem, cutIndex, cutNz);
+  if (cutNz == 0)
+    return NULL;
+
+#if defined GMI_TRACE
+  printvecDBL("final cut:", cutElem, cutIndex, cutNz);
+  printf("cutRhs: %f\n", cutRhs);
+#endif
+    
+#if defined TRACK_REJECT || defined TRACK_REJECT_SIMPLE
+  if (trackRejection) {
+    numGeneratedCuts++;
+  }
+#endif
+  if (cleanCut(cutElem, cutIndex, cutNz, cutRhs, xlp) && cutNz > 0) {
+    OsiRowCut* rc = new OsiRowCut();
+    rc->setRow(cutNz, cutIndex, cutElem);
+    rc->setLb(-param.getINFINIT());
+    rc->setUb(cutRhs);
+    return rc;
+  }
+  return NULL;
+} /* cutFromTableauRow */
+
 /************************************************************************/
 bool CglGMI::cleanCut(double* cutElem, int* cutIndex, int& cutNz,
 		       double& cutRhs, const double* xbar) {
@@ -1213,21 +1475,54 @@ void CglGMI::generateCuts(OsiCuts &cs)
   }
 #else
   CoinFactorization factorization;
-  if (factorize(factorization, colBasisIndex, rowBasisIndex)) {
+  if (tableauProvider) {
+    // shared factorization - may already be done by another generator
+    if (tableauProvider->factorize(*byCol, cstat, rstat)) {
+      printf("### WARNING: CglGMI::generateCuts(): error during factorization!\n");
+      return;
+    }
+    memcpy(colBasisIndex, tableauProvider->columnIsBasic(), ncol*sizeof(int));
+    memcpy(rowBasisIndex, tableauProvider->rowIsBasic(), nrow*sizeof(int));
+  }
+  else if (factorize(factorization, colBasisIndex, rowBasisIndex)) {
     printf("### WARNING: CglGMI::generateCuts(): error during factorization!\n");
     return;
   }
 #endif
 
 
-  // cut in sparse form
-  double* cutElem = new double[ncol];
-  int* cutIndex = new int[ncol];
-  int cutNz = 0;
-  double cutRhs;
-
-  // cut in dense form
-  double* cut = new double[ncol];
+  // Rows of the simplex tableau are obtained here, as the factorization is
+  // not thread safe, a block of rows at a time. The cuts for the rows of a
+  // block may then be computed in parallel; they are added in order, so the
+  // cuts do not depend on the number of threads.
+  int numThreads = CglNumberThreads(numberThreads, numFracBasic);
+  int blockSize = (numThreads > 1) ? 8*numThreads : 1;
+
+  // one generator for each thread (as f0 etc. depend on row)
+  CglGMI** generator = new CglGMI*[numThreads];
+  generator[0] = this;
+  // workspace for each thread: row of basis inverse, row of tableau,
+  // cut in dense form (only entries in cutList are nonzero) and cut in
+  // sparse form
+  CoinIndexedVector* threadPi = new CoinIndexedVector[numThreads];
+  CoinIndexedVector* threadTableauRow = new CoinIndexedVector[numThreads];
+  double** cut = new double*[numThreads];
+  int** cutList = new int*[numThreads];
+  double** cutElem = new double*[numThreads];
+  int** cutIndex = new int*[numThreads];
+  for (int i = 0; i < numThreads; ++i) {
+    if (i) {
+      generator[i] = new CglGMI(*this);
+      generator[i]->resetRejectionCounters();
+    }
+    threadPi[i].reserve(nrow);
+    threadTableauRow[i].reserve(ncol);
+    cut[i] = new double[ncol];
+    CoinZeroN(cut[i], ncol);
+    cutList[i] = new int[ncol];
+    cutElem[i] = new double[ncol];
+    cutIndex[i] = new int[ncol];
+  }
 
   double *slackVal = new double[nrow];
 
@@ -1235,171 +1530,194 @@ void CglGMI::generateCuts(OsiCuts &cs)
     slackVal[i] = rowRhs[i] - rowActivity[i];
   }
 
+  // Row of basis inverse and column part of row of tableau
+  CoinIndexedVector array;
+  CoinIndexedVector tableauRow;
+  array.reserve(nrow);
+  tableauRow.reserve(ncol);
 #if defined OSI_TABLEAU
   // Column part and row part of a row of the simplex tableau
   double* tableauColPart = new double[ncol];
   double* tableauRowPart = new double[nrow];
+  int * arrayRows = array.getIndices();
+  double * arrayElements = array.denseVector();
+  int * tableauIndex = tableauRow.getIndices();
+  double * tableauElements = tableauRow.denseVector();
+  // column part is always obtained with row of basis inverse
+  bool packTableauRow = true;
 #else
-  // Need some more data for simplex tableau computation
-  const int * row = byCol->getIndices();
-  const CoinBigIndex * columnStart = byCol->getVectorStarts();
-  const int * columnLength = byCol->getVectorLengths(); 
-  const double * columnElements = byCol->getElements();
-
   // Create work arrays for factorization
-  // two vectors for updating: the first one is needed to do the computations
-  // but we do not use it, the second one contains a row of the basis inverse
+  // the first vector is needed to do the computations but we do not use it
   CoinIndexedVector work;
-  CoinIndexedVector array;
-  // Make sure they large enough
   work.reserve(nrow);
-  array.reserve(nrow);
-  int * arrayRows = array.getIndices();
-  double * arrayElements = array.denseVector();
-  // End of code to create work arrays
   double one = 1.0;
-#endif
-
-  // Matrix elements by row for slack substitution
-  const double *elements = byRow->getElements();
-  const int *rowStart = byRow->getVectorStarts();
-  const int *indices = byRow->getIndices();
-  const int *rowLength = byRow->getVectorLengths(); 
-
-  // Indices of basic and slack variables, and cut elements
-  int iBasic, slackIndex;
-  double cutCoeff;
-  double rowElem;
+  // Rows of tableau from provider are computed in batches
+  const int batchSize = 32;
+  int batchPivot[batchSize];
+  // column part of row of tableau is computed by task unless from provider
+  bool packTableauRow = (tableauProvider != NULL);
+#endif
+
+  // Rows for block in packed form
+  int maxPacked = blockSize*CoinMin(nrow + ncol, 100) + nrow + ncol;
+  int *packedIndex = new int[maxPacked];
+  double *packedElem = new double[maxPacked];
+  int *piStart = new int[blockSize+1];
+  int *tableauStart = new int[blockSize+1];
+  int *basicVar = new int[blockSize];
+  OsiRowCut **rowCut = new OsiRowCut*[blockSize];
+
+  CglGMIInfo info;
+  info.generator = generator;
+  info.basicVar = basicVar;
+  info.piStart = piStart;
+  info.tableauStart = tableauStart;
+  info.tableauPacked = packTableauRow;
+  info.colBasisIndex = colBasisIndex;
+  info.slackVal = slackVal;
+  info.pi = threadPi;
+  info.tableauRow = threadTableauRow;
+  info.cut = cut;
+  info.cutList = cutList;
+  info.cutElem = cutElem;
+  info.cutIndex = cutIndex;
+  info.rowCut = rowCut;
+
+  // Row in which variable is basic
+  int iBasic;
+  double cutRhs;
   // Now generate the cuts: obtain a row of the simplex tableau
   // where an integer variable is basic and fractional, and compute the cut
-  for (int i = 0; i < numFracBasic; ++i) {
-    if (!computeCutFractionality(xlp[listFracBasic[i]], cutRhs)) {
-      // cut is discarded because of the small fractionalities involved
-#if defined TRACK_REJECT || defined TRACK_REJECT_SIMPLE
-      if (trackRejection) {	
-	// Say that we tried to generate a cut, but it was discarded
-	// because of small fractionality
-	fracFail++;
-	numGeneratedCuts++;
+  int i = 0;
+  while (i < numFracBasic) {
+    int numberInBlock = 0;
+    int numPacked = 0;
+    for (; i < numFracBasic && numberInBlock < blockSize; ++i) {
+#if !defined OSI_TABLEAU
+      if (tableauProvider && i % batchSize == 0) {
+	// get next batch of rows of B^-1 A in one pass
+	int numberInBatch = CoinMin(batchSize, numFracBasic - i);
+	for (int k = 0; k < numberInBatch; ++k) {
+	  batchPivot[k] = colBasisIndex[listFracBasic[i+k]];
+	}
+	tableauProvider->computeBInvARows(numberInBatch, batchPivot);
       }
 #endif
-      continue;
-    }
+      if (!computeCutFractionality(xlp[listFracBasic[i]], cutRhs)) {
+	// cut is discarded because of the small fractionalities involved
+#if defined TRACK_REJECT || defined TRACK_REJECT_SIMPLE
+	if (trackRejection) {	
+	  // Say that we tried to generate a cut, but it was discarded
+	  // because of small fractionality
+	  fracFail++;
+	  numGeneratedCuts++;
+	}
+#endif
+	continue;
+      }
 
-    // the variable listFracBasic[i] is basic in row iBasic
-    iBasic = colBasisIndex[listFracBasic[i]];
+      // the variable listFracBasic[i] is basic in row iBasic
+      iBasic = colBasisIndex[listFracBasic[i]];
 
 #if defined GMI_TRACE
-    printf("Row %d with var %d basic, f0 = %f\n", i, listFracBasic[i], f0);
+      printf("Row %d with var %d basic, f0 = %f\n", i, listFracBasic[i], f0);
 #endif
 
 #if defined OSI_TABLEAU
-    solver->getBInvARow(iBasic, tableauColPart, tableauRowPart);
-#else
-    array.clear();
-    array.setVector(1, &iBasic, &one);
-
-    factorization.updateColumnTranspose (&work, &array);
-
-    int numberInArray=array.getNumElements();
-#endif
-
-    // reset the cut
-    memset(cut, 0, ncol*sizeof(double));
-
-    // columns
-    for (int j = 0; j < ncol; ++j) {
-      if ((colBasisIndex[j] >= 0) || 
-	  (areEqual(colLower[j], colUpper[j], 
-		    param.getEPS(), param.getEPS()))) {
-	// Basic or fixed variable -- skip
-	continue;
-      }
-#ifdef OSI_TABLEAU
-      rowElem = tableauColPart[j];
-#else
-      rowElem = 0.0;
-      // add in row of tableau
-      for (int h = columnStart[j]; h < columnStart[j]+columnLength[j]; ++h) {
-	rowElem += columnElements[h]*arrayElements[row[h]];
-      }
-#endif
-      if (!isZero(fabs(rowElem))) {
-	// compute cut coefficient
-	flip(rowElem, j);
-	cutCoeff = computeCutCoefficient(rowElem, j);
-	if (isZero(cutCoeff)) {
-	  continue;
+      solver->getBInvARow(iBasic, tableauColPart, tableauRowPart);
+      // keep nonzeros in same order as dense row
+      int numberInArray = 0;
+      for (int j = 0; j < nrow; ++j) {
+	if (rowBasisIndex[j] < 0 && tableauRowPart[j]) {
+	  arrayRows[numberInArray++] = j;
+	  arrayElements[j] = tableauRowPart[j];
 	}
-	unflipOrig(cutCoeff, j, cutRhs);
-	cut[j] = cutCoeff;
-#if defined GMI_TRACE
-	printf("var %d, row %f, cut %f\n", j, rowElem, cutCoeff);
-#endif
       }
-    }
-
-    // now do slacks part
-#if defined OSI_TABLEAU
-    for (int j = 0 ; j < nrow; ++j) {
-      // index of the row corresponding to the slack variable
-      slackIndex = j;
-      if (rowBasisIndex[j] >= 0) {
-	// Basic variable -- skip it
-	continue;
+      array.setNumElements(numberInArray);
+      int numberInRow = 0;
+      for (int j = 0; j < ncol; ++j) {
+	if (tableauColPart[j]) {
+	  tableauIndex[numberInRow++] = j;
+	  tableauElements[j] = tableauColPart[j];
+	}
       }
-      rowElem = tableauRowPart[j];
+      tableauRow.setNumElements(numberInRow);
 #else
-    for (int j = 0 ; j < numberInArray ; ++j) {
-      // index of the row corresponding to the slack variable
-      slackIndex = arrayRows[j];
-      rowElem = arrayElements[slackIndex];
-#endif
-      if (!isZero(fabs(rowElem))) {
-	slackIndex += ncol;
-	// compute cut coefficient
-	flip(rowElem, slackIndex);
-	cutCoeff = computeCutCoefficient(rowElem, slackIndex);
-	if (isZero(fabs(cutCoeff))) {
-	  continue;
-	}
-	unflipSlack(cutCoeff, slackIndex, cutRhs, slackVal);
-	eliminateSlack(cutCoeff, slackIndex, cut, cutRhs,
-		       elements, rowStart, indices, rowLength, rowRhs);
-#if defined GMI_TRACE
-	printf("var %d, row %f, cut %f\n", slackIndex, rowElem, cutCoeff);
-#endif
+      if (tableauProvider) {
+	// row of basis inverse may have been computed already
+	tableauProvider->getBInvRow(iBasic, array);
+	tableauProvider->getBInvARow(iBasic, tableauRow);
       }
-    }
-
-    packRow(cut, cutElem, cutIndex, cutNz);
-    if (cutNz == 0)
-      continue;
+      else {
+	array.clear();
+	array.setVector(1, &iBasic, &one);
 
-#if defined GMI_TRACE
-    printvecDBL("final cut:", cutElem, cutIndex, cutNz);
-    printf("cutRhs: %f\n", cutRhs);
-#endif
-    
-#if defined TRACK_REJECT || defined TRACK_REJECT_SIMPLE
-    if (trackRejection) {
-      numGeneratedCuts++;
-    }
+	factorization.updateColumnTranspose (&work, &array);
+      }
 #endif
-    if (cleanCut(cutElem, cutIndex, cutNz, cutRhs, xlp) && cutNz > 0) {
-      OsiRowCut rc;
-      rc.setRow(cutNz, cutIndex, cutElem);
-      rc.setLb(-param.getINFINIT());
-      rc.setUb(cutRhs);
+
+      // save in packed form for task
+      basicVar[numberInBlock] = listFracBasic[i];
+      piStart[numberInBlock] = numPacked;
+      packVector(array, packedIndex, packedElem, numPacked, maxPacked);
+      tableauStart[numberInBlock] = numPacked;
+      if (packTableauRow) {
+	packVector(tableauRow, packedIndex, packedElem, numPacked, maxPacked);
+      }
+      numberInBlock++;
+      array.clear();
+      tableauRow.clear();
+    }
+    piStart[numberInBlock] = numPacked;
+    info.packedIndex = packedIndex;
+    info.packedElem = packedElem;
+    CglRunTasks(numThreads, numberInBlock, cutTask, &info);
+    // add in order
+    for (int k = 0; k < numberInBlock; ++k) {
+      OsiRowCut *rc = rowCut[k];
+      if (!rc) {
+	continue;
+      }
       if (!param.getCHECK_DUPLICATES()) {
 	cs.insert(rc);
       }
       else{
-	cs.insertIfNotDuplicate(rc, CoinAbsFltEq(param.getEPS_COEFF()));
+	cs.insertIfNotDuplicate(*rc, CoinAbsFltEq(param.getEPS_COEFF()));
+	delete rc;
       }
     }
+  }
 
+  for (int i = 0; i < numThreads; ++i) {
+    if (i) {
+#if defined TRACK_REJECT || defined TRACK_REJECT_SIMPLE
+      fracFail += generator[i]->fracFail;
+      dynFail += generator[i]->dynFail;
+      violFail += generator[i]->violFail;
+      suppFail += generator[i]->suppFail;
+      scaleFail += generator[i]->scaleFail;
+      numGeneratedCuts += generator[i]->numGeneratedCuts;
+#endif
+      delete generator[i];
+    }
+    delete[] cut[i];
+    delete[] cutList[i];
+    delete[] cutElem[i];
+    delete[] cutIndex[i];
   }
+  delete[] generator;
+  delete[] threadPi;
+  delete[] threadTableauRow;
+  delete[] cut;
+  delete[] cutList;
+  delete[] cutElem;
+  delete[] cutIndex;
+  delete[] packedIndex;
+  delete[] packedElem;
+  delete[] piStart;
+  delete[] tableauStart;
+  delete[] basicVar;
+  delete[] rowCut;
 
 #if defined GMI_TRACE
   printf("CglGMI::generateCuts() : number of cuts : %d\n", cs.sizeRowCuts());
@@ -1414,10 +1732,7 @@ void CglGMI::generateCuts(OsiCuts &cs)
 
   delete[] colBasisIndex;
   delete[] rowBasisIndex;
-  delete[] cut;
   delete[] slackVal;
-  delete[] cutElem;
-  delete[] cutIndex;
   delete[] listFracBasic;
   delete[] cstat;
   delete[] rstat;
@@ -16,6 +16,9 @@
 #include "CoinWarmStartBasis.hpp"
 #include "CoinFactorization.hpp"
 
+class CglTableauProvider;
+class CoinIndexedVector;
+
 /* Enable tracking of rejection of cutting planes. If this is disabled,
    the cut generator is slightly faster. If defined, it enables proper use
    of setTrackRejection and related functions. */
@@ -134,6 +137,19 @@ public:
 
   /// Get total number of generated cuts since last resetRejectionCounters()
   int getNumberGeneratedCuts();
+
+  /// Set/get shared factorization and tableau rows (not owned).
+  /// If NULL the generator factorizes the basis itself.
+  /// Not used when compiled with OSI_TABLEAU
+  inline void setTableauProvider(CglTableauProvider *provider)
+  {tableauProvider = provider;}
+  inline CglTableauProvider *getTableauProvider() const
+  {return tableauProvider;}
+
+  /// Set/get number of threads used to compute cuts from rows of the
+  /// tableau (default 1). Cuts are the same whatever the number of threads
+  inline void setNumberThreads(int value) {numberThreads = value;}
+  inline int getNumberThreads() const {return numberThreads;}
   
   //@}
 
@@ -185,6 +201,7 @@ private:
   /// Use multiples of the initial inequalities to cancel out the coefficient
   /// on a slack variables. 
   inline void eliminateSlack(double cutElem, int cutIndex, double* cut,
+			      int* cutList, int& cutListNz,
 			      double& cutRhs, const double *elements, 
 			      const int *rowStart, const int *indices, 
 			      const int *rowLength, const double *rhs);
@@ -201,9 +218,30 @@ private:
   inline void unflipSlack(double& rowElem, int rowIndex, double& rowRhs,
 			   const double* slack_val);
 
-  /// Pack a row of ncol elements
-  inline void packRow(double* row, double* rowElem, int* rowIndex,
-		       int& rowNz);
+  /// Pack the entries of row given in rowList (and zero them in row)
+  inline void packRow(double* row, int* rowList, int rowListNz,
+		       double* rowElem, int* rowIndex, int& rowNz);
+
+  /// Compute column part of row of tableau from row of basis inverse
+  /// using row copy; returns number of nonzeros
+  int computeTableauRow(const CoinIndexedVector& pi,
+			CoinIndexedVector& tableauRow,
+			const double *elements, const int *rowStart,
+			const int *indices, const int *rowLength);
+
+  /// Compute the cut from a row of the tableau (row of basis inverse and
+  /// column part) where integer variable basicVar is basic, using
+  /// workspace cut, cutList, cutElem and cutIndex. Returns new cut, or
+  /// NULL if cut is discarded
+  OsiRowCut* cutFromTableauRow(int basicVar, const CoinIndexedVector& pi,
+			       const CoinIndexedVector& tableauRow,
+			       const int* colBasisIndex,
+			       const double* slackVal,
+			       double* cut, int* cutList,
+			       double* cutElem, int* cutIndex);
+
+  /// Compute the cut for one row of a block (task for CglRunTasks)
+  static void cutTask(void* info, int iTask, int iThread);
 
   /// Clean the cutting plane; the cleaning procedure does several things
   /// like removing small coefficients, scaling, and checks several
@@ -315,6 +353,12 @@ private:
   /// Pointer on solver. Reset by each call to generateCuts().
   OsiSolverInterface *solver;
 
+  /// Shared factorization and tableau rows, or NULL (not owned).
+  CglTableauProvider *tableauProvider;
+
+  /// Number of threads to use
+  int numberThreads;
+
   /// Pointer on point to separate. Reset by each call to generateCuts().
   const double *xlp;
 
@@ -0,0 +1,134 @@
+// $Id$
+// Copyright (C) 2026, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cstdio>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+
+#include "CoinPragma.hpp"
+#include "CoinFloatEqual.hpp"
+#include "OsiSolverInterface.hpp"
+#include "OsiCuts.hpp"
+#include "CglGMI.hpp"
+#include "CglTableauProvider.hpp"
+
+// True if cuts have the same bounds and coefficients (within eq)
+static bool sameCut(const OsiRowCut & cut1, const OsiRowCut & cut2,
+		    int numberColumns, const CoinRelFltEq & eq)
+{
+  if (!eq(cut1.lb(),cut2.lb())||!eq(cut1.ub(),cut2.ub()))
+    return false;
+  double * row1 = cut1.row().denseVector(numberColumns);
+  double * row2 = cut2.row().denseVector(numberColumns);
+  bool same = true;
+  for (int iColumn=0;iColumn<numberColumns;iColumn++) {
+    if (!eq(row1[iColumn],row2[iColumn])) {
+      same = false;
+      break;
+    }
+  }
+  delete [] row1;
+  delete [] row2;
+  return same;
+}
+
+//--------------------------------------------------------------------------
+void
+CglGMIUnitTest(
+  const OsiSolverInterface * baseSiP,
+  const std::string mpsDir )
+{
+  CoinRelFltEq eq(0.000001);
+
+  // Test default constructor
+  {
+    CglGMI aGenerator;
+    assert (aGenerator.getNumberThreads()==1);
+    assert (aGenerator.getTableauProvider()==NULL);
+  }
+
+  // Test copy & assignment
+  {
+    CglTableauProvider provider;
+    CglGMI rhs;
+    {
+      CglGMI bGenerator;
+      bGenerator.setNumberThreads(4);
+      bGenerator.setTableauProvider(&provider);
+      CglGMI cGenerator(bGenerator);
+      assert (cGenerator.getNumberThreads()==4);
+      assert (cGenerator.getTableauProvider()==&provider);
+      rhs=bGenerator;
+    }
+    assert (rhs.getNumberThreads()==4);
+    assert (rhs.getTableauProvider()==&provider);
+  }
+
+  // Miplib3 problem p0033
+  if (1) {
+    // Setup
+    OsiSolverInterface  * siP = baseSiP->clone();
+    std::string fn(mpsDir+"p0033");
+    siP->readMps(fn.c_str(),"mps");
+    CglGMI test;
+
+    siP->initialSolve();
+    double lpRelaxBefore=siP->getObjValue();
+    std::cout<<"Initial LP value: "<<lpRelaxBefore<<std::endl;
+    assert( eq(lpRelaxBefore, 2520.5717391304347) );
+    int numberColumns = siP->getNumCols();
+
+    OsiCuts cuts;
+    test.generateCuts(*siP,cuts);
+    int nRowCuts = cuts.sizeRowCuts();
+    std::cout<<"There are "<<nRowCuts<<" GMI cuts"<<std::endl;
+    assert (nRowCuts>0);
+
+    // Same cuts whatever number of threads (without CGL_THREAD
+    // rows are still split into blocks and per thread workspace)
+    for (int numberThreads=2;numberThreads<=8;numberThreads*=2) {
+      CglGMI test2(test);
+      test2.setNumberThreads(numberThreads);
+      OsiCuts cuts2;
+      test2.generateCuts(*siP,cuts2);
+      assert (cuts2.sizeRowCuts()==nRowCuts);
+      for (int i=0;i<nRowCuts;i++)
+	assert (cuts2.rowCut(i)==cuts.rowCut(i));
+    }
+
+    // Same cuts (to rounding) with shared tableau provider
+    {
+      CglTableauProvider provider;
+      CglGMI test2(test);
+      test2.setTableauProvider(&provider);
+      OsiCuts cuts2;
+      test2.generateCuts(*siP,cuts2);
+      assert (cuts2.sizeRowCuts()==nRowCuts);
+      for (int i=0;i<nRowCuts;i++)
+	assert (sameCut(cuts2.rowCut(i),cuts.rowCut(i),numberColumns,eq));
+      // second time rows come from cache and basis is not factorized again
+      OsiCuts cuts3;
+      test2.setNumberThreads(4);
+      test2.generateCuts(*siP,cuts3);
+      assert (cuts3.sizeRowCuts()==nRowCuts);
+      for (int i=0;i<nRowCuts;i++)
+	assert (cuts3.rowCut(i)==cuts2.rowCut(i));
+      assert (provider.numberFactorizations()==1);
+      assert (provider.numberRowsReused()>0);
+    }
+
+    OsiSolverInterface::ApplyCutsReturnCode rc = siP->applyCuts(cuts);
+    siP->resolve();
+    double lpRelaxAfter=siP->getObjValue();
+    std::cout<<"LP value with cuts: "<<lpRelaxAfter<<std::endl;
+    assert( lpRelaxBefore < lpRelaxAfter );
+    assert( lpRelaxAfter < 3089.1 );
+
+    delete siP;
+  }
+}
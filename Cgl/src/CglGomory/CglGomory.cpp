@@ -34,6 +34,8 @@
 #endif
 #include "CoinWarmStartBasis.hpp"
 #include "CglGomory.hpp"
+#include "CglTableauProvider.hpp"
+#include "CglThreads.hpp"
 #include "CoinFinite.hpp"
 #ifdef CGL_DEBUG_GOMORY
 int gomory_try=CGL_DEBUG_GOMORY;
@@ -459,6 +461,717 @@ inline Rational nearestRational(double value, int maxDenominator)
     return tryA;
   }
 }
+#define MORE_GOMORY_CUTS 1
+// Information needed to derive cuts from rows of tableau
+typedef struct {
+  // Rows of B^-1 for block (packed)
+  const CoinBigIndex * piStart;
+  const int * piIndex;
+  const double * piElement;
+  // Basic column for each task
+  const int * which;
+  // Work arrays for each thread
+  CoinIndexedVector * array;
+  CoinIndexedVector * cutVector;
+  double ** packed;
+  // Cut for each task and whether ordinary (1) or less accurate (2)
+  OsiRowCut ** cut;
+  int * cutType;
+  // Problem
+  const CoinPackedMatrix * columnCopy;
+  const CoinPackedMatrix * rowCopy;
+  const double * colsol;
+  const double * colLower;
+  const double * colUpper;
+  const double * rowLower;
+  const double * rowUpper;
+  const char * intVar;
+  const int * columnIsBasic;
+  const bool * swap;
+  const int * rowType;
+  // Settings
+  double away;
+  double testFixed;
+  double relaxation;
+  double largestFactorMultiplier;
+  double tolerance;
+  double tolerance1;
+  double tolerance2;
+  double tolerance3;
+  double tolerance6;
+  double tolerance9;
+  int limit;
+  int saveLimit;
+  bool globalCuts;
+  bool doSorted;
+} CglGomoryInfo;
+/* Derives cut from one row of tableau.  Row of B^-1 has already been
+   computed.  Cut (if any) is left for caller to add so that cuts are
+   in same order whatever the number of threads.
+*/
+static void gomoryCut(void * voidInfo, int iTask, int iThread)
+{
+  CglGomoryInfo * gomoryInfo = reinterpret_cast<CglGomoryInfo *> (voidInfo);
+  const int * column = gomoryInfo->rowCopy->getIndices();
+  const CoinBigIndex * rowStart = gomoryInfo->rowCopy->getVectorStarts();
+  const int * rowLength = gomoryInfo->rowCopy->getVectorLengths(); 
+  const double * rowElements = gomoryInfo->rowCopy->getElements();
+  const int * row = gomoryInfo->columnCopy->getIndices();
+  const CoinBigIndex * columnStart = gomoryInfo->columnCopy->getVectorStarts();
+  const int * columnLength = gomoryInfo->columnCopy->getVectorLengths(); 
+  const double * columnElements = gomoryInfo->columnCopy->getElements();
+  int numberColumns = gomoryInfo->columnCopy->getNumCols();
+  const double * colsol = gomoryInfo->colsol;
+  const double * colLower = gomoryInfo->colLower;
+  const double * colUpper = gomoryInfo->colUpper;
+  const double * rowLower = gomoryInfo->rowLower;
+  const double * rowUpper = gomoryInfo->rowUpper;
+  const char * intVar = gomoryInfo->intVar;
+  const int * columnIsBasic = gomoryInfo->columnIsBasic;
+  const bool * swap = gomoryInfo->swap;
+  const int * rowType = gomoryInfo->rowType;
+  double away = gomoryInfo->away;
+  double testFixed = gomoryInfo->testFixed;
+  double relaxation = gomoryInfo->relaxation;
+  double largestFactorMultiplier = gomoryInfo->largestFactorMultiplier;
+  double tolerance = gomoryInfo->tolerance;
+  double tolerance1 = gomoryInfo->tolerance1;
+  double tolerance2 = gomoryInfo->tolerance2;
+  double tolerance3 = gomoryInfo->tolerance3;
+  double tolerance6 = gomoryInfo->tolerance6;
+  double tolerance9 = gomoryInfo->tolerance9;
+  int limit = gomoryInfo->limit;
+#if MORE_GOMORY_CUTS==2||MORE_GOMORY_CUTS==3
+  int saveLimit = gomoryInfo->saveLimit;
+#endif
+  bool globalCuts = gomoryInfo->globalCuts;
+#if MORE_GOMORY_CUTS==1||MORE_GOMORY_CUTS==3
+  bool doSorted = gomoryInfo->doSorted;
+#endif
+  double bounds[2]={-COIN_DBL_MAX,0.0};
+  int iColumn=gomoryInfo->which[iTask];
+  double reducedValue=above_integer(colsol[iColumn]);
+  double ratio=reducedValue/(1.0-reducedValue);
+  int iRow;
+  int j;
+  gomoryInfo->cut[iTask]=NULL;
+  gomoryInfo->cutType[iTask]=0;
+  assert(intVar[iColumn]&&reducedValue<1.0-away&&
+	 reducedValue>away);
+  // row of B^-1 into work array for this thread
+  CoinIndexedVector & array = gomoryInfo->array[iThread];
+  int * arrayRows = array.getIndices();
+  double * arrayElements = array.denseVector();
+  array.clear();
+  CoinBigIndex start = gomoryInfo->piStart[iTask];
+  int numberInPi = static_cast<int> (gomoryInfo->piStart[iTask+1]-start);
+  for (j=0;j<numberInPi;j++) {
+    iRow = gomoryInfo->piIndex[start+j];
+    arrayRows[j]=iRow;
+    arrayElements[iRow]=gomoryInfo->piElement[start+j];
+  }
+  array.setNumElements(numberInPi);
+  // we also need somewhere to accumulate cut
+  CoinIndexedVector & cutVector = gomoryInfo->cutVector[iThread];
+  int * cutIndex = cutVector.getIndices();
+  double * cutElement = cutVector.denseVector(); 
+  // and for packed form (as not necessarily in order)
+  double * packed = gomoryInfo->packed[iThread];
+#ifdef CGL_DEBUG
+  cutVector.checkClear();
+#endif
+  int numberNonInteger=0;
+  int numberInArray=array.getNumElements();
+#ifdef CGL_DEBUG
+  // check pivot on iColumn
+  {
+    double value=0.0;
+    int k;
+    // add in row of tableau
+    for (k=columnStart[iColumn];
+	 k<columnStart[iColumn]+columnLength[iColumn];k++) {
+      iRow = row[k];
+      value += columnElements[k]*arrayElements[iRow];
+    }
+    // should be 1
+    assert (fabs(value-1.0) < 1.0e-7);
+  }
+#endif
+  double largestFactor=0.0;
+  for (j=0;j<numberInArray;j++) {
+    int indexValue=arrayRows[j];
+    double value=arrayElements[indexValue];
+    largestFactor = CoinMax(largestFactor,fabs(value));
+  }
+  //reducedValue=colsol[iColumn];
+  // coding from pg 130 of Wolsey 
+  // adjustment to rhs
+  double rhs=0.0;
+  int number=0;
+  // number of terms (so includes modifications and cancellations)
+  int numberCoefficients=0;
+#ifdef CGL_DEBUG_GOMORY
+      if (!gomory_try)
+	printf("start for basic column %d\n",iColumn);
+#endif
+  // columns
+  for (j=0;j<numberColumns;j++) {
+    if (columnIsBasic[j]<0&&colUpper[j]>colLower[j]+testFixed) {
+      double value=0.0;
+      int k;
+      // add in row of tableau
+      for (k=columnStart[j];k<columnStart[j]+columnLength[j];k++) {
+	iRow = row[k];
+	double value2 = columnElements[k]*arrayElements[iRow];
+	largestFactor = CoinMax(largestFactor,fabs(value2));
+	value += value2;
+      }
+#ifdef CGL_DEBUG_GOMORY
+      if (!gomory_try&&value)
+	printf("col %d alpha %g colsol %g swap %c bounds %g %g\n",
+	       j,value,colsol[j],swap[j] ? 'Y' : 'N',
+	       colLower[j],colUpper[j]);
+#endif
+      // value is entry in tableau row end (C) ====
+      if (fabs(value)<1.0e-16) {
+	// small value
+	continue;
+      } else {
+	// left in to stop over compilation?
+	//if (iColumn==-52) printf("for basic %d, column %d has alpha %g, colsol %g\n",
+	//		      iColumn,j,value,colsol[j]);
+#if CGL_DEBUG>1
+	if (iColumn==52) printf("for basic %d, column %d has alpha %g, colsol %g\n",
+				iColumn,j,value,colsol[j]);
+#endif
+	// deal with bounds
+	if (swap[j]) {
+	  //reducedValue -= value*colUpper[j];
+	  // negate
+	  value = - value;
+	} else {
+	  //reducedValue -= value*colLower[j];
+	}
+#if CGL_DEBUG>1
+	if (iColumn==52) printf("%d value %g reduced %g int %d rhs %g swap %d\n",
+				j,value,reducedValue,intVar[j],rhs,swap[j]);
+#endif
+	double coefficient;
+	if (intVar[j]) {
+	  // integer
+	  coefficient = above_integer(value);
+	  if (coefficient > reducedValue) {
+	    coefficient = ratio * (1.0-coefficient);
+	  } 
+	} else {
+	  // continuous
+	  numberNonInteger++;
+	  if (value > 0.0) {
+	    coefficient = value;
+	  } else {
+	    //??? sign wrong in book
+	    coefficient = -ratio*value;
+	  }
+	}
+	if (swap[j]) {
+	  // negate
+	  coefficient = - coefficient;
+	  rhs += colUpper[j]*coefficient;
+	} else {
+	  rhs += colLower[j]*coefficient;
+	}
+	if (fabs(coefficient)>= COIN_INDEXED_TINY_ELEMENT) {
+	  cutElement[j] = coefficient;
+	  numberCoefficients++;
+	  cutIndex[number++]=j;
+	  // If too many - break from loop
+	  if (number>limit) 
+	    break;
+	}
+      }
+    } else {
+      // basic
+      continue;
+    }
+  }
+  cutVector.setNumElements(number);
+  // If too many - just clear vector and skip
+  if (number>limit) {
+    cutVector.clear();
+    return;
+  }
+  //check will be cut
+  //reducedValue=above_integer(reducedValue);
+  rhs += reducedValue;
+  double violation = reducedValue;
+#ifdef CGL_DEBUG
+  std::cout<<"cut has violation of "<<violation
+	   <<" value "<<colsol[iColumn]<<std::endl;
+#endif
+  // now do slacks part
+  for (j=0;j<numberInArray;j++) {
+    iRow=arrayRows[j];
+    double value = arrayElements[iRow];
+    int type=rowType[iRow];
+    if (type&&fabs(value)>=1.0e-16) {
+      if ((type&1)==0) {
+	// negate to get correct coefficient
+	value = - value;
+      }
+      double coefficient;
+      if ((type&4)!=0) {
+	// integer
+	coefficient = above_integer(value);
+	if (coefficient > reducedValue) {
+	  coefficient = ratio * (1.0-coefficient);
+	} 
+      } else {
+	numberNonInteger++;
+	// continuous
+	if (value > 0.0) {
+	  coefficient = value;
+	} else {
+	  coefficient = -ratio*value;
+	}
+      }
+      if ((type&1)!=0) {
+	// slack at ub - treat as +1.0
+	rhs -= coefficient*rowUpper[iRow];
+      } else {
+	// negate yet again ?
+	coefficient = - coefficient;
+	rhs -= coefficient*rowLower[iRow];
+      }
+      int k;
+      for (k=rowStart[iRow];
+	   k<rowStart[iRow]+rowLength[iRow];k++) {
+	int jColumn=column[k];
+	double value=rowElements[k];
+	double oldValue=cutElement[jColumn];
+	cutVector.quickAdd(jColumn,-coefficient*value);
+	numberCoefficients++;
+	if (!intVar[jColumn]&&!oldValue) 
+	  numberNonInteger++;
+      }
+    }
+  }
+  //check again and pack down
+  // also change signs
+  // also zero cutElement
+  double sum=0.0;
+  rhs = - rhs;
+  int n = cutVector.getNumElements();
+  // If too many - just clear vector and skip
+  if (n>limit) {
+    cutVector.clear();
+    return;
+  }
+#if MORE_GOMORY_CUTS==1||MORE_GOMORY_CUTS==3
+  double violation2=violation;
+#endif
+  number=0;
+  double sumCoefficients=0.0;
+  for (j=0;j<n;j++) {
+    int jColumn =cutIndex[j];
+    double value=-cutElement[jColumn];
+    sumCoefficients += fabs(value);
+    if (fabs(colsol[jColumn])>10.0)
+      sumCoefficients += 2.0*fabs(value);
+    cutElement[jColumn]=0.0;
+    if (fabs(value)>1.0e-8) {
+      sum+=value*colsol[jColumn];
+      packed[number]=value;
+      cutIndex[number++]=jColumn;
+    } else {
+#define LARGE_BOUND 1.0e20
+      // small - adjust rhs if rhs reasonable
+      if (value>0.0&&colLower[jColumn]>-LARGE_BOUND) {
+	rhs -= value*colLower[jColumn];
+#if MORE_GOMORY_CUTS==1||MORE_GOMORY_CUTS==3
+	// weaken violation
+	violation2 -= fabs(value*(colsol[jColumn]-colLower[jColumn]));
+#endif
+      } else if (value<0.0&&colUpper[jColumn]<LARGE_BOUND) {
+	rhs -= value*colUpper[jColumn];
+#if MORE_GOMORY_CUTS==1||MORE_GOMORY_CUTS==3
+	// weaken violation
+	violation2 -= fabs(value*(colsol[jColumn]-colUpper[jColumn]));
+#endif
+      } else if (fabs(value)>1.0e-13) {
+	// take anyway
+	sum+=value*colsol[jColumn];
+	packed[number]=value;
+	cutIndex[number++]=jColumn;
+      } 
+    }
+  }
+  // Final test on number
+  //if (number>limit)
+  //continue;
+  // say zeroed out
+  cutVector.setNumElements(0);
+  bool accurate2=false;
+  double difference=fabs((sum-rhs)-violation);
+  double useTolerance;
+  if (tolerance1>0.99) {
+    // use absolute
+    useTolerance = tolerance;
+  } else {
+    double rhs2=CoinMax(fabs(rhs),10.0);
+    useTolerance=rhs2*0.1*tolerance1;
+  }
+  bool accurate = (difference<useTolerance);
+#if MORE_GOMORY_CUTS==1||MORE_GOMORY_CUTS==3
+  double difference2=fabs((sum-rhs)-violation2);
+#if MORE_GOMORY_CUTS==1
+  if (difference2<useTolerance&&doSorted) 
+#else
+  if (difference2<useTolerance&&doSorted&&number<saveLimit) 
+#endif
+    accurate2=true;
+#endif
+  if (sum >rhs+tolerance2*away&&
+      (accurate||accurate2)) {
+    //#ifdef CGL_DEBUG
+#ifdef CGL_DEBUG
+#if CGL_DEBUG<=1
+    if (number<=-10) {
+#endif
+      for (j=0;j<number;j++) {
+	std::cout<<" ["<<cutIndex[j]<<","<<packed[j]<<"]";
+      }
+      std::cout<<" <= "<<rhs<<std::endl;
+#if CGL_DEBUG<=1
+    }
+#endif
+#endif
+    if (!numberNonInteger&&number) {
+#ifdef CGL_DEBUG
+      assert (sizeof(Rational)==sizeof(double));
+#endif
+      Rational * cleaned = reinterpret_cast<Rational *> (cutElement);
+      int * xInt = reinterpret_cast<int *> (cutElement);
+      // cut should have an integer slack so try and simplify
+      // add in rhs and put in cutElements (remember to zero later)
+      cutIndex[number]=numberColumns+1;
+      packed[number]=rhs;
+      int numberNonSmall=0;
+      int lcm = 1;
+	    
+      for (j=0;j<number+1;j++) {
+	double value=above_integer(fabs(packed[j]));
+	if (fabs(value)<tolerance3) {
+	  // too small
+	  continue;
+	} else {
+	  numberNonSmall++;
+	}
+	      
+	cleaned[j]=nearestRational(value,100000);
+	if (cleaned[j].denominator<0) {
+	  // bad rational
+	  lcm=-1;
+	  break;
+	}
+	int thisGcd = gcd(lcm,cleaned[j].denominator);
+	// may need to check for overflow
+	lcm /= thisGcd;
+	lcm *= cleaned[j].denominator;
+      }
+      if (lcm>0&&numberNonSmall) {
+	double multiplier = lcm;
+	int nOverflow = 0; 
+	for (j=0; j<number+1;j++) {
+	  double value = fabs(packed[j]);
+	  double dxInt = value*multiplier;
+	  xInt[j]= static_cast<int> (dxInt+0.5); 
+#if CGL_DEBUG>1
+	  printf("%g => %g   \n",value,dxInt);
+#endif
+	  if (dxInt>1.0e9||fabs(dxInt-xInt[j])> 1.0e-8) {
+	    nOverflow++;
+	    break;
+	  }
+	}
+	      
+	if (nOverflow){
+#ifdef CGL_DEBUG
+	  printf("Gomory Scaling: Warning: Overflow detected \n");
+#endif
+	  numberNonInteger=-1;
+	} else {
+		
+	  // find greatest common divisor of the elements
+	  j=0;
+	  while (!xInt[j])
+	    j++; // skip zeros
+	  int thisGcd = gcd(xInt[j],xInt[j+1]);
+	  j++;
+	  for (;j<number+1;j++) {
+	    if (xInt[j])
+	      thisGcd = gcd(thisGcd,xInt[j]);
+	  }
+#if 0
+	  // Check nothing too illegal - FIX this
+	  for (j=0;j<number+1;j++) {
+	    double old = lcm*packed[j];
+	    int newOne;
+	    if (old>0.0)
+	      newOne=xInt[j]/thisGcd;
+	    else
+	      newOne=-xInt[j]/thisGcd;
+	    if (fabs(((double) newOne)-old)>
+		1.0e-10*(fabs(newOne)+1.0)) {
+	      // say no good - first see if happens
+	      printf("Fix this test 456 - just skip\n");
+	      abort();
+	    }
+	  } 
+#endif		  
+#if CGL_DEBUG>1
+	  printf("The gcd of xInt is %i\n",thisGcd);    
+#endif
+		
+	  // construct new cut by dividing through by gcd and 
+	  double minMultiplier=1.0e100;
+	  double maxMultiplier=0.0;
+	  for (j=0; j<number+1;j++) {
+	    double old=packed[j];
+	    if (old>0.0) {
+	      packed[j]=xInt[j]/thisGcd;
+	    } else {
+	      packed[j]=-xInt[j]/thisGcd;
+	    }
+#if CGL_DEBUG>1
+	    printf("%g => %g   \n",old,packed[j]);
+#endif
+	    if (packed[j]) {
+	      if (fabs(packed[j])>maxMultiplier*fabs(old))
+		maxMultiplier = packed[j]/old;
+	      if (fabs(packed[j])<minMultiplier*fabs(old))
+		minMultiplier = packed[j]/old;
+	    }
+	  }
+	  rhs = packed[number];
+#ifdef CGL_DEBUG
+	  printf("min, max multipliers - %g, %g\n",
+		 minMultiplier,maxMultiplier);
+#endif
+	  assert(maxMultiplier/minMultiplier>0.9999&&maxMultiplier/minMultiplier<1.0001);
+	}
+      }
+      // erase cutElement
+      CoinFillN(cutElement,number+1,0.0);
+    } else {
+      // relax rhs a tiny bit
+      //#define CGL_GOMORY_OLD_RELAX
+#ifndef CGL_GOMORY_OLD_RELAX
+#if 0
+      double rhs2=rhs;
+      rhs2 += 1.0e-8;
+      // relax if lots of elements for mixed gomory
+      if (number>=20) {
+	rhs2  += 1.0e-7*(static_cast<double> (number/20));
+      }
+#endif
+      rhs += 1.0e-7;
+      if (numberCoefficients>=10||true) {
+	rhs  += 1.0e-7*sumCoefficients+1.0e-8*numberCoefficients;
+      }
+#if 0
+      if (numberCoefficients>number*3)
+      printf("old rhs %.18g new %.18g - n,nNon,nC,sumC %d,%d,%d %g\n",
+	     rhs2,rhs,number,numberNonInteger,numberCoefficients,
+	     sumCoefficients);
+#endif
+#else
+      rhs += 1.0e-8;
+      // relax if lots of elements for mixed gomory
+      if (number>=20) {
+	rhs  += 1.0e-7*(static_cast<double> (number/20));
+      }
+#endif
+    }
+    // Take off tiny elements
+    // for first pass reject
+#ifndef CGL_GOMORY_TINY_ELEMENT
+#define CGL_GOMORY_TINY_ELEMENT 1.0e-12
+#endif
+    {
+      int i,number2=number;
+      number=0;
+      double largest=0.0;
+      double smallest=1.0e30;
+      for (i=0;i<number2;i++) {
+	double value=fabs(packed[i]);
+	if (value<CGL_GOMORY_TINY_ELEMENT) {
+	  int iColumn = cutIndex[i];
+	  if (colUpper[iColumn]-colLower[iColumn]<LARGE_BOUND) {
+	    // weaken cut
+	    if (packed[i]>0.0) 
+	      rhs -= value*colLower[iColumn];
+	    else
+	      rhs += value*colUpper[iColumn];
+	  } else {
+	    // throw away
+	    number=limit+1;
+	    numberNonInteger=1;
+	    break;
+	  }
+	} else {
+	  int iColumn = cutIndex[i];
+	  if (colUpper[iColumn]!=colLower[iColumn]||globalCuts) {
+	    value=fabs(value);
+	    largest=CoinMax(largest,value);
+	    smallest=CoinMin(smallest,value);
+	    cutIndex[number]=cutIndex[i];
+	    packed[number++]=packed[i];
+	  } else {
+	    // fixed so subtract out
+	    rhs -= packed[i]*colLower[iColumn];
+	  }
+	}
+      }
+      if (largest>1.0e10*smallest||(number>20&&smallest<number*1.0e-6)) {
+	number=limit+1; //reject
+	numberNonInteger=1;
+      } else if (largest>1.0e9*smallest) {
+#ifdef CLP_INVESTIGATE2
+	printf("WOuld reject %g %g ratio %g\n",smallest,largest,
+	       smallest/largest);
+#endif
+#if MORE_GOMORY_CUTS==1||MORE_GOMORY_CUTS==3
+	accurate=false;
+#endif
+      } else {
+#define TRY7 2
+#define PRINT_NUMBER 0
+#if PRINT_NUMBER
+	if (number==PRINT_NUMBER) {
+	  printf("==========\n<= %.18g ",rhs);
+	  for (int i=0;i<PRINT_NUMBER;i++)
+	    printf("%.18g ",packed[i]);
+	  printf("\n");
+	}
+#endif
+	if (number>limit)  
+	  return;
+#if TRY7==1
+	// Just scale
+	double multiplier = 1.0/sqrt(largest*smallest);
+	for (int i=0;i<number;i++)
+	  packed[i] *= multiplier;
+	rhs *= multiplier;
+	if (number==PRINT_NUMBER) {
+	  printf("multiplier %g %g %g\n",
+		 multiplier,smallest,largest);
+	}
+#elif TRY7==2
+	// Look at ratio
+	double scaleFactor=fabs(rhs);
+	for (int i=0;i<number;i++) {
+	  double value=packed[i];
+	  double ratio = fabs(rhs/value);
+	  double nearest=floor(ratio+0.5);
+	  if (fabs(ratio-nearest)<1.0e-6 && nearest >= 1.0) {
+	    int iColumn=cutIndex[i];
+	    if (intVar[iColumn]) {
+	      if (colLower[iColumn]>=0.0) {
+		if (value>0.0) {
+		  // better if smaller
+		  if (ratio>nearest) {
+		    packed[i]=scaleFactor/nearest;
+		  }			  
+		} else {
+		  // better if larger
+		  if (ratio<nearest) {
+		    packed[i]=-scaleFactor/nearest;
+		  }			  
+		}
+		//if (value!=packed[i])
+		//printf("column %d rhs %.18g element %g ratio %.18g - new element %.18g\n",
+		//       iColumn,rhs,value,ratio,packed[i]);
+		//assert (fabs(value-packed[i])<1.0e-4);
+	      } else {
+		printf("column %d rhs %g element %g ratio %.18g - bounds %g,%g\n",
+		       iColumn,rhs,value,ratio,colLower[iColumn],colUpper[iColumn]);
+	      }
+	    }
+	  }
+	}
+#endif
+#if PRINT_NUMBER
+	if (number==PRINT_NUMBER) {
+	  printf("after %.18g ",rhs);
+	  for (int i=0;i<PRINT_NUMBER;i++)
+	    printf("%.18g ",packed[i]);
+	  printf("\n");
+	}
+#endif
+      }
+    }
+    if (number<limit||!numberNonInteger) {
+      bounds[1]=rhs;
+      if (number>50&&numberNonInteger)
+	bounds[1] = rhs+tolerance6+1.0e-8*fabs(rhs); // weaken
+      double test = CoinMin(largestFactor*largestFactorMultiplier,
+			    relaxation);
+      if (number>5&&numberNonInteger&&test>1.0e-20) {
+#ifdef CLP_INVESTIGATE2
+	printf("relaxing rhs by %g - largestFactor was %g, rel %g\n",
+	   CoinMin(test*fabs(rhs),tolerance9),largestFactor,relaxation);
+#endif
+	//bounds[1] = CoinMax(bounds[1],
+	//		  rhs+CoinMin(test*fabs(rhs),tolerance9)); // weaken
+	bounds[1] = bounds[1]+CoinMin(test*fabs(rhs),tolerance9); // weaken
+      }
+#ifdef MORE_GOMORY_CUTS
+      if (accurate) {
+#else
+      {
+#endif
+	// added to cuts (in order) by caller
+	OsiRowCut * rc = new OsiRowCut();
+	rc->setRow(number,cutIndex,packed,false);
+	rc->setLb(bounds[0]);
+	rc->setUb(bounds[1]);   
+	gomoryInfo->cut[iTask]=rc;
+	gomoryInfo->cutType[iTask]=1;
+#if MORE_GOMORY_CUTS==1||MORE_GOMORY_CUTS==3
+      } else if (accurate2) {
+	OsiRowCut * rc = new OsiRowCut();
+	rc->setRow(number,cutIndex,packed,false);
+	rc->setLb(bounds[0]);
+	rc->setUb(bounds[1]);   
+	gomoryInfo->cut[iTask]=rc;
+	gomoryInfo->cutType[iTask]=2;
+#endif
+      }
+    } else {
+#ifdef CGL_DEBUG
+      std::cout<<"cut has "<<number<<" entries - skipped"
+	       <<std::endl;
+      if (!number)
+	std::cout<<"******* Empty cut - infeasible"<<std::endl;
+#endif
+    }
+  } else {
+    // why dropped?
+#ifdef CGL_DEBUG
+    std::cout<<"first violation "<<violation<<" now "
+	     <<sum-rhs<<" why?, rhs= "<<rhs<<std::endl;
+	  
+    for (j=0;j<number;j++) {
+      int jColumn =cutIndex[j];
+      double value=packed[j];
+      std::cout<<"("<<jColumn<<","<<value<<","<<colsol[jColumn]
+	       <<") ";
+    }
+    std::cout<<std::endl;
+    //abort();
+#endif
+  }
+}
 // Does actual work - returns number of cuts
 int
 CglGomory::generateCuts( 
@@ -522,6 +1235,18 @@ CglGomory::generateCuts(
       columnIsBasic[i]=-1;
     }
   }
+  // factorization used for updates (may be shared)
+  const CoinFactorization * factor = &factorization;
+  bool useProvider = tableauProvider_&&!alternateFactorization_;
+  if (useProvider) {
+    status = tableauProvider_->factorize(columnCopy,*warm);
+    if (!status) {
+      factor = tableauProvider_->factorization();
+      memcpy(rowIsBasic,tableauProvider_->rowIsBasic(),numberRows*sizeof(int));
+      memcpy(columnIsBasic,tableauProvider_->columnIsBasic(),
+	     numberColumns*sizeof(int));
+    }
+  }
   //returns 0 -okay, -1 singular, -2 too many in basis, -99 memory */
   while (status<-98) {
 #ifdef CLP_OSL
@@ -550,10 +1275,10 @@ CglGomory::generateCuts(
   // End of creation of factorization (A) ====
   
 #ifdef CLP_OSL
-  double relaxation = !alternateFactorization_ ? factorization.conditionNumber() :
+  double relaxation = !alternateFactorization_ ? factor->conditionNumber() :
     factorization2->conditionNumber();
 #else
-  double relaxation = factorization.conditionNumber();
+  double relaxation = factor->conditionNumber();
 #endif
   // if very small be a bit more careful
   if (relaxation<1.0e-10)
@@ -564,7 +1289,6 @@ CglGomory::generateCuts(
 #endif
   //printf("condition %g %g\n",relaxation,conditionNumberMultiplier_);
   relaxation *= conditionNumberMultiplier_;
-  double bounds[2]={-COIN_DBL_MAX,0.0};
   int iColumn,iRow;
 
   const int * column = rowCopy.getIndices();
@@ -669,11 +1393,6 @@ CglGomory::generateCuts(
   // End of code to create work arrays (B) ====
 
   int numberAdded=0;
-  // we also need somewhere to accumulate cut
-  CoinIndexedVector cutVector;
-  cutVector.reserve(numberColumns+1);
-  int * cutIndex = cutVector.getIndices();
-  double * cutElement = cutVector.denseVector(); 
   // and for packed form (as not necessarily in order)
   // also space for sort
   bool doSorted = (infoOptions&256)!=0;
@@ -688,7 +1407,6 @@ CglGomory::generateCuts(
   double tolerance3=1.0e-4;
   double tolerance6=1.0e-6;
   double tolerance9=1.0e-4;
-#define MORE_GOMORY_CUTS 1
 #ifdef CLP_INVESTIGATE2
   int saveLimit = info.inTree ? 50 : 1000;
 #else
@@ -795,17 +1513,83 @@ CglGomory::generateCuts(
 #if MORE_GOMORY_CUTS==1||MORE_GOMORY_CUTS==3
   OsiCuts secondaryCuts;
 #endif
-  for (int kColumn=0;kColumn<nCandidates;kColumn++) {
-    if (nTotalEls<=0)
-      break;  // Got enough
-    iColumn=which[kColumn];
-    double reducedValue=above_integer(colsol[iColumn]);;
-    // This returns pivot row for columns or -1 if not basic (C) ====
-    int iBasic=columnIsBasic[iColumn];
-    double ratio=reducedValue/(1.0-reducedValue);
-    if (iBasic>=0) {
-  // Debug code below computes tableau column of basic ====
+  // Cuts are derived from rows of tableau by gomoryCut.  Rows of B^-1
+  // are computed here (factorization is not thread safe) a block at a
+  // time, then cuts for block may be done in parallel and are added in
+  // order so they do not depend on number of threads.
+  int numberThreads = CglNumberThreads(numberThreads_,nCandidates);
+  int blockSize = (numberThreads>1) ? 8*numberThreads : 1;
+  CoinIndexedVector * threadArray = new CoinIndexedVector [numberThreads];
+  CoinIndexedVector * cutVector = new CoinIndexedVector [numberThreads];
+  double ** threadPacked = new double * [numberThreads];
+  for (i=0;i<numberThreads;i++) {
+    threadArray[i].reserve(numberRows);
+    cutVector[i].reserve(numberColumns+1);
+    threadPacked[i] = i ? new double [numberColumns+1] : packed;
+  }
+  CoinBigIndex * piStart = new CoinBigIndex [blockSize+1];
+  CoinBigIndex maximumPi = blockSize*CoinMin(numberRows,100)+numberRows;
+  int * piIndex = new int [maximumPi];
+  double * piElement = new double [maximumPi];
+  OsiRowCut ** blockCut = new OsiRowCut * [blockSize];
+  int * cutType = new int [blockSize];
+  CglGomoryInfo gomoryInfo;
+  gomoryInfo.piStart = piStart;
+  gomoryInfo.piIndex = piIndex;
+  gomoryInfo.piElement = piElement;
+  gomoryInfo.array = threadArray;
+  gomoryInfo.cutVector = cutVector;
+  gomoryInfo.packed = threadPacked;
+  gomoryInfo.cut = blockCut;
+  gomoryInfo.cutType = cutType;
+  gomoryInfo.columnCopy = &columnCopy;
+  gomoryInfo.rowCopy = &rowCopy;
+  gomoryInfo.colsol = colsol;
+  gomoryInfo.colLower = colLower;
+  gomoryInfo.colUpper = colUpper;
+  gomoryInfo.rowLower = rowLower;
+  gomoryInfo.rowUpper = rowUpper;
+  gomoryInfo.intVar = intVar;
+  gomoryInfo.columnIsBasic = columnIsBasic;
+  gomoryInfo.swap = swap;
+  gomoryInfo.rowType = rowType;
+  gomoryInfo.away = away;
+  gomoryInfo.testFixed = testFixed;
+  gomoryInfo.relaxation = relaxation;
+  gomoryInfo.largestFactorMultiplier = largestFactorMultiplier_;
+  gomoryInfo.tolerance = tolerance;
+  gomoryInfo.tolerance1 = tolerance1;
+  gomoryInfo.tolerance2 = tolerance2;
+  gomoryInfo.tolerance3 = tolerance3;
+  gomoryInfo.tolerance6 = tolerance6;
+  gomoryInfo.tolerance9 = tolerance9;
+  gomoryInfo.limit = limit;
+#if MORE_GOMORY_CUTS==2||MORE_GOMORY_CUTS==3
+  gomoryInfo.saveLimit = saveLimit;
+#else
+  gomoryInfo.saveLimit = 0;
+#endif
+  gomoryInfo.globalCuts = globalCuts;
+  gomoryInfo.doSorted = doSorted;
+  int kColumn=0;
+  while (kColumn<nCandidates&&nTotalEls>0) {
+    int numberInBlock=CoinMin(blockSize,nCandidates-kColumn);
+    piStart[0]=0;
+    for (int kBlock=0;kBlock<numberInBlock;kBlock++) {
+      if (useProvider&&((kColumn+kBlock)&31)==0) {
+	// rows of B^-1 for next batch of candidates (all basic)
+	int batchPivot[32];
+	int numberInBatch=CoinMin(32,nCandidates-kColumn-kBlock);
+	for (int k=0;k<numberInBatch;k++)
+	  batchPivot[k]=columnIsBasic[which[kColumn+kBlock+k]];
+	tableauProvider_->computeBInvRows(numberInBatch,batchPivot);
+      }
+      iColumn=which[kColumn+kBlock];
+      // This returns pivot row for columns or -1 if not basic (C) ====
+      int iBasic=columnIsBasic[iColumn];
+      assert (iBasic>=0);
       int j;
+  // Debug code below computes tableau column of basic ====
 #ifdef CGL_DEBUG
       {
 	// put column into array
@@ -815,7 +1599,7 @@ CglGomory::generateCuts(
 #ifdef CLP_OSL
 	if (!alternateFactorization_)
 #endif
-	  factorization.updateColumn ( &work, &array );
+	  factor->updateColumn ( &work, &array );
 #ifdef CLP_OSL
 	else
 	  factorization2->updateColumn ( &work, &array );
@@ -837,655 +1621,89 @@ CglGomory::generateCuts(
       }
 #endif
       array.clear();
-      assert(intVar[iColumn]&&reducedValue<1.0-away&&reducedValue>away);
-      {
-#ifdef CGL_DEBUG
-	cutVector.checkClear();
-#endif
-	// get row of tableau
-	double one =1.0;
-	array.setVector(1,&iBasic,&one);
-	int numberNonInteger=0;
-	//Code below computes tableau row ====
-	// get pi
+      // get row of tableau
+      double one =1.0;
+      array.setVector(1,&iBasic,&one);
+      //Code below computes tableau row ====
+      // get pi
+      if (useProvider)
+	tableauProvider_->getBInvRow(iBasic,array);
 #ifdef CLP_OSL
-	if (!alternateFactorization_)
+      else if (!alternateFactorization_)
+#else
+      else
 #endif
-	  factorization.updateColumnTranspose ( &work, &array );
+	factorization.updateColumnTranspose ( &work, &array );
 #ifdef CLP_OSL
-	else
-	  factorization2->updateColumnTranspose ( &work, &array );
-#endif
-	int numberInArray=array.getNumElements();
-#ifdef CGL_DEBUG
-	// check pivot on iColumn
-	{
-	  double value=0.0;
-	  int k;
-	  // add in row of tableau
-	  for (k=columnStart[iColumn];
-	       k<columnStart[iColumn]+columnLength[iColumn];k++) {
-	    iRow = row[k];
-	    value += columnElements[k]*arrayElements[iRow];
-	  }
-	  // should be 1
-	  assert (fabs(value-1.0) < 1.0e-7);
-	}
-#endif
-	double largestFactor=0.0;
-	for (j=0;j<numberInArray;j++) {
-	  int indexValue=arrayRows[j];
-	  double value=arrayElements[indexValue];
-	  largestFactor = CoinMax(largestFactor,fabs(value));
-	}
-	//reducedValue=colsol[iColumn];
-	// coding from pg 130 of Wolsey 
-	// adjustment to rhs
-	double rhs=0.0;
-	int number=0;
-	// number of terms (so includes modifications and cancellations)
-	int numberCoefficients=0;
-#ifdef CGL_DEBUG_GOMORY
-	    if (!gomory_try)
-	      printf("start for basic column %d\n",iColumn);
-#endif
-	// columns
-	for (j=0;j<numberColumns;j++) {
-	  if (columnIsBasic[j]<0&&colUpper[j]>colLower[j]+testFixed) {
-	    double value=0.0;
-	    int k;
-	    // add in row of tableau
-	    for (k=columnStart[j];k<columnStart[j]+columnLength[j];k++) {
-	      iRow = row[k];
-	      double value2 = columnElements[k]*arrayElements[iRow];
-	      largestFactor = CoinMax(largestFactor,fabs(value2));
-	      value += value2;
-	    }
-#ifdef CGL_DEBUG_GOMORY
-	    if (!gomory_try&&value)
-	      printf("col %d alpha %g colsol %g swap %c bounds %g %g\n",
-		     j,value,colsol[j],swap[j] ? 'Y' : 'N',
-		     colLower[j],colUpper[j]);
-#endif
-	    // value is entry in tableau row end (C) ====
-	    if (fabs(value)<1.0e-16) {
-	      // small value
-	      continue;
-	    } else {
-	      // left in to stop over compilation?
-	      //if (iColumn==-52) printf("for basic %d, column %d has alpha %g, colsol %g\n",
-	      //		      iColumn,j,value,colsol[j]);
-#if CGL_DEBUG>1
-	      if (iColumn==52) printf("for basic %d, column %d has alpha %g, colsol %g\n",
-				      iColumn,j,value,colsol[j]);
-#endif
-	      // deal with bounds
-	      if (swap[j]) {
-		//reducedValue -= value*colUpper[j];
-		// negate
-		value = - value;
-	      } else {
-		//reducedValue -= value*colLower[j];
-	      }
-#if CGL_DEBUG>1
-	      if (iColumn==52) printf("%d value %g reduced %g int %d rhs %g swap %d\n",
-				      j,value,reducedValue,intVar[j],rhs,swap[j]);
-#endif
-	      double coefficient;
-	      if (intVar[j]) {
-		// integer
-		coefficient = above_integer(value);
-		if (coefficient > reducedValue) {
-		  coefficient = ratio * (1.0-coefficient);
-		} 
-	      } else {
-		// continuous
-		numberNonInteger++;
-		if (value > 0.0) {
-		  coefficient = value;
-		} else {
-		  //??? sign wrong in book
-		  coefficient = -ratio*value;
-		}
-	      }
-	      if (swap[j]) {
-		// negate
-		coefficient = - coefficient;
-		rhs += colUpper[j]*coefficient;
-	      } else {
-		rhs += colLower[j]*coefficient;
-	      }
-	      if (fabs(coefficient)>= COIN_INDEXED_TINY_ELEMENT) {
-		cutElement[j] = coefficient;
-		numberCoefficients++;
-		cutIndex[number++]=j;
-		// If too many - break from loop
-		if (number>limit) 
-		  break;
-	      }
-	    }
-	  } else {
-	    // basic
-	    continue;
-	  }
-	}
-	cutVector.setNumElements(number);
-	// If too many - just clear vector and skip
-	if (number>limit) {
-	  cutVector.clear();
-	  continue;
-	}
-	//check will be cut
-	//reducedValue=above_integer(reducedValue);
-	rhs += reducedValue;
-	double violation = reducedValue;
-#ifdef CGL_DEBUG
-	std::cout<<"cut has violation of "<<violation
-		 <<" value "<<colsol[iColumn]<<std::endl;
-#endif
-	// now do slacks part
-	for (j=0;j<numberInArray;j++) {
-	  iRow=arrayRows[j];
-	  double value = arrayElements[iRow];
-	  int type=rowType[iRow];
-	  if (type&&fabs(value)>=1.0e-16) {
-	    if ((type&1)==0) {
-	      // negate to get correct coefficient
-	      value = - value;
-	    }
-	    double coefficient;
-	    if ((type&4)!=0) {
-	      // integer
-	      coefficient = above_integer(value);
-	      if (coefficient > reducedValue) {
-		coefficient = ratio * (1.0-coefficient);
-	      } 
-	    } else {
-	      numberNonInteger++;
-	      // continuous
-	      if (value > 0.0) {
-		coefficient = value;
-	      } else {
-		coefficient = -ratio*value;
-	      }
-	    }
-	    if ((type&1)!=0) {
-	      // slack at ub - treat as +1.0
-	      rhs -= coefficient*rowUpper[iRow];
-	    } else {
-	      // negate yet again ?
-	      coefficient = - coefficient;
-	      rhs -= coefficient*rowLower[iRow];
-	    }
-	    int k;
-	    for (k=rowStart[iRow];
-		 k<rowStart[iRow]+rowLength[iRow];k++) {
-	      int jColumn=column[k];
-	      double value=rowElements[k];
-	      double oldValue=cutElement[jColumn];
-	      cutVector.quickAdd(jColumn,-coefficient*value);
-	      numberCoefficients++;
-	      if (!intVar[jColumn]&&!oldValue) 
-		numberNonInteger++;
-	    }
-	  }
-	}
-	//check again and pack down
-	// also change signs
-	// also zero cutElement
-	double sum=0.0;
-	rhs = - rhs;
-	int n = cutVector.getNumElements();
-	// If too many - just clear vector and skip
-	if (n>limit) {
-	  cutVector.clear();
-	  continue;
-	}
-#if MORE_GOMORY_CUTS==1||MORE_GOMORY_CUTS==3
-	double violation2=violation;
-#endif
-	number=0;
-	double sumCoefficients=0.0;
-	for (j=0;j<n;j++) {
-	  int jColumn =cutIndex[j];
-	  double value=-cutElement[jColumn];
-	  sumCoefficients += fabs(value);
-	  if (fabs(colsol[jColumn])>10.0)
-	    sumCoefficients += 2.0*fabs(value);
-	  cutElement[jColumn]=0.0;
-	  if (fabs(value)>1.0e-8) {
-	    sum+=value*colsol[jColumn];
-	    packed[number]=value;
-	    cutIndex[number++]=jColumn;
-          } else {
-#define LARGE_BOUND 1.0e20
-            // small - adjust rhs if rhs reasonable
-            if (value>0.0&&colLower[jColumn]>-LARGE_BOUND) {
-              rhs -= value*colLower[jColumn];
-#if MORE_GOMORY_CUTS==1||MORE_GOMORY_CUTS==3
-	      // weaken violation
-	      violation2 -= fabs(value*(colsol[jColumn]-colLower[jColumn]));
-#endif
-            } else if (value<0.0&&colUpper[jColumn]<LARGE_BOUND) {
-              rhs -= value*colUpper[jColumn];
-#if MORE_GOMORY_CUTS==1||MORE_GOMORY_CUTS==3
-	      // weaken violation
-	      violation2 -= fabs(value*(colsol[jColumn]-colUpper[jColumn]));
-#endif
-            } else if (fabs(value)>1.0e-13) {
-              // take anyway
-              sum+=value*colsol[jColumn];
-              packed[number]=value;
-              cutIndex[number++]=jColumn;
-            } 
-          }
-	}
-	// Final test on number
-	//if (number>limit)
-	//continue;
-	// say zeroed out
-	cutVector.setNumElements(0);
-	bool accurate2=false;
-	double difference=fabs((sum-rhs)-violation);
-	double useTolerance;
-	if (tolerance1>0.99) {
-	  // use absolute
-	  useTolerance = tolerance;
-	} else {
-	  double rhs2=CoinMax(fabs(rhs),10.0);
-	  useTolerance=rhs2*0.1*tolerance1;
-	}
-	bool accurate = (difference<useTolerance);
-#if MORE_GOMORY_CUTS==1||MORE_GOMORY_CUTS==3
-	double difference2=fabs((sum-rhs)-violation2);
-#if MORE_GOMORY_CUTS==1
-	if (difference2<useTolerance&&doSorted) 
+      else
+	factorization2->updateColumnTranspose ( &work, &array );
+#endif
+      int numberInArray=array.getNumElements();
+      CoinBigIndex put=piStart[kBlock];
+      if (put+numberInArray>maximumPi) {
+	maximumPi = 2*maximumPi+numberInArray;
+	int * tempIndex = new int [maximumPi];
+	CoinMemcpyN(piIndex,put,tempIndex);
+	delete [] piIndex;
+	piIndex = tempIndex;
+	double * tempElement = new double [maximumPi];
+	CoinMemcpyN(piElement,put,tempElement);
+	delete [] piElement;
+	piElement = tempElement;
+	gomoryInfo.piIndex = piIndex;
+	gomoryInfo.piElement = piElement;
+      }
+      for (j=0;j<numberInArray;j++) {
+	iRow=arrayRows[j];
+	piIndex[put]=iRow;
+	piElement[put++]=arrayElements[iRow];
+      }
+      piStart[kBlock+1]=put;
+      array.clear();
+    }
+    gomoryInfo.which = which+kColumn;
+    CglRunTasks(numberThreads,numberInBlock,gomoryCut,&gomoryInfo);
+    // add in order
+    for (int kBlock=0;kBlock<numberInBlock;kBlock++) {
+      OsiRowCut * rc = blockCut[kBlock];
+      if (!rc)
+	continue;
+      // if got enough then just delete
+      if (nTotalEls>0) {
+	int number = rc->row().getNumElements();
+	if (cutType[kBlock]==1) {
+#if MORE_GOMORY_CUTS<2
+	  nTotalEls -= number;
+	  cs.insert(*rc);
 #else
-	if (difference2<useTolerance&&doSorted&&number<saveLimit) 
-#endif
-	  accurate2=true;
-#endif
-	if (sum >rhs+tolerance2*away&&
-	    (accurate||accurate2)) {
-	  //#ifdef CGL_DEBUG
-#ifdef CGL_DEBUG
-#if CGL_DEBUG<=1
-	  if (number<=-10) {
-#endif
-	    for (j=0;j<number;j++) {
-	      std::cout<<" ["<<cutIndex[j]<<","<<packed[j]<<"]";
-	    }
-	    std::cout<<" <= "<<rhs<<std::endl;
-#if CGL_DEBUG<=1
-	  }
-#endif
-#endif
-	  if (!numberNonInteger&&number) {
-#ifdef CGL_DEBUG
-	    assert (sizeof(Rational)==sizeof(double));
-#endif
-	    Rational * cleaned = reinterpret_cast<Rational *> (cutElement);
-	    int * xInt = reinterpret_cast<int *> (cutElement);
-	    // cut should have an integer slack so try and simplify
-	    // add in rhs and put in cutElements (remember to zero later)
-	    cutIndex[number]=numberColumns+1;
-	    packed[number]=rhs;
-	    int numberNonSmall=0;
-	    int lcm = 1;
-	    
-	    for (j=0;j<number+1;j++) {
-	      double value=above_integer(fabs(packed[j]));
-	      if (fabs(value)<tolerance3) {
-		// too small
-		continue;
-	      } else {
-		numberNonSmall++;
-	      }
-	      
-	      cleaned[j]=nearestRational(value,100000);
-	      if (cleaned[j].denominator<0) {
-		// bad rational
-		lcm=-1;
-		break;
-	      }
-	      int thisGcd = gcd(lcm,cleaned[j].denominator);
-	      // may need to check for overflow
-	      lcm /= thisGcd;
-	      lcm *= cleaned[j].denominator;
-	    }
-	    if (lcm>0&&numberNonSmall) {
-	      double multiplier = lcm;
-	      int nOverflow = 0; 
-	      for (j=0; j<number+1;j++) {
-		double value = fabs(packed[j]);
-		double dxInt = value*multiplier;
-		xInt[j]= static_cast<int> (dxInt+0.5); 
-#if CGL_DEBUG>1
-		printf("%g => %g   \n",value,dxInt);
-#endif
-		if (dxInt>1.0e9||fabs(dxInt-xInt[j])> 1.0e-8) {
-		  nOverflow++;
-		  break;
-		}
-	      }
-	      
-	      if (nOverflow){
-#ifdef CGL_DEBUG
-		printf("Gomory Scaling: Warning: Overflow detected \n");
-#endif
-		numberNonInteger=-1;
-	      } else {
-		
-		// find greatest common divisor of the elements
-		j=0;
-		while (!xInt[j])
-		  j++; // skip zeros
-		int thisGcd = gcd(xInt[j],xInt[j+1]);
-		j++;
-		for (;j<number+1;j++) {
-		  if (xInt[j])
-		    thisGcd = gcd(thisGcd,xInt[j]);
-		}
-#if 0
-		// Check nothing too illegal - FIX this
-		for (j=0;j<number+1;j++) {
-		  double old = lcm*packed[j];
-		  int newOne;
-		  if (old>0.0)
-		    newOne=xInt[j]/thisGcd;
-		  else
-		    newOne=-xInt[j]/thisGcd;
-		  if (fabs(((double) newOne)-old)>
-		      1.0e-10*(fabs(newOne)+1.0)) {
-		    // say no good - first see if happens
-		    printf("Fix this test 456 - just skip\n");
-		    abort();
-		  }
-		} 
-#endif		  
-#if CGL_DEBUG>1
-		printf("The gcd of xInt is %i\n",thisGcd);    
-#endif
-		
-		// construct new cut by dividing through by gcd and 
-		double minMultiplier=1.0e100;
-		double maxMultiplier=0.0;
-		for (j=0; j<number+1;j++) {
-		  double old=packed[j];
-		  if (old>0.0) {
-		    packed[j]=xInt[j]/thisGcd;
-		  } else {
-		    packed[j]=-xInt[j]/thisGcd;
-		  }
-#if CGL_DEBUG>1
-		  printf("%g => %g   \n",old,packed[j]);
-#endif
-		  if (packed[j]) {
-		    if (fabs(packed[j])>maxMultiplier*fabs(old))
-		      maxMultiplier = packed[j]/old;
-		    if (fabs(packed[j])<minMultiplier*fabs(old))
-		      minMultiplier = packed[j]/old;
-		  }
-		}
-		rhs = packed[number];
-#ifdef CGL_DEBUG
-		printf("min, max multipliers - %g, %g\n",
-		       minMultiplier,maxMultiplier);
-#endif
-		assert(maxMultiplier/minMultiplier>0.9999&&maxMultiplier/minMultiplier<1.0001);
-	      }
-	    }
-	    // erase cutElement
-	    CoinFillN(cutElement,number+1,0.0);
+	  if(number<saveLimit) {
+	    nTotalEls -= number;
+	    cs.insert(*rc);
 	  } else {
-	    // relax rhs a tiny bit
-	    //#define CGL_GOMORY_OLD_RELAX
-#ifndef CGL_GOMORY_OLD_RELAX
-#if 0
-	    double rhs2=rhs;
-	    rhs2 += 1.0e-8;
-	    // relax if lots of elements for mixed gomory
-	    if (number>=20) {
-	      rhs2  += 1.0e-7*(static_cast<double> (number/20));
-	    }
-#endif
-	    rhs += 1.0e-7;
-	    if (numberCoefficients>=10||true) {
-	      rhs  += 1.0e-7*sumCoefficients+1.0e-8*numberCoefficients;
-	    }
-#if 0
-	    if (numberCoefficients>number*3)
-	    printf("old rhs %.18g new %.18g - n,nNon,nC,sumC %d,%d,%d %g\n",
-		   rhs2,rhs,number,numberNonInteger,numberCoefficients,
-		   sumCoefficients);
-#endif
-#else
-	    rhs += 1.0e-8;
-	    // relax if lots of elements for mixed gomory
-	    if (number>=20) {
-	      rhs  += 1.0e-7*(static_cast<double> (number/20));
-	    }
-#endif
-	  }
-	  // Take off tiny elements
-	  // for first pass reject
-#ifndef CGL_GOMORY_TINY_ELEMENT
-#define CGL_GOMORY_TINY_ELEMENT 1.0e-12
-#endif
-	  {
-	    int i,number2=number;
-	    number=0;
-	    double largest=0.0;
-	    double smallest=1.0e30;
-	    for (i=0;i<number2;i++) {
-	      double value=fabs(packed[i]);
-	      if (value<CGL_GOMORY_TINY_ELEMENT) {
-		int iColumn = cutIndex[i];
-		if (colUpper[iColumn]-colLower[iColumn]<LARGE_BOUND) {
-		  // weaken cut
-		  if (packed[i]>0.0) 
-		    rhs -= value*colLower[iColumn];
-		  else
-		    rhs += value*colUpper[iColumn];
-		} else {
-		  // throw away
-		  number=limit+1;
-		  numberNonInteger=1;
-		  break;
-		}
-	      } else {
-		int iColumn = cutIndex[i];
-		if (colUpper[iColumn]!=colLower[iColumn]||globalCuts) {
-		  value=fabs(value);
-		  largest=CoinMax(largest,value);
-		  smallest=CoinMin(smallest,value);
-		  cutIndex[number]=cutIndex[i];
-		  packed[number++]=packed[i];
-		} else {
-		  // fixed so subtract out
-		  rhs -= packed[i]*colLower[iColumn];
-		}
-	      }
-	    }
-	    if (largest>1.0e10*smallest||(number>20&&smallest<number*1.0e-6)) {
-	      number=limit+1; //reject
-	      numberNonInteger=1;
-	    } else if (largest>1.0e9*smallest) {
-#ifdef CLP_INVESTIGATE2
-	      printf("WOuld reject %g %g ratio %g\n",smallest,largest,
-		     smallest/largest);
-#endif
-#if MORE_GOMORY_CUTS==1||MORE_GOMORY_CUTS==3
-	      accurate=false;
-#endif
-	    } else {
-#define TRY7 2
-#define PRINT_NUMBER 0
-#if PRINT_NUMBER
-	      if (number==PRINT_NUMBER) {
-		printf("==========\n<= %.18g ",rhs);
-		for (int i=0;i<PRINT_NUMBER;i++)
-		  printf("%.18g ",packed[i]);
-		printf("\n");
-	      }
-#endif
-	      if (number>limit)  
-		continue;
-#if TRY7==1
-	      // Just scale
-	      double multiplier = 1.0/sqrt(largest*smallest);
-	      for (int i=0;i<number;i++)
-		packed[i] *= multiplier;
-	      rhs *= multiplier;
-	      if (number==PRINT_NUMBER) {
-		printf("multiplier %g %g %g\n",
-		       multiplier,smallest,largest);
-	      }
-#elif TRY7==2
-	      // Look at ratio
-	      double scaleFactor=fabs(rhs);
-	      for (int i=0;i<number;i++) {
-		double value=packed[i];
-		double ratio = fabs(rhs/value);
-		double nearest=floor(ratio+0.5);
-		if (fabs(ratio-nearest)<1.0e-6 && nearest >= 1.0) {
-		  int iColumn=cutIndex[i];
-		  if (intVar[iColumn]) {
-		    if (colLower[iColumn]>=0.0) {
-		      if (value>0.0) {
-			// better if smaller
-			if (ratio>nearest) {
-			  packed[i]=scaleFactor/nearest;
-			}			  
-		      } else {
-			// better if larger
-			if (ratio<nearest) {
-			  packed[i]=-scaleFactor/nearest;
-			}			  
-		      }
-		      //if (value!=packed[i])
-		      //printf("column %d rhs %.18g element %g ratio %.18g - new element %.18g\n",
-		      //       iColumn,rhs,value,ratio,packed[i]);
-		      //assert (fabs(value-packed[i])<1.0e-4);
-		    } else {
-		      printf("column %d rhs %g element %g ratio %.18g - bounds %g,%g\n",
-			     iColumn,rhs,value,ratio,colLower[iColumn],colUpper[iColumn]);
-		    }
-		  }
-		}
-	      }
-#endif
-#if PRINT_NUMBER
-	      if (number==PRINT_NUMBER) {
-		printf("after %.18g ",rhs);
-		for (int i=0;i<PRINT_NUMBER;i++)
-		  printf("%.18g ",packed[i]);
-		printf("\n");
-	      }
-#endif
-	    }
+	    longCuts.insert(*rc);
 	  }
-	  if (number<limit||!numberNonInteger) {
-	    bounds[1]=rhs;
-	    if (number>50&&numberNonInteger)
-	      bounds[1] = rhs+tolerance6+1.0e-8*fabs(rhs); // weaken
-	    double test = CoinMin(largestFactor*largestFactorMultiplier_,
-				  relaxation);
-	    if (number>5&&numberNonInteger&&test>1.0e-20) {
-#ifdef CLP_INVESTIGATE2
-	      printf("relaxing rhs by %g - largestFactor was %g, rel %g\n",
-	         CoinMin(test*fabs(rhs),tolerance9),largestFactor,relaxation);
 #endif
-	      //bounds[1] = CoinMax(bounds[1],
-	      //		  rhs+CoinMin(test*fabs(rhs),tolerance9)); // weaken
-	      bounds[1] = bounds[1]+CoinMin(test*fabs(rhs),tolerance9); // weaken
-	    }
-#ifdef MORE_GOMORY_CUTS
-	    if (accurate) {
-#else
-	    {
-#endif
-	      OsiRowCut rc;
-	      rc.setRow(number,cutIndex,packed,false);
-	      rc.setLb(bounds[0]);
-	      rc.setUb(bounds[1]);   
-#if MORE_GOMORY_CUTS<2
-	      nTotalEls -= number;
-	      cs.insert(rc);
-#else
-	      if(number<saveLimit) {
-		nTotalEls -= number;
-		cs.insert(rc);
-	      } else {
-		longCuts.insert(rc);
-	      }
-#endif
-	      //printf("nTot %d kCol %d iCol %d ibasic %d\n",
-	      //     nTotalEls,kColumn,iColumn,iBasic);
-	      numberAdded++;
+	  numberAdded++;
 #if MORE_GOMORY_CUTS==1||MORE_GOMORY_CUTS==3
-	    } else if (accurate2) {
-	      OsiRowCut rc;
-	      rc.setRow(number,cutIndex,packed,false);
-	      rc.setLb(bounds[0]);
-	      rc.setUb(bounds[1]);   
-	      secondaryCuts.insert(rc);
-#endif
-	    }
-	  } else {
-#ifdef CGL_DEBUG
-	    std::cout<<"cut has "<<number<<" entries - skipped"
-		     <<std::endl;
-	    if (!number)
-	      std::cout<<"******* Empty cut - infeasible"<<std::endl;
-#endif
-	  }
 	} else {
-	  // why dropped?
-#ifdef CGL_DEBUG
-	  std::cout<<"first violation "<<violation<<" now "
-		   <<sum-rhs<<" why?, rhs= "<<rhs<<std::endl;
-	  
-	  for (j=0;j<number;j++) {
-	    int jColumn =cutIndex[j];
-	    double value=packed[j];
-	    std::cout<<"("<<jColumn<<","<<value<<","<<colsol[jColumn]
-		     <<") ";
-	  }
-	  std::cout<<std::endl;
-	  //abort();
-#endif
-	}
-      }
-    } else {
-      // not basic
-#if CGL_DEBUG>1
-      {
-	// put column into array
-	array.setVector(columnLength[iColumn],row+columnStart[iColumn],
-			columnElements+columnStart[iColumn]);
-	// get column in tableau
-#ifdef CLP_OSL
-	if (!alternateFactorization_)
-#endif
-	  factorization.updateColumn ( &work, &array );
-#ifdef CLP_OSL
-	else
-	  factorization2->updateColumn ( &work, &array );
+	  secondaryCuts.insert(*rc);
 #endif
-	int numberInArray=array.getNumElements();
-	printf("non-basic %d\n",iColumn);
-	for (int j=0;j<numberInArray;j++) {
-	  int indexValue=arrayRows[j];
-	  double value=arrayElements[indexValue];
-	  if (fabs(value)>1.0e-6) {
-	    printf("%d %g\n",indexValue,value);
-	  }
 	}
       }
-#endif
+      delete rc;
     }
+    kColumn += numberInBlock;
   }
+  for (i=1;i<numberThreads;i++)
+    delete [] threadPacked[i];
+  delete [] threadPacked;
+  delete [] threadArray;
+  delete [] cutVector;
+  delete [] piStart;
+  delete [] piIndex;
+  delete [] piElement;
+  delete [] blockCut;
+  delete [] cutType;
 #ifdef CLP_OSL
   delete factorization2;
 #endif
@@ -1648,7 +1866,9 @@ limit_(50),
 limitAtRoot_(0),
 dynamicLimitInTree_(-1),
 alternateFactorization_(0),
-gomoryType_(0)
+gomoryType_(0),
+numberThreads_(1),
+tableauProvider_(NULL)
 {
 
 }
@@ -1667,7 +1887,9 @@ CglGomory::CglGomory (const CglGomory & source) :
   limitAtRoot_(source.limitAtRoot_),
   dynamicLimitInTree_(source.dynamicLimitInTree_),
   alternateFactorization_(source.alternateFactorization_),
-  gomoryType_(source.gomoryType_)
+  gomoryType_(source.gomoryType_),
+  numberThreads_(source.numberThreads_),
+  tableauProvider_(source.tableauProvider_)
 { 
   if (source.originalSolver_)
     originalSolver_ = source.originalSolver_->clone();
@@ -1707,6 +1929,8 @@ CglGomory::operator=(const CglGomory& rhs)
     dynamicLimitInTree_ = rhs.dynamicLimitInTree_;
     alternateFactorization_=rhs.alternateFactorization_; 
     gomoryType_ = rhs.gomoryType_;
+    numberThreads_ = rhs.numberThreads_;
+    tableauProvider_ = rhs.tableauProvider_;
     delete originalSolver_;
     if (rhs.originalSolver_)
       originalSolver_ = rhs.originalSolver_->clone();
@@ -10,6 +10,7 @@
 #include "CglCutGenerator.hpp"
 
 class CoinWarmStartBasis;
+class CglTableauProvider;
 /** Gomory Cut Generator Class */
 class CglGomory : public CglCutGenerator {
    friend void CglGomoryUnitTest(const OsiSolverInterface * siP,
@@ -131,6 +132,20 @@ public:
    /// Get whether alternative factorization being used
    inline bool alternativeFactorization() const
    { return (alternateFactorization_!=0);} 
+   /** Set shared factorization and tableau rows (not owned, NULL
+       for own factorization).  Not used with alternative factorization */
+   inline void setTableauProvider(CglTableauProvider * provider)
+   { tableauProvider_=provider;}
+   /// Get shared factorization and tableau rows
+   inline CglTableauProvider * tableauProvider() const
+   { return tableauProvider_;}
+   /** Set number of threads to use for deriving cuts from rows of
+       tableau (default 1).  Cuts are the same whatever the number of threads */
+   inline void setNumberThreads(int value)
+   { numberThreads_=value;}
+   /// Get number of threads
+   inline int numberThreads() const
+   { return numberThreads_;}
   //@}
 
   /**@name Constructors and destructors */
@@ -189,6 +204,10 @@ private:
   int alternateFactorization_;
   /// Type - 0 normal, 1 add original matrix one, 2 replace
   int gomoryType_;
+  /// Number of threads to use
+  int numberThreads_;
+  /// Shared factorization and tableau rows (not owned)
+  CglTableauProvider * tableauProvider_;
   //@}
 };
 
@@ -15,6 +15,7 @@
 #include "OsiCuts.hpp"
 #include "CoinWarmStartBasis.hpp"
 #include "CglGomory.hpp"
+#include "CglTableauProvider.hpp"
 
 
 //--------------------------------------------------------------------------
@@ -1482,6 +1483,54 @@ CglGomoryUnitTest(
     int nRowCuts = cuts.sizeRowCuts();
     std::cout<<"There are "<<nRowCuts<<" Gomory cuts"<<std::endl;
     assert(cuts.sizeRowCuts() > 0);
+
+    // Same cuts with shared tableau provider - factorized once
+    {
+      CglTableauProvider provider;
+      CglGomory test2(test);
+      test2.setTableauProvider(&provider);
+      OsiCuts cuts2;
+      test2.generateCuts(*siP,cuts2);
+      assert (cuts2.sizeRowCuts()==nRowCuts);
+      OsiCuts cuts3;
+      test2.generateCuts(*siP,cuts3);
+      assert (cuts3.sizeRowCuts()==nRowCuts);
+      assert (provider.numberFactorizations()==1);
+      assert (provider.numberRowsReused()>0);
+      // rows of B^-1 A done in batch same as one at a time
+      CglTableauProvider provider2;
+      assert (!provider2.factorize(*siP));
+      int numberRows = provider.numberRows();
+      int * which = new int [numberRows];
+      for (int i=0;i<numberRows;i++)
+	which[i]=i;
+      provider.computeBInvARows(numberRows,which);
+      CoinIndexedVector row1;
+      CoinIndexedVector row2;
+      for (int i=0;i<numberRows;i++) {
+	int n1 = provider.getBInvARow(i,row1);
+	int n2 = provider2.getBInvARow(i,row2);
+	assert (n1==n2);
+	for (int k=0;k<n1;k++) {
+	  int iColumn = row1.getIndices()[k];
+	  assert (eq(row1.denseVector()[iColumn],row2.denseVector()[iColumn]));
+	}
+	row1.clear();
+	row2.clear();
+      }
+      delete [] which;
+    }
+    // Same cuts whatever number of threads (without CGL_THREAD
+    // candidates are still split into blocks and per thread workspace)
+    for (int numberThreads=2;numberThreads<=8;numberThreads*=2) {
+      CglGomory test2(test);
+      test2.setNumberThreads(numberThreads);
+      OsiCuts cuts2;
+      test2.generateCuts(*siP,cuts2);
+      assert (cuts2.sizeRowCuts()==nRowCuts);
+      for (int i=0;i<nRowCuts;i++)
+	assert (cuts2.rowCut(i)==cuts.rowCut(i));
+    }
     OsiSolverInterface::ApplyCutsReturnCode rc = siP->applyCuts(cuts);
     
     siP->resolve();
@@ -10,6 +10,7 @@
 //---------------------------------------------------------------------------
 #include "CglLandP.hpp"
 #include "CglLandPSimplex.hpp"
+#include "CglThreads.hpp"
 
 #define INT_INFEAS(value) fabs(value - floor(value+0.5))
 
@@ -65,7 +66,8 @@ CglLandP::Parameters::Parameters():
         rhsWeightType(Fixed),
         lhs_norm(L1),
         generateExtraCuts(none),
-        pivotSelection(mostNegativeRc)
+        pivotSelection(mostNegativeRc),
+        usePivotHistory(false)
 {
     EPS = 1e-08;
 }
@@ -93,7 +95,8 @@ CglLandP::Parameters::Parameters(const Parameters &other):
         rhsWeightType(other.rhsWeightType),
         lhs_norm(other.lhs_norm),
         generateExtraCuts(other.generateExtraCuts),
-        pivotSelection(other.pivotSelection)
+        pivotSelection(other.pivotSelection),
+        usePivotHistory(other.usePivotHistory)
 {}
 
 CglLandP::Parameters & CglLandP::Parameters::operator=(const Parameters &other)
@@ -123,6 +126,7 @@ CglLandP::Parameters & CglLandP::Parameters::operator=(const Parameters &other)
         lhs_norm = other.lhs_norm;
         generateExtraCuts = other.generateExtraCuts;
         pivotSelection = other.pivotSelection;
+        usePivotHistory = other.usePivotHistory;
     }
     return *this;
 }
@@ -424,7 +428,11 @@ CglLandP::CglLandP(const CglLandP::Parameters &params,
         params_(params), cached_(), validator_(validator), numcols_(-1),
         originalColLower_(NULL), originalColUpper_(NULL),
         canLift_(false),
-        extraCuts_()
+        extraCuts_(),
+        numberThreads_(1),
+        pivotHistory_(),
+        historyNumCols_(-1),
+        numberReplayedPivots_(0)
 {
     handler_ = new CoinMessageHandler();
     handler_->setLogLevel(0);
@@ -447,7 +455,11 @@ CglLandP::CglLandP(const CglLandP & source):
         validator_(source.validator_), numcols_(source.numcols_),
         originalColLower_(NULL), originalColUpper_(NULL),
         canLift_(source.canLift_),
-        extraCuts_(source.extraCuts_)
+        extraCuts_(source.extraCuts_),
+        numberThreads_(source.numberThreads_),
+        pivotHistory_(source.pivotHistory_),
+        historyNumCols_(source.historyNumCols_),
+        numberReplayedPivots_(source.numberReplayedPivots_)
 {
     handler_ = new CoinMessageHandler();
     handler_->setLogLevel(source.handler_->logLevel());
@@ -473,6 +485,10 @@ CglLandP& CglLandP::operator=(const CglLandP &rhs)
         cached_ = rhs.cached_;
         validator_ = rhs.validator_;
         extraCuts_ = rhs.extraCuts_;
+        numberThreads_ = rhs.numberThreads_;
+        pivotHistory_ = rhs.pivotHistory_;
+        historyNumCols_ = rhs.historyNumCols_;
+        numberReplayedPivots_ = rhs.numberReplayedPivots_;
     }
     return *this;
 }
@@ -519,6 +535,26 @@ CglLandP::scanExtraCuts(OsiCuts& cs, const double * colsol) const
     //  std::cout<<"Added "<<numAdded<<" previously generated cuts."<<std::endl;
 }
 
+/* Shared by tasks separating fractional variables in parallel */
+typedef struct
+{
+    const CglLandP * generator;
+    const OsiSolverInterface * si;
+    const OsiSolverInterface * t_si;
+    /* row of variable separated by each task */
+    const int * rows;
+    /* simplex, validator and parameters for each thread */
+    LAP::CglLandPSimplex ** simplex;
+    LAP::Validator * validators;
+    CglLandP::Parameters * params;
+    /* cut, rejection code and code of failed cut for each task */
+    OsiRowCut ** cuts;
+    int * codes;
+    int * failedCodes;
+    /* pivots of each variable at last round (NULL if not kept) */
+    std::vector<CglLandP::Pivot> * history;
+} CglLandPSeparateInfo;
+
 void
 CglLandP::generateCuts(const OsiSolverInterface & si, OsiCuts & cs,
                        const CglTreeInfo info )
@@ -593,79 +629,146 @@ CglLandP::generateCuts(const OsiSolverInterface & si, OsiCuts & cs,
     params_.timeLimit += CoinCpuTime();
     CoinRelFltEq eq(1e-04);
 
-    for (unsigned int i = 0; i < indices.size() && nCut < params.maxCutPerRound &&
-            nCut < cached_.nBasics_ ; i++)
+    // Pivots giving the cut of each variable are kept from round to round
+    // (indexed by variable, structurals first then slacks)
+    std::vector<Pivot> * history = NULL;
+    if (params.usePivotHistory && params.pivotLimit != 0)
     {
-
-        //Check for time limit
-        int iRow = indices[i];
-        assert(iRow < numrows);
-        OsiRowCut cut;
-        int code=1;
-        OsiSolverInterface * ncSi = NULL;
-
-        if (params.pivotLimit != 0)
-        {
-            ncSi = t_si->clone();
-            landpSi.setSi(ncSi);
-            ncSi->setDblParam(OsiDualObjectiveLimit, COIN_DBL_MAX);
-            ncSi->messageHandler()->setLogLevel(0);
-        }
-
-        int generated = 0;
-        if (params.pivotLimit == 0)
+        if (((info.pass == 0) && !info.inTree) ||
+                t_si->getNumCols() != historyNumCols_)
         {
-            generated = landpSi.generateMig(iRow, cut, params);
+            pivotHistory_.clear();
+            historyNumCols_ = t_si->getNumCols();
         }
-        else
+        unsigned int numVars = t_si->getNumCols() + t_si->getNumRows();
+        if (pivotHistory_.size() < numVars)
+            pivotHistory_.resize(numVars);
+        if (numVars)
+            history = &pivotHistory_[0];
+    }
+
+    // Variables can be separated in parallel when each one only depends on
+    // the starting basis (pivots are done on a copy of the solver and no
+    // extra cuts are shared between variables)
+    int numberThreads = 1;
+    if (params.pivotLimit != 0 && params.generateExtraCuts == CglLandP::none)
+        numberThreads = CglNumberThreads(numberThreads_,
+                                         static_cast<int>(indices.size()));
+    if (numberThreads > 1)
+    {
+        // One simplex (and validator to count rejections) per thread
+        LAP::CglLandPSimplex ** simplex =
+            new LAP::CglLandPSimplex * [numberThreads];
+        LAP::Validator * validators = new LAP::Validator[numberThreads];
+        std::vector<Parameters> threadParams(numberThreads, params);
+        for (int iThread = 0 ; iThread < numberThreads ; iThread++)
         {
-            generated = landpSi.optimize(iRow, cut, cached_, params);
-            if (params.generateExtraCuts == CglLandP::AllViolatedMigs)
-            {
-                landpSi.genThisBasisMigs(cached_, params);
-            }
-            landpSi.resetSolver(cached_.basis_);
+            validators[iThread] = validator_;
+            validators[iThread].resetRejections();
+            simplex[iThread] = new LAP::CglLandPSimplex(*t_si, cached_,
+                    threadParams[iThread], validators[iThread]);
+            simplex[iThread]->setLogLevel(handler_->logLevel());
         }
-        code = 0;
-        if (generated)
-            code = validator_(cut, cached_.colsol_, si, params, originalColLower_, originalColUpper_);
-        if (!generated || code)
+        // Variables are done in blocks of at most as many as cuts still
+        // wanted, so that exactly the same variables are tried as in serial
+        int maxBlock = std::min(params.maxCutPerRound, cached_.nBasics_);
+        maxBlock = std::max(std::min(maxBlock,
+                                     static_cast<int>(indices.size())), 1);
+        OsiRowCut ** cuts = new OsiRowCut * [maxBlock];
+        int * codes = new int[maxBlock];
+        int * failedCodes = new int[maxBlock];
+        CglLandPSeparateInfo sepInfo;
+        sepInfo.generator = this;
+        sepInfo.si = &si;
+        sepInfo.t_si = t_si;
+        sepInfo.simplex = simplex;
+        sepInfo.validators = validators;
+        sepInfo.params = &threadParams[0];
+        sepInfo.cuts = cuts;
+        sepInfo.codes = codes;
+        sepInfo.failedCodes = failedCodes;
+        sepInfo.history = history;
+        unsigned int next = 0;
+        while (next < indices.size() && nCut < params.maxCutPerRound &&
+                nCut < cached_.nBasics_)
         {
-            if (params.pivotLimit !=0)
+            int numberTasks = std::min(params.maxCutPerRound - nCut,
+                                       cached_.nBasics_ - nCut);
+            numberTasks = std::min(numberTasks,
+                                   static_cast<int>(indices.size() - next));
+            sepInfo.rows = &indices[next];
+            CglRunTasks(numberThreads, numberTasks, separateTask, &sepInfo);
+            // Merge in order of variables
+            LAP::Cuts blockCuts;
+            blockCuts.resize(numberTasks);
+            for (int iTask = 0 ; iTask < numberTasks ; iTask++)
             {
-                handler_->message(LAP_CUT_FAILED_DO_MIG, messages_)<<validator_.failureString(code)<<CoinMessageEol;
-                landpSi.freeSi();
-                OsiSolverInterface * ncSi = t_si->clone();
-                landpSi.setSi(ncSi);
-                params.pivotLimit = 0;
-                if (landpSi.optimize(iRow, cut, cached_, params))
+                if (failedCodes[iTask] >= 0)
+                {
+                    handler_->message(LAP_CUT_FAILED_DO_MIG, messages_)<<
+                    validator_.failureString(failedCodes[iTask])<<CoinMessageEol;
+                }
+                if (codes[iTask])
+                {
+                    handler_->message(CUT_REJECTED, messages_)<<
+                    validator_.failureString(codes[iTask])<<CoinMessageEol;
+                    delete cuts[iTask];
+                }
+                else
                 {
-                    code = validator_(cut, cached_.colsol_, si, params, originalColLower_, originalColUpper_);
+                    blockCuts.insert(iTask, cuts[iTask]);
                 }
-                params.pivotLimit = params_.pivotLimit;
             }
+            nCut += blockCuts.insertAll(cs, eq);
+            next += numberTasks;
         }
-
-        if (params.pivotLimit != 0)
+        for (int iThread = 0 ; iThread < numberThreads ; iThread++)
         {
-            landpSi.freeSi();
-        }
-        if (code)
-        {
-            handler_->message(CUT_REJECTED, messages_)<<
-            validator_.failureString(code)<<CoinMessageEol;
+            validator_.addRejections(validators[iThread]);
+            landpSi.addPivInfo(*simplex[iThread]);
+            delete simplex[iThread];
         }
-        else
+        delete [] simplex;
+        delete [] validators;
+        delete [] cuts;
+        delete [] codes;
+        delete [] failedCodes;
+    }
+    else
+    {
+        for (unsigned int i = 0; i < indices.size() &&
+                nCut < params.maxCutPerRound && nCut < cached_.nBasics_ ; i++)
         {
-            if (canLift_)
+
+            //Check for time limit
+            int iRow = indices[i];
+            assert(iRow < numrows);
+            OsiRowCut cut;
+            int failedCode;
+            int code = separate(landpSi, validator_, si, t_si, iRow, params,
+                                cut, failedCode,
+                                history ? history + cached_.basics_[iRow] : NULL);
+            if (failedCode >= 0)
             {
-                cut.setGloballyValid(true);
+                handler_->message(LAP_CUT_FAILED_DO_MIG, messages_)<<validator_.failureString(failedCode)<<CoinMessageEol;
             }
-            cs.insertIfNotDuplicate(cut, eq);
-            //cs.insert(cut);
+            if (code)
             {
-                //std::cout<<"Violation "<<cut.violated(cached_.colsol_)<<std::endl;
-                nCut++;
+                handler_->message(CUT_REJECTED, messages_)<<
+                validator_.failureString(code)<<CoinMessageEol;
+            }
+            else
+            {
+                if (canLift_)
+                {
+                    cut.setGloballyValid(true);
+                }
+                cs.insertIfNotDuplicate(cut, eq);
+                //cs.insert(cut);
+                {
+                    //std::cout<<"Violation "<<cut.violated(cached_.colsol_)<<std::endl;
+                    nCut++;
+                }
             }
         }
     }
@@ -692,6 +795,7 @@ CglLandP::generateCuts(const OsiSolverInterface & si, OsiCuts & cs,
         delete cut;
     }
 
+    numberReplayedPivots_ = landpSi.numReplayedPivots();
     landpSi.outPivInfo(nCut);
     params_.timeLimit -= CoinCpuTime();
 
@@ -703,6 +807,101 @@ CglLandP::generateCuts(const OsiSolverInterface & si, OsiCuts & cs,
 }
 
 
+/** Separate variable basic in row iRow with landpSi (from the starting basis)
+    and validate the cut.  Returns 0 if cut is good or the rejection code,
+    failedCode is set if a MIG had to be generated instead of the lift-and-project
+    cut (to the rejection code of that cut) and is -1 otherwise.*/
+int
+CglLandP::separate(LAP::CglLandPSimplex & landpSi, LAP::Validator & validator,
+                   const OsiSolverInterface & si,
+                   const OsiSolverInterface * t_si, int iRow,
+                   Parameters & params, OsiRowCut & cut,
+                   int & failedCode,
+                   std::vector<Pivot> * history) const
+{
+    int code=1;
+    failedCode = -1;
+    OsiSolverInterface * ncSi = NULL;
+
+    if (params.pivotLimit != 0)
+    {
+        ncSi = t_si->clone();
+        landpSi.setSi(ncSi);
+        ncSi->setDblParam(OsiDualObjectiveLimit, COIN_DBL_MAX);
+        ncSi->messageHandler()->setLogLevel(0);
+    }
+
+    int generated = 0;
+    if (params.pivotLimit == 0)
+    {
+        generated = landpSi.generateMig(iRow, cut, params);
+    }
+    else
+    {
+        generated = landpSi.optimize(iRow, cut, cached_, params, history);
+        if (params.generateExtraCuts == CglLandP::AllViolatedMigs)
+        {
+            landpSi.genThisBasisMigs(cached_, params);
+        }
+        landpSi.resetSolver(cached_.basis_);
+    }
+    code = 0;
+    if (generated)
+        code = validator(cut, cached_.colsol_, si, params, originalColLower_, originalColUpper_);
+    if (history != NULL)
+    {
+        if (generated && !code)
+            *history = landpSi.pivots();
+        else
+            history->clear();
+    }
+    if (!generated || code)
+    {
+        if (params.pivotLimit !=0)
+        {
+            failedCode = code;
+            landpSi.freeSi();
+            OsiSolverInterface * ncSi = t_si->clone();
+            landpSi.setSi(ncSi);
+            params.pivotLimit = 0;
+            if (landpSi.optimize(iRow, cut, cached_, params))
+            {
+                code = validator(cut, cached_.colsol_, si, params, originalColLower_, originalColUpper_);
+            }
+            params.pivotLimit = params_.pivotLimit;
+        }
+    }
+
+    if (params.pivotLimit != 0)
+    {
+        landpSi.freeSi();
+    }
+    return code;
+}
+
+/** Separate one fractional variable (task for CglRunTasks) */
+void
+CglLandP::separateTask(void * voidInfo, int iTask, int iThread)
+{
+    CglLandPSeparateInfo * info =
+        reinterpret_cast<CglLandPSeparateInfo *> (voidInfo);
+    const CglLandP & generator = *info->generator;
+    OsiRowCut * cut = new OsiRowCut;
+    info->codes[iTask] =
+        generator.separate(*info->simplex[iThread], info->validators[iThread],
+                           *info->si, info->t_si, info->rows[iTask],
+                           info->params[iThread], *cut,
+                           info->failedCodes[iTask],
+                           info->history ?
+                           info->history + generator.cached_.basics_[info->rows[iTask]] :
+                           NULL);
+    if (generator.canLift_)
+    {
+        cut->setGloballyValid(true);
+    }
+    info->cuts[iTask] = cut;
+}
+
 template < class S, class T, class U >
 class StableCompare
 {
@@ -102,6 +102,15 @@ public:
         Fixed = 0 /** 2*initial number of constraints. */,
         Dynamic /** 2 * current number of constraints. */
     };
+    /** A pivot of the lift-and-project simplex (indices of entering and
+        leaving variables, direction is 1 if leaving variable goes to its
+        upper bound and -1 otherwise).*/
+    struct Pivot
+    {
+        int incoming;
+        int leaving;
+        int direction;
+    };
     /** Class storing parameters.
         \remark I take all parameters from Ionut's code */
     class Parameters : public CglParam
@@ -158,7 +167,11 @@ public:
         bool countMistakenRc;
         /** Work in the reduced space (only non-structurals enter the basis) */
         SeparationSpaces sepSpace;
-        /** Apply perturbation procedure. */
+        /** Apply perturbation procedure.  Random numbers for perturbation
+            are drawn from a generator reseeded for each variable, so cuts
+            do not depend on the number of threads; as they are no longer
+            drawn from CoinDrand48(), cuts with perturb differ from those
+            of previous releases (even on one thread).*/
         bool perturb;
         /** How to weight normalization.*/
         Normalization normalization;
@@ -170,6 +183,10 @@ public:
         ExtraCutsMode generateExtraCuts;
         /** Which rule to apply for choosing entering and leaving variables.*/
         SelectionRules pivotSelection;
+        /** Replay the pivots which gave the cut for a variable at previous
+            round before pivoting.
+          \default false */
+        bool usePivotHistory;
         ///@}
     };
 
@@ -230,6 +247,23 @@ public:
     {
         return params_;
     }
+    /** Set number of threads used to separate fractional variables (only
+        used if compiled with CGL_THREAD, and only when pivoting without
+        extra cuts). Cuts are the same whatever the number.*/
+    void setNumberThreads(int value)
+    {
+        numberThreads_ = value;
+    }
+    int numberThreads() const
+    {
+        return numberThreads_;
+    }
+    /** Number of pivots replayed from the pivot history at last call to
+        generateCuts (only non zero if params_.usePivotHistory is set).*/
+    int numberReplayedPivots() const
+    {
+        return numberReplayedPivots_;
+    }
 private:
 
 
@@ -279,6 +313,18 @@ private:
     void getSortedFractionalIndices(std::vector<int>& indices,
                                     const CachedData &data,
                                     const CglLandP::Parameters & params) const;
+    /** Separate variable basic in row iRow from starting basis and validate
+        the cut. Returns 0 if cut is good or the rejection code.
+        If history is not NULL pivots in it are replayed first and it is
+        replaced by the pivots giving the cut (or emptied).*/
+    int separate(LAP::CglLandPSimplex & landpSi, LAP::Validator & validator,
+                 const OsiSolverInterface & si,
+                 const OsiSolverInterface * t_si, int iRow,
+                 Parameters & params, OsiRowCut & cut,
+                 int & failedCode,
+                 std::vector<Pivot> * history) const;
+    /** Separate one fractional variable (task for CglRunTasks).*/
+    static void separateTask(void * info, int iTask, int iThread);
     /** Cached informations about problem.*/
     CachedData cached_;
     /** message handler */
@@ -299,6 +345,18 @@ private:
     bool canLift_;
     /** Store some extra cut which could be cheaply generated but do not cut current incumbent.*/
     OsiCuts extraCuts_;
+    /** Number of threads to separate variables with (only used if compiled
+        with CGL_THREAD).*/
+    int numberThreads_;
+    /** Pivots which gave the cut of each variable (structurals then slacks)
+        at last round (empty if none, only used if params_.usePivotHistory
+        is set).*/
+    std::vector< std::vector<Pivot> > pivotHistory_;
+    /** Number of columns of the problem pivotHistory_ is for.*/
+    int historyNumCols_;
+    /** Number of pivots replayed from pivotHistory_ at last call to
+        generateCuts.*/
+    int numberReplayedPivots_;
 };
 void CglLandPUnitTest(OsiSolverInterface *si, const std::string & mpsDir);
 
@@ -211,7 +211,7 @@ CglLandPSimplex::CglLandPSimplex(const OsiSolverInterface &si,
         col_in_subspace(),
         colCandidateToLeave_(NULL),
         basics_(NULL), nonBasics_(NULL),
-        M1_(), M2_(), M3_(),
+        M1_(), M2_(), M3_(), m3AbsSum_(0), m3NegSum_(0), m3PosSum_(0),
         sigma_(0), basis_(NULL), colsolToCut_(NULL),
         colsol_(NULL),
         ncols_orig_(0),nrows_orig_(0),
@@ -222,7 +222,10 @@ CglLandPSimplex::CglLandPSimplex(const OsiSolverInterface &si,
         validator_(validator),
         numPivots_(0),
         numSourceRowEntered_(0),
-        numIncreased_(0)
+        numIncreased_(0),
+        numReplayed_(0),
+        pivots_(),
+        randomNumberGenerator_(987654321)
 {
     ncols_orig_ = si.getNumCols();
     nrows_orig_ = si.getNumRows();
@@ -616,7 +619,8 @@ CglLandPSimplex::generateMig(int row, OsiRowCut & cut,
 
 bool
 CglLandPSimplex::optimize
-(int row, OsiRowCut & cut,const CglLandP::CachedData &cached,const CglLandP::Parameters & params)
+(int row, OsiRowCut & cut,const CglLandP::CachedData &cached,const CglLandP::Parameters & params,
+ const std::vector<CglLandP::Pivot> * history)
 {
     bool optimal = false;
     int nRowFailed = 0;
@@ -631,6 +635,7 @@ CglLandPSimplex::optimize
     CoinCopyN(cached.nonBasics_, ncols_, nonBasics_);
     CoinCopyN(cached.colsol_, nrows_+ ncols_, colsol_);
     CoinCopyN(cached.colsol_, nrows_+ ncols_, colsolToCut_);
+    randomNumberGenerator_.setSeed(987654321);
 
     delete basis_;
     basis_ = new CoinWarmStartBasis(*cached.basis_);
@@ -692,12 +697,22 @@ CglLandPSimplex::optimize
     bool allowDegeneratePivot = numberConsecutiveDegenerate < params.degeneratePivotLimit;
     bool beObstinate = 0;
     int numPivots = 0;
+    int numReplayed = 0;
     int saveNumSourceEntered = numSourceRowEntered_;
     int saveNumIncreased = numIncreased_;
     int numCycle = 0;
     int numFailedPivots = 0;
     bool hasFlagedRow = false;
     int maxTryRow = 5;
+    pivots_.clear();
+    if (history != NULL && !history->empty())
+    {
+        numReplayed = replayPivots(*history, params);
+        if (numReplayed < 0)
+            return 0;
+        numPivots = numReplayed;
+        numReplayed_ += numReplayed;
+    }
     while (  !optimal && numPivots < params.pivotLimit)
     {
         if (timeLimit - CoinCpuTime() < 0.) break;
@@ -709,7 +724,7 @@ CglLandPSimplex::optimize
         int leaving = -1;
         int incoming = -1;
         double bestSigma;
-        if (params.pivotSelection != CglLandP::initialReducedCosts || numPivots == 0)
+        if (params.pivotSelection != CglLandP::initialReducedCosts || numPivots == numReplayed)
         {
             leaving = fastFindCutImprovingPivotRow(direction, gammaSign, params.pivotTol,
                                                    params.pivotSelection == CglLandP::initialReducedCosts);
@@ -720,7 +735,7 @@ CglLandPSimplex::optimize
             if (leaving >= 0)
             {
                 if (params.pivotSelection == CglLandP::mostNegativeRc ||
-                        (params.pivotSelection == CglLandP::initialReducedCosts && numPivots == 0))
+                        (params.pivotSelection == CglLandP::initialReducedCosts && numPivots == numReplayed))
                 {
 
                     if (params.pivotSelection == CglLandP::initialReducedCosts)
@@ -759,15 +774,15 @@ CglLandPSimplex::optimize
         }
         else if (params.pivotSelection == CglLandP::initialReducedCosts)
         {
-            assert(numPivots > 0);
+            assert(numPivots > numReplayed);
             while (incoming < 0 && !optimal)   // if no improving was found rescan the tables of reduced cost to find a good one
             {
                 if (!hasFlagedRow)
                     hasFlagedRow = true;
                 leaving = rescanReducedCosts(direction, gammaSign, params.pivotTol);
-                rowFlags_[leaving] = false;
                 if (leaving >= 0)
                 {
+                    rowFlags_[leaving] = false;
                     incoming = fastFindBestPivotColumn(direction, gammaSign,
                                                        params.pivotTol,
                                                        params.away,
@@ -808,7 +823,7 @@ CglLandPSimplex::optimize
                                             fabs(gamma) < 1e-05));
 #endif
 
-                std::pair<int, int> cur_pivot(nonBasics_[incoming],basics_[leaving]);
+                CglLandP::Pivot curPivot = {nonBasics_[incoming], basics_[leaving], direction};
 
                 bool pivoted = changeBasis(incoming,leaving,direction,
 #ifndef OLD_COMPUTATION
@@ -827,6 +842,7 @@ CglLandPSimplex::optimize
                 if (pivoted)
                 {
                     numPivots++;
+                    pivots_.push_back(curPivot);
 
                     double lastSigma = sigma_;
                     if (params.modularize)
@@ -931,6 +947,91 @@ CglLandPSimplex::optimize
 }
 
 
+/** Replay pivots of history (done for the same variable at previous round)
+    while the variables are still in the right place and the pivot still
+    improves the cut. Returns the number of pivots done or -1 if a pivot
+    failed.*/
+int
+CglLandPSimplex::replayPivots(const std::vector<CglLandP::Pivot> & history,
+                              const CglLandP::Parameters & params)
+{
+    double infty = si_->getInfinity();
+    int numPivots = 0;
+    for (unsigned int p = 0 ; p < history.size() &&
+            numPivots < params.pivotLimit ; p++)
+    {
+        const CglLandP::Pivot & pivot = history[p];
+        int leaving = -1;
+        for (int i = 0 ; i < nrows_ ; i++)
+        {
+            if (basics_[i] == pivot.leaving)
+            {
+                leaving = i;
+                break;
+            }
+        }
+        int incoming = -1;
+        for (int j = 0 ; j < ncols_ ; j++)
+        {
+            if (nonBasics_[j] == pivot.incoming)
+            {
+                incoming = j;
+                break;
+            }
+        }
+        if (leaving < 0 || leaving == row_k_.num || incoming < 0 ||
+                !col_in_subspace[pivot.incoming])
+            break;
+        if (pivot.direction > 0 ? getUpBound(pivot.leaving) >= infty :
+                getLoBound(pivot.leaving) <= -infty)
+            break;
+
+        row_i_.num = leaving;
+        pullTableauRow(row_i_);
+        adjustTableauRow(pivot.leaving, row_i_, pivot.direction);
+        // same test as fastFindBestPivotColumn (objective of the combination
+        // of rows k and i compared to row k alone)
+        bool improving = false;
+        double gamma = 0.;
+        if (fabs(row_i_[pivot.incoming]) >= 1e-05)
+        {
+            gamma = - row_k_[pivot.incoming] / row_i_[pivot.incoming];
+            double newRhs = row_k_.rhs + gamma * row_i_.rhs;
+            improving = newRhs >= params.away && newRhs <= 1 - params.away &&
+                        computeCglpObjective(gamma, false) <
+                        computeCglpObjective(0., false) - 1e-07;
+        }
+        if (!improving)
+        {
+            resetOriginalTableauRow(pivot.leaving, row_i_, pivot.direction);
+            break;
+        }
+#ifndef OLD_COMPUTATION
+        bool recompute_source_row = (numPivots && (numPivots % 10 == 0 ||
+                                     fabs(gamma) < 1e-05));
+#endif
+        if (!changeBasis(incoming, leaving, pivot.direction,
+#ifndef OLD_COMPUTATION
+                         recompute_source_row,
+#endif
+                         false))
+        {
+            handler_->message(PivotFailedSigmaUnchanged,messages_)<<CoinMessageEol<<CoinMessageEol;
+            return -1;
+        }
+        numPivots++;
+        pivots_.push_back(pivot);
+        if (params.modularize)
+        {
+            row_k_.modularize(integers_);
+        }
+        sigma_ = computeCglpObjective(row_k_);
+        handler_->message(PivotLog,messages_)<<numPivots<<sigma_<<
+        nonBasics_[incoming]<<basics_[leaving]<<pivot.direction<<gamma<<false<<CoinMessageEol<<CoinMessageEol;
+    }
+    return numPivots;
+}
+
 bool
 CglLandPSimplex::changeBasis(int incoming, int leaving, int leavingStatus,
 #ifndef OLD_COMPUTATION
@@ -1378,17 +1479,15 @@ CglLandPSimplex::fastFindCutImprovingPivotRow( int &direction, int &gammaSign,
     //Need to get the column of the tableau in rW3_ for each of these and
     //add up with correctly in storage for multiplier for negative gamma (named rW3_) and
     //for positive gamma (which is named rW4_)
-    if (!M3_.empty())
+    //(both are zero when M3_ is empty so that the scan of the rows below does not branch on it)
+    CoinFillN(&rWk3_[0],nrows_,0.);
+    CoinFillN(&rWk4_[0],nrows_,0.);
+    if (!M3_.empty() && modularize)
     {
-        CoinFillN(&rWk3_[0],nrows_,0.);
-        CoinFillN(&rWk4_[0],nrows_,0.);
-        if (modularize)
-        {
-            double * rWk3bis_ = NULL;
-            double * rWk4bis_ = NULL;
-            CoinFillN(rWk3bis_,nrows_,0.);
-            CoinFillN(rWk4bis_,nrows_,0.);
-        }
+        double * rWk3bis_ = NULL;
+        double * rWk4bis_ = NULL;
+        CoinFillN(rWk3bis_,nrows_,0.);
+        CoinFillN(rWk4bis_,nrows_,0.);
     }
     for (unsigned int i = 0 ; i < M3_.size() ; i++)
     {
@@ -1398,25 +1497,22 @@ CglLandPSimplex::fastFindCutImprovingPivotRow( int &direction, int &gammaSign,
         if (ii < ncols_orig_ && basis_->getStructStatus(ii)==CoinWarmStartBasis::atUpperBound) swap = true;
         if (ii >= ncols_orig_ && basis_->getArtifStatus(ii - ncols_orig_)==CoinWarmStartBasis::atUpperBound) swap = true;
 
+        // Everything which only depends on ii is computed once so that the loop
+        // on the rows has no branch.
+        const double colSign = swap ? -1. : 1.;
+        const double weight = norm_weights_.empty() ? 1. : norm_weights_[ii];
+        const double sigmaCoef = normedCoef(sigma, ii);
+        const double m2Coef = getColsolToCut(ii) - sigmaCoef;
+        const double * col = &rWk2_[0];
+        double * negGamma = &rWk3_[0];
+        double * posGamma = &rWk4_[0];
         for (int j = 0 ; j < nrows_ ; j++)
         {
-            if (swap)
-                rWk2_[j] = - rWk2_[j];
-            if (rWk2_[j] > 0.)
-            {
-                //is in M1 for multiplier with negative gamma
-                rWk3_[j] -= normedCoef(sigma*rWk2_[j], ii);
-                //is in M2 for multiplier with positive gamma
-                rWk4_[j] -= (getColsolToCut(ii) - normedCoef(sigma, ii))*rWk2_[j];
-            }
-            else if (rWk2_[j] < 0.)
-            {
-                //is in M2 for multiplier with negative gamma
-                rWk3_[j] -=(getColsolToCut(ii) - normedCoef(sigma, ii))*rWk2_[j];
-
-                //is in M1 for multiplier with positive gamma
-                rWk4_[j] -= normedCoef(sigma, ii)*rWk2_[j];
-            }
+            const double a = colSign * col[j];
+            //if a > 0 is in M1 for multiplier with negative gamma and in M2 for multiplier with positive gamma
+            //if a < 0 is in M2 for multiplier with negative gamma and in M1 for multiplier with positive gamma
+            negGamma[j] -= a > 0. ? sigma * a * weight : (a < 0. ? m2Coef * a : 0.);
+            posGamma[j] -= a > 0. ? m2Coef * a : (a < 0. ? sigmaCoef * a : 0.);
         }
 
     }
@@ -1443,171 +1539,95 @@ CglLandPSimplex::fastFindCutImprovingPivotRow( int &direction, int &gammaSign,
     //for (int i = 0 ; i < ncols_orig_ ; i++) {
     //  fzero -= getColsolToCut(nonBasics_[i]) * row_k_[nonBasics_[i]];
     //}
+    const double oneMinusFzero = 1 - fzero;
+
+    // The rows are scanned by blocks. For each block the data of the basic
+    // variables is first gathered in contiguous arrays, then the four reduced
+    // costs of every row of the block are computed without branching (rows
+    // which can not leave at a bound are discarded afterwards) and finally the
+    // block is searched for the best candidate.
+    const int blockSize = 256;
+    double loBlock[blockSize];
+    double upBlock[blockSize];
+    double colsolBlock[blockSize];
+    double toCutBlock[blockSize];
+    double sigmaBlock[blockSize];
+    // Order in which the reduced costs of a row are examined with their direction and sign of gamma
+    double * redCosts[4] = {ul_i, vl_i, uu_i, vu_i};
+    static const int rcDirection[4] = {-1, -1, 1, 1};
+    static const int rcGammaSign[4] = {-1, 1, -1, 1};
 
     double bestReducedCost = -tolerance;
-    for (int i = 0 ; i < nrows_ ; i++)
-    {
-      //if ((!row_k_.modularized_ && i == row_k_.num)//obviously not necessary to combine row k with itself
-        if ((i == row_k_.num)//obviously not necessary to combine row k with itself
-                //   && fabs(getUpBound(basics_[row_i_.num]) - getLoBound(basics_[row_i_.num]))>1e-09 //variable is not fixed
-                || col_in_subspace[basics_[i]] == false
-           )
-        {
-            ul_i[i]=uu_i[i]=vl_i[i]=vu_i[i]=10.;
-            rowFlags_[i] = false;
-            continue;
-        }
-
-        double tau1 = rWk1_[i];
-        double tau2 = rWk1_[i];
-        double tau3 = rWk1_[i];
-        double tau4 = rWk1_[i];
-        if (!M3_.empty())
-        {
-            tau1 += rWk3_[i];
-            tau2 += rWk4_[i];
-            tau3 += rWk4_[i];
-            tau4 += rWk3_[i];
-        }
-        if (modularize)
-        {
-            tau1 = rWk1_[i] + rWk3_[i];
-            tau2 = rWk1bis_[i] + rWk3_[i];
-            tau3 = - rWk1_[i] - rWk4_[i];
-            tau4 = - rWk1bis_[i] - rWk3_[i];
-        }
-
-
-        double redCost;
-        bool hasNegativeRc = false;
-
-        double loBound = getLoBound(basics_[i]);
-
-        if (loBound > -1e50)
-        {
-            redCost = - normedCoef(sigma,basics_[i]) + (tau1)
-                      + (1 - fzero) * ( colsol_[basics_[i]]
-                                        - loBound);
-
-
-            if (redCost < -tolerance)
-            {
-                ul_i[i] = redCost;
-                hasNegativeRc = true;
-            }
-            else
-            {
-                if (fabs(redCost) < tolerance) nZeroRc++;
-                else nPositiveRc ++;
-                ul_i[i] = 10.;
-            }
-            if (redCost < bestReducedCost
-                    && rowFlags_[i] )   //row has not been flaged
-            {
-                bestDirection = -1;
-                bestGammaSign = -1;
-                bestReducedCost = redCost;
-                bestRow = i;
-            }
-
-
-            redCost = -normedCoef(sigma,basics_[i]) - (tau2)
-                      - (1 - fzero) * ( colsol_[basics_[i]]
-                                        - loBound)
-                      - loBound + getColsolToCut(basics_[i]);
-
-            if (redCost < -tolerance)
-            {
-                vl_i[i] = redCost;
-                hasNegativeRc = true;
-            }
-            else
-            {
-                if (fabs(redCost) < tolerance) nZeroRc++;
-                else nPositiveRc ++;
-                vl_i[i]=10.;
-            }
-
-            if (redCost < bestReducedCost
-                    && rowFlags_[i])   //row has not been flaged
-            {
-                bestDirection = -1;
-                bestGammaSign = 1;
-                bestReducedCost = redCost;
-                bestRow = i;
-            }
-
-
-
-        }
-        else
-        {
-            ul_i[i] = 10.;
-            vl_i[i] = 10.;
-        }
-        double upBound = getUpBound(basics_[i]);
-        if (getUpBound(basics_[i]) < 1e50)
-        {
-            redCost = - normedCoef(sigma,basics_[i]) - (tau3)
-                      + (1 - fzero) * ( - colsol_[basics_[i]]
-                                        + upBound);
-
-            if (redCost < -tolerance)
-            {
-                uu_i[i] = redCost;
-                hasNegativeRc = true;
-            }
-            else
-            {
-                if (fabs(redCost) < tolerance) nZeroRc++;
-                else nPositiveRc ++;
-                uu_i[i] = 10.;
-            }
-
-            if (redCost < bestReducedCost
-                    && rowFlags_[i])   //row has not been flaged
-            {
-                bestDirection = 1;
-                bestGammaSign = -1;
-                bestReducedCost = redCost;
-                bestRow = i;
-            }
-
-            redCost = -normedCoef(sigma,basics_[i]) + (tau4)
-                      - (1 - fzero) * ( - colsol_[basics_[i]]
-                                        + upBound)
-                      + upBound - getColsolToCut(basics_[i]);
-
-            if (redCost < -tolerance)
-            {
-                vu_i[i] = redCost;
-                hasNegativeRc = true;
-            }
-
-
-            else
-            {
-                if (fabs(redCost) < tolerance) nZeroRc++;
-                else nPositiveRc ++;
-                vu_i[i] = 10.;
-            }
-
-            if (redCost < bestReducedCost
-                    && rowFlags_[i])   //row has not been flaged
-            {
-                bestDirection = 1;
-                bestGammaSign = 1;
-                bestReducedCost = redCost;
-                bestRow = i;
+    for (int first = 0 ; first < nrows_ ; first += blockSize)
+    {
+        const int n = CoinMin(blockSize, nrows_ - first);
+        for (int k = 0 ; k < n ; k++)
+        {
+            const int & basic = basics_[first + k];
+            loBlock[k] = getLoBound(basic);
+            upBlock[k] = getUpBound(basic);
+            colsolBlock[k] = colsol_[basic];
+            toCutBlock[k] = getColsolToCut(basic);
+            sigmaBlock[k] = normedCoef(sigma, basic);
+        }
+        for (int k = 0 ; k < n ; k++)
+        {
+            const int i = first + k;
+            const double tauNeg = rWk1_[i] + rWk3_[i];
+            const double tauPos = rWk1_[i] + rWk4_[i];
+            const double toLo = oneMinusFzero * ( colsolBlock[k] - loBlock[k]);
+            const double toUp = oneMinusFzero * ( - colsolBlock[k] + upBlock[k]);
+            ul_i[i] = - sigmaBlock[k] + tauNeg + toLo;
+            vl_i[i] = - sigmaBlock[k] - tauPos - toLo - loBlock[k] + toCutBlock[k];
+            uu_i[i] = - sigmaBlock[k] - tauPos + toUp;
+            vu_i[i] = - sigmaBlock[k] + tauNeg - toUp + upBlock[k] - toCutBlock[k];
+        }
+        for (int k = 0 ; k < n ; k++)
+        {
+            const int i = first + k;
+            //if ((!row_k_.modularized_ && i == row_k_.num)//obviously not necessary to combine row k with itself
+            if ((i == row_k_.num)//obviously not necessary to combine row k with itself
+                    //   && fabs(getUpBound(basics_[row_i_.num]) - getLoBound(basics_[row_i_.num]))>1e-09 //variable is not fixed
+                    || col_in_subspace[basics_[i]] == false
+               )
+            {
+                ul_i[i]=uu_i[i]=vl_i[i]=vu_i[i]=10.;
+                rowFlags_[i] = false;
+                continue;
+            }
+            bool hasNegativeRc = false;
+            const bool hasLoBound = loBlock[k] > -1e50;
+            const bool hasUpBound = upBlock[k] < 1e50;
+            for (int c = 0 ; c < 4 ; c++)
+            {
+                if (rcDirection[c] == -1 ? !hasLoBound : !hasUpBound)
+                {
+                    redCosts[c][i] = 10.;
+                    continue;
+                }
+                const double redCost = redCosts[c][i];
+                if (redCost < -tolerance)
+                {
+                    hasNegativeRc = true;
+                }
+                else
+                {
+                    if (fabs(redCost) < tolerance) nZeroRc++;
+                    else nPositiveRc ++;
+                    redCosts[c][i] = 10.;
+                }
+                if (redCost < bestReducedCost
+                        && rowFlags_[i] )   //row has not been flaged
+                {
+                    bestDirection = rcDirection[c];
+                    bestGammaSign = rcGammaSign[c];
+                    bestReducedCost = redCost;
+                    bestRow = i;
+                }
             }
+            if (hasNegativeRc) nNegativeRcRows_ ++;
+            else if (flagPositiveRows) rowFlags_[i] = false;
         }
-        else
-        {
-            uu_i[i] = 10.;
-            vu_i[i] = 10.;
-        }
-        if (hasNegativeRc) nNegativeRcRows_ ++;
-        else if (flagPositiveRows) rowFlags_[i] = false;
     }
     handler_->message(NumberNegRc, messages_)<<nNegativeRcRows_<<CoinMessageEol;
     handler_->message(NumberZeroRc, messages_)<<nZeroRc<<CoinMessageEol;
@@ -2435,20 +2455,9 @@ CglLandPSimplex::computeCglpRedCost(int direction, int gammaSign, double tau)
 
     double value =0;
     int sign = gammaSign * direction;
-    double tau1 = 0;
-    double tau2 = 0;
-    for (unsigned int i = 0 ; i < M3_.size() ; i++)
-    {
-        tau1 += fabs(row_i_ [M3_[i]]);
-        if (sign == 1 && row_i_[M3_[i]] < 0)
-        {
-            tau2 += row_i_[M3_[i]] * getColsolToCut(M3_[i]);
-        }
-        else if (sign == -1 && row_i_[M3_[i]] > 0)
-        {
-            tau2 += row_i_[M3_[i]] * getColsolToCut(M3_[i]);
-        }
-    }
+    // Contributions of M3 have been computed with tau in computeRedCostConstantsInRow
+    double tau1 = m3AbsSum_;
+    double tau2 = sign == 1 ? m3NegSum_ : m3PosSum_;
     double Tau = - sign * (tau + tau2) - tau1 * sigma_;
     value = - sigma_ + Tau
             + (1 - getColsolToCut(basics_[row_k_.num])) * sign * (row_i_.rhs
@@ -2475,6 +2484,19 @@ CglLandPSimplex::computeRedCostConstantsInRow()
         tau1 -= row_i_[M2_[i]];
         tau2 += row_i_[M2_[i]] * getColsolToCut(M2_[i]);
     }
+    // Sums on M3 used by computeCglpRedCost for each direction and sign of gamma
+    m3AbsSum_ = 0;
+    m3NegSum_ = 0;
+    m3PosSum_ = 0;
+    for (unsigned int i = 0 ; i < M3_.size() ; i++)
+    {
+        const double & a = row_i_[M3_[i]];
+        m3AbsSum_ += fabs(a);
+        if (a < 0)
+            m3NegSum_ += a * getColsolToCut(M3_[i]);
+        else if (a > 0)
+            m3PosSum_ += a * getColsolToCut(M3_[i]);
+    }
     return sigma_ * tau1 + tau2;
 
 }
@@ -2489,59 +2511,31 @@ CglLandPSimplex::updateM1_M2_M3(TabRow & row, double tolerance, bool perturb)
     for (int i = 0; i<ncols_ ; i++)
     {
         const int &ii = nonBasics_[i];
+        // Only the columns in the subspace are candidates to leave
+        const bool inSubspace = col_in_subspace[ii];
+        colCandidateToLeave_[i] = inSubspace;
+        if (!inSubspace)
+            continue;
         const double &f = row[ii];
         if (f< -tolerance)
         {
-            if (col_in_subspace[ii])
-            {
-                M1_.push_back(ii);
-                colCandidateToLeave_[i]=true;
-            }
-            else
-            {
-                colCandidateToLeave_[i]=false;
-            }
+            M1_.push_back(ii);
         }
         else if (f>tolerance)
         {
-            if (col_in_subspace[ii])
-            {
+            M2_.push_back(ii);
+        }
+        else if (perturb)   //assign to M1 or M2 at random
+        {
+            int sign = randomNumberGenerator_.randomDouble() > 0.5 ? 1 : -1;
+            if (sign == -1)   //put into M1
+                M1_.push_back(ii);
+            else   //put into M2
                 M2_.push_back(ii);
-                colCandidateToLeave_[i]=true;
-            }
-            else
-            {
-                colCandidateToLeave_[i]=false;
-            }
         }
         else
         {
-            if (col_in_subspace[ii])
-            {
-                if (perturb)   //assign to M1 or M2 at random
-                {
-                    int sign = CoinDrand48() > 0.5 ? 1 : -1;
-                    if (sign == -1)   //put into M1
-                    {
-                        M1_.push_back(ii);
-                        colCandidateToLeave_[i]=true;
-                    }
-                    else   //put into M2
-                    {
-                        M2_.push_back(ii);
-                        colCandidateToLeave_[i]=true;
-                    }
-                }
-                else
-                {
-                    M3_.push_back(ii);
-                    colCandidateToLeave_[i] = true;
-                }
-            }
-            else
-            {
-                colCandidateToLeave_[i] = false;
-            }
+            M3_.push_back(ii);
         }
     }
     //std::cout<<"M3 has "<<M3_.size()<<" variables."<<std::endl;
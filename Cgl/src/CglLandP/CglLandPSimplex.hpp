@@ -22,6 +22,7 @@
 #include "CoinMessageHandler.hpp"
 #include "CoinWarmStartBasis.hpp"
 #include "CoinPackedMatrix.hpp"
+#include "CoinHelperFunctions.hpp"
 
 #ifdef COIN_HAS_OSICLP
 #include "OsiClpSolverInterface.hpp"
@@ -53,8 +54,10 @@ public:
     void cacheUpdate(const CglLandP::CachedData &cached, bool reducedSpace = 0);
     /** reset the solver to optimal basis */
     bool resetSolver(const CoinWarmStartBasis * basis);
-    /** Perfom pivots to find the best cuts */
-    bool optimize(int var, OsiRowCut & cut, const CglLandP::CachedData &cached, const CglLandP::Parameters & params);
+    /** Perfom pivots to find the best cuts (if history is not NULL first
+        replay its pivots while they improve the cut).*/
+    bool optimize(int var, OsiRowCut & cut, const CglLandP::CachedData &cached, const CglLandP::Parameters & params,
+                  const std::vector<CglLandP::Pivot> * history = NULL);
     /** Find Gomory cut (i.e. don't do extra setup required for pivots).*/
     bool generateMig(int row, OsiRowCut &cut, const CglLandP::Parameters & params);
 
@@ -130,12 +133,31 @@ public:
         return basics_;
     }
 
+    /** Pivots done at last call to optimize.*/
+    const std::vector<CglLandP::Pivot> & pivots() const
+    {
+        return pivots_;
+    }
+
     void outPivInfo(int ncuts)
     {
         handler_->message(RoundStats, messages_)<<ncuts<<numPivots_
         <<numSourceRowEntered_
         <<numIncreased_<<CoinMessageEol;
     }
+    /** Add pivot statistics of other (when variables are separated in parallel).*/
+    void addPivInfo(const CglLandPSimplex &other)
+    {
+        numPivots_ += other.numPivots_;
+        numSourceRowEntered_ += other.numSourceRowEntered_;
+        numIncreased_ += other.numIncreased_;
+        numReplayed_ += other.numReplayed_;
+    }
+    /** Number of pivots replayed from pivot histories.*/
+    int numReplayedPivots() const
+    {
+        return numReplayed_;
+    }
 #ifdef APPEND_ROW
     /** Append source row to tableau.*/
     void append_row(int row_num, bool modularize) ;
@@ -151,6 +173,10 @@ protected:
                      bool recompute_source_row,
 #endif
                      bool modularize);
+    /** Replay pivots of history while they can be done and improve the cut.
+      \return number of pivots done (-1 if a pivot failed). */
+    int replayPivots(const std::vector<CglLandP::Pivot> & history,
+                     const CglLandP::Parameters & params);
     /** Find a row which can be used to perform an improving pivot the fast way
       * (i.e., find the leaving variable).
       \return index of the row on which to pivot or -1 if none exists. */
@@ -330,6 +356,12 @@ private:
     std::vector<int> M2_;
     /** Stores the variables which could be either in M1 or M2 */
     std::vector<int> M3_;
+    /** Sum of absolute values of coefficients of row_i_ in M3 */
+    double m3AbsSum_;
+    /** Sum of negative coefficients of row_i_ in M3 times the solution to cut */
+    double m3NegSum_;
+    /** Sum of positive coefficients of row_i_ in M3 times the solution to cut */
+    double m3PosSum_;
     /** stores the cglp value of the normalized cut obtained from row k_ */
     double sigma_;
     /** Keep track of basis status */
@@ -386,6 +418,13 @@ private:
     int numSourceRowEntered_;
     /** Record the number of times that sigma increased.*/
     int numIncreased_;
+    /** Record the number of pivots replayed from pivot histories.*/
+    int numReplayed_;
+    /** Pivots done at last call to optimize.*/
+    std::vector<CglLandP::Pivot> pivots_;
+    /** Random numbers for perturbation (reseeded for each variable so that
+        cuts do not depend on the order variables are separated in).*/
+    CoinThreadRandom randomNumberGenerator_;
 
     /** Message handler. */
     CoinMessageHandler * handler_;
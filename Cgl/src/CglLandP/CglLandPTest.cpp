@@ -41,6 +41,7 @@ CglLandPUnitTest(
         assert(aGenerator.parameter().strengthen==true);
         assert(aGenerator.parameter().perturb==true);
         assert(aGenerator.parameter().pivotSelection==CglLandP::mostNegativeRc);
+        assert(aGenerator.parameter().usePivotHistory==false);
     }
 
 
@@ -62,6 +63,7 @@ CglLandPUnitTest(
             b.parameter().strengthen = false;
             b.parameter().perturb = false;
             b.parameter().pivotSelection=CglLandP::bestPivot;
+            b.parameter().usePivotHistory = true;
             //Test Copy
             CglLandP c(b);
             assert(c.parameter().pivotLimit == 100);
@@ -77,6 +79,7 @@ CglLandPUnitTest(
             assert(c.parameter().strengthen == false);
             assert(c.parameter().perturb == false);
             assert(c.parameter().pivotSelection == CglLandP::bestPivot);
+            assert(c.parameter().usePivotHistory == true);
             a=b;
             assert(a.parameter().pivotLimit == 100);
             assert(a.parameter().maxCutPerRound == 100);
@@ -91,6 +94,7 @@ CglLandPUnitTest(
             assert(a.parameter().strengthen == false);
             assert(a.parameter().perturb == false);
             assert(a.parameter().pivotSelection == CglLandP::bestPivot);
+            assert(a.parameter().usePivotHistory == true);
         }
     }
 
@@ -214,6 +218,20 @@ CglLandPUnitTest(
 
         // Test generateCuts method
         test.generateCuts(*siP,cuts);
+
+        // Same cuts when separating variables in parallel (without
+        // CGL_THREAD variables are still split into tasks with one
+        // simplex per thread)
+        for (int numberThreads = 2 ; numberThreads <= 8 ; numberThreads *= 2)
+        {
+            CglLandP test2;
+            test2.setNumberThreads(numberThreads);
+            OsiCuts cuts2;
+            test2.generateCuts(*siP,cuts2);
+            assert(cuts2.sizeRowCuts() == cuts.sizeRowCuts());
+            for (int i = 0 ; i < cuts.sizeRowCuts() ; i++)
+                assert(cuts2.rowCut(i) == cuts.rowCut(i));
+        }
         OsiSolverInterface::ApplyCutsReturnCode rc = siP->applyCuts(cuts);
 
         siP->resolve();
@@ -307,6 +325,49 @@ CglLandPUnitTest(
         delete siP;
     }
 
+    if (1)  //test two rounds replaying pivots of first one
+    {
+        // with both pivot selection rules which use the pivot history
+        for (int iSelection = 0 ; iSelection < 2 ; iSelection++)
+        {
+            // Setup
+            OsiSolverInterface  * siP = si->clone();
+            std::string fn(mpsDir+"p0033");
+            siP->readMps(fn.c_str(),"mps");
+            siP->activateRowCutDebugger("p0033");
+            CglLandP test;
+            test.parameter().usePivotHistory = true;
+            if (iSelection)
+                test.parameter().pivotSelection = CglLandP::initialReducedCosts;
+            siP->initialSolve();
+            double lpRelaxBefore=siP->getObjValue();
+            assert( eq(lpRelaxBefore, 2520.5717391304347) );
+
+            CglTreeInfo info;
+            OsiCuts cuts;
+            test.generateCuts(*siP,cuts,info);
+            // nothing to replay at first round
+            assert( test.numberReplayedPivots() == 0 );
+            OsiSolverInterface::ApplyCutsReturnCode rc = siP->applyCuts(cuts);
+            siP->resolve();
+            double lpRelaxAfter=siP->getObjValue();
+            assert( lpRelaxAfter > (iSelection ? lpRelaxBefore : 2840.) );
+
+            info.pass = 1;
+            OsiCuts cuts2;
+            test.generateCuts(*siP,cuts2,info);
+            // pivots giving the cuts of first round must have been replayed
+            assert( test.numberReplayedPivots() > 0 );
+            rc = siP->applyCuts(cuts2);
+            siP->resolve();
+            double lpRelaxAfter2=siP->getObjValue();
+            std::cout<<"Relaxation after two rounds "<<lpRelaxAfter2<<std::endl;
+            assert( lpRelaxAfter <= lpRelaxAfter2 + 1e-06 );
+
+            delete siP;
+        }
+    }
+
     if (1)  //Finally test code in documentation
     {
         // Setup
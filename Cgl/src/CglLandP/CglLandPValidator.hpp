@@ -109,6 +109,17 @@ public:
     {
         return numRejected_[ code];
     }
+    /** Reset number of cuts rejected for each reason.*/
+    void resetRejections()
+    {
+        numRejected_.assign(DummyEnd, 0);
+    }
+    /** Add numbers of cuts rejected by other (when cuts are validated in parallel).*/
+    void addRejections(const Validator &other)
+    {
+        for (int i = 0 ; i < DummyEnd ; i++)
+            numRejected_[i] += other.numRejected_[i];
+    }
 private:
     static void fillRejectionReasons();
     /** max percentage of given formulation fillIn should be accepted for cut fillin.*/
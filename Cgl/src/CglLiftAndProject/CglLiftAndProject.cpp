@@ -62,12 +62,19 @@ void CglLiftAndProject::generateCuts(const OsiSolverInterface& si, OsiCuts& cs,
   const int * AtildeIndices =  Atilde->getIndices();
   const CoinBigIndex * AtildeStarts = Atilde->getVectorStarts();
   const int * AtildeLengths = Atilde->getVectorLengths();  
-  const int AtildeFullSize = AtildeStarts[m];
   const double * btilde = si.getRowLower();
 
-  // Set up memory for system (10) [BCC:307]
+  // Column j of Atilde is needed for the part of the problem
+  // which depends on j
+  const CoinPackedMatrix * AtildeByCol = si.getMatrixByCol();
+  const double * AtildeColElements =  AtildeByCol->getElements();
+  const int * AtildeColIndices =  AtildeByCol->getIndices();
+  const CoinBigIndex * AtildeColStarts = AtildeByCol->getVectorStarts();
+  const int * AtildeColLengths = AtildeByCol->getVectorLengths();  
+
+  // System (10) [BCC:307]
   // (the problem over the norm intersected 
-  //  with the polar cone)
+  //  with the polar cone) is
   // 
   // min <<x^T,Atilde^T>,u> + x_ju_0
   // s.t.
@@ -87,63 +94,68 @@ void CglLiftAndProject::generateCuts(const OsiSolverInterface& si, OsiCuts& cs,
   // e_0 is a (AtildeNCols x 1) vector of all zeros 
   // e_j is e_0 with a 1 in the jth position
 
-  // Storing B in column order. B is a (n+2 x 2m+2) matrix 
-  // But need to allow for possible gaps in Atilde.
-  // At each iteration, only need to change 2 cols and objfunc
-  // Sane design of OsiSolverInterface does not permit mucking
-  // with matrix.
-  // Because we must delete and add cols to alter matrix,
-  // and we can only add columns on the end of the matrix
-  // put the v_0 and u_0 columns on the end.
-  // rather than as described in [BCC]
- 
-  // Initially allocating B with space for v_0 and u_O cols
-  // but not populating, for efficiency.
-
-  // B without u_0 and v_0 is a (n+2 x 2m) size matrix.
+  // u_0 and v_0 are free and only appear in row j and in
+  // the last row, we eliminate them:
+  //   v_0 = beta_ - <btilde,v>
+  //   u_0 = v_0 - <Atilde_j,u> + <Atilde_j,v>
+  // (Atilde_j being column j of Atilde) and solve instead
+  //
+  // min <Atilde x - x_j Atilde_j, u> + x_j <Atilde_j - btilde, v>
+  // s.t.
+  //     <B',(u,v)> = (0,...,0,beta_)^T except for row j which is free
+  //     u,v >= 0
+  // where
+  //
+  // B' = Atilde^T  -Atilde^T
+  //      btilde^T   e_0^T
+  //
+  // (the optimal value being this objective plus x_j beta_).
+  // B' does not depend on j: it is loaded once and, from one x_j
+  // to the next, only the bounds of row j and the objective
+  // change so that each problem is warm started from the
+  // optimal basis of the previous one.
 
+  // Storing B' in column order. B' is a (n+1 x 2m) matrix 
+  // But need to allow for possible gaps in Atilde.
   int twoM = 2*m;
-  int BNumRows = n+2;
-  int BNumCols = twoM+2;
-  int BFullSize = 2*AtildeFullSize+twoM+3;
+  int BNumRows = n+1;
+  int BNumCols = twoM;
+  CoinBigIndex BFullSize = 0;
+  int i;
+  for (i=0; i<m; i++)
+    BFullSize += 2*AtildeLengths[i]+1;
   double * BElements = new double[BFullSize];
   int * BIndices = new int[BFullSize];
   CoinBigIndex * BStarts = new CoinBigIndex [BNumCols+1];
   int * BLengths = new int[BNumCols];
 
-
-  int i, ij, k=0;
-  int nPlus1=n+1;
-  int offset = AtildeStarts[m]+m;
+  CoinBigIndex ij, k=0;
   for (i=0; i<m; i++){
+    // u_i
+    BStarts[i]=k;
     for (ij=AtildeStarts[i];ij<AtildeStarts[i]+AtildeLengths[i];ij++){
       BElements[k]=AtildeElements[ij];
-      BElements[k+offset]=-AtildeElements[ij];
       BIndices[k]= AtildeIndices[ij];
-      BIndices[k+offset]= AtildeIndices[ij];
-
       k++;
     }
     BElements[k]=btilde[i];
-    BElements[k+offset]=btilde[i];
     BIndices[k]=n;
-    BIndices[k+offset]=nPlus1;
-    BStarts[i]= AtildeStarts[i]+i;
-    BStarts[i+m]=offset+BStarts[i];// = AtildeStarts[m]+m+AtildeStarts[i]+i
-    BLengths[i]= AtildeLengths[i]+1;
-    BLengths[i+m]= AtildeLengths[i]+1;
     k++;
+    BLengths[i]= AtildeLengths[i]+1;
   }
-
-  BStarts[twoM]=BStarts[twoM-1]+BLengths[twoM-1];
-
-  // Cols that will be deleted each iteration
-  int BNumColsLessOne=BNumCols-1;
-  int BNumColsLessTwo=BNumCols-2;
-  const int delCols[2] = {BNumColsLessOne, BNumColsLessTwo};
+  for (i=0; i<m; i++){
+    // v_i
+    BStarts[i+m]=k;
+    for (ij=AtildeStarts[i];ij<AtildeStarts[i]+AtildeLengths[i];ij++){
+      BElements[k]=-AtildeElements[ij];
+      BIndices[k]= AtildeIndices[ij];
+      k++;
+    }
+    BLengths[i+m]= AtildeLengths[i];
+  }
+  BStarts[twoM]=k;
 
   // Set lower bound on u and v
-  // u_0, v_0 will be reset as free
   const double solverINFINITY = si.getInfinity();
   double * BColLowers = new double[BNumCols];
   double * BColUppers = new double[BNumCols];
@@ -151,37 +163,29 @@ void CglLiftAndProject::generateCuts(const OsiSolverInterface& si, OsiCuts& cs,
   CoinFillN(BColUppers,BNumCols,solverINFINITY); 
 
   // Set row lowers and uppers.
-  // The rhs is zero, for but the last two rows.
-  // For these the rhs is beta_
+  // The rhs is zero, for but the last row.
+  // For this one the rhs is beta_
   double * BRowLowers = new double[BNumRows];
   double * BRowUppers = new double[BNumRows];
   CoinFillN(BRowLowers,BNumRows,0.0);  
   CoinFillN(BRowUppers,BNumRows,0.0);
-  BRowLowers[BNumRows-2]=beta_;
-  BRowUppers[BNumRows-2]=beta_;
   BRowLowers[BNumRows-1]=beta_;
   BRowUppers[BNumRows-1]=beta_;
 
-
   // Calculate base objective <<x^T,Atilde^T>,u>
-  // Note: at each iteration coefficient u_0
-  //       changes to <x^T,e_j>
-  //       w=(u,v,beta,v_0,u_0) size 2m+3
-  //       So, BOjective[2m+2]=x[j]
+  // Note: at each iteration the coefficients of u_i
+  //       and v_i with Atilde_ij != 0 and all the
+  //       coefficients of v change with x_j
   double * BObjective= new double[BNumCols];
   double * Atildex = new double[m];
   CoinFillN(BObjective,BNumCols,0.0);
   Atilde->times(x,Atildex); // Atildex is size m, x is size n
   CoinDisjointCopyN(Atildex,m,BObjective); 
 
-  // Number of cols and size of Elements vector
-  // in B without the v_0 and u_0 cols
-  int BFullSizeLessThree = BFullSize-3;
-
-  // Load B matrix into a column orders CoinPackedMatrix
+  // Load B' matrix into a column orders CoinPackedMatrix
   CoinPackedMatrix * BMatrix = new CoinPackedMatrix(true, BNumRows,
-						  BNumColsLessTwo, 
-						  BFullSizeLessThree,
+						  BNumCols, 
+						  BFullSize,
 						  BElements,BIndices, 
 						  BStarts,BLengths);
   // Assign problem into a solver interface 
@@ -196,29 +200,26 @@ void CglLiftAndProject::generateCuts(const OsiSolverInterface& si, OsiCuts& cs,
   coneSi->setObjSense(1.0);
 
   // The plot outline from here on down:
-  // coneSi has been assigned B without the u_0 and v_0 columns
-  // Calculate base objective <<x^T,Atilde^T>,u>
+  // coneSi has been assigned B' and the base objective
   // bool haveWarmStart = false;
   // For (j=0; j<n, j++)
   //   if (!isBinary(x_j) || x_j<=0 || x_j>=1) continue;
   //   // IMPROVEME: if(haveWarmStart) check if j attractive
-  //   add {-e_j,0,-1} matrix column for v_0
-  //   add {e_j,0,0} matrix column for u_0
-  //   objective coefficient for u_0 is  x_j 
+  //   set objective for x_j
+  //   free row j
   //   if (haveWarmStart) 
-  //      set warmstart info
-  //   solve min{objw:Bw=0; w>=0,except v_0, u_0 free}
+  //      resolve from last optimal basis
+  //   solve min{objw:B'w=0 except row j; w>=0}
   //   if (bounded)
   //      get warmstart info
   //      haveWarmStart=true;
   //      ustar = optimal u solution
-  //      ustar_0 = optimal u_0 solution
-  //      alpha^T= <ustar^T,Atilde> -ustar_0e_j^T
+  //      vstar = optimal v solution
+  //      alpha^T= <ustar^T,Atilde> + ustar_0e_j^T
   //      (double check <alpha^T,x> >= beta_ should be violated)
   //      add <alpha^T,x> >= beta_ to cutset 
   //   endif
-  //   delete column for u_0 // this deletes all column info.
-  //   delete column for v_0
+  //   fix row j back to 0
   // endFor
   // clean up memory
   // return 0;
@@ -227,16 +228,13 @@ void CglLiftAndProject::generateCuts(const OsiSolverInterface& si, OsiCuts& cs,
   CoinIotaN(nVectorIndices, n, 0);
 
   bool haveWarmStart = false;
+  bool lastOptimal = false;
   bool equalObj1, equalObj2;
   CoinRelFltEq eq;
 
-  double v_0Elements[2] = {-1,1};
-  double u_0Elements[1] = {1};
-
   CoinWarmStart * warmStart = 0;
 
-  double * ustar = new double[m];
-  CoinFillN(ustar, m, 0.0);
+  double * objective = new double[BNumCols];
 
   double* alpha = new double[n];
   CoinFillN(alpha, n, 0.0);
@@ -249,40 +247,43 @@ void CglLiftAndProject::generateCuts(const OsiSolverInterface& si, OsiCuts& cs,
     if (equalObj1 || equalObj2) continue;
     // IMPROVEME: if (haveWarmStart) check if j attractive;
 
-    // AskLL:wanted to declare u_0 and v_0 packedVec outside loop
-    // and setIndices, but didn't see a method to do that(?)
-    // (Could "insert". Seems inefficient)
-    int v_0Indices[2]={j,nPlus1};
-    int u_0Indices[1]={j};
-    // 
-    CoinPackedVector  v_0(2,v_0Indices,v_0Elements,false);
-    CoinPackedVector  u_0(1,u_0Indices,u_0Elements,false);
-
-#if CGL_DEBUG
-    const CoinPackedMatrix *see1 = coneSi->getMatrixByRow();
-#endif
+    // objective for x_j
+    CoinDisjointCopyN(Atildex, m, objective);
+    for (i=0; i<m; i++)
+      objective[i+m] = -x[j]*btilde[i];
+    for (ij=AtildeColStarts[j];ij<AtildeColStarts[j]+AtildeColLengths[j];ij++){
+      objective[AtildeColIndices[ij]] -= x[j]*AtildeColElements[ij];
+      objective[AtildeColIndices[ij]+m] += x[j]*AtildeColElements[ij];
+    }
+    coneSi->setObjective(objective);
+    coneSi->setRowBounds(j,-solverINFINITY,solverINFINITY);
 
-    coneSi->addCol(v_0,-solverINFINITY,solverINFINITY,0);
-    coneSi->addCol(u_0,-solverINFINITY,solverINFINITY,x[j]);
     if(haveWarmStart) {
-      coneSi->setWarmStart(warmStart);
+      // if last problem was solved to optimality coneSi
+      // still has its basis
+      if (!lastOptimal)
+        coneSi->setWarmStart(warmStart);
       coneSi->resolve();
     }
     else {
-
-#if CGL_DEBUG
-      const CoinPackedMatrix *see2 = coneSi->getMatrixByRow();
-#endif
-
       coneSi->initialSolve();
     }
-    if(coneSi->isProvenOptimal()){
+    lastOptimal = coneSi->isProvenOptimal();
+    if(lastOptimal){
+      delete warmStart;
       warmStart = coneSi->getWarmStart();
       haveWarmStart=true;
       const double * wstar = coneSi->getColSolution();
-      CoinDisjointCopyN(wstar, m, ustar);
+      const double * ustar = wstar;
+      const double * vstar = wstar+m;
       Atilde->transposeTimes(ustar,alpha);
-      alpha[j]+=wstar[BNumCols-1]; 
+      // alpha_j = <Atilde_j,u> + u_0 = <Atilde_j,v> + v_0
+      double alpha_j = beta_;
+      for (i=0; i<m; i++)
+        alpha_j -= btilde[i]*vstar[i];
+      for (ij=AtildeColStarts[j];ij<AtildeColStarts[j]+AtildeColLengths[j];ij++)
+        alpha_j += AtildeColElements[ij]*vstar[AtildeColIndices[ij]];
+      alpha[j] = alpha_j;
       
 #if debug
       int p;
@@ -302,14 +303,15 @@ void CglLiftAndProject::generateCuts(const OsiSolverInterface& si, OsiCuts& cs,
       rc.setUb(solverINFINITY);
       cs.insert(rc);
     }
-    // delete col for u_o and v_0
-    coneSi->deleteCols(2,delCols);
-
-    // clean up memory
+    // row j is back to <Atilde_j,u> = <Atilde_j,v>
+    coneSi->setRowBounds(j,0.0,0.0);
   }
   // clean up
+  delete warmStart;
+  delete coneSi;
   delete [] alpha;
-  delete [] ustar;
+  delete [] objective;
+  delete [] Atildex;
   delete [] nVectorIndices;
   // BMatrix, BColLowers,BColUppers, BObjective, BRowLowers, BRowUppers
   // are all freed by OsiSolverInterface destructor (?)
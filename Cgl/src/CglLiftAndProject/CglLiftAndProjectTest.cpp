@@ -0,0 +1,135 @@
+// $Id$
+// Copyright (C) 2026, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include "CoinPragma.hpp"
+#include "CoinFinite.hpp"
+#include "OsiSolverInterface.hpp"
+#include "OsiCuts.hpp"
+#include "CglLiftAndProject.hpp"
+
+void
+CglLiftAndProjectUnitTest(const OsiSolverInterface *baseSiP,
+			  const std::string /*mpsDir*/)
+{
+  // Test default constructor
+  {
+    CglLiftAndProject aGenerator;
+    assert (aGenerator.getBeta()==1.0);
+  }
+
+  // Test copy & assignment
+  {
+    CglLiftAndProject rhs;
+    {
+      CglLiftAndProject bGenerator;
+      bGenerator.setBeta(-1);
+      CglLiftAndProject cGenerator(bGenerator);
+      assert (cGenerator.getBeta()==-1.0);
+      rhs=bGenerator;
+    }
+    assert (rhs.getBeta()==-1.0);
+  }
+
+  // Test get/set methods
+  {
+    CglLiftAndProject getset;
+    getset.setBeta(-1);
+    assert (getset.getBeta()==-1.0);
+    getset.setBeta(1);
+    assert (getset.getBeta()==1.0);
+    bool thrown=false;
+    try {
+      getset.setBeta(2);
+    }
+    catch (CoinError &) {
+      thrown=true;
+    }
+    assert (thrown);
+    assert (getset.getBeta()==1.0);
+  }
+
+  // Test generate cuts on an odd cycle in the canonical form the
+  // generator expects (all rows >=, bounds as rows)
+  //  min x0 + x1 + x2
+  //  x0 + x1 >= 1, x1 + x2 >= 1, x0 + x2 >= 1, x binary
+  // LP optimum is 1.5 at x=(0.5,0.5,0.5), integer optimum is 2
+  {
+    const int numberColumns = 3;
+    const int numberRows = 9;
+    // rows 0-2 cycle, 3-5 x>=0, 6-8 -x>=-1
+    CoinBigIndex start[numberColumns+1]={0,4,8,12};
+    int rows[12]={0,2,3,6, 0,1,4,7, 1,2,5,8};
+    double elements[12]={1.0,1.0,1.0,-1.0, 1.0,1.0,1.0,-1.0,
+			 1.0,1.0,1.0,-1.0};
+    double columnLower[numberColumns]={0.0,0.0,0.0};
+    double columnUpper[numberColumns]={1.0,1.0,1.0};
+    double objective[numberColumns]={1.0,1.0,1.0};
+    double rowLower[numberRows]={1.0,1.0,1.0,0.0,0.0,0.0,-1.0,-1.0,-1.0};
+    double rowUpper[numberRows];
+    for (int iRow=0;iRow<numberRows;iRow++)
+      rowUpper[iRow]=COIN_DBL_MAX;
+    OsiSolverInterface * siP = baseSiP->clone();
+    siP->loadProblem(numberColumns,numberRows,start,rows,elements,
+		     columnLower,columnUpper,objective,rowLower,rowUpper);
+    for (int iColumn=0;iColumn<numberColumns;iColumn++)
+      siP->setInteger(iColumn);
+    siP->initialSolve();
+    assert (siP->isProvenOptimal());
+    double lpRelaxBefore=siP->getObjValue();
+    assert (fabs(lpRelaxBefore-1.5)<1.0e-7);
+    const double * x = siP->getColSolution();
+    double xstar[numberColumns];
+    for (int iColumn=0;iColumn<numberColumns;iColumn++)
+      xstar[iColumn]=x[iColumn];
+
+    CglLiftAndProject cg;
+    OsiCuts cuts;
+    cg.generateCuts(*siP,cuts);
+    int nRowCuts = cuts.sizeRowCuts();
+    // one cut for each fractional variable
+    assert (nRowCuts==numberColumns);
+    for (int i=0;i<nRowCuts;i++) {
+      const OsiRowCut & rcut = cuts.rowCut(i);
+      assert (rcut.lb()==cg.getBeta());
+      // cut must be violated by the LP solution
+      assert (rcut.violated(xstar)>1.0e-5);
+      // and valid for all integer solutions
+      const CoinPackedVector & rpv = rcut.row();
+      for (int point=0;point<(1<<numberColumns);point++) {
+	double value[numberColumns];
+	for (int iColumn=0;iColumn<numberColumns;iColumn++)
+	  value[iColumn]=(point>>iColumn)&1;
+	if (value[0]+value[1]<1.0||value[1]+value[2]<1.0||
+	    value[0]+value[2]<1.0)
+	  continue;
+	assert (rpv.dotProduct(value)>=rcut.lb()-1.0e-7);
+      }
+    }
+
+    // test that the cuts improve the
+    // lp objective function value
+    OsiSolverInterface::ApplyCutsReturnCode rc = siP->applyCuts(cuts);
+    siP->resolve();
+    double lpRelaxAfter=siP->getObjValue();
+#ifdef CGL_DEBUG
+    printf("\n\nOrig LP min=%f\n",lpRelaxBefore);
+    printf("Final LP min=%f\n\n",lpRelaxAfter);
+#endif
+    assert (lpRelaxAfter<=2.0+1.0e-7);
+    if (!(lpRelaxBefore < lpRelaxAfter)){
+       printf("***Warning: Bound did not improve after addition of cut.\n");
+       printf("***This can happen, but is generally not expected\n");
+    }
+    delete siP;
+  }
+}
@@ -8,6 +8,7 @@
 #include <cmath>
 #include <cfloat>
 #include <iostream>
+#include <algorithm>
 
 #include "CoinPragma.hpp"
 #include "CoinHelperFunctions.hpp"
@@ -15,6 +16,7 @@
 #include "CoinPackedMatrix.hpp"
 #include "OsiRowCutDebugger.hpp"
 #include "CglOddHole.hpp"
+#include "CglThreads.hpp"
 //#define CGL_DEBUG
 // We may want to sort cut
 typedef struct {double dj;double element; int sequence;} 
@@ -26,6 +28,319 @@ public:
     return ( x.dj < y.dj);
   }
 }; 
+// For shortest paths
+typedef struct {
+  double cost; //cost to starting node
+  int back; //previous node
+  int stamp; //cost and back only valid if stamp is for this starting node
+  int position; //position in heap (-1 if not in heap)
+} Path;
+// Moves node at position up heap (keyed on path cost)
+static void heapUp(int * heap, Path * path, int position)
+{
+  int node=heap[position];
+  double thisCost=path[node].cost;
+  while (position) {
+    int parent=(position-1)>>1;
+    int parentNode=heap[parent];
+    if (path[parentNode].cost<=thisCost)
+      break;
+    heap[position]=parentNode;
+    path[parentNode].position=position;
+    position=parent;
+  }
+  heap[position]=node;
+  path[node].position=position;
+}
+// Moves node at position down heap of size nHeap
+static void heapDown(int * heap, Path * path, int nHeap, int position)
+{
+  int node=heap[position];
+  double thisCost=path[node].cost;
+  while (true) {
+    int child=2*position+1;
+    if (child>=nHeap)
+      break;
+    if (child+1<nHeap&&path[heap[child+1]].cost<path[heap[child]].cost)
+      child++;
+    int childNode=heap[child];
+    if (path[childNode].cost>=thisCost)
+      break;
+    heap[position]=childNode;
+    path[childNode].position=position;
+    position=child;
+  }
+  heap[position]=node;
+  path[node].position=position;
+}
+// Work space for one thread
+typedef struct {
+  Path * path;
+  int * heap;
+  int * mark;
+  int * clean;
+  int * candidate;
+  int * cycleRow;
+  double * element;
+  double_double_int_triple * sortit;
+  int * countcol;
+} CglOddHoleWork;
+// What is needed to look for odd cycles from each starting node
+typedef struct {
+  // doubled graph
+  const int * starts;
+  const int * to;
+  const double * cost;
+  const int * rowfound;
+  int nSmall;
+  // row copy
+  const int * column;
+  const CoinBigIndex * rowStart;
+  const int * rowLength;
+  const double * solution;
+  const double * dj;
+  // random numbers to winnow out duplicate cuts
+  const double * check;
+  double minimumViolation;
+  double minimumViolationPer;
+  int maximumEntries;
+  bool packed;
+  // first starting node of each task
+  const int * taskStart;
+  // cut (or NULL) and its hash value for each starting node
+  OsiRowCut ** cut;
+  double * hash;
+  CglOddHoleWork * work;
+} CglOddHoleInfo;
+// Looks for odd cycle from starting node icol
+static OsiRowCut * oddHoleCut(const CglOddHoleInfo & info,
+			      CglOddHoleWork & work, int icol, double & hash)
+{
+  const int * starts = info.starts;
+  const int * to = info.to;
+  const double * cost = info.cost;
+  const int * rowfound = info.rowfound;
+  const int nSmall = info.nSmall;
+  const int * column = info.column;
+  const CoinBigIndex * rowStart = info.rowStart;
+  const int * rowLength = info.rowLength;
+  const double * solution = info.solution;
+  const double * dj = info.dj;
+  const bool packed = info.packed;
+  Path * path = work.path;
+  int * heap = work.heap;
+  int * mark = work.mark;
+  int * clean = work.clean;
+  int * candidate = work.candidate;
+  int * cycleRow = work.cycleRow;
+  double * element = work.element;
+  double_double_int_triple * sortit = work.sortit;
+  int * countcol = work.countcol;
+  const double maxPathCost=0.9999;
+  int bias = packed ? 0 : 1; //amount to add before halving
+  int j;
+  int jcol=icol+nSmall;
+  int nHeap=1;
+  path[icol].cost=0.0;
+  path[icol].back=-1;
+  path[icol].stamp=icol;
+  heap[0]=icol;
+  path[icol].position=0;
+  while(nHeap) {
+    int inode=heap[0];
+    path[inode].position=-1;
+    if (--nHeap) {
+      heap[0]=heap[nHeap];
+      heapDown(heap,path,nHeap,0);
+    }
+    // finished if got to other copy of starting node
+    if (inode==jcol)
+      break;
+    double thisCost=path[inode].cost;
+    int k;
+    for (k=starts[inode];k<starts[inode+1];k++) {
+      int jnode=to[k];
+      double newCost=thisCost+cost[k];
+      if (newCost>=maxPathCost)
+	continue; // no good for cut
+      if (path[jnode].stamp!=icol) {
+	// first time reached
+	path[jnode].stamp=icol;
+	path[jnode].cost=newCost;
+	path[jnode].back=inode;
+	heap[nHeap]=jnode;
+	heapUp(heap,path,nHeap++);
+      } else if (path[jnode].position>=0&&
+		 newCost<path[jnode].cost-1.0e-12) {
+	// still in heap and better
+	path[jnode].cost=newCost;
+	path[jnode].back=inode;
+	heapUp(heap,path,path[jnode].position);
+      }
+    }
+  }
+  // clear anything left in heap
+  for (j=0;j<nHeap;j++)
+    path[heap[j]].position=-1;
+  if (path[jcol].stamp!=icol||path[jcol].cost>=maxPathCost)
+    return NULL;
+  int ii;
+  int nrow2=0;
+  int nclean=0;
+  double sum=0;
+#ifdef CGL_DEBUG
+  printf("** %d ",jcol-nSmall);
+#endif
+  ii=1;
+  candidate[0]=jcol;
+  while(jcol!=icol) {
+    int jjcol;
+    jcol=path[jcol].back;
+    if (jcol>=nSmall) {
+      jjcol=jcol-nSmall;
+    } else {
+      jjcol=jcol;
+    }
+#ifdef CGL_DEBUG
+    printf(" %d",jjcol);
+#endif
+    if (mark[jjcol]) {
+      // probably means this is from another cycle (will have been found)
+      // one of cycles must be zero cost
+      // printf("variable already on chain!\n");
+    } else {
+      mark[jjcol]=1;
+      clean[nclean++]=jjcol;
+      candidate[ii++]=jcol;
+    }
+  }
+#ifdef CGL_DEBUG
+  printf("\n");
+#endif
+  for (j=0;j<nclean;j++) {
+    int k=clean[j];
+    mark[k]=0;
+  }
+  int k;
+  for (k=ii-1;k>0;k--) {
+    int jk,kk=candidate[k];
+    int ix=0;
+    for (jk=starts[kk];jk<starts[kk+1];jk++) {
+      int ito=to[jk];
+      if (ito==candidate[k-1]) {
+	ix=1;
+	// back to original row
+	cycleRow[nrow2++]=rowfound[jk];
+	break;
+      }
+    }
+    if (!ix)
+      return NULL;
+  }
+  if ((nrow2&1)!=1)
+    return NULL;
+  int nincut=0;
+  for (k=0;k<nrow2;k++) {
+    int irow=cycleRow[k];
+    for (j=rowStart[irow];j<rowStart[irow]+rowLength[irow];j++) {
+      int icol=column[j];
+      if (!countcol[icol]) candidate[nincut++]=icol;
+      countcol[icol]++;
+    }
+  }
+#ifdef CGL_DEBUG
+  printf("true constraint %d",nrow2);
+#endif
+  nrow2=nrow2>>1;
+  double rhs=nrow2; 
+  if (!packed) rhs++; // +1 for cover
+  ii=0;
+  for (k=0;k<nincut;k++) {
+    int jcol=candidate[k];
+    if (countcol[jcol]) {
+#ifdef CGL_DEBUG
+      printf(" %d %d",jcol,countcol[jcol]);
+#endif
+      int ihalf=(countcol[jcol]+bias)>>1;
+      if (ihalf) {
+	element[ii]=ihalf;
+	sum+=solution[jcol]*element[ii];
+	candidate[ii++]=jcol;
+      }
+      countcol[jcol]=0;
+    }
+  }
+#ifdef CGL_DEBUG
+  printf("\n");
+#endif
+  double violation = packed ? sum-rhs : rhs-sum;
+  if (violation<info.minimumViolation) {
+#ifdef CGL_DEBUG
+    printf("why no cut\n");
+#endif
+    return NULL;
+  }
+  if (static_cast<double> (ii) * info.minimumViolationPer>violation||
+      ii>info.maximumEntries) {
+#ifdef CGL_DEBUG
+    printf("why no cut\n");
+#endif
+    if (!packed)
+      return NULL;
+    // sort and see if we can get down to length
+    // relax by taking out ones with solution 0.0
+    nincut=ii;
+    for (k=0;k<nincut;k++) {
+      int jcol=candidate[k];
+      double value = fabs(dj[jcol]);
+      if (solution[jcol])
+	value = -solution[jcol];
+      sortit[k].dj=value;
+      sortit[k].element=element[k];
+      sortit[k].sequence=jcol;
+    }
+    // sort 
+    std::sort(sortit,sortit+nincut,double_double_int_triple_compare());
+    nincut = CoinMin(nincut,info.maximumEntries);
+    sum=0.0;
+    for (k=0;k<nincut;k++) {
+      int jcol=sortit[k].sequence;
+      candidate[k]=jcol;
+      element[k]=sortit[k].element;
+      sum+=solution[jcol]*element[k];
+    }
+    violation = sum-rhs;
+    ii=nincut;
+    if (violation<info.minimumViolation)
+      return NULL;
+  }
+  OsiRowCut * rc = new OsiRowCut();
+  if (packed) {
+    rc->setLb(-COIN_DBL_MAX);
+    rc->setUb(rhs);   
+  } else {
+    // other way for cover
+    rc->setUb(COIN_DBL_MAX);
+    rc->setLb(rhs);   
+  }
+  rc->setRow(ii,candidate,element);
+  CoinPackedVector candidatePv(ii,candidate,element);
+  candidatePv.sortIncrIndex();
+  hash = candidatePv.dotProduct(info.check);
+#ifdef CGL_DEBUG
+  printf("sum %g rhs %g %d\n",sum,rhs,ii);
+#endif
+  return rc;
+}
+// Looks for odd cycles from one block of starting nodes
+static void oddHoleTask(void * voidInfo, int iTask, int iThread)
+{
+  CglOddHoleInfo * info = reinterpret_cast<CglOddHoleInfo *> (voidInfo);
+  CglOddHoleWork & work = info->work[iThread];
+  for (int icol=info->taskStart[iTask];icol<info->taskStart[iTask+1];
+       icol++)
+    info->cut[icol] = oddHoleCut(*info,work,icol,info->hash[icol]);
+}
 //-------------------------------------------------------------------------------
 // Generate three cycle cuts
 //------------------------------------------------------------------- 
@@ -45,6 +360,7 @@ void CglOddHole::generateCuts(const OsiSolverInterface & si, OsiCuts & cs,
   // If it does then suitable rows are subset of information
   
   CglOddHole temp;
+  temp.numberThreads_=numberThreads_;
   int * checkRow = new int[nRows];
   int i;
   if (!suitableRows_) {
@@ -303,281 +619,100 @@ void CglOddHole::generateCuts(const OsiRowCutDebugger * /*debugger*/,
     }
   }
 
-  // Shortest path algorithm from Dijkstra - is there a better one?
-
-  typedef struct {
-    double cost; //cost to starting node
-    int back; //previous node
-  } Path;
-  typedef struct {
-    double cost; //cost to starting node
-    int node; //node
-  } Item;
-  Item * stack = new Item [nSmall2];
-  Path * path = new Path [nSmall2];
-  // arrays below are used only if looks promising
-  // allocate here
-  // we don't know how many cuts will be generated
-  int ncuts=0;
-  int maxcuts=1000;
-  double * hash = reinterpret_cast<double *> (malloc(maxcuts*sizeof(double)));
-  // to clean (should not be needed)
-  int * clean = new int[nSmall2];
-  int * candidate = new int[CoinMax(nSmall2,nCols)];
-  double * element = new double[nCols];
-  // in case we want to sort
-  double_double_int_triple * sortit = 
-    new double_double_int_triple [nCols];
-  memset(mark,0,nSmall2*sizeof(int));
-  int * countcol = new int[nCols];
-  memset(countcol,0,nCols*sizeof(int));
-  int bias = packed ? 0 : 1; //amount to add before halving
-  // If nSmall large then should do a randomized subset
-  // Improvement 1
-  int icol;
-  for (icol=0;icol<nSmall;icol++) {
-    int j;
-    int jcol=icol+nSmall;
-    int istack=1;
-    for (j=0;j<nSmall2;j++) {
-      path[j].cost=1.0e70;
-      path[j].back=nSmall2+1;
+  // Shortest path algorithm from Dijkstra using a binary heap.
+  // Costs are positive and only paths of cost less than one can give a
+  // violated cut so we can stop as soon as cost gets that large.
+  // Path entries are stamped with starting node so they need not be
+  // cleared for each one.
+  // Each starting node is independent so blocks of them can be done
+  // in parallel - each thread has its own work space.
+  int numberThreads = CglNumberThreads(numberThreads_,nSmall);
+  int numberTasks = (numberThreads>1) ? CoinMin(4*numberThreads,nSmall) : 1;
+  int * taskStart = new int [numberTasks+1];
+  for (i=0;i<=numberTasks;i++)
+    taskStart[i]=(nSmall*i)/numberTasks;
+  CglOddHoleInfo oddInfo;
+  oddInfo.starts=starts;
+  oddInfo.to=to;
+  oddInfo.cost=cost;
+  oddInfo.rowfound=rowfound;
+  oddInfo.nSmall=nSmall;
+  oddInfo.column=column;
+  oddInfo.rowStart=rowStart;
+  oddInfo.rowLength=rowLength;
+  oddInfo.solution=solution;
+  oddInfo.dj=dj;
+  oddInfo.check=check;
+  oddInfo.minimumViolation=minimumViolation_;
+  oddInfo.minimumViolationPer=minimumViolationPer_;
+  oddInfo.maximumEntries=maximumEntries_;
+  oddInfo.packed=packed;
+  oddInfo.taskStart=taskStart;
+  oddInfo.cut = new OsiRowCut * [nSmall];
+  oddInfo.hash = new double [nSmall];
+  oddInfo.work = new CglOddHoleWork [numberThreads];
+  int iThread;
+  for (iThread=0;iThread<numberThreads;iThread++) {
+    CglOddHoleWork & work = oddInfo.work[iThread];
+    work.path = new Path [nSmall2];
+    for (i=0;i<nSmall2;i++) {
+      work.path[i].stamp=-1;
+      work.path[i].position=-1;
     }
-    path[icol].cost=0.0;
-    path[icol].back=-1;
-    stack[0].cost=0.0;
-    stack[0].node=icol;
-    mark[icol]=1;
-    while(istack) {
-      Item thisItem=stack[--istack];
-      double thisCost=thisItem.cost;
-      int inode=thisItem.node;
-      int k;
-      mark[inode]=0; //say available for further work
-      // See if sorting every so many would help (and which way)?
-      // Improvement 2
-      for (k=starts[inode];k<starts[inode+1];k++) {
-	int jnode=to[k];
-	if (!mark[jnode]&&thisCost+cost[k]<path[jnode].cost-1.0e-12) {
-	  path[jnode].cost=thisCost+cost[k];
-	  path[jnode].back=inode;
-	  // add to stack
-	  stack[istack].cost=path[jnode].cost;
-	  stack[istack++].node=jnode;
-	  mark[jnode]=1;
-#ifdef CGL_DEBUG
-	  assert (istack<=nSmall2);
-#endif
-	}
-      }
+    work.heap = new int [nSmall2];
+    work.mark = new int [nSmall2];
+    memset(work.mark,0,nSmall2*sizeof(int));
+    work.clean = new int [nSmall2];
+    work.candidate = new int [CoinMax(nSmall2,nCols)];
+    work.cycleRow = new int [nSmall2];
+    work.element = new double [nCols];
+    work.sortit = new double_double_int_triple [nCols];
+    work.countcol = new int [nCols];
+    memset(work.countcol,0,nCols*sizeof(int));
+  }
+  CglRunTasks(numberThreads,numberTasks,oddHoleTask,&oddInfo);
+  // Same cut may come from several starting nodes - keep first
+  int ncuts=0;
+  std::pair<double,int> * hash = new std::pair<double,int> [nSmall];
+  for (i=0;i<nSmall;i++) {
+    if (oddInfo.cut[i])
+      hash[ncuts++]=std::make_pair(oddInfo.hash[i],i);
+  }
+  std::sort(hash,hash+ncuts);
+  for (i=1;i<ncuts;i++) {
+    if (hash[i].first==hash[i-1].first) {
+      //could check equality - quicker just to assume
+      int k=hash[i].second;
+      delete oddInfo.cut[k];
+      oddInfo.cut[k]=NULL;
     }
-    bool good=(path[jcol].cost<0.9999);
-
-    if (good)  { /* try */
-      int ii;
-      int nrow2=0;
-      int nclean=0;
-      double sum=0;
-#ifdef CGL_DEBUG
-      printf("** %d ",jcol-nSmall);
-#endif
-      ii=1;
-      candidate[0]=jcol;
-      while(jcol!=icol) {
-	int jjcol;
-	jcol=path[jcol].back;
-	if (jcol>=nSmall) {
-	  jjcol=jcol-nSmall;
-	} else {
-	  jjcol=jcol;
-	}
-#ifdef CGL_DEBUG
-	printf(" %d",jjcol);
-#endif
-	if (mark[jjcol]) {
-	  // good=false;
-	  // probably means this is from another cycle (will have been found)
-	  // one of cycles must be zero cost
-	  // printf("variable already on chain!\n");
-	} else {
-	  mark[jjcol]=1;
-	  clean[nclean++]=jjcol;
-	  candidate[ii++]=jcol;
-#ifdef CGL_DEBUG
-	  assert (ii<=nSmall2);
-#endif
-	}
-      }
-#ifdef CGL_DEBUG
-      printf("\n");
-#endif
-      for (j=0;j<nclean;j++) {
-	int k=clean[j];
-	mark[k]=0;
-      }
-      if (good) {
-	int k;
-	for (k=ii-1;k>0;k--) {
-	  int jk,kk=candidate[k];
-	  int ix=0;
-	  for (jk=starts[kk];jk<starts[kk+1];jk++) {
-	    int ito=to[jk];
-	    if (ito==candidate[k-1]) {
-	      ix=1;
-	      // back to original row
-	      mrow[nrow2++]=rowfound[jk];
-	      break;
-	    }
-	  }
-	  if (!ix) {
-	    good=false;
-	  }
-	}
-	if ((nrow2&1)!=1) {
-	  good=false;
-	}
-	if (good) {
-	  int nincut=0;
-	  for (k=0;k<nrow2;k++) {
-	    int j,irow=mrow[k];
-	    for (j=rowStart[irow];j<rowStart[irow]+rowLength[irow];j++) {
-	      int icol=column[j];
-	      if (!countcol[icol]) candidate[nincut++]=icol;
-	      countcol[icol]++;
-	    }
-	  }
-#ifdef CGL_DEBUG
-	  printf("true constraint %d",nrow2);
-#endif
-	  nrow2=nrow2>>1;
-	  double rhs=nrow2; 
-	  if (!packed) rhs++; // +1 for cover
-	  ii=0;
-	  for (k=0;k<nincut;k++) {
-	    int jcol=candidate[k];
-	    if (countcol[jcol]) {
-#ifdef CGL_DEBUG
-	      printf(" %d %d",jcol,countcol[jcol]);
-#endif
-	      int ihalf=(countcol[jcol]+bias)>>1;
-	      if (ihalf) {
-		element[ii]=ihalf;
-		sum+=solution[jcol]*element[ii];
-		/*printf("%d %g %g\n",jcol,element[ii],sumall[jcol]);*/
-		candidate[ii++]=jcol;
-	      }
-	      countcol[jcol]=0;
-	    }
-	  }
-#ifdef CGL_DEBUG
-          printf("\n");
-#endif
-	  OsiRowCut rc;
-	  double violation=0.0;
-	  if (packed) {
-	    violation = sum-rhs;
-	    rc.setLb(-COIN_DBL_MAX);
-	    rc.setUb(rhs);   
-	  } else {
-	    // other way for cover
-	    violation = rhs-sum;
-	    rc.setUb(COIN_DBL_MAX);
-	    rc.setLb(rhs);   
-	  }
-	  if (violation<minimumViolation_) {
-#ifdef CGL_DEBUG
-	    printf("why no cut\n");
-#endif
-	    good=false;
-	  } else {
-	    if (static_cast<double> (ii) * minimumViolationPer_>violation||
-		ii>maximumEntries_) {
-#ifdef CGL_DEBUG
-	      printf("why no cut\n");
-#endif
-	      if (packed) {
-		// sort and see if we can get down to length
-		// relax by taking out ones with solution 0.0
-		nincut=ii;
-		for (k=0;k<nincut;k++) {
-		  int jcol=candidate[k];
-		  double value = fabs(dj[jcol]);
-		  if (solution[jcol])
-		  value = -solution[jcol];
-		  sortit[k].dj=value;
-		  sortit[k].element=element[k];
-		  sortit[k].sequence=jcol;
-		}
-		// sort 
-		std::sort(sortit,sortit+nincut,double_double_int_triple_compare());
-		nincut = CoinMin(nincut,maximumEntries_);
-		sum=0.0;
-		for (k=0;k<nincut;k++) {
-		  int jcol=sortit[k].sequence;
-		  candidate[k]=jcol;
-		  element[k]=sortit[k].element;
-		  sum+=solution[jcol]*element[k];
-		}
-		violation = sum-rhs;
-		ii=nincut;
-		if (violation<minimumViolation_) {
-		  good=false;
-		}
-	      } else { 
-		good=false;
-	      }
-	    }
-	  }
-	  if (good) {
-	    //this assumes not many cuts
-	    int j;
-#if 0
-	    double value=0.0;
-	    for (j=0;j<ii;j++) {
-	      int icol=candidate[j];
-	      value += check[icol]*element[j];
-	    }
-#else
-            CoinPackedVector candidatePv(ii,candidate,element);
-            candidatePv.sortIncrIndex();
-            double value = candidatePv.dotProduct(check);
-#endif
-
-	    for (j=0;j<ncuts;j++) {
-	      if (value==hash[j]) {
-		//could check equality - quicker just to assume
-		break;
-	      }
-	    }
-	    if (j==ncuts) {
-	      //new
-	      if (ncuts==maxcuts) {
-		maxcuts *= 2;
-		hash = reinterpret_cast<double *> (realloc(hash,maxcuts*sizeof(double)));
-	      }
-	      hash[ncuts++]=value;
-	      rc.setRow(ii,candidate,element);
+  }
+  for (i=0;i<nSmall;i++) {
+    if (oddInfo.cut[i]) {
 #ifdef CGL_DEBUG
-	      printf("sum %g rhs %g %d\n",sum,rhs,ii);
-	      if (debugger) 
-		assert(!debugger->invalidCut(rc)); 
+      if (debugger) 
+	assert(!debugger->invalidCut(*oddInfo.cut[i])); 
 #endif
-	      cs.insert(rc);
-	    }
-	  }
-	}
-	/* end of adding cut */
-      }
+      cs.insert(oddInfo.cut[i]);
     }
   }
-  delete [] countcol;
-  delete [] element;
-  delete [] candidate;
-  delete [] sortit;
-  delete [] clean;
-  delete [] path;
-  delete [] stack;
-  free(hash);
+  delete [] hash;
+  for (iThread=0;iThread<numberThreads;iThread++) {
+    CglOddHoleWork & work = oddInfo.work[iThread];
+    delete [] work.path;
+    delete [] work.heap;
+    delete [] work.mark;
+    delete [] work.clean;
+    delete [] work.candidate;
+    delete [] work.cycleRow;
+    delete [] work.element;
+    delete [] work.sortit;
+    delete [] work.countcol;
+  }
+  delete [] oddInfo.work;
+  delete [] oddInfo.cut;
+  delete [] oddInfo.hash;
+  delete [] taskStart;
   delete [] check;
   delete [] mark;
   delete [] starts;
@@ -705,6 +840,7 @@ onetol_(1-epsilon_)
   minimumViolation_=0.001;
   minimumViolationPer_=0.0003;
   maximumEntries_=100;
+  numberThreads_=1;
 }
 
 //-------------------------------------------------------------------
@@ -740,6 +876,7 @@ onetol_(source.onetol_)
   minimumViolation_=source.minimumViolation_;
   minimumViolationPer_=source.minimumViolationPer_;
   maximumEntries_=source.maximumEntries_;
+  numberThreads_=source.numberThreads_;
 }
 
 //-------------------------------------------------------------------
@@ -795,6 +932,7 @@ CglOddHole::operator=(
     minimumViolation_=rhs.minimumViolation_;
     minimumViolationPer_=rhs.minimumViolationPer_;
     maximumEntries_=rhs.maximumEntries_;
+    numberThreads_=rhs.numberThreads_;
   }
   return *this;
 }
@@ -34,8 +34,11 @@ public:
       Insert the generated cuts into OsiCut, cs.
 
       This is only done for rows with unsatisfied 0-1 variables.  If there
-      are many of these it will be slow.  Improvements would do a 
-      randomized subset and also speed up shortest path algorithm used.
+      are many of these it will be slow.  Shortest paths use Dijkstra
+      with a heap and stop once cost is too large to give a violated cut.
+      Each variable is used as a starting node and these searches can be
+      split across threads (see setNumberThreads).  Cuts are the same
+      whatever the number of threads.
 
   */
   virtual void generateCuts( const OsiSolverInterface & si, OsiCuts & cs,
@@ -77,6 +80,12 @@ public:
   /// Maximum number of entries in a cut
   int getMaximumEntries() const;
   void setMaximumEntries(int value);
+  /// Set number of threads to use for shortest paths (default 1)
+  inline void setNumberThreads(int value)
+  { numberThreads_ = value;}
+  /// Get number of threads
+  inline int numberThreads() const
+  { return numberThreads_;}
   //@}
 
   /**@name Constructors and destructors */
@@ -145,6 +154,8 @@ private:
   int numberRows_;
   /// number of cliques
   int numberCliques_;
+  /// Number of threads to use
+  int numberThreads_;
   //@}
 };
 
@@ -40,6 +40,16 @@ CglOddHoleUnitTest(
     }
   }
 
+  // Test get/set methods
+  {
+    CglOddHole getset;
+    assert (getset.numberThreads() == 1);
+    getset.setNumberThreads(4);
+    assert (getset.numberThreads() == 4);
+    CglOddHole copy(getset);
+    assert (copy.numberThreads() == 4);
+  }
+
 
   // test on simple case
   {  
@@ -71,7 +81,59 @@ CglOddHoleUnitTest(
     rpv.sortIncrIndex();
     assert (check==rpv);
   }
-  
+
+  // Same cuts whatever number of threads - 5-hole and 7-hole
+  // (without CGL_THREAD starting nodes are still split into tasks)
+  {
+    const int nRows=12;
+    const int nCols=12;
+    const int nEls=24;
+    double elem[nEls];
+    int column[nEls];
+    CoinBigIndex start[nRows];
+    int len[nRows];
+    for (int iRow=0;iRow<nRows;iRow++) {
+      // edge iRow - iRow+1 round each hole
+      int first = (iRow<5) ? 0 : 5;
+      int size = (iRow<5) ? 5 : 7;
+      start[iRow]=2*iRow;
+      len[iRow]=2;
+      column[2*iRow]=iRow;
+      column[2*iRow+1]=first+(iRow-first+1)%size;
+      elem[2*iRow]=1.0;
+      elem[2*iRow+1]=1.0;
+    }
+    CoinPackedMatrix matrix(false,nCols,nRows,nEls,elem,column,start,len);
+    double sol[nCols];
+    double dj[nCols];
+    int which[nRows];
+    int fixed[nCols];
+    for (int i=0;i<nCols;i++) {
+      sol[i]=0.5;
+      dj[i]=0.0;
+      which[i]=1;
+      fixed[i]=0;
+    }
+    CglTreeInfo info;
+    info.randomNumberGenerator=NULL;
+    OsiCuts cs;
+    CglOddHole test1;
+    test1.generateCuts(NULL,matrix,sol,dj,cs,which,fixed,info,true);
+    int nRowCuts = cs.sizeRowCuts();
+    assert (nRowCuts==2);
+    for (int i=0;i<nRowCuts;i++)
+      assert (cs.rowCut(i).violated(sol)>0.1);
+    for (int numberThreads=2;numberThreads<=8;numberThreads*=2) {
+      OsiCuts cs2;
+      CglOddHole test2;
+      test2.setNumberThreads(numberThreads);
+      test2.generateCuts(NULL,matrix,sol,dj,cs2,which,fixed,info,true);
+      assert (cs2.sizeRowCuts()==nRowCuts);
+      for (int i=0;i<nRowCuts;i++)
+	assert (cs2.rowCut(i)==cs.rowCut(i));
+    }
+  }
+
   // Testcase /u/rlh/osl2/mps/scOneInt.mps
   // Model has 3 continous, 2 binary, and 1 general
   // integer variable.
@@ -24,6 +24,8 @@
 #include "CoinHelperFunctions.hpp"
 #include "CoinWarmStartBasis.hpp"
 
+#include "CglThreads.hpp"
+
 #include "CglProbing.hpp"
 #include "CglDuplicateRow.hpp"
 #include "CglClique.hpp"
@@ -1116,6 +1118,22 @@ static void writeDebugMps(const OsiSolverInterface * solver,
 #else
 #define writeDebugMps(x,y,z)
 #endif
+// Rows, columns, elements and fixed columns for profiling
+static void profileSize(const OsiSolverInterface * model, int * size)
+{
+  int numberColumns = model->getNumCols();
+  const double * columnLower = model->getColLower();
+  const double * columnUpper = model->getColUpper();
+  int numberFixed=0;
+  for (int iColumn=0;iColumn<numberColumns;iColumn++) {
+    if (columnLower[iColumn]==columnUpper[iColumn])
+      numberFixed++;
+  }
+  size[0]=model->getNumRows();
+  size[1]=numberColumns;
+  size[2]=model->getNumElements();
+  size[3]=numberFixed;
+}
 OsiSolverInterface *
 CglPreProcess::preProcessNonDefault(OsiSolverInterface & model, 
 				    int makeEquality, int numberPasses,
@@ -1145,6 +1163,7 @@ CglPreProcess::preProcessNonDefault(OsiSolverInterface & model,
    }
 # endif
   originalModel_ = & model;
+  profile_.clear();
   if (tuning>=1000000) {
     numberPasses=tuning/1000000;
     tuning %= 1000000;
@@ -1164,6 +1183,12 @@ CglPreProcess::preProcessNonDefault(OsiSolverInterface & model,
   delete [] originalRow_;
   originalColumn_=NULL;
   originalRow_=NULL;
+  delete [] postColumn_;
+  delete [] postRow_;
+  delete [] postValue_;
+  postColumn_=NULL;
+  postRow_=NULL;
+  postValue_=NULL;
   //startModel_=&model;
   // make clone
   delete startModel_;
@@ -2029,9 +2054,13 @@ CglPreProcess::preProcessNonDefault(OsiSolverInterface & model,
 #endif
     // So standalone version can switch off
     double feasibilityTolerance = ((tuning&1024)==0) ? CGL_PREPROCESS_TOLERANCE : 1.0e-4;
+    int startSize[4];
+    profileSize(oldModel,startSize);
+    double startTime = CoinGetTimeOfDay();
     presolvedModel = pinfo->presolvedModel(*oldModel,feasibilityTolerance,true,5,prohibited_,keepSolution,rowType_);
     oldModel->messageHandler()->setLogLevel(saveLogLevel);
     if (presolvedModel) {
+      addProfile(0,-1,-2,startTime,startSize,presolvedModel);
       presolvedModel->messageHandler()->setLogLevel(saveLogLevel);
       //presolvedModel->writeMps("new");
       writeDebugMps(presolvedModel,"ordinary",pinfo);
@@ -2066,7 +2095,11 @@ CglPreProcess::preProcessNonDefault(OsiSolverInterface & model,
   if (!infeas&&true) {
     // may be better to just do at end
     writeDebugMps(startModel2,"before",NULL);
+    int startSize[4];
+    profileSize(startModel2,startSize);
+    double startTime = CoinGetTimeOfDay();
     infeas = tightenPrimalBounds(*startModel2);
+    addProfile(0,-1,-4,startTime,startSize,startModel2);
     writeDebugMps(startModel2,"after",NULL);
   }
   if (infeas) {
@@ -2223,6 +2256,7 @@ CglPreProcess::preProcessNonDefault(OsiSolverInterface & model,
 #endif
     }
     for (int iPass=doInitialPresolve;iPass<numberSolvers_;iPass++) {
+      int firstStep = numberProfileSteps();
       // Look at Vubs
       {
         const double * columnLower = oldModel->getColLower();
@@ -2363,6 +2397,9 @@ CglPreProcess::preProcessNonDefault(OsiSolverInterface & model,
       oldModel->getStrParam(OsiSolverName,solverName);
       // Extend if you want other solvers to keep solution
       bool keepSolution=solverName=="clp";
+      int startSize[4];
+      profileSize(oldModel,startSize);
+      double startTime = CoinGetTimeOfDay();
       presolvedModel = pinfo->presolvedModel(*oldModel,CGL_PREPROCESS_TOLERANCE,true,5,
 					     prohibited_,keepSolution,rowType_);
       oldModel->messageHandler()->setLogLevel(saveLogLevel);
@@ -2371,6 +2408,7 @@ CglPreProcess::preProcessNonDefault(OsiSolverInterface & model,
 	delete pinfo;
         break;
       }
+      addProfile(iPass,-1,-2,startTime,startSize,presolvedModel);
       presolvedModel->messageHandler()->setLogLevel(saveLogLevel);
       // update prohibited and rowType
       update(pinfo,presolvedModel);
@@ -2427,6 +2465,16 @@ CglPreProcess::preProcessNonDefault(OsiSolverInterface & model,
       if (!numberChanges&&!numberFixed) {
 #if CBC_USEFUL_PRINTING>1
 	printf("exiting after pass %d of %d\n",iPass,numberSolvers_);
+#endif
+        numberSolvers_=iPass+1;
+        break;
+      }
+      // see if pass was worth doing
+      if (minimumReductionRate_>0.0&&iPass<numberSolvers_-1&&
+	  reductionRate(firstStep)<minimumReductionRate_) {
+#if CBC_USEFUL_PRINTING>1
+	printf("exiting after pass %d of %d - %g reductions per second\n",
+	       iPass,numberSolvers_,reductionRate(firstStep));
 #endif
         numberSolvers_=iPass+1;
         break;
@@ -2436,7 +2484,11 @@ CglPreProcess::preProcessNonDefault(OsiSolverInterface & model,
   if (returnModel) {
     if (returnModel->getNumRows()) {
       // tighten bounds
+      int startSize[4];
+      profileSize(returnModel,startSize);
+      double startTime = CoinGetTimeOfDay();
       int infeas = tightenPrimalBounds(*returnModel);
+      addProfile(numberSolvers_,-1,-4,startTime,startSize,returnModel);
       if (infeas) {
         delete returnModel;
 	for (int iPass=0;iPass<numberSolvers_;iPass++) {
@@ -2881,6 +2933,310 @@ CglPreProcess::preProcessNonDefault(OsiSolverInterface & model,
   return returnModel;
 }
 
+/* Tightens column bounds using one row.
+   Bounds are taken from columnLower and columnUpper and any tighter
+   bounds stored in newLower and newUpper (which may be the same arrays).
+   Columns with tighter bounds are added to changed (only if not
+   already marked if mark given).
+   Returns number of bounds tightened or -1 if row infeasible.
+   If newLower is NULL nothing is stored and 1 is returned as soon as
+   a bound would be tightened.
+*/
+static int tightenRow(int iRow, const int * column, const double * element,
+		      const CoinBigIndex * rowStart, const int * rowLength,
+		      const double * rowLower, const double * rowUpper,
+		      const double * columnLower, const double * columnUpper,
+		      double * newLower, double * newUpper,
+		      int * changed, int & numberChangedColumns, char * mark,
+		      int & numberInfeasible, double large, double tolerance)
+{
+#ifndef NDEBUG
+  double large2= 1.0e10*large;
+#endif
+  int numberChanged=0;
+  int iColumn;
+  // possible row
+  int infiniteUpper = 0;
+  int infiniteLower = 0;
+  double maximumUp = 0.0;
+  double maximumDown = 0.0;
+  double newBound;
+  CoinBigIndex rStart = rowStart[iRow];
+  CoinBigIndex rEnd = rowStart[iRow]+rowLength[iRow];
+  CoinBigIndex j;
+  // Compute possible lower and upper ranges
+
+  for (j = rStart; j < rEnd; ++j) {
+    double value=element[j];
+    iColumn = column[j];
+    if (value > 0.0) {
+      if (columnUpper[iColumn] >= large) {
+	++infiniteUpper;
+      } else {
+	maximumUp += columnUpper[iColumn] * value;
+      }
+      if (columnLower[iColumn] <= -large) {
+	++infiniteLower;
+      } else {
+	maximumDown += columnLower[iColumn] * value;
+      }
+    } else if (value<0.0) {
+      if (columnUpper[iColumn] >= large) {
+	++infiniteLower;
+      } else {
+	maximumDown += columnUpper[iColumn] * value;
+      }
+      if (columnLower[iColumn] <= -large) {
+	++infiniteUpper;
+      } else {
+	maximumUp += columnLower[iColumn] * value;
+      }
+    }
+  }
+  // Build in a margin of error
+  maximumUp += 1.0e-8*fabs(maximumUp);
+  maximumDown -= 1.0e-8*fabs(maximumDown);
+  double maxUp = maximumUp+infiniteUpper*1.0e31;
+  double maxDown = maximumDown-infiniteLower*1.0e31;
+  if (maxUp <= rowUpper[iRow] + tolerance && 
+      maxDown >= rowLower[iRow] - tolerance) {
+
+    // Row is redundant - make totally free
+  } else {
+    if (maxUp < rowLower[iRow] -100.0*tolerance ||
+	maxDown > rowUpper[iRow]+100.0*tolerance) {
+      // problem is infeasible - exit at once
+      return -1;
+    }
+    double lower = rowLower[iRow];
+    double upper = rowUpper[iRow];
+    for (j = rStart; j < rEnd; ++j) {
+      double value=element[j];
+      iColumn = column[j];
+      double nowLower = columnLower[iColumn];
+      double nowUpper = columnUpper[iColumn];
+      bool changedColumn=false;
+      if (value > 0.0) {
+	// positive value
+	if (lower>-large) {
+	  if (!infiniteUpper) {
+	    assert(nowUpper < large2);
+	    newBound = nowUpper + 
+	      (lower - maximumUp) / value;
+	    // relax if original was large
+	    if (fabs(maximumUp)>1.0e8)
+	      newBound -= 1.0e-12*fabs(maximumUp);
+	  } else if (infiniteUpper==1&&nowUpper>large) {
+	    newBound = (lower -maximumUp) / value;
+	    // relax if original was large
+	    if (fabs(maximumUp)>1.0e8)
+	      newBound -= 1.0e-12*fabs(maximumUp);
+	  } else {
+	    newBound = -COIN_DBL_MAX;
+	  }
+	  if (newBound > nowLower + 1.0e-12&&newBound>-large) {
+	    // Tighten the lower bound 
+	    if (!newLower)
+	      return 1; // only asked if row would tighten a bound
+	    newLower[iColumn] = CoinMax(newLower[iColumn],newBound);
+	    numberChanged++;
+	    changedColumn=true;
+	    // check infeasible (relaxed)
+	    if (nowUpper - newBound < 
+		-100.0*tolerance) {
+	      numberInfeasible++;
+	    }
+	    // adjust
+	    double now;
+	    if (nowLower<-large) {
+	      now=0.0;
+	      infiniteLower--;
+	    } else {
+	      now = nowLower;
+	    }
+	    maximumDown += (newBound-now) * value;
+	    nowLower = newBound;
+	  }
+	} 
+	if (upper <large) {
+	  if (!infiniteLower) {
+	    assert(nowLower >- large2);
+	    newBound = nowLower + 
+	      (upper - maximumDown) / value;
+	    // relax if original was large
+	    if (fabs(maximumDown)>1.0e8)
+	      newBound += 1.0e-12*fabs(maximumDown);
+	  } else if (infiniteLower==1&&nowLower<-large) {
+	    newBound =   (upper - maximumDown) / value;
+	    // relax if original was large
+	    if (fabs(maximumDown)>1.0e8)
+	      newBound += 1.0e-12*fabs(maximumDown);
+	  } else {
+	    newBound = COIN_DBL_MAX;
+	  }
+	  if (newBound < nowUpper - 1.0e-12&&newBound<large) {
+	    // Tighten the upper bound 
+	    if (!newLower)
+	      return 1; // only asked if row would tighten a bound
+	    newUpper[iColumn] = CoinMin(newUpper[iColumn],newBound);
+	    numberChanged++;
+	    changedColumn=true;
+	    // check infeasible (relaxed)
+	    if (newBound - nowLower < 
+		-100.0*tolerance) {
+	      numberInfeasible++;
+	    }
+	    // adjust 
+	    double now;
+	    if (nowUpper>large) {
+	      now=0.0;
+	      infiniteUpper--;
+	    } else {
+	      now = nowUpper;
+	    }
+	    maximumUp += (newBound-now) * value;
+	    nowUpper = newBound;
+	  }
+	}
+      } else {
+	// negative value
+	if (lower>-large) {
+	  if (!infiniteUpper) {
+	    assert(nowLower < large2);
+	    newBound = nowLower + 
+	      (lower - maximumUp) / value;
+	    // relax if original was large
+	    if (fabs(maximumUp)>1.0e8)
+	      newBound += 1.0e-12*fabs(maximumUp);
+	  } else if (infiniteUpper==1&&nowLower<-large) {
+	    newBound = (lower -maximumUp) / value;
+	    // relax if original was large
+	    if (fabs(maximumUp)>1.0e8)
+	      newBound += 1.0e-12*fabs(maximumUp);
+	  } else {
+	    newBound = COIN_DBL_MAX;
+	  }
+	  if (newBound < nowUpper - 1.0e-12&&newBound<large) {
+	    // Tighten the upper bound 
+	    if (!newLower)
+	      return 1; // only asked if row would tighten a bound
+	    newUpper[iColumn] = CoinMin(newUpper[iColumn],newBound);
+	    numberChanged++;
+	    changedColumn=true;
+	    // check infeasible (relaxed)
+	    if (newBound - nowLower < 
+		-100.0*tolerance) {
+	      numberInfeasible++;
+	    }
+	    // adjust
+	    double now;
+	    if (nowUpper>large) {
+	      now=0.0;
+	      infiniteLower--;
+	    } else {
+	      now = nowUpper;
+	    }
+	    maximumDown += (newBound-now) * value;
+	    nowUpper = newBound;
+	  }
+	}
+	if (upper <large) {
+	  if (!infiniteLower) {
+	    assert(nowUpper < large2);
+	    newBound = nowUpper + 
+	      (upper - maximumDown) / value;
+	    // relax if original was large
+	    if (fabs(maximumDown)>1.0e8)
+	      newBound -= 1.0e-12*fabs(maximumDown);
+	  } else if (infiniteLower==1&&nowUpper>large) {
+	    newBound =   (upper - maximumDown) / value;
+	    // relax if original was large
+	    if (fabs(maximumDown)>1.0e8)
+	      newBound -= 1.0e-12*fabs(maximumDown);
+	  } else {
+	    newBound = -COIN_DBL_MAX;
+	  }
+	  if (newBound > nowLower + 1.0e-12&&newBound>-large) {
+	    // Tighten the lower bound 
+	    if (!newLower)
+	      return 1; // only asked if row would tighten a bound
+	    newLower[iColumn] = CoinMax(newLower[iColumn],newBound);
+	    numberChanged++;
+	    changedColumn=true;
+	    // check infeasible (relaxed)
+	    if (nowUpper - newBound < 
+		-100.0*tolerance) {
+	      numberInfeasible++;
+	    }
+	    // adjust
+	    double now;
+	    if (nowLower<-large) {
+	      now=0.0;
+	      infiniteUpper--;
+	    } else {
+	      now = nowLower;
+	    }
+	    maximumUp += (newBound-now) * value;
+	    nowLower = newBound;
+	  }
+	}
+      }
+      if (changedColumn) {
+	if (!mark) {
+	  changed[numberChangedColumns++]=iColumn;
+	} else if (!mark[iColumn]) {
+	  mark[iColumn]=1;
+	  changed[numberChangedColumns++]=iColumn;
+	}
+      }
+    }
+  }
+  return numberChanged;
+}
+// Information for one task in parallel tightenPrimalBounds
+typedef struct {
+  const int * column;
+  const double * element;
+  const CoinBigIndex * rowStart;
+  const int * rowLength;
+  const double * rowLower;
+  const double * rowUpper;
+  // bounds at start of pass
+  const double * columnLower;
+  const double * columnUpper;
+  // rows for this pass
+  const int * whichRow;
+  int numberActive;
+  int numberTasks;
+  double large;
+  double tolerance;
+  // set for each row in whichRow - nonzero if row would tighten a bound
+  // (or is infeasible) with bounds at start of pass
+  char * rowFlag;
+} CglTightenInfo;
+// Looks at a block of rows using bounds at start of pass
+static void tightenTask(void * voidInfo, int iTask, int /*iThread*/)
+{
+  CglTightenInfo * info = reinterpret_cast<CglTightenInfo *> (voidInfo);
+  int first = static_cast<int>((static_cast<double>(info->numberActive)*iTask)/
+			       info->numberTasks);
+  int last = static_cast<int>((static_cast<double>(info->numberActive)*(iTask+1))/
+			      info->numberTasks);
+  int numberChangedColumns = 0;
+  int numberInfeasible = 0;
+  for (int i=first;i<last;i++) {
+    int iRow = info->whichRow[i];
+    // only flag - bounds are changed in serial pass
+    int n = tightenRow(iRow,info->column,info->element,
+		       info->rowStart,info->rowLength,
+		       info->rowLower,info->rowUpper,
+		       info->columnLower,info->columnUpper,
+		       NULL,NULL,NULL,numberChangedColumns,
+		       NULL,numberInfeasible,
+		       info->large,info->tolerance);
+    info->rowFlag[iRow] = (n!=0) ? 1 : 0;
+  }
+}
 /* Tightens primal bounds to make dual and branch and cutfaster.  Unless
    fixed, bounds are slightly looser than they could be.
    Returns non-zero if problem infeasible
@@ -2952,14 +3308,45 @@ CglPreProcess::tightenPrimalBounds(OsiSolverInterface & model,double factor)
   int numberRows = model.getNumRows();
   const double * rowLower = model.getRowLower();
   const double * rowUpper = model.getRowUpper();
-#ifndef NDEBUG
-  double large2= 1.0e10*large;
-#endif
 #define MAXPASS 10
 
   // Loop round seeing if we can tighten bounds
-  // Would be faster to have a stack of possible rows
-  // and we put altered rows back on stack
+  // Only rows with a column changed since they were last looked at
+  // are looked at again (which gives same bounds as looking at all)
+  const CoinPackedMatrix * columnCopy = model.getMatrixByCol();
+  const int * row = columnCopy->getIndices();
+  const CoinBigIndex * columnStart = columnCopy->getVectorStarts();
+  const int * columnLength = columnCopy->getVectorLengths(); 
+  // 1 look at this pass, 2 look at next pass
+  char * markRow = new char [numberRows];
+  memset(markRow,1,numberRows);
+  int * changed = new int [numberColumns];
+  /* If parallel then rows to be looked at in a pass are first looked at
+     by tasks using bounds at start of pass.  Then rows are done in order
+     as in serial case - but a row can be skipped if it would not tighten
+     any bound and none of its columns has been changed earlier in this
+     pass.  So bounds do not depend on number of threads. */
+  int numberTasks = numberThreads_;
+  CglTightenInfo parallelInfo;
+  int * whichRow = NULL;
+  char * rowFlag = NULL;
+  if (numberTasks>1) {
+    whichRow = new int [numberRows];
+    rowFlag = new char [numberRows];
+    parallelInfo.column = column;
+    parallelInfo.element = element;
+    parallelInfo.rowStart = rowStart;
+    parallelInfo.rowLength = rowLength;
+    parallelInfo.rowLower = rowLower;
+    parallelInfo.rowUpper = rowUpper;
+    parallelInfo.columnLower = newLower;
+    parallelInfo.columnUpper = newUpper;
+    parallelInfo.whichRow = whichRow;
+    parallelInfo.numberTasks = numberTasks;
+    parallelInfo.large = large;
+    parallelInfo.tolerance = tolerance;
+    parallelInfo.rowFlag = rowFlag;
+  }
   int numberCheck=-1;
   while(numberChanged>numberCheck) {
 
@@ -2968,233 +3355,59 @@ CglPreProcess::tightenPrimalBounds(OsiSolverInterface & model,double factor)
     if (iPass==MAXPASS) break;
     iPass++;
     
+    if (numberTasks>1) {
+      int numberActive=0;
+      for (iRow = 0; iRow < numberRows; iRow++) {
+	if (markRow[iRow]&&(rowLower[iRow]>-large||rowUpper[iRow]<large)) 
+	  whichRow[numberActive++]=iRow;
+      }
+      parallelInfo.numberActive = numberActive;
+      CglRunTasks(numberThreads_,numberTasks,tightenTask,&parallelInfo);
+    }
+    // 1 look at, 3 look at (column changed this pass), 2 next pass
     for (iRow = 0; iRow < numberRows; iRow++) {
-
+      if (markRow[iRow]!=1&&markRow[iRow]!=3)
+	continue;
+      bool columnChanged = (markRow[iRow]==3);
+      markRow[iRow]=0;
       if (rowLower[iRow]>-large||rowUpper[iRow]<large) {
-
-	// possible row
-	int infiniteUpper = 0;
-	int infiniteLower = 0;
-	double maximumUp = 0.0;
-	double maximumDown = 0.0;
-	double newBound;
-	CoinBigIndex rStart = rowStart[iRow];
-	CoinBigIndex rEnd = rowStart[iRow]+rowLength[iRow];
-	CoinBigIndex j;
-	// Compute possible lower and upper ranges
-      
-	for (j = rStart; j < rEnd; ++j) {
-	  double value=element[j];
-	  iColumn = column[j];
-	  if (value > 0.0) {
-	    if (newUpper[iColumn] >= large) {
-	      ++infiniteUpper;
-	    } else {
-	      maximumUp += newUpper[iColumn] * value;
-	    }
-	    if (newLower[iColumn] <= -large) {
-	      ++infiniteLower;
-	    } else {
-	      maximumDown += newLower[iColumn] * value;
-	    }
-	  } else if (value<0.0) {
-	    if (newUpper[iColumn] >= large) {
-	      ++infiniteLower;
-	    } else {
-	      maximumDown += newUpper[iColumn] * value;
-	    }
-	    if (newLower[iColumn] <= -large) {
-	      ++infiniteUpper;
-	    } else {
-	      maximumUp += newLower[iColumn] * value;
-	    }
-	  }
+	if (rowFlag&&!columnChanged&&!rowFlag[iRow])
+	  continue; // same bounds as at start of pass and nothing to do
+	int numberChangedColumns=0;
+	int n = tightenRow(iRow,column,element,rowStart,rowLength,
+			   rowLower,rowUpper,newLower,newUpper,
+			   newLower,newUpper,changed,numberChangedColumns,
+			   NULL,numberInfeasible,large,tolerance);
+	if (n<0) {
+	  // problem is infeasible - exit at once
+	  numberInfeasible++;
+	  break;
 	}
-	// Build in a margin of error
-	maximumUp += 1.0e-8*fabs(maximumUp);
-	maximumDown -= 1.0e-8*fabs(maximumDown);
-	double maxUp = maximumUp+infiniteUpper*1.0e31;
-	double maxDown = maximumDown-infiniteLower*1.0e31;
-	if (maxUp <= rowUpper[iRow] + tolerance && 
-	    maxDown >= rowLower[iRow] - tolerance) {
-	  
-	  // Row is redundant - make totally free
-	} else {
-	  if (maxUp < rowLower[iRow] -100.0*tolerance ||
-	      maxDown > rowUpper[iRow]+100.0*tolerance) {
-	    // problem is infeasible - exit at once
-	    numberInfeasible++;
-	    break;
-	  }
-	  double lower = rowLower[iRow];
-	  double upper = rowUpper[iRow];
-	  for (j = rStart; j < rEnd; ++j) {
-	    double value=element[j];
-	    iColumn = column[j];
-	    double nowLower = newLower[iColumn];
-	    double nowUpper = newUpper[iColumn];
-	    if (value > 0.0) {
-	      // positive value
-	      if (lower>-large) {
-		if (!infiniteUpper) {
-		  assert(nowUpper < large2);
-		  newBound = nowUpper + 
-		    (lower - maximumUp) / value;
-		  // relax if original was large
-		  if (fabs(maximumUp)>1.0e8)
-		    newBound -= 1.0e-12*fabs(maximumUp);
-		} else if (infiniteUpper==1&&nowUpper>large) {
-		  newBound = (lower -maximumUp) / value;
-		  // relax if original was large
-		  if (fabs(maximumUp)>1.0e8)
-		    newBound -= 1.0e-12*fabs(maximumUp);
-		} else {
-		  newBound = -COIN_DBL_MAX;
-		}
-		if (newBound > nowLower + 1.0e-12&&newBound>-large) {
-		  // Tighten the lower bound 
-		  newLower[iColumn] = newBound;
-		  numberChanged++;
-		  // check infeasible (relaxed)
-		  if (nowUpper - newBound < 
-		      -100.0*tolerance) {
-		    numberInfeasible++;
-		  }
-		  // adjust
-		  double now;
-		  if (nowLower<-large) {
-		    now=0.0;
-		    infiniteLower--;
-		  } else {
-		    now = nowLower;
-		  }
-		  maximumDown += (newBound-now) * value;
-		  nowLower = newBound;
-		}
-	      } 
-	      if (upper <large) {
-		if (!infiniteLower) {
-		  assert(nowLower >- large2);
-		  newBound = nowLower + 
-		    (upper - maximumDown) / value;
-		  // relax if original was large
-		  if (fabs(maximumDown)>1.0e8)
-		    newBound += 1.0e-12*fabs(maximumDown);
-		} else if (infiniteLower==1&&nowLower<-large) {
-		  newBound =   (upper - maximumDown) / value;
-		  // relax if original was large
-		  if (fabs(maximumDown)>1.0e8)
-		    newBound += 1.0e-12*fabs(maximumDown);
-		} else {
-		  newBound = COIN_DBL_MAX;
-		}
-		if (newBound < nowUpper - 1.0e-12&&newBound<large) {
-		  // Tighten the upper bound 
-		  newUpper[iColumn] = newBound;
-		  numberChanged++;
-		  // check infeasible (relaxed)
-		  if (newBound - nowLower < 
-		      -100.0*tolerance) {
-		    numberInfeasible++;
-		  }
-		  // adjust 
-		  double now;
-		  if (nowUpper>large) {
-		    now=0.0;
-		    infiniteUpper--;
-		  } else {
-		    now = nowUpper;
-		  }
-		  maximumUp += (newBound-now) * value;
-		  nowUpper = newBound;
-		}
-	      }
-	    } else {
-	      // negative value
-	      if (lower>-large) {
-		if (!infiniteUpper) {
-		  assert(nowLower < large2);
-		  newBound = nowLower + 
-		    (lower - maximumUp) / value;
-		  // relax if original was large
-		  if (fabs(maximumUp)>1.0e8)
-		    newBound += 1.0e-12*fabs(maximumUp);
-		} else if (infiniteUpper==1&&nowLower<-large) {
-		  newBound = (lower -maximumUp) / value;
-		  // relax if original was large
-		  if (fabs(maximumUp)>1.0e8)
-		    newBound += 1.0e-12*fabs(maximumUp);
-		} else {
-		  newBound = COIN_DBL_MAX;
-		}
-		if (newBound < nowUpper - 1.0e-12&&newBound<large) {
-		  // Tighten the upper bound 
-		  newUpper[iColumn] = newBound;
-		  numberChanged++;
-		  // check infeasible (relaxed)
-		  if (newBound - nowLower < 
-		      -100.0*tolerance) {
-		    numberInfeasible++;
-		  }
-		  // adjust
-		  double now;
-		  if (nowUpper>large) {
-		    now=0.0;
-		    infiniteLower--;
-		  } else {
-		    now = nowUpper;
-		  }
-		  maximumDown += (newBound-now) * value;
-		  nowUpper = newBound;
-		}
-	      }
-	      if (upper <large) {
-		if (!infiniteLower) {
-		  assert(nowUpper < large2);
-		  newBound = nowUpper + 
-		    (upper - maximumDown) / value;
-		  // relax if original was large
-		  if (fabs(maximumDown)>1.0e8)
-		    newBound -= 1.0e-12*fabs(maximumDown);
-		} else if (infiniteLower==1&&nowUpper>large) {
-		  newBound =   (upper - maximumDown) / value;
-		  // relax if original was large
-		  if (fabs(maximumDown)>1.0e8)
-		    newBound -= 1.0e-12*fabs(maximumDown);
-		} else {
-		  newBound = -COIN_DBL_MAX;
-		}
-		if (newBound > nowLower + 1.0e-12&&newBound>-large) {
-		  // Tighten the lower bound 
-		  newLower[iColumn] = newBound;
-		  numberChanged++;
-		  // check infeasible (relaxed)
-		  if (nowUpper - newBound < 
-		      -100.0*tolerance) {
-		    numberInfeasible++;
-		  }
-		  // adjust
-		  double now;
-		  if (nowLower<-large) {
-		    now=0.0;
-		    infiniteUpper--;
-		  } else {
-		    now = nowLower;
-		  }
-		  maximumUp += (newBound-now) * value;
-		  nowLower = newBound;
-		}
-	      }
-	    }
+	numberChanged += n;
+	// later rows this pass - earlier (and this) next pass
+	for (int k=0;k<numberChangedColumns;k++) {
+	  iColumn = changed[k];
+	  for (CoinBigIndex j=columnStart[iColumn];
+	       j<columnStart[iColumn]+columnLength[iColumn];j++) {
+	    int jRow = row[j];
+	    markRow[jRow] = (jRow>iRow) ? 3 : 2;
 	  }
 	}
       }
     }
+    for (iRow = 0; iRow < numberRows; iRow++) {
+      if (markRow[iRow])
+	markRow[iRow]=1;
+    }
     totalTightened += numberChanged;
     if (iPass==1)
       numberCheck=numberChanged>>4;
     if (numberInfeasible) break;
   }
+  delete [] whichRow;
+  delete [] rowFlag;
+  delete [] markRow;
+  delete [] changed;
   if (!numberInfeasible) {
     // Set bounds slightly loose unless integral - now tighter
     double useTolerance = 1.0e-5;
@@ -3418,6 +3631,8 @@ void
 CglPreProcess::postProcess(OsiSolverInterface & modelIn
 			   ,bool deleteStuff)
 {
+  // Maps for postProcessSolution need presolve information deleted below
+  createPostProcessMaps();
   // Do presolves
   bool saveHint;
   OsiHintStrength saveStrength;
@@ -3957,6 +4172,207 @@ CglPreProcess::postProcess(OsiSolverInterface & modelIn
   originalModel_->setHintParam(OsiDoDualInInitial,saveHint2,saveStrength2);
   originalModel_->setHintParam(OsiDoPresolveInInitial,saveHint,saveStrength);
 }
+/* Value of a column taken out by presolve if it can be got from
+   model presolve started with - fixed or empty */
+static double removedValue(const OsiSolverInterface * model, int iColumn)
+{
+  double lower = model->getColLower()[iColumn];
+  double upper = model->getColUpper()[iColumn];
+  if (lower==upper)
+    return lower;
+  if (model->getMatrixByCol()->getVectorLengths()[iColumn])
+    return COIN_DBL_MAX;
+  // empty - presolve will have put at best bound
+  double cost = model->getObjSense()*model->getObjCoefficients()[iColumn];
+  double infinity = model->getInfinity();
+  if (cost>0.0) {
+    return (lower>-infinity) ? lower : COIN_DBL_MAX;
+  } else if (cost<0.0) {
+    return (upper<infinity) ? upper : COIN_DBL_MAX;
+  } else if (lower>-infinity) {
+    return CoinMax(lower,CoinMin(0.0,upper));
+  } else {
+    return CoinMin(upper,0.0);
+  }
+}
+// Creates maps for postProcessSolution
+bool
+CglPreProcess::createPostProcessMaps()
+{
+  if (postColumn_)
+    return true;
+  if (!originalModel_||!startModel_)
+    return false;
+  // Find last presolve - all before must still exist
+  int lastPass;
+  for (lastPass=numberSolvers_-1;lastPass>=0;lastPass--) {
+    if (presolve_[lastPass])
+      break;
+  }
+  for (int iPass=0;iPass<=lastPass;iPass++) {
+    if (!presolve_[iPass]||!model_[iPass]||
+	(iPass&&!modifiedModel_[iPass-1]))
+      return false;
+  }
+  int numberColumns = originalModel_->getNumCols();
+  int numberRows = originalModel_->getNumRows();
+  postValue_ = new double [numberColumns];
+  for (int i=0;i<numberColumns;i++)
+    postValue_[i]=COIN_DBL_MAX;
+  // columns of model at this pass in terms of startModel_
+  int nColumns = startModel_->getNumCols();
+  int * map = new int [nColumns];
+  for (int i=0;i<nColumns;i++)
+    map[i]=i;
+  char * kept = new char [nColumns];
+  for (int iPass=0;iPass<=lastPass;iPass++) {
+    const OsiSolverInterface * model = iPass ? modifiedModel_[iPass-1] : startModel_;
+    const int * original = presolve_[iPass]->originalColumns();
+    int nColumnsNow = model_[iPass]->getNumCols();
+    memset(kept,0,nColumns);
+    for (int i=0;i<nColumnsNow;i++)
+      kept[original[i]]=1;
+    for (int i=0;i<nColumns;i++) {
+      int iColumn = map[i];
+      if (!kept[i]&&iColumn<numberColumns)
+	postValue_[iColumn] = removedValue(model,i);
+    }
+    for (int i=0;i<nColumnsNow;i++)
+      map[i]=map[original[i]];
+    nColumns = nColumnsNow;
+  }
+  postColumn_ = new int [numberColumns];
+  for (int i=0;i<numberColumns;i++)
+    postColumn_[i]=-1;
+  for (int i=0;i<nColumns;i++) {
+    int iColumn = map[i];
+    if (iColumn<numberColumns)
+      postColumn_[iColumn]=i;
+  }
+  delete [] kept;
+  delete [] map;
+  postRow_ = new int [numberRows];
+  for (int i=0;i<numberRows;i++)
+    postRow_[i]=-1;
+  // original rows are in terms of startModel_ (any >= numberRows were added)
+  const int * original = originalRows();
+  int nRows = (lastPass>=0) ? model_[lastPass]->getNumRows() : numberRows;
+  for (int i=0;i<nRows;i++) {
+    int iRow = original[i];
+    if (iRow>=0&&iRow<numberRows)
+      postRow_[iRow]=i;
+  }
+  return true;
+}
+/* Creates solution (and optionally basis) in original model
+   using stored maps (no solvers) */
+int
+CglPreProcess::postProcessSolution(const double * solution,
+				   double * originalSolution,
+				   const CoinWarmStartBasis * basis,
+				   CoinWarmStartBasis * originalBasis)
+{
+  if (!createPostProcessMaps())
+    return -1;
+  OsiSolverInterface * model = originalModel_;
+  int numberColumns = model->getNumCols();
+  int numberRows = model->getNumRows();
+  const double * columnLower = model->getColLower();
+  const double * columnUpper = model->getColUpper();
+  const double * rowLower = model->getRowLower();
+  const double * rowUpper = model->getRowUpper();
+  double tolerance;
+  model->getDblParam(OsiPrimalTolerance,tolerance);
+  tolerance *= 10.0;
+  int numberInfeasible=0;
+  for (int iColumn=0;iColumn<numberColumns;iColumn++) {
+    int jColumn = postColumn_[iColumn];
+    double value;
+    if (jColumn>=0) {
+      value = solution[jColumn];
+      if (model->isInteger(iColumn)) {
+	double value2 = floor(value+0.5);
+	if (fabs(value-value2)<1.0e-3)
+	  value = value2;
+      }
+    } else {
+      value = postValue_[iColumn];
+      if (value==COIN_DBL_MAX) {
+	// not known - take bound nearest zero and let check decide
+	value = CoinMax(columnLower[iColumn],CoinMin(0.0,columnUpper[iColumn]));
+      }
+    }
+    if (value<columnLower[iColumn]-tolerance||
+	value>columnUpper[iColumn]+tolerance)
+      numberInfeasible++;
+    originalSolution[iColumn]=value;
+  }
+  // check rows
+  const CoinPackedMatrix * columnCopy = model->getMatrixByCol();
+  const int * row = columnCopy->getIndices();
+  const CoinBigIndex * columnStart = columnCopy->getVectorStarts();
+  const int * columnLength = columnCopy->getVectorLengths(); 
+  const double * element = columnCopy->getElements();
+  double * rowActivity = new double[numberRows];
+  memset(rowActivity,0,numberRows*sizeof(double));
+  for (int iColumn=0;iColumn<numberColumns;iColumn++) {
+    double value = originalSolution[iColumn];
+    if (value) {
+      for (CoinBigIndex j=columnStart[iColumn];
+	   j<columnStart[iColumn]+columnLength[iColumn];j++) {
+	int iRow=row[j];
+	rowActivity[iRow] += value*element[j];
+      }
+    }
+  }
+  for (int iRow=0;iRow<numberRows;iRow++) {
+    if (rowActivity[iRow]<rowLower[iRow]-tolerance||
+	rowActivity[iRow]>rowUpper[iRow]+tolerance)
+      numberInfeasible++;
+  }
+  delete [] rowActivity;
+  if (basis&&originalBasis) {
+    originalBasis->setSize(numberColumns,numberRows);
+    int numberBasic=0;
+    for (int iColumn=0;iColumn<numberColumns;iColumn++) {
+      int jColumn = postColumn_[iColumn];
+      CoinWarmStartBasis::Status status;
+      if (jColumn>=0)
+	status = basis->getStructStatus(jColumn);
+      else if (originalSolution[iColumn]==columnUpper[iColumn]&&
+	       columnUpper[iColumn]>columnLower[iColumn])
+	status = CoinWarmStartBasis::atUpperBound;
+      else
+	status = CoinWarmStartBasis::atLowerBound;
+      if (status==CoinWarmStartBasis::basic)
+	numberBasic++;
+      originalBasis->setStructStatus(iColumn,status);
+    }
+    for (int iRow=0;iRow<numberRows;iRow++) {
+      int jRow = postRow_[iRow];
+      CoinWarmStartBasis::Status status = (jRow>=0) ?
+	basis->getArtifStatus(jRow) : CoinWarmStartBasis::basic;
+      if (status==CoinWarmStartBasis::basic)
+	numberBasic++;
+      originalBasis->setArtifStatus(iRow,status);
+    }
+    /* Number basic can be wrong if preprocessing added rows
+       (statuses of those are lost) - so correct using slacks */
+    for (int iRow=numberRows-1;iRow>=0&&numberBasic!=numberRows;iRow--) {
+      CoinWarmStartBasis::Status status = originalBasis->getArtifStatus(iRow);
+      if (numberBasic<numberRows) {
+	if (status!=CoinWarmStartBasis::basic) {
+	  originalBasis->setArtifStatus(iRow,CoinWarmStartBasis::basic);
+	  numberBasic++;
+	}
+      } else if (status==CoinWarmStartBasis::basic&&postRow_[iRow]>=0) {
+	originalBasis->setArtifStatus(iRow,CoinWarmStartBasis::atLowerBound);
+	numberBasic--;
+      }
+    }
+  }
+  return numberInfeasible;
+}
 //-------------------------------------------------------------------
 // Returns the greatest common denominator of two 
 // positive integers, a and b, found using Euclid's algorithm 
@@ -4982,10 +5398,17 @@ CglPreProcess::modified(OsiSolverInterface * model,
     info.pass = iPass;
     info.options=0;
     int numberChangedThisPass=0;
+    int firstStep = numberProfileSteps();
+    int startSize[4];
+    double startTime;
 #if 1
     // look at cliques every time
     if ((options_&32)!=0) {
+      profileSize(newModel,startSize);
+      startTime = CoinGetTimeOfDay();
       OsiSolverInterface * temp=cliqueIt(*newModel,0.0001);
+      addProfile(iBigPass,iPass,-3,startTime,startSize,
+		 (temp&&temp->getNumRows()<newModel->getNumRows()) ? temp : newModel);
       if (temp) {
 #if CBC_USEFUL_PRINTING
 	printf("bigpass %d pass %d after cliques %d rows, before %d\n",
@@ -5021,6 +5444,8 @@ CglPreProcess::modified(OsiSolverInterface * model,
       const int * duplicate=NULL;
       CglDuplicateRow * dupRow = NULL;
       CglClique * cliqueGen = NULL;
+      profileSize(newModel,startSize);
+      startTime = CoinGetTimeOfDay();
       if (iGenerator>=0) {
         //char name[20];
         //sprintf(name,"prex%2.2d.mps",iGenerator);
@@ -5105,6 +5530,29 @@ CglPreProcess::modified(OsiSolverInterface * model,
 #if CBC_USEFUL_PRINTING
 	  printf("%d clique cuts\n",n);
 #endif
+	  {
+	    // Merged set packing rows (CglClique::setMergeCliques) replace
+	    // originals before cuts are looked at - empty ones are dominated
+	    numberRows=newModel->getNumRows();
+	    int numberMerged=0;
+	    int * dropMerged = new int[numberRows];
+	    OsiCuts mergedRows;
+	    for (int iRow=0;iRow<numberRows;iRow++) {
+	      if (whichCut[iRow]) {
+		dropMerged[numberMerged++]=iRow;
+		if (whichCut[iRow]->row().getNumElements())
+		  mergedRows.insert(*whichCut[iRow]);
+		delete whichCut[iRow];
+		whichCut[iRow]=NULL;
+	      }
+	    }
+	    if (numberMerged) {
+	      newModel->deleteRows(numberMerged,dropMerged);
+	      newModel->applyCuts(mergedRows);
+	      newModel->resolve();
+	    }
+	    delete [] dropMerged;
+	  }
 	  OsiSolverInterface * copySolver = newModel->clone();
 	  numberRows=copySolver->getNumRows();
 	  copySolver->applyCuts(cs);
@@ -5198,6 +5646,7 @@ CglPreProcess::modified(OsiSolverInterface * model,
 	  }
 	  delete copySolver;
 	  delete [] drop;
+	  addProfile(iBigPass,iPass,iGenerator,startTime,startSize,newModel);
 	  continue;
 	  //for (int i=0;i<n;i++) {
 	  //OsiRowCut & thisCut = cs.rowCut(i);
@@ -6004,6 +6453,7 @@ CglPreProcess::modified(OsiSolverInterface * model,
 	  //newModel->writeMpsNative("infeas.mps",NULL,NULL,2,1);
 	}
       }
+      addProfile(iBigPass,iPass,iGenerator,startTime,startSize,newModel);
       if (!feasible)
         break;
     }
@@ -6012,7 +6462,10 @@ CglPreProcess::modified(OsiSolverInterface * model,
     numberChanges +=  numberChangedThisPass;
     if (iPass<numberPasses-1) {
       int multiplier = (numberPasses>10) ? numberRows+1000 : 1;
-      if ((!numberFixed&&numberChangedThisPass*multiplier<numberRows+numberColumns)||iPass==numberPasses-2) {
+      // or not worth it
+      bool slowPass = minimumReductionRate_>0.0&&
+	reductionRate(firstStep)<minimumReductionRate_;
+      if ((!numberFixed&&numberChangedThisPass*multiplier<numberRows+numberColumns)||iPass==numberPasses-2||slowPass) {
         // do special probing at end - but not if very last pass
 	if (iBigPass<numberSolvers_-1 && numberPasses > 4) {
 	  firstGenerator=-1;
@@ -6085,7 +6538,12 @@ CglPreProcess::CglPreProcess()
   prohibited_(NULL),
   numberRowType_(0),
   options_(0),
-  rowType_(NULL)
+  rowType_(NULL),
+  minimumReductionRate_(0.0),
+  numberThreads_(0),
+  postColumn_(NULL),
+  postRow_(NULL),
+  postValue_(NULL)
 {
   handler_ = new CoinMessageHandler();
   handler_->setLogLevel(2);
@@ -6106,7 +6564,10 @@ CglPreProcess::CglPreProcess(const CglPreProcess & rhs)
   numberIterationsPre_(rhs.numberIterationsPre_),
   numberIterationsPost_(rhs.numberIterationsPost_),
   numberRowType_(rhs.numberRowType_),
-  options_(rhs.options_)
+  options_(rhs.options_),
+  profile_(rhs.profile_),
+  minimumReductionRate_(rhs.minimumReductionRate_),
+  numberThreads_(rhs.numberThreads_)
 {
   if (defaultHandler_) {
     handler_ = new CoinMessageHandler();
@@ -6164,6 +6625,17 @@ CglPreProcess::CglPreProcess(const CglPreProcess & rhs)
   prohibited_ = CoinCopyOfArray(rhs.prohibited_,numberProhibited_);
   rowType_ = CoinCopyOfArray(rhs.rowType_,numberRowType_);
   cuts_ = rhs.cuts_;
+  if (rhs.postColumn_) {
+    int numberColumns = originalModel_->getNumCols();
+    int numberRows = originalModel_->getNumRows();
+    postColumn_ = CoinCopyOfArray(rhs.postColumn_,numberColumns);
+    postRow_ = CoinCopyOfArray(rhs.postRow_,numberRows);
+    postValue_ = CoinCopyOfArray(rhs.postValue_,numberColumns);
+  } else {
+    postColumn_ = NULL;
+    postRow_ = NULL;
+    postValue_ = NULL;
+  }
 }
   
 // Assignment operator 
@@ -6181,6 +6653,9 @@ CglPreProcess::operator=(const CglPreProcess& rhs)
     numberIterationsPost_ = rhs.numberIterationsPost_;
     numberRowType_ = rhs.numberRowType_;
     options_ = rhs.options_;
+    profile_ = rhs.profile_;
+    minimumReductionRate_ = rhs.minimumReductionRate_;
+    numberThreads_ = rhs.numberThreads_;
     if (defaultHandler_) {
       handler_ = new CoinMessageHandler();
       handler_->setLogLevel(rhs.handler_->logLevel());
@@ -6235,6 +6710,13 @@ CglPreProcess::operator=(const CglPreProcess& rhs)
     prohibited_ = CoinCopyOfArray(rhs.prohibited_,numberProhibited_);
     rowType_ = CoinCopyOfArray(rhs.rowType_,numberRowType_);
     cuts_ = rhs.cuts_;
+    if (rhs.postColumn_) {
+      int numberColumns = originalModel_->getNumCols();
+      int numberRows = originalModel_->getNumRows();
+      postColumn_ = CoinCopyOfArray(rhs.postColumn_,numberColumns);
+      postRow_ = CoinCopyOfArray(rhs.postRow_,numberRows);
+      postValue_ = CoinCopyOfArray(rhs.postValue_,numberColumns);
+    }
   }
   return *this;
 }
@@ -6293,6 +6775,13 @@ CglPreProcess::gutsOfDestructor()
   delete [] rowType_;
   rowType_=NULL;
   numberRowType_=0;
+  profile_.clear();
+  delete [] postColumn_;
+  delete [] postRow_;
+  delete [] postValue_;
+  postColumn_=NULL;
+  postRow_=NULL;
+  postValue_=NULL;
 }
 // Add one generator
 void 
@@ -6594,6 +7083,44 @@ CglPreProcess::reducedCostFix(OsiSolverInterface & model)
   }
   return numberFixed;
 }
+// Add step to profile
+void 
+CglPreProcess::addProfile(int majorPass, int minorPass, int step,
+			  double startTime, const int * startSize,
+			  const OsiSolverInterface * model)
+{
+  int size[4];
+  profileSize(model,size);
+  CglPreProcessProfile thisStep;
+  thisStep.time = CoinGetTimeOfDay()-startTime;
+  thisStep.majorPass = majorPass;
+  thisStep.minorPass = minorPass;
+  thisStep.step = step;
+  // columns may have been fixed and then removed
+  thisStep.numberFixed = CoinMax(size[3]-startSize[3],0);
+  thisStep.rowsReduced = startSize[0]-size[0];
+  thisStep.columnsReduced = startSize[1]-size[1];
+  thisStep.elementsReduced = startSize[2]-size[2];
+  profile_.push_back(thisStep);
+}
+// Reductions per second over steps from firstStep on
+double 
+CglPreProcess::reductionRate(int firstStep) const
+{
+  double time = 0.0;
+  double reductions = 0.0;
+  int numberSteps = numberProfileSteps();
+  for (int i=CoinMax(firstStep,0);i<numberSteps;i++) {
+    const CglPreProcessProfile & thisStep = profile_[i];
+    time += thisStep.time;
+    reductions += thisStep.numberFixed + thisStep.rowsReduced +
+      thisStep.columnsReduced + thisStep.elementsReduced;
+  }
+  if (time>1.0e-8)
+    return CoinMax(reductions,0.0)/time;
+  else
+    return COIN_DBL_MAX;
+}
 // Pass in prohibited columns 
 void 
 CglPreProcess::passInProhibited(const char * prohibited,int numberColumns)
@@ -13,9 +13,38 @@
 #include "CglStored.hpp"
 #include "OsiPresolve.hpp"
 #include "CglCutGenerator.hpp"
+class CoinWarmStartBasis;
 
 //#############################################################################
 
+/** Profile of one step of preprocessing.
+
+    step is the cut generator number for cut generators (duplicate rows
+    and cliques are added as cut generators), -1 for special probing,
+    -2 for OsiPresolve, -3 for cliqueIt and -4 for tightenPrimalBounds.
+    minorPass is -1 for steps outside the minor passes of modified.
+    Reductions are measured on the model before and after the step so
+    may be negative (e.g. if a generator adds rows).
+*/
+typedef struct {
+  /// Elapsed (wall clock) time taken by step - steps may use several threads
+  double time;
+  /// Major pass (presolve pass)
+  int majorPass;
+  /// Minor pass within major pass
+  int minorPass;
+  /// Which step
+  int step;
+  /// Number of columns newly fixed
+  int numberFixed;
+  /// Number of rows removed
+  int rowsReduced;
+  /// Number of columns removed
+  int columnsReduced;
+  /// Number of elements removed
+  CoinBigIndex elementsReduced;
+} CglPreProcessProfile;
+
 /** Class for preProcessing and postProcessing.
 
     While cuts can be added at any time in the tree, some cuts are actually just
@@ -67,8 +96,31 @@ public:
   /// Creates solution in original model
   void postProcess(OsiSolverInterface &model
 		   ,bool deleteStuff=true);
+  /** Creates solution (and optionally basis) in original model from a
+      solution of preprocessed model.  No solvers are used or copied -
+      just stored column and row maps and values of columns presolve
+      took out - so this can be called cheaply many times
+      e.g. for every new incumbent.
+
+      Removed columns which were fixed or empty get their values from
+      bounds, any others are put at bound nearest zero so solution is
+      checked against original model.  Returns 0 if originalSolution
+      is feasible, number of infeasibilities if not (then postProcess
+      should be used) or -1 if maps could not be created.
+  */
+  int postProcessSolution(const double * solution, double * originalSolution,
+			  const CoinWarmStartBasis * basis=NULL,
+			  CoinWarmStartBasis * originalBasis=NULL);
+  /** Creates maps for postProcessSolution.  This is done on first
+      call to that or at start of postProcess (which deletes the
+      information needed) so need not be called directly.
+      Returns false if not possible */
+  bool createPostProcessMaps();
   /** Tightens primal bounds to make dual and branch and cutfaster.  Unless
       fixed or integral, bounds are slightly looser than they could be.
+      Only rows with a column whose bounds changed are looked at again.
+      If numberThreads()>1 rows are first looked at in parallel so that
+      only those which may tighten a bound are done in order.
       Returns non-zero if problem infeasible
       Fudge for branch and bound - put bounds on columns of factor *
       largest value (at continuous) - should improve stability
@@ -188,6 +240,34 @@ public:
   /// Set options
   inline void setOptions(int value)
   { options_=value;}
+  /** Set minimum rate of reductions per second.
+      Reductions are fixings plus rows, columns and elements removed.
+      If a major or minor pass does fewer reductions per second than
+      this then no more passes of that type are done.
+      0.0 (default) switches off
+  */
+  inline void setMinimumReductionRate(double value)
+  { minimumReductionRate_=value;}
+  /// Get minimum rate of reductions per second
+  inline double minimumReductionRate() const
+  { return minimumReductionRate_;}
+  /** Set number of threads for tightenPrimalBounds.
+      Bounds are the same whatever the number of threads.
+      Threads are only used if compiled with CGL_THREAD.
+  */
+  inline void setNumberThreads(int value)
+  { numberThreads_=value;}
+  /// Get number of threads for tightenPrimalBounds
+  inline int numberThreads() const
+  { return numberThreads_;}
+  /// Number of steps in profile of last preprocessing
+  inline int numberProfileSteps() const
+  { return static_cast<int>(profile_.size());}
+  /// Profile of last preprocessing (one entry per step)
+  inline const CglPreProcessProfile * profile() const
+  { return profile_.empty() ? NULL : &profile_[0];}
+  /// Reductions per second over steps from firstStep on (COIN_DBL_MAX if no time)
+  double reductionRate(int firstStep) const;
   //@}
 
   ///@name Cut generator methods 
@@ -278,6 +358,11 @@ private:
   void createOriginalIndices();
   /// Make continuous variables integer
   void makeInteger();
+  /** Add step to profile.  startTime is from CoinGetTimeOfDay and
+      startSize is as given by profileSize for model at start of step */
+  void addProfile(int majorPass, int minorPass, int step,
+		  double startTime, const int * startSize,
+		  const OsiSolverInterface * model);
   //@}
 
 //---------------------------------------------------------------------------
@@ -360,6 +445,18 @@ private:
   char * rowType_;
   /// Cuts from dropped rows
   CglStored cuts_;
+  /// Profile of each step of last preprocessing
+  std::vector<CglPreProcessProfile> profile_;
+  /// Minimum reductions per second to keep doing passes (0.0 off)
+  double minimumReductionRate_;
+  /// Number of threads (blocks of rows) in tightenPrimalBounds
+  int numberThreads_;
+  /// Column in preprocessed model for each original column (-1 if out)
+  int * postColumn_;
+  /// Row in preprocessed model for each original row (-1 if out)
+  int * postRow_;
+  /// Value of each original column taken out (COIN_DBL_MAX if not known)
+  double * postValue_;
  //@}
 };
 /// For Bron-Kerbosch
@@ -489,4 +586,14 @@ private:
   int numberCuts_;
   int lastHash_;
 };
+
+//#############################################################################
+/** A function that tests the methods in the CglPreProcess class. The
+    only reason for it not to be a member method is that this way it doesn't
+    have to be compiled into the library. And that's a gain, because the
+    library should be compiled with optimization on, but this method should be
+    compiled with debugging. */
+void CglPreProcessUnitTest(const OsiSolverInterface * siP,
+			   const std::string mpdDir );
+
 #endif
@@ -0,0 +1,146 @@
+// $Id$
+// Copyright (C) 2026, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cstdio>
+#include <cmath>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+
+#include "CoinPragma.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinFinite.hpp"
+#include "OsiSolverInterface.hpp"
+#include "CglPreProcess.hpp"
+
+//--------------------------------------------------------------------------
+void
+CglPreProcessUnitTest(
+  const OsiSolverInterface * baseSiP,
+  const std::string /*mpsDir*/ )
+{
+  // Test default constructor
+  {
+    CglPreProcess aProcess;
+    assert (aProcess.numberThreads()==0);
+  }
+
+  // Test copy & assignment
+  {
+    CglPreProcess rhs;
+    {
+      CglPreProcess bProcess;
+      bProcess.setNumberThreads(4);
+      CglPreProcess cProcess(bProcess);
+      assert (cProcess.numberThreads()==4);
+      rhs=bProcess;
+    }
+    assert (rhs.numberThreads()==4);
+  }
+
+  // Test postProcessSolution - preprocess a small MIP, solve the reduced
+  // model and check solution mapped back is feasible and optimal for
+  // original model.
+  // Column 5 is fixed at one and column 6 is empty so presolve takes
+  // them out.
+  // min -5x0 -4x1 -6x2 -3x3 -2x4 + x5 + x6
+  //  3x0 + 2x1 + 4x2             + x5      <= 6
+  //         x1 +  x2 + x3 +  x4            >= 2
+  //  2x0              + x3 + 3x4 + x5      <= 5
+  // x0-x5 binary, 0 <= x6 <= 4
+  {
+    const int numberColumns=7;
+    const int numberRows=3;
+    const CoinBigIndex start[]={0,2,4,6,8,10,12,12};
+    const int row[]={0,2, 0,1, 0,1, 1,2, 1,2, 0,2};
+    const double element[]={3.0,2.0, 2.0,1.0, 4.0,1.0, 1.0,1.0,
+			    1.0,3.0, 1.0,1.0};
+    const double columnLower[]={0.0,0.0,0.0,0.0,0.0,1.0,0.0};
+    const double columnUpper[]={1.0,1.0,1.0,1.0,1.0,1.0,4.0};
+    const double objective[]={-5.0,-4.0,-6.0,-3.0,-2.0,1.0,1.0};
+    const double rowLower[]={-COIN_DBL_MAX,2.0,-COIN_DBL_MAX};
+    const double rowUpper[]={6.0,COIN_DBL_MAX,5.0};
+    OsiSolverInterface * siP = baseSiP->clone();
+    siP->loadProblem(numberColumns,numberRows,start,row,element,
+		     columnLower,columnUpper,objective,rowLower,rowUpper);
+    int iColumn;
+    for (iColumn=0;iColumn<6;iColumn++)
+      siP->setInteger(iColumn);
+    siP->initialSolve();
+    // best objective by looking at all values of binaries (x6 is 0)
+    double bestObjective=COIN_DBL_MAX;
+    for (int k=0;k<64;k++) {
+      double x[7];
+      for (iColumn=0;iColumn<6;iColumn++)
+	x[iColumn]=(k>>iColumn)&1;
+      x[6]=0.0;
+      if (!x[5])
+	continue;
+      double row0=3*x[0]+2*x[1]+4*x[2]+x[5];
+      double row1=x[1]+x[2]+x[3]+x[4];
+      double row2=2*x[0]+x[3]+3*x[4]+x[5];
+      if (row0>6.0||row1<2.0||row2>5.0)
+	continue;
+      double value=0.0;
+      for (iColumn=0;iColumn<numberColumns;iColumn++)
+	value += objective[iColumn]*x[iColumn];
+      if (value<bestObjective)
+	bestObjective=value;
+    }
+    assert (bestObjective==-11.0);
+    for (int numberThreads=1;numberThreads<=4;numberThreads*=2) {
+      CglPreProcess process;
+      process.messageHandler()->setLogLevel(0);
+      process.setNumberThreads(numberThreads);
+      OsiSolverInterface * reduced = process.preProcess(*siP,false,5);
+      assert (reduced);
+      assert (reduced->getNumCols()<numberColumns);
+      reduced->branchAndBound();
+      // fix integers at solution and get continuous values
+      const double * solution = reduced->getColSolution();
+      int nReduced = reduced->getNumCols();
+      for (iColumn=0;iColumn<nReduced;iColumn++) {
+	if (reduced->isInteger(iColumn)) {
+	  double value=floor(solution[iColumn]+0.5);
+	  reduced->setColLower(iColumn,value);
+	  reduced->setColUpper(iColumn,value);
+	}
+      }
+      reduced->resolve();
+      assert (reduced->isProvenOptimal());
+      double originalSolution[7];
+      int nBad=process.postProcessSolution(reduced->getColSolution(),
+					   originalSolution);
+      assert (!nBad);
+      // check against original model here as well
+      const CoinPackedMatrix * columnCopy = siP->getMatrixByCol();
+      const int * rowIndex = columnCopy->getIndices();
+      const CoinBigIndex * columnStart = columnCopy->getVectorStarts();
+      const int * columnLength = columnCopy->getVectorLengths();
+      const double * columnElement = columnCopy->getElements();
+      double rowActivity[3]={0.0,0.0,0.0};
+      double objectiveValue=0.0;
+      for (iColumn=0;iColumn<numberColumns;iColumn++) {
+	double value=originalSolution[iColumn];
+	assert (value>=columnLower[iColumn]-1.0e-7);
+	assert (value<=columnUpper[iColumn]+1.0e-7);
+	if (siP->isInteger(iColumn))
+	  assert (value==floor(value+0.5));
+	objectiveValue += objective[iColumn]*value;
+	for (CoinBigIndex j=columnStart[iColumn];
+	     j<columnStart[iColumn]+columnLength[iColumn];j++)
+	  rowActivity[rowIndex[j]] += columnElement[j]*value;
+      }
+      for (int iRow=0;iRow<numberRows;iRow++) {
+	assert (rowActivity[iRow]>=rowLower[iRow]-1.0e-7);
+	assert (rowActivity[iRow]<=rowUpper[iRow]+1.0e-7);
+      }
+      assert (fabs(objectiveValue-bestObjective)<1.0e-7);
+    }
+    delete siP;
+  }
+}
@@ -26,6 +26,7 @@
 
 #include "CoinPragma.hpp"
 #include "CoinHelperFunctions.hpp"
+#include "CoinSort.hpp"
 #include "CoinPackedVector.hpp"
 #include "CoinPackedMatrix.hpp"
 #include "CoinIndexedVector.hpp"
@@ -33,6 +34,7 @@
 #include "CoinFactorization.hpp"
 #include "CoinWarmStartBasis.hpp"
 #include "CglRedSplit.hpp"
+#include "CglTableauProvider.hpp"
 #include "CoinFinite.hpp"
 
 //-------------------------------------------------------------------
@@ -51,64 +53,68 @@ inline double CglRedSplit::rs_above_integer(double value)
 } /* rs_above_integer */
 
 /**********************************************************/
+// Matrices are stored as one block so that rows are contiguous; the
+// row pointers are followed by a pointer to the block as allocated
 void rs_allocmatINT(int ***v, const int m, const int n)
 {
   int i;
 
-  *v = reinterpret_cast<int **> (calloc (m, sizeof(int *)));
+  *v = reinterpret_cast<int **> (calloc (m+1, sizeof(int *)));
   if (*v == NULL) {
     printf("###ERROR: INTEGER matrix allocation failed\n");
     exit(1);
   }
 
+  int *block = reinterpret_cast<int *> (calloc (m*n+1, sizeof(int)));
+  if (block == NULL) {
+    printf("###ERROR: INTEGER matrix allocation failed\n");
+    exit(1);
+  }
+  (*v)[m] = block;
   for(i=0; i<m; i++) {
-    (*v)[i] = reinterpret_cast<int *> (calloc (n, sizeof(int)));
-    if ((*v)[i] == NULL) {
-      printf("###ERROR: INTEGER matrix allocation failed\n");
-      exit(1);
-    }
+    (*v)[i] = block + i*n;
   }
 } /* rs_allocmatINT */
 
 /**********************************************************/
 void rs_deallocmatINT(int ***v, const int m, const int /*n*/)
 {
-  int i;
-
-  for(i=0; i<m; i++) {
-    free(reinterpret_cast<void *> ((*v)[i]));
-  }
+  free(reinterpret_cast<void *> ((*v)[m]));
   free(reinterpret_cast<void *> (*v));
 } /* rs_deallocmatINT */
 
 /**********************************************************/
+// As rs_allocmatINT but rows are padded to a multiple of 4 doubles and
+// start on a 32 byte boundary
 void rs_allocmatDBL(double ***v, const int m, const int n)
 {
   int i;
+  int stride = (n+3)&~3;
 
-  *v = reinterpret_cast<double **> (calloc (m, sizeof(double *)));
+  *v = reinterpret_cast<double **> (calloc (m+1, sizeof(double *)));
   if (*v == NULL) {
     printf("###ERROR: DOUBLE matrix allocation failed\n");
     exit(1);
   }
 
+  double *block = reinterpret_cast<double *> (calloc (m*stride+4, 
+						      sizeof(double)));
+  if (block == NULL) {
+    printf("###ERROR: DOUBLE matrix allocation failed\n");
+    exit(1);
+  }
+  (*v)[m] = block;
+  int offset = static_cast<int> (reinterpret_cast<size_t> (block)&31);
+  double *aligned = block + ((32-offset)&31)/sizeof(double);
   for(i=0; i<m; i++) {
-    (*v)[i] = reinterpret_cast<double *> (calloc (n, sizeof(double)));
-    if ((*v)[i] == NULL) {
-      printf("###ERROR: DOUBLE matrix allocation failed\n");
-      exit(1);
-    }
+    (*v)[i] = aligned + i*stride;
   }
 } /* rs_allocmatDBL */
 
 /**********************************************************/
 void rs_deallocmatDBL(double ***v, const int m, const int /*n*/)
 {
-  int i;
-
-  for(i=0; i<m; i++) {
-    free(reinterpret_cast<void *> ((*v)[i]));
-  }
+  free(reinterpret_cast<void *> ((*v)[m]));
   free(reinterpret_cast<void *> (*v));
 } /* rs_deallocmatDBL */
 
@@ -241,8 +247,10 @@ double rs_genalea (int *x0)
 void CglRedSplit::update_pi_mat(int r1, int r2, int step) {
 
   int j;
+  int *row1 = pi_mat[r1];
+  const int *row2 = pi_mat[r2];
   for(j=0; j<mTab; j++) {
-    pi_mat[r1][j] = pi_mat[r1][j] - step * pi_mat[r2][j];
+    row1[j] -= step * row2[j];
   }
 } /* update_pi_mat */
 
@@ -250,9 +258,10 @@ void CglRedSplit::update_pi_mat(int r1, int r2, int step) {
 void CglRedSplit::update_redTab(int r1, int r2, int step) {
 
   int j;
+  double *row1 = contNonBasicTab[r1];
+  const double *row2 = contNonBasicTab[r2];
   for(j=0; j<nTab; j++) {
-    contNonBasicTab[r1][j] = 
-                  contNonBasicTab[r1][j] - step * contNonBasicTab[r2][j];
+    row1[j] -= step * row2[j];
   }
 } /* update_redTab */
 
@@ -409,12 +418,16 @@ void CglRedSplit::generate_row(int index_row, double *row) {
       row[intBasicVar_frac[i]] += pi_mat[index_row][i];
     }
   }
-  for(i=0; i<card_intNonBasicVar; i++) {
-    int locind = intNonBasicVar[i];
-    row[locind] = 0;
-    int j;
-    for(j=0; j<mTab; j++) {
-      row[locind] += pi_mat[index_row][j] * intNonBasicTab[j][i];
+  // add multiples of rows of intNonBasicTab (rows are contiguous)
+  const int *pi = pi_mat[index_row];
+  int j;
+  for(j=0; j<mTab; j++) {
+    if(pi[j]) {
+      double value = pi[j];
+      const double *tableau = intNonBasicTab[j];
+      for(i=0; i<card_intNonBasicVar; i++) {
+	row[intNonBasicVar[i]] += value * tableau[i];
+      }
     }
   }
   for(i=0; i<card_contNonBasicVar; i++) {
@@ -1196,9 +1209,19 @@ void CglRedSplit::generateCuts(const OsiSolverInterface &si, OsiCuts & cs,
   colType = NULL;
   byRow = solver->getMatrixByRow();
 
-  solver->enableFactorization();
-  generateCuts(cs);
-  solver->disableFactorization();
+  if(tableauProvider) {
+    // rows of tableau from shared factorization
+    if(tableauProvider->factorize(*solver)) {
+      printf("### WARNING: CglRedSplit::generateCuts(): error during factorization.\n");
+      return;
+    }
+    generateCuts(cs);
+  }
+  else {
+    solver->enableFactorization();
+    generateCuts(cs);
+    solver->disableFactorization();
+  }
 } /* generateCuts */
 
 /************************************************************************/
@@ -1226,7 +1249,12 @@ void CglRedSplit::generateCuts(OsiCuts &cs)
   rs_printvecINT("rstat", rstat, nrow);
 #endif
 
-  solver->getBasics(basis_index);
+  if(tableauProvider) {
+    tableauProvider->getBasics(basis_index);
+  }
+  else {
+    solver->getBasics(basis_index);
+  }
 
   cv_intBasicVar_frac = new int[ncol];  
   intBasicVar_frac = new int[ncol];                                 
@@ -1432,7 +1460,18 @@ double *slack_val = new double[nrow];
   rs_allocmatDBL(&contNonBasicTab, mTab, nTab);
   rs_allocmatDBL(&intNonBasicTab, mTab, card_intNonBasicVar);
 
-  card_intBasicVar_frac = 0; // recompute in pivot order
+  card_intBasicVar_frac = 0; // recompute in order of basic variables
+
+  // Rows are taken in order of their basic variable, not pivot order,
+  // so cuts are the same whichever factorization gave the tableau
+  int *rowOrder = new int[nrow];
+  int *sortKey = new int[nrow];
+  for(i=0; i<nrow; i++) {
+    rowOrder[i] = i;
+    sortKey[i] = basis_index[i];
+  }
+  CoinSort_2(sortKey, sortKey+nrow, rowOrder);
+  delete[] sortKey;
 
   for(i=0; i<nrow; i++) {
 
@@ -1441,9 +1480,10 @@ double *slack_val = new double[nrow];
     }
 
     int ind_row = start + i;
-    if(ind_row > nrow) {
+    if(ind_row >= nrow) {
       ind_row -= nrow;
     }
+    ind_row = rowOrder[ind_row];
 
     if(basis_index[ind_row] >= ncol) {
       continue;
@@ -1454,7 +1494,12 @@ double *slack_val = new double[nrow];
       intBasicVar_frac[card_intBasicVar_frac] = basis_index[ind_row];
       card_intBasicVar_frac++;
       rhsTab[card_rowTab] = xlp[basis_index[ind_row]];
-      solver->getBInvARow(ind_row, z, slack);
+      if(tableauProvider) {
+	tableauProvider->getBInvARow(ind_row, z, slack);
+      }
+      else {
+	solver->getBInvARow(ind_row, z, slack);
+      }
       int ii;
       for(ii=0; ii<card_contNonBasicVar; ii++) {
 	int locind = contNonBasicVar[ii];
@@ -1480,6 +1525,7 @@ double *slack_val = new double[nrow];
       card_rowTab++;
     }
   }
+  delete[] rowOrder;
 
   rs_allocmatINT(&pi_mat, mTab, mTab);
   for(i=0; i<mTab; i++) {
@@ -1790,7 +1836,8 @@ contNonBasicTab(0),
 intNonBasicTab(0),
 rhsTab(0),
 given_optsol(0),
-card_given_optsol(0)
+card_given_optsol(0),
+tableauProvider(NULL)
 {}
 
 /*********************************************************************/
@@ -1816,7 +1863,8 @@ contNonBasicTab(0),
 intNonBasicTab(0),
 rhsTab(0),
 given_optsol(0),
-card_given_optsol(0)
+card_given_optsol(0),
+tableauProvider(NULL)
 {
   param = RS_param;
 }
@@ -1845,7 +1893,8 @@ CglRedSplit::CglRedSplit (const CglRedSplit & source) :
   intNonBasicTab(NULL),
   rhsTab(NULL),
   given_optsol(source.given_optsol),
-  card_given_optsol(source.card_given_optsol)
+  card_given_optsol(source.card_given_optsol),
+  tableauProvider(source.tableauProvider)
 {}
 
 /*********************************************************************/
@@ -1869,6 +1918,7 @@ CglRedSplit::operator=(const CglRedSplit &source)
     param = source.param;
     given_optsol = source.given_optsol;
     card_given_optsol = source.card_given_optsol;
+    tableauProvider = source.tableauProvider;
   }
   return *this;
 }
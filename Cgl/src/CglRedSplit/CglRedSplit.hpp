@@ -18,6 +18,8 @@
 #include "CglCutGenerator.hpp"
 #include "CglRedSplitParam.hpp"
 
+class CglTableauProvider;
+
 /** Gomory Reduce-and-Split Cut Generator Class; See method generateCuts().
     Based on the paper by K. Anderson, G. Cornuejols, Yanjun Li, 
     "Reduce-and-Split Cuts: Improving the Performance of Mixed Integer 
@@ -92,6 +94,14 @@ public:
 
   /// Print the current simplex tableau  
   void printOptTab(OsiSolverInterface *solver) const;
+
+  /// Set shared factorization and tableau rows (not owned).
+  /// If NULL, tableau rows are obtained from the solver.
+  inline void setTableauProvider(CglTableauProvider *provider)
+  {tableauProvider = provider;}
+  /// Get shared factorization and tableau rows
+  inline CglTableauProvider *getTableauProvider() const
+  {return tableauProvider;}
   
   //@}
 
@@ -432,6 +442,9 @@ private:
   /// Reset by each call to generateCuts().
   const CoinPackedMatrix *byRow;
 
+  /// Shared factorization and tableau rows, or NULL (not owned).
+  CglTableauProvider *tableauProvider;
+
   //@}
 };
 
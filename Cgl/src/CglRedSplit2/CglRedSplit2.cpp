@@ -37,9 +37,12 @@
 #include "OsiSolverInterface.hpp"
 
 #include "CglRedSplit2.hpp"
+#include "CglTableauProvider.hpp"
+#include "CglThreads.hpp"
 #include "CoinPackedVector.hpp"
 #include "CoinPackedMatrix.hpp"
 #include "CoinIndexedVector.hpp"
+#include "CoinSort.hpp"
 #include "OsiRowCutDebugger.hpp"
 #include "CoinFactorization.hpp"
 #include "CoinFinite.hpp"
@@ -94,56 +97,64 @@ inline double CglRedSplit2::rs_above_integer(const double value) const
 } /* rs_above_integer */
 
 /**********************************************************/
+// Matrices are stored as one block so that rows are contiguous; the
+// row pointers are followed by a pointer to the block as allocated
 void CglRedSplit2::rs_allocmatINT(int ***v, int m, int n)
 {
-  *v = reinterpret_cast<int **> (calloc (m, sizeof(int *)));
+  *v = reinterpret_cast<int **> (calloc (m+1, sizeof(int *)));
   if (*v == NULL) {
     printf("###ERROR: INTEGER matrix allocation failed\n");
     exit(1);
   }
 
+  int *block = reinterpret_cast<int *> (calloc (m*n+1, sizeof(int)));
+  if (block == NULL) {
+    printf("###ERROR: INTEGER matrix allocation failed\n");
+    exit(1);
+  }
+  (*v)[m] = block;
   for (int i = 0; i < m; ++i) {
-    (*v)[i] = reinterpret_cast<int *> (calloc (n, sizeof(int)));
-    if ((*v)[i] == NULL) {
-      printf("###ERROR: INTEGER matrix allocation failed\n");
-      exit(1);
-    }
+    (*v)[i] = block + i*n;
   }
 } /* rs_allocmatINT */
 
 /**********************************************************/
 void CglRedSplit2::rs_deallocmatINT(int ***v, int m)
 {
-  for (int i = 0; i < m; ++i) {
-    free(reinterpret_cast<void *> ((*v)[i]));
-  }
+  free(reinterpret_cast<void *> ((*v)[m]));
   free(reinterpret_cast<void *> (*v));
 } /* rs_deallocmatINT */
 
 /**********************************************************/
+// As rs_allocmatINT but rows are padded to a multiple of 4 doubles and
+// start on a 32 byte boundary
 void CglRedSplit2::rs_allocmatDBL(double ***v, int m, int n)
 {
-  *v = reinterpret_cast<double **> (calloc (m, sizeof(double *)));
+  int stride = (n+3)&~3;
+  *v = reinterpret_cast<double **> (calloc (m+1, sizeof(double *)));
   if (*v == NULL) {
     printf("###ERROR: DOUBLE matrix allocation failed\n");
     exit(1);
   }
 
+  double *block = reinterpret_cast<double *> (calloc (m*stride+4, 
+						      sizeof(double)));
+  if (block == NULL) {
+    printf("###ERROR: DOUBLE matrix allocation failed\n");
+    exit(1);
+  }
+  (*v)[m] = block;
+  int offset = static_cast<int> (reinterpret_cast<size_t> (block)&31);
+  double *aligned = block + ((32-offset)&31)/sizeof(double);
   for (int i = 0; i < m; ++i){
-    (*v)[i] = reinterpret_cast<double *> (calloc (n, sizeof(double)));
-    if ((*v)[i] == NULL) {
-      printf("###ERROR: DOUBLE matrix allocation failed\n");
-      exit(1);
-    }
+    (*v)[i] = aligned + i*stride;
   }
 } /* rs_allocmatDBL */
 
 /**********************************************************/
 void CglRedSplit2::rs_deallocmatDBL(double ***v, int m)
 {
-  for (int i = 0; i < m; ++i){
-    free(reinterpret_cast<void *> ((*v)[i]));
-  }
+  free(reinterpret_cast<void *> ((*v)[m]));
   free(reinterpret_cast<void *> (*v));
 } /* rs_deallocmatDBL */
 
@@ -341,15 +352,20 @@ void CglRedSplit2::lubksb(double **a, int n, int *indx, double *b) const {
 /***************************************************************************/
 double CglRedSplit2::compute_norm_change(double oldnorm, const int* list, 
 					 int numElemList,
-					 const double* multipliers) const {
+					 const double* multipliers,
+					 double* work) const {
+  // form linear combination a row at a time (rows are contiguous)
+  memset(work, 0, nTab*sizeof(double));
+  for (int i = 0; i < numElemList; ++i){
+    double multiplier = multipliers[i];
+    const double *row = workNonBasicTab[list[i]];
+    for (int j = 0; j < nTab; ++j){
+      work[j] += multiplier*row[j];
+    }
+  }
   double newnorm = 0;
-  double accumulator;
   for (int j = 0; j < nTab; ++j){
-    accumulator = 0;
-    for (int i = 0; i < numElemList; ++i){
-      accumulator += multipliers[i]*workNonBasicTab[list[i]][j];
-    }
-    newnorm += accumulator*accumulator;
+    newnorm += work[j]*work[j];
   }
   return (newnorm-oldnorm);
   
@@ -1075,6 +1091,29 @@ void CglRedSplit2::fill_workNonBasicTab(CglRedSplit2Param::ColumnSelectionStrate
 #endif
   }
 }
+/***************************************************************************/
+/* Shared by tasks reducing blocks of rows of workNonBasicTab */
+typedef struct {
+  const CglRedSplit2 * generator;
+  int maxRowsReduction;
+  CglRedSplit2Param::RowSelectionStrategy rowSelectionStrategy;
+  /* task iTask reduces rows taskStart[iTask] to taskStart[iTask+1]-1 */
+  const int * taskStart;
+  /* number of rows reduced by each task */
+  int * reduced;
+  /* workspace for each thread */
+#ifdef RS2_USE_LAPACK
+  double ** A;
+#else
+  double *** A;
+#endif
+  double ** b;
+  int ** indexlu;
+  double ** tmpveclu;
+  int ** list;
+  double ** combination;
+} CglRedSplit2ReduceInfo;
+
 /***************************************************************************/
 void CglRedSplit2::reduce_workNonBasicTab(int numRowsReduction, 
 					  CglRedSplit2Param::RowSelectionStrategy rowSelectionStrategy,
@@ -1084,39 +1123,141 @@ void CglRedSplit2::reduce_workNonBasicTab(int numRowsReduction,
   if (maxRowsReduction == 1){
     return;
   }
-  int i, j, k, h;
+  int numRowsToReduce = CoinMin(mTab, maxIterations);
+  if (numRowsToReduce <= 0){
+    return;
+  }
+  // Rows are reduced independently (row k only changes pi_mat[k]), so
+  // blocks of rows can be done in parallel; a few tasks per thread
+  // to even out load
+  int numThreads = CglNumberThreads(numberThreads, numRowsToReduce);
+  int numTasks = (numThreads > 1) ? 
+    CoinMin(4*numThreads, numRowsToReduce) : 1;
+  int iTask, iThread;
+  int* taskStart = new int[numTasks+1];
+  for (iTask = 0; iTask <= numTasks; ++iTask){
+    taskStart[iTask] = (numRowsToReduce*iTask)/numTasks;
+  }
+  CglRedSplit2ReduceInfo info;
+  info.generator = this;
+  info.maxRowsReduction = maxRowsReduction;
+  info.rowSelectionStrategy = rowSelectionStrategy;
+  info.taskStart = taskStart;
+  info.reduced = new int[numTasks];
+  // Allocate space to store the matrix for the linear system, right
+  // hand side, data for LU decomposition, list of rows involved in
+  // the linear combination and the linear combination of rows
+#ifdef RS2_USE_LAPACK
+  info.A = new double*[numThreads];
+#else
+  info.A = new double**[numThreads];
+#endif
+  info.b = new double*[numThreads];
+  info.indexlu = new int*[numThreads];
+  info.tmpveclu = new double*[numThreads];
+  info.list = new int*[numThreads];
+  info.combination = new double*[numThreads];
+  for (iThread = 0; iThread < numThreads; ++iThread){
+#ifdef RS2_USE_LAPACK
+    info.A[iThread] = new double[maxRowsReduction*maxRowsReduction];
+#else
+    rs_allocmatDBL(&info.A[iThread], maxRowsReduction, maxRowsReduction);
+#endif
+    info.b[iThread] = new double[maxRowsReduction];
+    info.indexlu[iThread] = new int[maxRowsReduction];
+    info.tmpveclu[iThread] = new double[maxRowsReduction];
+    info.list[iThread] = new int[maxRowsReduction];
+    info.combination[iThread] = new double[nTab];
+  }
 
-  // Allocate space to store the matrix for the linear system
+  CglRunTasks(numThreads, numTasks, reduce_task, &info);
+
+  for (iTask = 0; iTask < numTasks; ++iTask){
+    numRedRows += info.reduced[iTask];
+  }
+  for (iThread = 0; iThread < numThreads; ++iThread){
 #ifdef RS2_USE_LAPACK
-  double* A = new double[maxRowsReduction*maxRowsReduction];
+    delete[] info.A[iThread];
 #else
-  double** A;
-  rs_allocmatDBL(&A, maxRowsReduction, maxRowsReduction);
+    rs_deallocmatDBL(&info.A[iThread], maxRowsReduction);
+#endif
+    delete[] info.b[iThread];
+    delete[] info.indexlu[iThread];
+    delete[] info.tmpveclu[iThread];
+    delete[] info.list[iThread];
+    delete[] info.combination[iThread];
+  }
+  delete[] info.A;
+  delete[] info.b;
+  delete[] info.indexlu;
+  delete[] info.tmpveclu;
+  delete[] info.list;
+  delete[] info.combination;
+  delete[] info.reduced;
+  delete[] taskStart;
+
+#ifdef RS2_TRACE
+  double sum_norms = 0;
+  for(int i=0; i<mTab; i++) {
+    sum_norms += norm[i];
+  }
+  printf("CglRedSplit2::reduce_contNonBasicTab():Final sum of norms: %f\n", sum_norms);
+  printf("CglRedSplit2::reduce_contNonBasicTab(): %d rows reduced\n",numRedRows);
+#endif
+
+} /* reduce_workNonBasicTab */
+
+/***************************************************************************/
+void CglRedSplit2::reduce_task(void* voidInfo, int iTask, int iThread) {
+  CglRedSplit2ReduceInfo* info = 
+    reinterpret_cast<CglRedSplit2ReduceInfo*>(voidInfo);
+  const CglRedSplit2& rs = *info->generator;
+  const CglRedSplit2Param& param = rs.param;
+  const double* norm = rs.norm;
+  const double* const* workNonBasicTab = rs.workNonBasicTab;
+  const int nTab = rs.nTab;
+  int** pi_mat = rs.pi_mat;
+  const int maxRowsReduction = info->maxRowsReduction;
+  int i, j, k;
+
+  // Matrix for the linear system
+#ifdef RS2_USE_LAPACK
+  double* A = info->A[iThread];
+#else
+  double** A = info->A[iThread];
 #endif
   // Right hand side
-  double* b = new double[maxRowsReduction];
+  double* b = info->b[iThread];
   // Data for LU decomposition
-  int* indexlu = new int[maxRowsReduction];
+  int* indexlu = info->indexlu[iThread];
   double tmpnumlu = 0.0;
-  double* tmpveclu = new double[maxRowsReduction];
+  double* tmpveclu = info->tmpveclu[iThread];
   // List of rows involved in the linear combination
-  int* list = new int[maxRowsReduction];
+  int* list = info->list[iThread];
+  // Linear combination of rows
+  double* combination = info->combination[iThread];
   
   // Number of rows actually used
   int numUsedRows;
+  // Number of rows reduced by this task
+  int numReduced = 0;
   
-  bool resolveWithNormalization = false;
+  // Row being solved again with normalization (only for that row, so
+  // rows do not depend on each other)
+  int resolveRow = -1;
 
-  for (k = 0; k < mTab && k < maxIterations; ++k) {
-    if (!checkTime()){
+  for (k = info->taskStart[iTask]; k < info->taskStart[iTask+1]; ++k) {
+    if (!rs.checkTime()){
       break;
     }
+    bool resolveWithNormalization = (k == resolveRow);
     if (norm[k] > param.getNormIsZero()) {
       // Obtain the list of rows that should be used to reduce row k
-      numUsedRows = get_list_rows_reduction(k, maxRowsReduction, list, norm,
-					    rowSelectionStrategy);
+      numUsedRows = rs.get_list_rows_reduction(k, maxRowsReduction, list, 
+					       norm, 
+					       info->rowSelectionStrategy);
 #ifdef RS2_TRACE
-      rs_printvecINT("rows used for reduction", list, numUsedRows);
+      rs.rs_printvecINT("rows used for reduction", list, numUsedRows);
 #endif
       if (numUsedRows <= 1){
 	// This means that the list only contains the current row;
@@ -1124,31 +1265,26 @@ void CglRedSplit2::reduce_workNonBasicTab(int numRowsReduction,
 	continue;
       }      
       // Note: the list must have size maxRowsReduction.
-      // Now prepare the linear system according to the paper
+      // Now prepare the linear system according to the paper.
+      // Matrix is symmetric so only j >= i is computed
       for (i = 0; i < numUsedRows; ++i){
-	for (j = 0; j < numUsedRows; ++j){
-#ifdef RS2_USE_LAPACK
-	  A[i*numUsedRows+j] = 0;
-#else
-	  A[i][j] = 0;
-#endif
+	const double *rowI = workNonBasicTab[list[i]];
+	for (j = i; j < numUsedRows; ++j){
+	  double value = 0.0;
 	  if (list[i] != k && list[j] != k){
-	    for (h = 0; h < nTab; ++h){
-#ifdef RS2_USE_LAPACK
-	      A[i*numUsedRows+j]+=workNonBasicTab[list[i]][h]*workNonBasicTab[list[j]][h];
-#else
-	      A[i][j]+=workNonBasicTab[list[i]][h]*workNonBasicTab[list[j]][h];
-#endif
-	    }
+	    value = rs.rs_dotProd(rowI, workNonBasicTab[list[j]], nTab);
 	    if (resolveWithNormalization && i == j){
 	      // Penalize the norm of lambda, i.e. the solution
+	      value += norm[k]*param.getNormalization();
+	    }
+	  }
 #ifdef RS2_USE_LAPACK
-	      A[i*numUsedRows+j] += norm[k]*param.getNormalization();
+	  A[i*numUsedRows+j] = value;
+	  A[j*numUsedRows+i] = value;
 #else
-	      A[i][j] += norm[k]*param.getNormalization();
+	  A[i][j] = value;
+	  A[j][i] = value;
 #endif
-	    }
-	  }
 	}
 	if (list[i] == k){
 	  b[i] = 1;
@@ -1159,29 +1295,26 @@ void CglRedSplit2::reduce_workNonBasicTab(int numRowsReduction,
 #endif
 	}
 	else{
-	  b[i] = 0;
-	  for (h = 0; h < nTab; ++h){
-	    b[i] -= workNonBasicTab[list[i]][h]*workNonBasicTab[k][h];
-	  }
+	  b[i] = -rs.rs_dotProd(rowI, workNonBasicTab[k], nTab);
 	}
       }
       // Linear system has been written, now solve it
 #ifdef RS2_USE_LAPACK
-      int info = 0;
+      int lapackInfo = 0;
       int h = 1;
       dgesv_(&numUsedRows, &h, A, &numUsedRows, indexlu, 
-	     b, &numUsedRows, &info);
+	     b, &numUsedRows, &lapackInfo);
 	
-      if (info)
+      if (lapackInfo)
 	continue;
 #else
       // LU decomposition
-      if (!ludcmp(A, numUsedRows, indexlu, &tmpnumlu, tmpveclu)){
+      if (!rs.ludcmp(A, numUsedRows, indexlu, &tmpnumlu, tmpveclu)){
 	// numerical error: exit
 	continue;
       }
       // Backward substitution
-      lubksb(A, numUsedRows, indexlu, b);
+      rs.lubksb(A, numUsedRows, indexlu, b);
 #endif
       // Check the 1-norm of the solution
       double sumnorm = 0.0;
@@ -1193,7 +1326,7 @@ void CglRedSplit2::reduce_workNonBasicTab(int numRowsReduction,
 	}
       }
 #ifdef RS2_TRACE
-      rs_printvecDBL("multipliers", b, numUsedRows);
+      rs.rs_printvecDBL("multipliers", b, numUsedRows);
       printf("sumnorm: %f\n", sumnorm);
 #endif
       if (sumnorm == 1){
@@ -1205,45 +1338,26 @@ void CglRedSplit2::reduce_workNonBasicTab(int numRowsReduction,
 	       sumnorm > param.getMaxSumMultipliers()){
 	// The norm of lambda is too large, resolve with normalization
 	// (note that we do not want to do this more than once)
-	resolveWithNormalization = true;
+	resolveRow = k;
 	k--;
 	continue;
       }
-      resolveWithNormalization = false;
       if (sumnorm > param.getMaxSumMultipliers()){
 	// If we got this far, even resolving did not help, so we skip
 	continue;
       }
-      double deltaNorm = compute_norm_change(norm[k], list, 
-					     numUsedRows, b);
+      double deltaNorm = rs.compute_norm_change(norm[k], list, 
+						numUsedRows, b, combination);
       if (deltaNorm <= -norm[k]*param.getMinNormReduction()){
 	for (i = 0; i < numUsedRows; ++i){
 	  pi_mat[k][list[i]] = (int)(b[i]);
 	}
-	numRedRows++;
+	numReduced++;
       }
     } /* if (norm[k] > param.getNormIsZero()) */
-  } /*for (k = 0; k < mTab; ++k) */
-  delete[] b;
-  delete[] list;
-  delete[] indexlu;
-  delete[] tmpveclu;
-#ifdef RS2_USE_LAPACK
-  delete[] A;
-#else
-  rs_deallocmatDBL(&A, maxRowsReduction);
-#endif
-
-#ifdef RS2_TRACE
-  sum_norms = 0;
-  for(i=0; i<mTab; i++) {
-    sum_norms += norm[i];
-  }
-  printf("CglRedSplit2::reduce_contNonBasicTab():Final sum of norms: %f\n", sum_norms);
-  printf("CglRedSplit2::reduce_contNonBasicTab(): %d rows reduced\n",numRedRows);
-#endif
-
-} /* reduce_workNonBasicTab */
+  } /* for (k = taskStart[iTask]; k < taskStart[iTask+1]; ++k) */
+  info->reduced[iTask] = numReduced;
+} /* reduce_task */
 
 /************************************************************************/
 void CglRedSplit2::generate_row(int index_row, double *row) {
@@ -1615,13 +1729,24 @@ void CglRedSplit2::generateCuts(const OsiSolverInterface &si, OsiCuts & cs,
   rowActivity = solver->getRowActivity();
   byRow = solver->getMatrixByRow();
 
-  solver->enableFactorization();
-  generateCuts(&cs, param.getMaxNumCuts());
-  solver->disableFactorization();
+  if(tableauProvider) {
+    // rows of tableau from shared factorization
+    if(tableauProvider->factorize(*solver)) {
+      printf("### WARNING: CglRedSplit2::generateCuts(): error during factorization.\n");
+      return;
+    }
+    generateCuts(&cs, param.getMaxNumCuts(), NULL, tableauProvider);
+  }
+  else {
+    solver->enableFactorization();
+    generateCuts(&cs, param.getMaxNumCuts());
+    solver->disableFactorization();
+  }
 } /* generateCuts */
 
 /************************************************************************/
-int CglRedSplit2::generateCuts(OsiCuts* cs, int maxNumCuts, int* lambda)
+int CglRedSplit2::generateCuts(OsiCuts* cs, int maxNumCuts, int* lambda,
+				CglTableauProvider* provider)
 {
   int i;
   is_integer = new int[ncol]; 
@@ -1643,7 +1768,12 @@ int CglRedSplit2::generateCuts(OsiCuts* cs, int maxNumCuts, int* lambda)
   rs_printvecINT("cstat", cstat, ncol);
   rs_printvecINT("rstat", rstat, nrow);
 #endif
-  solver->getBasics(basis_index);
+  if(provider) {
+    provider->getBasics(basis_index);
+  }
+  else {
+    solver->getBasics(basis_index);
+  }
 
   cv_intBasicVar = new int[ncol];  
   cv_intBasicVar_frac = new int[ncol];  
@@ -1805,12 +1935,23 @@ int CglRedSplit2::generateCuts(OsiCuts* cs, int maxNumCuts, int* lambda)
   // position of each integer basic variable in the simplex tableau
   int* origRow = new int[nrow];
 
-  card_intBasicVar = 0; // recompute in pivot order
+  card_intBasicVar = 0; // recompute in order of basic variables
   card_intBasicVar_frac = 0;
 
+  // Rows are taken in order of their basic variable, not pivot order,
+  // so cuts are the same whichever factorization gave the tableau
+  int *rowOrder = new int[nrow];
+  int *sortKey = new int[nrow];
   for(i=0; i<nrow; i++) {
+    rowOrder[i] = i;
+    sortKey[i] = basis_index[i];
+  }
+  CoinSort_2(sortKey, sortKey+nrow, rowOrder);
+  delete[] sortKey;
 
-    int ind_row = i;
+  for(i=0; i<nrow; i++) {
+
+    int ind_row = rowOrder[i];
 
     if(basis_index[ind_row] >= ncol || 
        cv_intBasicVar[basis_index[ind_row]] != 1) {
@@ -1828,7 +1969,12 @@ int CglRedSplit2::generateCuts(OsiCuts* cs, int maxNumCuts, int* lambda)
       cv_fracRowsTab[card_intBasicVar] = 1;
     }
     // obtain row of simplex tableau
-    solver->getBInvARow(ind_row, z, slack);
+    if(provider) {
+      provider->getBInvARow(ind_row, z, slack);
+    }
+    else {
+      solver->getBInvARow(ind_row, z, slack);
+    }
 
     rhsTab[card_rowTab] = xlp[basis_index[ind_row]];
 
@@ -1872,6 +2018,7 @@ int CglRedSplit2::generateCuts(OsiCuts* cs, int maxNumCuts, int* lambda)
     }
 #endif
   }
+  delete[] rowOrder;
 #if RS_FAST_INT == 0 && RS_FAST_CONT == 0 && RS_FAST_WORK == 0
   rs_allocmatINT(&pi_mat, mTab, mTab);
 #else
@@ -2320,7 +2467,9 @@ CglRedSplit2::CglRedSplit2() :
   pi_mat(0),
   contNonBasicTab(0),
   intNonBasicTab(0),
-  rhsTab(0)
+  rhsTab(0),
+  tableauProvider(NULL),
+  numberThreads(1)
 {
 }
 
@@ -2349,7 +2498,9 @@ CglRedSplit2::CglRedSplit2(const CglRedSplit2Param &RS_param) :
   pi_mat(0),
   contNonBasicTab(0),
   intNonBasicTab(0),
-  rhsTab(0)
+  rhsTab(0),
+  tableauProvider(NULL),
+  numberThreads(1)
 {
   param = RS_param;
 }
@@ -2380,7 +2531,9 @@ CglRedSplit2::CglRedSplit2 (const CglRedSplit2 & source) :
   pi_mat(NULL),
   contNonBasicTab(NULL),
   intNonBasicTab(NULL),
-  rhsTab(NULL)
+  rhsTab(NULL),
+  tableauProvider(source.tableauProvider),
+  numberThreads(source.numberThreads)
 {
 }
 
@@ -2403,6 +2556,8 @@ CglRedSplit2::operator=(const CglRedSplit2 &source)
   if (this != &source) {
     CglCutGenerator::operator=(source);
     param = source.param;
+    tableauProvider = source.tableauProvider;
+    numberThreads = source.numberThreads;
   }
   return *this;
 }
@@ -19,6 +19,8 @@
 #include "CoinHelperFunctions.hpp"
 #include "CoinTime.hpp"
 
+class CglTableauProvider;
+
 /** Reduce-and-Split Cut Generator Class; See method generateCuts().
     Based on the papers "Practical strategies for generating rank-1
     split cuts in mixed-integer linear programming" by G. Cornuejols
@@ -136,6 +138,22 @@ public:
 
   /// Print the current simplex tableau  
   void printOptTab(OsiSolverInterface *solver) const;
+
+  /// Set shared factorization and tableau rows (not owned).
+  /// If NULL, tableau rows are obtained from the solver.
+  /// Only used by generateCuts, not by generateMultipliers.
+  inline void setTableauProvider(CglTableauProvider *provider)
+  {tableauProvider = provider;}
+  /// Get shared factorization and tableau rows
+  inline CglTableauProvider *getTableauProvider() const
+  {return tableauProvider;}
+
+  /// Set number of threads used to reduce rows of the tableau (only
+  /// used if compiled with CGL_THREAD). Cuts are the same whatever the
+  /// number, except that the time limit is on cpu time of all threads.
+  inline void setNumberThreads(int value) {numberThreads = value;}
+  /// Get number of threads used to reduce rows of the tableau
+  inline int getNumberThreads() const {return numberThreads;}
   
   //@}
 
@@ -174,7 +192,9 @@ private:
   // generated cuts (or multipliers).
   // Will generate cuts if cs != NULL, and will generate multipliers
   // if lambda != NULL. 
-  int generateCuts(OsiCuts* cs, int maxNumCuts, int* lambda = NULL);
+  // Rows of the tableau come from provider if not NULL.
+  int generateCuts(OsiCuts* cs, int maxNumCuts, int* lambda = NULL,
+		   CglTableauProvider* provider = NULL);
 
   /// Compute the fractional part of value, allowing for small error.
   inline double rs_above_integer(const double value) const; 
@@ -203,6 +223,9 @@ private:
 			      rowSelectionStrategy,
 			      int maxIterations);
 
+  /// Reduce one block of rows of workNonBasicTab (task for CglRunTasks)
+  static void reduce_task(void* info, int iTask, int iThread);
+
   /// Generate a linear combination of the rows of the current LP
   /// tableau, using the row multipliers stored in the matrix pi_mat
   /// on the row of index index_row
@@ -278,9 +301,10 @@ private:
   // Check if the linear combination given by listOfRows with given multipliers
   // improves the norm of row #rowindex; note: multipliers are rounded!
   // Returns the difference with respect to the old norm (if negative there is
-  // an improvement, if positive norm increases)
+  // an improvement, if positive norm increases); work must have nTab entries
   double compute_norm_change(double oldnorm, const int* listOfRows,
-			     int numElemList, const double* multipliers) const;
+			     int numElemList, const double* multipliers,
+			     double* work) const;
 
   // Compute the list of rows that should be used to reduce row #rowIndex
   int get_list_rows_reduction(int rowIndex, int numRowsReduction, 
@@ -477,6 +501,13 @@ private:
   /// Reset by each call to generateCuts().
   double startTime;
 
+  /// Shared factorization and tableau rows, or NULL (not owned).
+  CglTableauProvider *tableauProvider;
+
+  /// Number of threads to reduce rows with (only used if compiled
+  /// with CGL_THREAD)
+  int numberThreads;
+
   //@}
 };
 
@@ -6,8 +6,38 @@
 #endif
 
 #include <cassert>
+#include <cmath>
 #include "CoinPragma.hpp"
 #include "CglRedSplit2.hpp"
+#include "CglTableauProvider.hpp"
+
+// True if two cuts have the same support and their coefficients and
+// bounds differ by at most tolerance (relative for large values)
+static bool
+sameCut(const OsiRowCut & cut1, const OsiRowCut & cut2, double tolerance)
+{
+  const CoinPackedVector & row1 = cut1.row();
+  const CoinPackedVector & row2 = cut2.row();
+  int n = row1.getNumElements();
+  if (n != row2.getNumElements())
+    return false;
+  const int * index1 = row1.getIndices();
+  const int * index2 = row2.getIndices();
+  const double * element1 = row1.getElements();
+  const double * element2 = row2.getElements();
+  for (int i = 0; i < n; i++) {
+    if (index1[i] != index2[i])
+      return false;
+    double scale = CoinMax(1.0, fabs(element1[i]));
+    if (fabs(element1[i] - element2[i]) > tolerance*scale)
+      return false;
+  }
+  if (fabs(cut1.lb() - cut2.lb()) > tolerance*CoinMax(1.0, fabs(cut1.lb())))
+    return false;
+  if (fabs(cut1.ub() - cut2.ub()) > tolerance*CoinMax(1.0, fabs(cut1.ub())))
+    return false;
+  return true;
+}
 
 
 void
@@ -74,6 +104,35 @@ CglRedSplit2UnitTest(const OsiSolverInterface *baseSiP,
       int nRowCuts = cs.sizeRowCuts();
       std::cout<<"There are "<<nRowCuts<<" Reduce-and-Split2 cuts"<<std::endl;
       assert(cs.sizeRowCuts() > 0);
+
+      // Same cuts with tableau rows from a CglTableauProvider - its
+      // factorization is not the solver's so only to a tolerance
+      {
+	CglTableauProvider provider;
+	CglRedSplit2 gct2;
+	gct2.getParam().setMAX_SUPPORT(34);
+	gct2.setTableauProvider(&provider);
+	OsiCuts cs2;
+	gct2.generateCuts(*siP, cs2);
+	assert(cs2.sizeRowCuts() == nRowCuts);
+	for (int i = 0; i < nRowCuts; i++)
+	  assert(sameCut(cs2.rowCut(i), cs.rowCut(i), 1.0e-7));
+	assert(provider.numberFactorizations() == 1);
+      }
+
+      // Same cuts when reducing rows in parallel (without CGL_THREAD
+      // rows to reduce are still split into tasks)
+      for (int numberThreads = 2; numberThreads <= 8; numberThreads *= 2) {
+	CglRedSplit2 gct2;
+	gct2.getParam().setMAX_SUPPORT(34);
+	gct2.setNumberThreads(numberThreads);
+	OsiCuts cs2;
+	gct2.generateCuts(*siP, cs2);
+	assert(cs2.sizeRowCuts() == nRowCuts);
+	for (int i = 0; i < nRowCuts; i++)
+	  assert(cs2.rowCut(i) == cs.rowCut(i));
+      }
+
       OsiSolverInterface::ApplyCutsReturnCode rc = siP->applyCuts(cs);
       
       siP->resolve();
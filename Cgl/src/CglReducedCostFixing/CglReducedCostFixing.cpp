@@ -0,0 +1,305 @@
+// $Id$
+// Copyright (C) 2026, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <cfloat>
+#include <cassert>
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinPackedVector.hpp"
+#include "CoinSort.hpp"
+#include "CoinFinite.hpp"
+#include "OsiColCut.hpp"
+#include "CglReducedCostFixing.hpp"
+/* Fixes or tightens one candidate for this gap.
+   Returns 0 if not changed, 1 if tightened, 2 if fixed */
+static int tightenCandidate(double gap, int iColumn, double dj, double bound,
+			    double & otherBound,
+			    CoinPackedVector & lbs, CoinPackedVector & ubs)
+{
+  // can not move more than this
+  double move = floor(CoinMin(gap/dj,1.0e15));
+  if (iColumn>=0) {
+    double newUpper = bound+move;
+    if (newUpper<otherBound-0.5) {
+      otherBound = newUpper;
+      ubs.insert(iColumn,newUpper);
+      return (newUpper==bound) ? 2 : 1;
+    }
+  } else {
+    double newLower = bound-move;
+    if (newLower>otherBound+0.5) {
+      otherBound = newLower;
+      lbs.insert(-1-iColumn,newLower);
+      return (newLower==bound) ? 2 : 1;
+    }
+  }
+  return 0;
+}
+//-------------------------------------------------------------------
+// Generate reduced cost fixings
+//-------------------------------------------------------------------
+void
+CglReducedCostFixing::generateCuts(const OsiSolverInterface & si, OsiCuts & cs,
+				   const CglTreeInfo /*info*/)
+{
+  numberCandidates_=0;
+  numberDone_=0;
+  numberPartial_=0;
+  numberChanged_=0;
+  if (!si.isProvenOptimal())
+    return;
+  double direction = si.getObjSense();
+  objectiveValue_ = si.getObjValue()*direction;
+  double cutoff = cutoff_;
+  if (cutoff==COIN_DBL_MAX) {
+    si.getDblParam(OsiDualObjectiveLimit,cutoff);
+    cutoff *= direction;
+  }
+  double dualTolerance;
+  si.getDblParam(OsiDualTolerance,dualTolerance);
+  gapTolerance_ = 100.0*dualTolerance;
+  // not really but thats all we can get
+  double integerTolerance;
+  si.getDblParam(OsiPrimalTolerance,integerTolerance);
+  int numberColumns = si.getNumCols();
+  const double * lower = si.getColLower();
+  const double * upper = si.getColUpper();
+  const double * solution = si.getColSolution();
+  const double * reducedCost = si.getReducedCost();
+  gutsOfDelete();
+  column_ = new int [numberColumns];
+  dj_ = new double [numberColumns];
+  key_ = new double [numberColumns];
+  bound_ = new double [numberColumns];
+  otherBound_ = new double [numberColumns];
+  partial_ = new int [numberColumns];
+  // partial_ used for sort order first
+  int * which = partial_;
+  int n=0;
+  for (int iColumn=0;iColumn<numberColumns;iColumn++) {
+    if (si.isInteger(iColumn)&&upper[iColumn]>lower[iColumn]) {
+      double djValue = direction*reducedCost[iColumn];
+      double range = CoinMin(upper[iColumn]-lower[iColumn],1.0e30);
+      if (solution[iColumn]<lower[iColumn]+integerTolerance&&djValue>0.0) {
+	column_[n]=iColumn;
+	dj_[n]=djValue;
+      } else if (solution[iColumn]>upper[iColumn]-integerTolerance&&djValue<0.0) {
+	column_[n]=-1-iColumn;
+	dj_[n]=-djValue;
+      } else {
+	continue;
+      }
+      // sort on minus so largest first
+      key_[n]=-dj_[n]*range;
+      which[n]=n;
+      n++;
+    }
+  }
+  CoinSort_2(key_,key_+n,which);
+  // put in order
+  int * tempColumn = new int [n];
+  double * tempDj = new double [n];
+  for (int i=0;i<n;i++) {
+    int k=which[i];
+    key_[i] = -key_[i];
+    tempColumn[i]=column_[k];
+    tempDj[i]=dj_[k];
+  }
+  memcpy(column_,tempColumn,n*sizeof(int));
+  memcpy(dj_,tempDj,n*sizeof(double));
+  delete [] tempColumn;
+  delete [] tempDj;
+  for (int i=0;i<n;i++) {
+    int iColumn = column_[i];
+    if (iColumn>=0) {
+      bound_[i]=lower[iColumn];
+      otherBound_[i]=upper[iColumn];
+    } else {
+      iColumn = -1-iColumn;
+      bound_[i]=upper[iColumn];
+      otherBound_[i]=lower[iColumn];
+    }
+  }
+  numberCandidates_=n;
+  if (fabs(cutoff)<1.0e20)
+    tighten(cutoff-objectiveValue_+gapTolerance_,cs);
+}
+// Better solution found - only look at candidates which may change
+int
+CglReducedCostFixing::newCutoff(double cutoff, OsiCuts & cs)
+{
+  numberChanged_=0;
+  if (cutoff<cutoff_)
+    cutoff_=cutoff;
+  if (!numberCandidates_||fabs(cutoff)>=1.0e20)
+    return 0;
+  return tighten(cutoff-objectiveValue_+gapTolerance_,cs);
+}
+/* Fixes or tightens candidates which can be with this gap
+   and adds column cut to cs */
+int
+CglReducedCostFixing::tighten(double gap, OsiCuts & cs)
+{
+  numberChanged_=0;
+  if (gap<=0.0)
+    return 0;
+  CoinPackedVector lbs;
+  CoinPackedVector ubs;
+  // ones already looked at which may go further
+  int nPartial=0;
+  for (int i=0;i<numberPartial_;i++) {
+    int iCandidate = partial_[i];
+    int returnCode = tightenCandidate(gap,column_[iCandidate],dj_[iCandidate],
+				      bound_[iCandidate],otherBound_[iCandidate],
+				      lbs,ubs);
+    if (returnCode)
+      numberChanged_++;
+    if (returnCode!=2)
+      partial_[nPartial++]=iCandidate;
+  }
+  // new ones - in order so stop when gap too large
+  while (numberDone_<numberCandidates_&&key_[numberDone_]>gap) {
+    int iCandidate = numberDone_;
+    int returnCode = tightenCandidate(gap,column_[iCandidate],dj_[iCandidate],
+				      bound_[iCandidate],otherBound_[iCandidate],
+				      lbs,ubs);
+    if (returnCode)
+      numberChanged_++;
+    if (returnCode!=2)
+      partial_[nPartial++]=iCandidate;
+    numberDone_++;
+  }
+  numberPartial_=nPartial;
+  if (numberChanged_) {
+    OsiColCut cc;
+    cc.setLbs(lbs);
+    cc.setUbs(ubs);
+    cc.setEffectiveness(100.0);
+    cs.insert(cc);
+  }
+  return numberChanged_;
+}
+
+//-------------------------------------------------------------------
+// Default Constructor
+//-------------------------------------------------------------------
+CglReducedCostFixing::CglReducedCostFixing ()
+:
+  CglCutGenerator(),
+  cutoff_(COIN_DBL_MAX),
+  objectiveValue_(0.0),
+  gapTolerance_(0.0),
+  numberCandidates_(0),
+  numberDone_(0),
+  numberPartial_(0),
+  numberChanged_(0),
+  column_(NULL),
+  dj_(NULL),
+  key_(NULL),
+  bound_(NULL),
+  otherBound_(NULL),
+  partial_(NULL)
+{
+}
+
+//-------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------
+CglReducedCostFixing::CglReducedCostFixing (const CglReducedCostFixing & rhs)
+:
+  CglCutGenerator(rhs),
+  column_(NULL),
+  dj_(NULL),
+  key_(NULL),
+  bound_(NULL),
+  otherBound_(NULL),
+  partial_(NULL)
+{
+  gutsOfCopy(rhs);
+}
+
+//-------------------------------------------------------------------
+// Clone
+//-------------------------------------------------------------------
+CglCutGenerator *
+CglReducedCostFixing::clone() const
+{
+  return new CglReducedCostFixing(*this);
+}
+
+//-------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------
+CglReducedCostFixing::~CglReducedCostFixing ()
+{
+  gutsOfDelete();
+}
+
+//----------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------
+CglReducedCostFixing &
+CglReducedCostFixing::operator=(const CglReducedCostFixing& rhs)
+{
+  if (this != &rhs) {
+    CglCutGenerator::operator=(rhs);
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+// Frees candidates
+void
+CglReducedCostFixing::gutsOfDelete()
+{
+  delete [] column_;
+  delete [] dj_;
+  delete [] key_;
+  delete [] bound_;
+  delete [] otherBound_;
+  delete [] partial_;
+  column_ = NULL;
+  dj_ = NULL;
+  key_ = NULL;
+  bound_ = NULL;
+  otherBound_ = NULL;
+  partial_ = NULL;
+}
+// Copies candidates
+void
+CglReducedCostFixing::gutsOfCopy(const CglReducedCostFixing & rhs)
+{
+  cutoff_ = rhs.cutoff_;
+  objectiveValue_ = rhs.objectiveValue_;
+  gapTolerance_ = rhs.gapTolerance_;
+  numberCandidates_ = rhs.numberCandidates_;
+  numberDone_ = rhs.numberDone_;
+  numberPartial_ = rhs.numberPartial_;
+  numberChanged_ = rhs.numberChanged_;
+  if (rhs.column_) {
+    int n = numberCandidates_;
+    column_ = CoinCopyOfArray(rhs.column_,n);
+    dj_ = CoinCopyOfArray(rhs.dj_,n);
+    key_ = CoinCopyOfArray(rhs.key_,n);
+    bound_ = CoinCopyOfArray(rhs.bound_,n);
+    otherBound_ = CoinCopyOfArray(rhs.otherBound_,n);
+    partial_ = CoinCopyOfArray(rhs.partial_,n);
+  }
+}
+// Create C++ lines to get to current state
+std::string
+CglReducedCostFixing::generateCpp( FILE * fp)
+{
+  CglReducedCostFixing other;
+  fprintf(fp,"0#include \"CglReducedCostFixing.hpp\"\n");
+  fprintf(fp,"3  CglReducedCostFixing reducedCostFixing;\n");
+  if (getAggressiveness()!=other.getAggressiveness())
+    fprintf(fp,"3  reducedCostFixing.setAggressiveness(%d);\n",getAggressiveness());
+  else
+    fprintf(fp,"4  reducedCostFixing.setAggressiveness(%d);\n",getAggressiveness());
+  return "reducedCostFixing";
+}
@@ -0,0 +1,137 @@
+// $Id$
+// Copyright (C) 2026, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CglReducedCostFixing_H
+#define CglReducedCostFixing_H
+
+#include <string>
+
+#include "CglCutGenerator.hpp"
+
+/** Reduced cost fixing Cut Generator Class
+
+    Uses reduced costs of an optimal LP and a cutoff to fix integer
+    variables (or tighten bounds of general integer variables) which
+    are at a bound.  A variable at lower bound with reduced cost dj
+    can not move more than gap/dj where gap is cutoff-objective.
+
+    generateCuts keeps the candidates from the LP sorted so that when
+    a better solution is found newCutoff only has to look at those
+    candidates which can now be fixed or tightened.
+*/
+class CglReducedCostFixing : public CglCutGenerator {
+
+public:
+
+  /**@name Generate Cuts */
+  //@{
+  /** Fix or tighten bounds of integer variables using reduced costs
+      of the model of the solver interface, si, which should be optimal.
+
+      Insert the resulting column cut into OsiCut, cs.
+
+      Cutoff is as set by setCutoff or if not set the dual objective
+      limit of si.
+  */
+  virtual void generateCuts( const OsiSolverInterface & si, OsiCuts & cs,
+			     const CglTreeInfo info = CglTreeInfo());
+  /** Call when a better solution has been found.  Uses reduced costs
+      saved by last generateCuts so only candidates which can now
+      be changed are looked at.  Inserts a column cut into cs if any
+      bounds changed and returns number changed */
+  int newCutoff(double cutoff, OsiCuts & cs);
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Set cutoff - always as minimize
+  inline void setCutoff(double value)
+  { cutoff_=value;}
+  /// Get cutoff - always as minimize (COIN_DBL_MAX if not set)
+  inline double getCutoff() const
+  { return cutoff_;}
+  /// Number of candidates from last LP
+  inline int numberCandidates() const
+  { return numberCandidates_;}
+  /// Number of bounds changed by last generateCuts or newCutoff
+  inline int numberChanged() const
+  { return numberChanged_;}
+  //@}
+
+  /**@name Constructors and destructors */
+  //@{
+  /// Default constructor
+  CglReducedCostFixing ();
+
+  /// Copy constructor
+  CglReducedCostFixing (const CglReducedCostFixing & rhs);
+
+  /// Clone
+  virtual CglCutGenerator * clone() const;
+
+  /// Assignment operator
+  CglReducedCostFixing &
+    operator=(const CglReducedCostFixing& rhs);
+
+  /// Destructor
+  virtual
+    ~CglReducedCostFixing ();
+  /// Create C++ lines to get to current state
+  virtual std::string generateCpp( FILE * fp);
+  //@}
+
+protected:
+
+  // Protected member methods
+  /// Frees candidates
+  void gutsOfDelete();
+  /// Copies candidates
+  void gutsOfCopy(const CglReducedCostFixing & rhs);
+  /** Fixes or tightens candidates which can be with this gap
+      and adds column cut to cs.  Returns number changed */
+  int tighten(double gap, OsiCuts & cs);
+
+  // Protected member data
+
+  /**@name Protected member data */
+  //@{
+  /// Cutoff (as minimize)
+  double cutoff_;
+  /// Objective value (as minimize) of LP candidates come from
+  double objectiveValue_;
+  /// Added to gap to allow for dual tolerance
+  double gapTolerance_;
+  /// Number of candidates
+  int numberCandidates_;
+  /// Number of candidates at start of list which have been looked at
+  int numberDone_;
+  /// Number of candidates looked at but not fixed (general integers)
+  int numberPartial_;
+  /// Number of bounds changed last time
+  int numberChanged_;
+  /// Columns - -1-iColumn if at upper bound
+  int * column_;
+  /// Reduced cost (made positive)
+  double * dj_;
+  /// Sort key (dj * distance to other bound) - decreasing
+  double * key_;
+  /// Bound candidate is at
+  double * bound_;
+  /// Other bound (as tightened)
+  double * otherBound_;
+  /// Candidates looked at but not fixed
+  int * partial_;
+  //@}
+};
+
+//#############################################################################
+/** A function that tests the methods in the CglReducedCostFixing class. The
+    only reason for it not to be a member method is that this way it doesn't
+    have to be compiled into the library. And that's a gain, because the
+    library should be compiled with optimization on, but this method should be
+    compiled with debugging. */
+void CglReducedCostFixingUnitTest(const OsiSolverInterface * siP,
+				  const std::string mpdDir );
+
+#endif
@@ -0,0 +1,166 @@
+// $Id$
+// Copyright (C) 2026, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "OsiSolverInterface.hpp"
+#include "OsiCuts.hpp"
+#include "CglReducedCostFixing.hpp"
+
+// Apply column cuts in cs to lower and upper
+static void applyColumnCuts(const OsiCuts & cs, double * lower, double * upper)
+{
+  for (int i=0;i<cs.sizeColCuts();i++) {
+    const OsiColCut & cut = cs.colCut(i);
+    const CoinPackedVector & lbs = cut.lbs();
+    for (int k=0;k<lbs.getNumElements();k++) {
+      int iColumn = lbs.getIndices()[k];
+      lower[iColumn] = CoinMax(lower[iColumn],lbs.getElements()[k]);
+    }
+    const CoinPackedVector & ubs = cut.ubs();
+    for (int k=0;k<ubs.getNumElements();k++) {
+      int iColumn = ubs.getIndices()[k];
+      upper[iColumn] = CoinMin(upper[iColumn],ubs.getElements()[k]);
+    }
+  }
+}
+
+void
+CglReducedCostFixingUnitTest(const OsiSolverInterface *baseSiP,
+			     const std::string /*mpsDir*/)
+{
+  // Test default constructor
+  {
+    CglReducedCostFixing aGenerator;
+    assert (aGenerator.getCutoff()==COIN_DBL_MAX);
+    assert (!aGenerator.numberCandidates());
+  }
+
+  // Test copy & assignment
+  {
+    CglReducedCostFixing rhs;
+    {
+      CglReducedCostFixing bGenerator;
+      bGenerator.setCutoff(10.0);
+      CglReducedCostFixing cGenerator(bGenerator);
+      assert (cGenerator.getCutoff()==10.0);
+      rhs=bGenerator;
+    }
+    assert (rhs.getCutoff()==10.0);
+  }
+
+  // Test on a small problem whose reduced costs are the costs
+  //  min 10x0 + 3x1 + 2x2 + 0.5x3 - 4x4 + 7x5 + x6
+  //  x0 + ... + x6 <= 100
+  //  x0, x1, x4 binary, x2, x3, x6 integer in [0,10], x5 in [0,1]
+  // LP optimum is -4 with x4=1 and all others 0
+  {
+    const int numberColumns = 7;
+    double objective[numberColumns]={10.0,3.0,2.0,0.5,-4.0,7.0,1.0};
+    double columnLower[numberColumns]={0.0,0.0,0.0,0.0,0.0,0.0,0.0};
+    double columnUpper[numberColumns]={1.0,1.0,10.0,10.0,1.0,1.0,10.0};
+    int rowIndices[numberColumns]={0,0,0,0,0,0,0};
+    int columnIndices[numberColumns]={0,1,2,3,4,5,6};
+    double elements[numberColumns]={1.0,1.0,1.0,1.0,1.0,1.0,1.0};
+    CoinPackedMatrix matrix(true,rowIndices,columnIndices,elements,
+			    numberColumns);
+    double rowLower[1]={-COIN_DBL_MAX};
+    double rowUpper[1]={100.0};
+    OsiSolverInterface * siP = baseSiP->clone();
+    siP->loadProblem(matrix,columnLower,columnUpper,objective,
+		     rowLower,rowUpper);
+    for (int iColumn=0;iColumn<numberColumns;iColumn++) {
+      if (iColumn!=5)
+	siP->setInteger(iColumn);
+    }
+    siP->initialSolve();
+    assert (siP->isProvenOptimal());
+    assert (fabs(siP->getObjValue()+4.0)<1.0e-7);
+
+    // no cutoff - nothing to do
+    {
+      CglReducedCostFixing noCutoff;
+      OsiCuts cs;
+      noCutoff.generateCuts(*siP,cs);
+      assert (noCutoff.numberCandidates()==6);
+      assert (!noCutoff.numberChanged());
+      assert (!cs.sizeColCuts());
+    }
+
+    // cutoff 0.5 (gap 4.5) fixes x0 and tightens general integers
+    // x2 (<=2), x3 (<=9) and x6 (<=4)
+    CglReducedCostFixing incremental;
+    incremental.setCutoff(0.5);
+    double lower[numberColumns];
+    double upper[numberColumns];
+    {
+      OsiCuts cs;
+      incremental.generateCuts(*siP,cs);
+      assert (incremental.numberCandidates()==6);
+      assert (incremental.numberChanged()==4);
+      assert (cs.sizeColCuts()==1);
+      CoinCopyN(columnLower,numberColumns,lower);
+      CoinCopyN(columnUpper,numberColumns,upper);
+      applyColumnCuts(cs,lower,upper);
+      assert (upper[0]==0.0);
+      assert (upper[1]==1.0);
+      assert (upper[2]==2.0);
+      assert (upper[3]==9.0);
+      assert (lower[4]==0.0);
+      assert (upper[5]==1.0);
+      assert (upper[6]==4.0);
+    }
+
+    // better solutions - bounds from newCutoff must be the same as
+    // those from a full scan with the new cutoff
+    double cutoff[3]={-1.5,-2.9,-3.6};
+    int expectChanged[3]={5,3,2};
+    for (int iPass=0;iPass<3;iPass++) {
+      OsiCuts cs;
+      int nChanged = incremental.newCutoff(cutoff[iPass],cs);
+      assert (nChanged==incremental.numberChanged());
+      assert (nChanged==expectChanged[iPass]);
+      assert (incremental.getCutoff()==cutoff[iPass]);
+      applyColumnCuts(cs,lower,upper);
+      CglReducedCostFixing fullScan;
+      fullScan.setCutoff(cutoff[iPass]);
+      OsiCuts cs2;
+      fullScan.generateCuts(*siP,cs2);
+      double lower2[numberColumns];
+      double upper2[numberColumns];
+      CoinCopyN(columnLower,numberColumns,lower2);
+      CoinCopyN(columnUpper,numberColumns,upper2);
+      applyColumnCuts(cs2,lower2,upper2);
+      for (int iColumn=0;iColumn<numberColumns;iColumn++) {
+	assert (lower[iColumn]==lower2[iColumn]);
+	assert (upper[iColumn]==upper2[iColumn]);
+      }
+    }
+    // by now everything except continuous x5 is fixed
+    for (int iColumn=0;iColumn<numberColumns;iColumn++) {
+      if (iColumn!=5)
+	assert (lower[iColumn]==upper[iColumn]);
+    }
+    assert (lower[4]==1.0);
+    // a worse cutoff changes nothing
+    {
+      OsiCuts cs;
+      assert (!incremental.newCutoff(10.0,cs));
+      assert (!cs.sizeColCuts());
+      assert (incremental.getCutoff()==cutoff[2]);
+    }
+    delete siP;
+  }
+}
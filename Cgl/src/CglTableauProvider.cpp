@@ -0,0 +1,679 @@
+// $Id$
+// Copyright (C) 2026, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+#include "CoinWarmStartBasis.hpp"
+#include "OsiSolverInterface.hpp"
+#include "CglTableauProvider.hpp"
+
+//-------------------------------------------------------------------
+// Factorize basis given by status arrays (1 is basic)
+//-------------------------------------------------------------------
+int
+CglTableauProvider::factorize(const CoinPackedMatrix & columnCopy,
+			      const int * columnStatus, const int * rowStatus)
+{
+  if (!columnCopy.isColOrdered()) {
+    CoinPackedMatrix copy;
+    copy.reverseOrderedCopyOf(columnCopy);
+    return factorize(copy,columnStatus,rowStatus);
+  }
+  if (factorized_&&sameProblem(columnCopy,columnStatus,rowStatus))
+    return 0;
+  clear();
+  numberRows_ = columnCopy.getNumRows();
+  numberColumns_ = columnCopy.getNumCols();
+  columnCopy_ = columnCopy;
+  rowIsBasic_ = new int [numberRows_];
+  columnIsBasic_ = new int [numberColumns_];
+  int i;
+  for (i=0;i<numberRows_;i++)
+    rowIsBasic_[i] = (rowStatus[i]==1) ? 1 : -1;
+  for (i=0;i<numberColumns_;i++)
+    columnIsBasic_[i] = (columnStatus[i]==1) ? 1 : -1;
+  // Taken from CglGomory
+  //returns 0 -okay, -1 singular, -2 too many in basis, -99 memory */
+  int status=-100;
+  while (status<-98) {
+    status=factorization_.factorize(columnCopy_,
+				    rowIsBasic_, columnIsBasic_);
+    if (status==-99) factorization_.areaFactor(factorization_.areaFactor() * 2.0);
+  }
+  numberFactorizations_++;
+  if (status) {
+#ifdef COIN_DEVELOP
+    printf("Bad factorization of basis - status %d\n",status);
+#endif
+    return -1;
+  }
+  conditionNumber_ = factorization_.conditionNumber();
+  cacheStart_ = new int [2*numberRows_];
+  cacheLength_ = new int [2*numberRows_];
+  CoinFillN(cacheStart_,2*numberRows_,-1);
+  work_.reserve(numberRows_);
+  array_.reserve(numberRows_);
+  row_.reserve(numberColumns_);
+  factorized_=true;
+  return 0;
+}
+// Factorize basis given by warm start
+int
+CglTableauProvider::factorize(const CoinPackedMatrix & columnCopy,
+			      const CoinWarmStartBasis & basis)
+{
+  int numberRows = columnCopy.getNumRows();
+  int numberColumns = columnCopy.getNumCols();
+  int * rowStatus = new int [numberRows+numberColumns];
+  int * columnStatus = rowStatus+numberRows;
+  int i;
+  for (i=0;i<numberRows;i++)
+    rowStatus[i] = (basis.getArtifStatus(i) == CoinWarmStartBasis::basic) ? 1 : 0;
+  for (i=0;i<numberColumns;i++)
+    columnStatus[i] = (basis.getStructStatus(i) == CoinWarmStartBasis::basic) ? 1 : 0;
+  int returnCode = factorize(columnCopy,columnStatus,rowStatus);
+  delete [] rowStatus;
+  return returnCode;
+}
+// Factorize current basis of solver
+int
+CglTableauProvider::factorize(const OsiSolverInterface & si)
+{
+  CoinWarmStart * warmstart = si.getWarmStart();
+  CoinWarmStartBasis* warm =
+    dynamic_cast<CoinWarmStartBasis*>(warmstart);
+  int returnCode=-1;
+  if (warm)
+    returnCode = factorize(*si.getMatrixByCol(),*warm);
+  delete warmstart;
+  return returnCode;
+}
+// True if same matrix and basis as last factorization
+bool
+CglTableauProvider::sameProblem(const CoinPackedMatrix & columnCopy,
+				const int * columnStatus,
+				const int * rowStatus) const
+{
+  if (columnCopy.getNumRows()!=numberRows_||
+      columnCopy.getNumCols()!=numberColumns_||
+      columnCopy.getNumElements()!=columnCopy_.getNumElements())
+    return false;
+  int i;
+  // basis first as cheaper
+  for (i=0;i<numberRows_;i++) {
+    if ((rowStatus[i]==1)!=(rowIsBasic_[i]>=0))
+      return false;
+  }
+  for (i=0;i<numberColumns_;i++) {
+    if ((columnStatus[i]==1)!=(columnIsBasic_[i]>=0))
+      return false;
+  }
+  const int * row = columnCopy.getIndices();
+  const CoinBigIndex * columnStart = columnCopy.getVectorStarts();
+  const int * columnLength = columnCopy.getVectorLengths();
+  const double * columnElements = columnCopy.getElements();
+  const int * row2 = columnCopy_.getIndices();
+  const CoinBigIndex * columnStart2 = columnCopy_.getVectorStarts();
+  const int * columnLength2 = columnCopy_.getVectorLengths();
+  const double * columnElements2 = columnCopy_.getElements();
+  for (i=0;i<numberColumns_;i++) {
+    int n = columnLength[i];
+    if (n!=columnLength2[i])
+      return false;
+    CoinBigIndex start = columnStart[i];
+    CoinBigIndex start2 = columnStart2[i];
+    for (int k=0;k<n;k++) {
+      if (row[start+k]!=row2[start2+k]||
+	  columnElements[start+k]!=columnElements2[start2+k])
+	return false;
+    }
+  }
+  return true;
+}
+// Forget factorization and all rows
+void
+CglTableauProvider::clear()
+{
+  gutsOfDelete();
+  factorized_=false;
+  haveRowCopy_=false;
+  conditionNumber_=0.0;
+  numberRows_=0;
+  numberColumns_=0;
+}
+// Basic variable in each pivot row
+void
+CglTableauProvider::getBasics(int * index) const
+{
+  int i;
+  for (i=0;i<numberRows_;i++) {
+    int iPivot = rowIsBasic_[i];
+    if (iPivot>=0)
+      index[iPivot]=numberColumns_+i;
+  }
+  for (i=0;i<numberColumns_;i++) {
+    int iPivot = columnIsBasic_[i];
+    if (iPivot>=0)
+      index[iPivot]=i;
+  }
+}
+//-------------------------------------------------------------------
+// Row of B^-1 for this pivot row
+//-------------------------------------------------------------------
+int
+CglTableauProvider::getBInvRow(int iPivot, CoinIndexedVector & array)
+{
+  assert (factorized_&&iPivot>=0&&iPivot<numberRows_);
+  if (cacheStart_[iPivot]>=0) {
+    numberRowsReused_++;
+    return copyFromCache(iPivot,array);
+  }
+  array.clear();
+  array.reserve(numberRows_);
+  double one=1.0;
+  array.setVector(1,&iPivot,&one);
+  factorization_.updateColumnTranspose(&work_,&array);
+  numberRowsComputed_++;
+  saveInCache(iPivot,array);
+  return array.getNumElements();
+}
+// Column part of row of B^-1 A for this pivot row
+int
+CglTableauProvider::getBInvARow(int iPivot, CoinIndexedVector & array)
+{
+  assert (factorized_&&iPivot>=0&&iPivot<numberRows_);
+  int which = numberRows_+iPivot;
+  if (cacheStart_[which]>=0) {
+    numberRowsReused_++;
+    return copyFromCache(which,array);
+  }
+  getBInvRow(iPivot,array_);
+  if (sparseEnough(array_)) {
+    int n = sparseBInvARow(array_,array);
+    array_.clear();
+    numberRowsComputed_++;
+    saveInCache(which,array);
+    return n;
+  }
+  const double * pi = array_.denseVector();
+  const int * row = columnCopy_.getIndices();
+  const CoinBigIndex * columnStart = columnCopy_.getVectorStarts();
+  const int * columnLength = columnCopy_.getVectorLengths();
+  const double * columnElements = columnCopy_.getElements();
+  array.clear();
+  array.reserve(numberColumns_);
+  int * index = array.getIndices();
+  double * element = array.denseVector();
+  int n=0;
+  for (int iColumn=0;iColumn<numberColumns_;iColumn++) {
+    double value=0.0;
+    for (CoinBigIndex k=columnStart[iColumn];
+	 k<columnStart[iColumn]+columnLength[iColumn];k++)
+      value += columnElements[k]*pi[row[k]];
+    if (fabs(value)>=COIN_INDEXED_TINY_ELEMENT) {
+      index[n++]=iColumn;
+      element[iColumn]=value;
+    }
+  }
+  array.setNumElements(n);
+  array.setPackedMode(false);
+  array_.clear();
+  numberRowsComputed_++;
+  saveInCache(which,array);
+  return n;
+}
+// Dense row of B^-1 A as OsiSolverInterface::getBInvARow
+void
+CglTableauProvider::getBInvARow(int iPivot, double * z, double * slack)
+{
+  int n = getBInvARow(iPivot,row_);
+  const int * index = row_.getIndices();
+  const double * element = row_.denseVector();
+  CoinZeroN(z,numberColumns_);
+  int i;
+  for (i=0;i<n;i++) {
+    int iColumn = index[i];
+    z[iColumn]=element[iColumn];
+  }
+  row_.clear();
+  if (slack) {
+    n = getBInvRow(iPivot,array_);
+    index = array_.getIndices();
+    element = array_.denseVector();
+    CoinZeroN(slack,numberRows_);
+    for (i=0;i<n;i++) {
+      int iRow = index[i];
+      slack[iRow]=element[iRow];
+    }
+    array_.clear();
+  }
+}
+// Rows of B^-1 for several pivot rows
+int
+CglTableauProvider::computeBInvRows(int number, const int * which)
+{
+  assert (factorized_);
+  int numberComputed=0;
+  for (int i=0;i<number;i++) {
+    int iPivot = which[i];
+    if (cacheStart_[iPivot]<0) {
+      getBInvRow(iPivot,array_);
+      array_.clear();
+      numberComputed++;
+    }
+  }
+  return numberComputed;
+}
+/* Rows of B^-1 A for several pivot rows.
+   Rows of B^-1 are computed one at a time (CoinFactorization has no
+   multiple right hand side btran) and stored by row of matrix so that
+   one pass through column copy gives all dense rows of B^-1 A.
+*/
+int
+CglTableauProvider::computeBInvARows(int number, const int * which)
+{
+  assert (factorized_);
+  // rows needing dense pass (position in batch and pivot row)
+  int * densePivot = new int [number];
+  int numberDense=0;
+  // Entries of rows of B^-1 for dense pass (by batch row)
+  int maximumEntries = CoinMax(number,1)*16;
+  int numberEntries=0;
+  int * entryRow = new int [maximumEntries];
+  int * entryWhich = new int [maximumEntries];
+  double * entryElement = new double [maximumEntries];
+  int numberComputed=0;
+  int i;
+  for (i=0;i<number;i++) {
+    int iPivot = which[i];
+    if (cacheStart_[numberRows_+iPivot]>=0)
+      continue;
+    int n = getBInvRow(iPivot,array_);
+    const int * index = array_.getIndices();
+    const double * element = array_.denseVector();
+    int k;
+    numberComputed++;
+    if (sparseEnough(array_)) {
+      // hypersparse - do now
+      sparseBInvARow(array_,row_);
+      numberRowsComputed_++;
+      saveInCache(numberRows_+iPivot,row_);
+      row_.clear();
+    } else {
+      if (numberEntries+n>maximumEntries) {
+	maximumEntries = CoinMax(2*maximumEntries,numberEntries+n);
+	int * temp = new int [maximumEntries];
+	CoinMemcpyN(entryRow,numberEntries,temp);
+	delete [] entryRow;
+	entryRow = temp;
+	temp = new int [maximumEntries];
+	CoinMemcpyN(entryWhich,numberEntries,temp);
+	delete [] entryWhich;
+	entryWhich = temp;
+	double * temp2 = new double [maximumEntries];
+	CoinMemcpyN(entryElement,numberEntries,temp2);
+	delete [] entryElement;
+	entryElement = temp2;
+      }
+      for (k=0;k<n;k++) {
+	int iRow = index[k];
+	entryRow[numberEntries]=iRow;
+	entryWhich[numberEntries]=numberDense;
+	entryElement[numberEntries++]=element[iRow];
+      }
+      densePivot[numberDense++]=iPivot;
+    }
+    array_.clear();
+  }
+  if (numberDense) {
+    // sort entries by row of matrix
+    CoinBigIndex * start = new CoinBigIndex [numberRows_+1];
+    CoinZeroN(start,numberRows_+1);
+    for (i=0;i<numberEntries;i++)
+      start[entryRow[i]+1]++;
+    for (i=0;i<numberRows_;i++)
+      start[i+1] += start[i];
+    int * batchWhich = new int [numberEntries];
+    double * batchElement = new double [numberEntries];
+    CoinBigIndex * put = new CoinBigIndex [numberRows_];
+    CoinMemcpyN(start,numberRows_,put);
+    for (i=0;i<numberEntries;i++) {
+      CoinBigIndex k = put[entryRow[i]]++;
+      batchWhich[k]=entryWhich[i];
+      batchElement[k]=entryElement[i];
+    }
+    delete [] put;
+    // one pass through column copy - results stored by column
+    double * sum = new double [numberDense];
+    CoinZeroN(sum,numberDense);
+    int * touched = new int [numberDense];
+    char * mark = new char [numberDense];
+    memset(mark,0,numberDense);
+    int * count = new int [numberDense+1];
+    CoinZeroN(count,numberDense+1);
+    int maximumOut = numberDense*16;
+    int numberOut=0;
+    int * outWhich = new int [maximumOut];
+    int * outColumn = new int [maximumOut];
+    double * outElement = new double [maximumOut];
+    const int * row = columnCopy_.getIndices();
+    const CoinBigIndex * columnStart = columnCopy_.getVectorStarts();
+    const int * columnLength = columnCopy_.getVectorLengths();
+    const double * columnElements = columnCopy_.getElements();
+    for (int iColumn=0;iColumn<numberColumns_;iColumn++) {
+      int nTouched=0;
+      for (CoinBigIndex k=columnStart[iColumn];
+	   k<columnStart[iColumn]+columnLength[iColumn];k++) {
+	int iRow = row[k];
+	double value = columnElements[k];
+	for (CoinBigIndex j=start[iRow];j<start[iRow+1];j++) {
+	  int iWhich = batchWhich[j];
+	  if (!mark[iWhich]) {
+	    mark[iWhich]=1;
+	    touched[nTouched++]=iWhich;
+	  }
+	  sum[iWhich] += value*batchElement[j];
+	}
+      }
+      if (numberOut+nTouched>maximumOut) {
+	maximumOut = CoinMax(2*maximumOut,numberOut+nTouched);
+	int * temp = new int [maximumOut];
+	CoinMemcpyN(outWhich,numberOut,temp);
+	delete [] outWhich;
+	outWhich = temp;
+	temp = new int [maximumOut];
+	CoinMemcpyN(outColumn,numberOut,temp);
+	delete [] outColumn;
+	outColumn = temp;
+	double * temp2 = new double [maximumOut];
+	CoinMemcpyN(outElement,numberOut,temp2);
+	delete [] outElement;
+	outElement = temp2;
+      }
+      for (int k=0;k<nTouched;k++) {
+	int iWhich = touched[k];
+	double value = sum[iWhich];
+	sum[iWhich]=0.0;
+	mark[iWhich]=0;
+	if (fabs(value)>=COIN_INDEXED_TINY_ELEMENT) {
+	  outWhich[numberOut]=iWhich;
+	  outColumn[numberOut]=iColumn;
+	  outElement[numberOut++]=value;
+	  count[iWhich+1]++;
+	}
+      }
+    }
+    // sort by batch row (keeping column order) and save
+    for (i=0;i<numberDense;i++)
+      count[i+1] += count[i];
+    int * sortedColumn = new int [numberOut+1];
+    double * sortedElement = new double [numberOut+1];
+    for (i=0;i<numberOut;i++) {
+      int k = count[outWhich[i]]++;
+      sortedColumn[k]=outColumn[i];
+      sortedElement[k]=outElement[i];
+    }
+    int startRow=0;
+    for (i=0;i<numberDense;i++) {
+      numberRowsComputed_++;
+      saveInCache(numberRows_+densePivot[i],count[i]-startRow,
+		  sortedColumn+startRow,sortedElement+startRow);
+      startRow = count[i];
+    }
+    delete [] sortedColumn;
+    delete [] sortedElement;
+    delete [] outWhich;
+    delete [] outColumn;
+    delete [] outElement;
+    delete [] count;
+    delete [] mark;
+    delete [] touched;
+    delete [] sum;
+    delete [] batchWhich;
+    delete [] batchElement;
+    delete [] start;
+  }
+  delete [] entryRow;
+  delete [] entryWhich;
+  delete [] entryElement;
+  delete [] densePivot;
+  return numberComputed;
+}
+// True if row of B^-1 A should be done using row copy
+bool
+CglTableauProvider::sparseEnough(const CoinIndexedVector & pi)
+{
+  if (!haveRowCopy_) {
+    rowCopy_.reverseOrderedCopyOf(columnCopy_);
+    haveRowCopy_=true;
+  }
+  const int * rowLength = rowCopy_.getVectorLengths();
+  const int * index = pi.getIndices();
+  int n = pi.getNumElements();
+  // estimate work if done by row
+  CoinBigIndex nWork=0;
+  for (int i=0;i<n;i++)
+    nWork += rowLength[index[i]];
+  return 10*nWork<columnCopy_.getNumElements();
+}
+// Row of B^-1 A using row copy
+int
+CglTableauProvider::sparseBInvARow(const CoinIndexedVector & pi,
+				   CoinIndexedVector & array)
+{
+  const int * column = rowCopy_.getIndices();
+  const CoinBigIndex * rowStart = rowCopy_.getVectorStarts();
+  const int * rowLength = rowCopy_.getVectorLengths();
+  const double * rowElements = rowCopy_.getElements();
+  const int * piIndex = pi.getIndices();
+  const double * piElement = pi.denseVector();
+  int numberInPi = pi.getNumElements();
+  array.clear();
+  array.reserve(numberColumns_);
+  int * index = array.getIndices();
+  double * element = array.denseVector();
+  int n=0;
+  int i;
+  for (i=0;i<numberInPi;i++) {
+    int iRow = piIndex[i];
+    double value = piElement[iRow];
+    for (CoinBigIndex k=rowStart[iRow];k<rowStart[iRow]+rowLength[iRow];k++) {
+      int iColumn = column[k];
+      double value2 = value*rowElements[k];
+      if (element[iColumn]) {
+	value2 += element[iColumn];
+	// keep in list even if cancelled
+	element[iColumn] = value2 ? value2 : COIN_DBL_MIN;
+      } else {
+	element[iColumn] = value2 ? value2 : COIN_DBL_MIN;
+	index[n++]=iColumn;
+      }
+    }
+  }
+  // same order and tolerance as column pass
+  std::sort(index,index+n);
+  int nKeep=0;
+  for (i=0;i<n;i++) {
+    int iColumn = index[i];
+    if (fabs(element[iColumn])>=COIN_INDEXED_TINY_ELEMENT)
+      index[nKeep++]=iColumn;
+    else
+      element[iColumn]=0.0;
+  }
+  array.setNumElements(nKeep);
+  array.setPackedMode(false);
+  return nKeep;
+}
+// Saves entry in cache if room
+void
+CglTableauProvider::saveInCache(int which, const CoinIndexedVector & array)
+{
+  int n = array.getNumElements();
+  if (cacheSize_+n>maximumCache_)
+    return;
+  if (cacheSize_+n>cacheAllocated_) {
+    int newSize = CoinMin(CoinMax(2*cacheAllocated_,cacheSize_+n+1000),
+			  maximumCache_);
+    int * temp = new int [newSize];
+    CoinMemcpyN(cacheIndex_,cacheSize_,temp);
+    delete [] cacheIndex_;
+    cacheIndex_ = temp;
+    double * temp2 = new double [newSize];
+    CoinMemcpyN(cacheElement_,cacheSize_,temp2);
+    delete [] cacheElement_;
+    cacheElement_ = temp2;
+    cacheAllocated_ = newSize;
+  }
+  const int * index = array.getIndices();
+  const double * element = array.denseVector();
+  cacheStart_[which]=cacheSize_;
+  cacheLength_[which]=n;
+  for (int i=0;i<n;i++) {
+    int j = index[i];
+    cacheIndex_[cacheSize_]=j;
+    cacheElement_[cacheSize_++]=element[j];
+  }
+}
+// Saves packed entry in cache if room
+void
+CglTableauProvider::saveInCache(int which, int n, const int * index,
+				const double * element)
+{
+  if (cacheSize_+n>maximumCache_)
+    return;
+  if (cacheSize_+n>cacheAllocated_) {
+    int newSize = CoinMin(CoinMax(2*cacheAllocated_,cacheSize_+n+1000),
+			  maximumCache_);
+    int * temp = new int [newSize];
+    CoinMemcpyN(cacheIndex_,cacheSize_,temp);
+    delete [] cacheIndex_;
+    cacheIndex_ = temp;
+    double * temp2 = new double [newSize];
+    CoinMemcpyN(cacheElement_,cacheSize_,temp2);
+    delete [] cacheElement_;
+    cacheElement_ = temp2;
+    cacheAllocated_ = newSize;
+  }
+  cacheStart_[which]=cacheSize_;
+  cacheLength_[which]=n;
+  CoinMemcpyN(index,n,cacheIndex_+cacheSize_);
+  CoinMemcpyN(element,n,cacheElement_+cacheSize_);
+  cacheSize_ += n;
+}
+// Copies entry from cache to array
+int
+CglTableauProvider::copyFromCache(int which, CoinIndexedVector & array) const
+{
+  array.clear();
+  array.reserve(which<numberRows_ ? numberRows_ : numberColumns_);
+  int * index = array.getIndices();
+  double * element = array.denseVector();
+  int start = cacheStart_[which];
+  int n = cacheLength_[which];
+  for (int i=0;i<n;i++) {
+    int j = cacheIndex_[start+i];
+    index[i]=j;
+    element[j]=cacheElement_[start+i];
+  }
+  array.setNumElements(n);
+  array.setPackedMode(false);
+  return n;
+}
+
+//-------------------------------------------------------------------
+// Default Constructor
+//-------------------------------------------------------------------
+CglTableauProvider::CglTableauProvider ()
+:
+  conditionNumber_(0.0),
+  rowIsBasic_(NULL),
+  columnIsBasic_(NULL),
+  cacheStart_(NULL),
+  cacheLength_(NULL),
+  cacheIndex_(NULL),
+  cacheElement_(NULL),
+  cacheSize_(0),
+  cacheAllocated_(0),
+  maximumCache_(5000000),
+  numberRows_(0),
+  numberColumns_(0),
+  numberFactorizations_(0),
+  numberRowsComputed_(0),
+  numberRowsReused_(0),
+  haveRowCopy_(false),
+  factorized_(false)
+{
+}
+
+//-------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------
+CglTableauProvider::CglTableauProvider (const CglTableauProvider & rhs)
+:
+  conditionNumber_(0.0),
+  rowIsBasic_(NULL),
+  columnIsBasic_(NULL),
+  cacheStart_(NULL),
+  cacheLength_(NULL),
+  cacheIndex_(NULL),
+  cacheElement_(NULL),
+  cacheSize_(0),
+  cacheAllocated_(0),
+  maximumCache_(rhs.maximumCache_),
+  numberRows_(0),
+  numberColumns_(0),
+  numberFactorizations_(0),
+  numberRowsComputed_(0),
+  numberRowsReused_(0),
+  haveRowCopy_(false),
+  factorized_(false)
+{
+}
+
+//-------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------
+CglTableauProvider::~CglTableauProvider ()
+{
+  gutsOfDelete();
+}
+
+//----------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------
+CglTableauProvider &
+CglTableauProvider::operator=(const CglTableauProvider& rhs)
+{
+  if (this != &rhs) {
+    clear();
+    maximumCache_ = rhs.maximumCache_;
+  }
+  return *this;
+}
+// Frees arrays
+void
+CglTableauProvider::gutsOfDelete()
+{
+  delete [] rowIsBasic_;
+  delete [] columnIsBasic_;
+  delete [] cacheStart_;
+  delete [] cacheLength_;
+  delete [] cacheIndex_;
+  delete [] cacheElement_;
+  rowIsBasic_ = NULL;
+  columnIsBasic_ = NULL;
+  cacheStart_ = NULL;
+  cacheLength_ = NULL;
+  cacheIndex_ = NULL;
+  cacheElement_ = NULL;
+  cacheSize_ = 0;
+  cacheAllocated_ = 0;
+}
@@ -0,0 +1,205 @@
+// $Id$
+// Copyright (C) 2026, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CglTableauProvider_H
+#define CglTableauProvider_H
+
+#include "CoinFactorization.hpp"
+#include "CoinIndexedVector.hpp"
+#include "CoinPackedMatrix.hpp"
+
+class CoinWarmStartBasis;
+class OsiSolverInterface;
+
+/** Basis factorization and tableau row service
+
+    Tableau based generators (Gomory, GMI, Twomir, RedSplit) each
+    factorize the same basis and compute the same rows of the tableau.
+    A CglTableauProvider can be passed to all of them (setTableauProvider)
+    so that the basis is factorized once per LP solution and rows of
+    B^-1 and of B^-1 A are computed once and then reused.
+
+    factorize only does work if the matrix or the set of basic variables
+    has changed since last time.  Rows are indexed by pivot row as given
+    by rowIsBasic and columnIsBasic (this is not necessarily the same order
+    as OsiSolverInterface::getBasics).  The slack part of a row uses the
+    convention of OsiSolverInterface::getBInvARow (i.e. Ax+s=b).
+
+    The provider is not owned by the generators.  It is not thread safe -
+    rows needed by several threads should be computed before they start.
+*/
+class CglTableauProvider {
+
+public:
+
+  /**@name Factorization */
+  //@{
+  /** Factorize basis given by status arrays (1 is basic as in
+      OsiSolverInterface::getBasisStatus).  Does nothing if same as
+      last time.  Returns 0 if okay, -1 if bad factorization */
+  int factorize(const CoinPackedMatrix & columnCopy,
+		const int * columnStatus, const int * rowStatus);
+  /// Factorize basis given by warm start
+  int factorize(const CoinPackedMatrix & columnCopy,
+		const CoinWarmStartBasis & basis);
+  /// Factorize current basis of solver
+  int factorize(const OsiSolverInterface & si);
+  /// Forget factorization and all rows
+  void clear();
+  /// True if there is a valid factorization
+  inline bool factorized() const
+  { return factorized_;}
+  /// Factorization (NULL if none)
+  inline const CoinFactorization * factorization() const
+  { return factorized_ ? &factorization_ : NULL;}
+  /// Condition number of factorization
+  inline double conditionNumber() const
+  { return conditionNumber_;}
+  /// Pivot row for each row (slack) or -1 if not basic
+  inline const int * rowIsBasic() const
+  { return rowIsBasic_;}
+  /// Pivot row for each column or -1 if not basic
+  inline const int * columnIsBasic() const
+  { return columnIsBasic_;}
+  /// Basic variable in each pivot row (slacks numberColumns+iRow)
+  void getBasics(int * index) const;
+  /// Number of rows
+  inline int numberRows() const
+  { return numberRows_;}
+  /// Number of columns
+  inline int numberColumns() const
+  { return numberColumns_;}
+  //@}
+
+  /**@name Tableau rows */
+  //@{
+  /** Puts row of B^-1 for this pivot row into array (not packed).
+      Returns number of elements */
+  int getBInvRow(int iPivot, CoinIndexedVector & array);
+  /** Puts column part of row of B^-1 A for this pivot row into
+      array (not packed).  Returns number of elements */
+  int getBInvARow(int iPivot, CoinIndexedVector & array);
+  /// Dense row of B^-1 A as OsiSolverInterface::getBInvARow
+  void getBInvARow(int iPivot, double * z, double * slack=NULL);
+  /** Computes rows of B^-1 for several pivot rows and keeps them in
+      cache so that getBInvRow just copies.  Returns number computed */
+  int computeBInvRows(int number, const int * which);
+  /** Computes column parts of rows of B^-1 A (and rows of B^-1) for
+      several pivot rows and keeps them in cache.  Rows where row of B^-1
+      is very sparse are done using a row copy, the rest are formed
+      together in one pass through the column copy.  Rows which do not
+      fit in cache will be computed again by getBInvARow, so the batch
+      should not be too large.  Returns number computed */
+  int computeBInvARows(int number, const int * which);
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Set maximum number of elements kept in row cache
+  inline void setMaximumCache(int value)
+  { maximumCache_=value;}
+  /// Get maximum number of elements kept in row cache
+  inline int maximumCache() const
+  { return maximumCache_;}
+  /// Number of times basis has been factorized
+  inline int numberFactorizations() const
+  { return numberFactorizations_;}
+  /// Number of rows computed (row of B^-1 or B^-1 A)
+  inline int numberRowsComputed() const
+  { return numberRowsComputed_;}
+  /// Number of rows found in cache
+  inline int numberRowsReused() const
+  { return numberRowsReused_;}
+  //@}
+
+  /**@name Constructors and destructors */
+  //@{
+  /// Default constructor
+  CglTableauProvider ();
+
+  /// Copy constructor (copies settings - not factorization)
+  CglTableauProvider (const CglTableauProvider & rhs);
+
+  /// Assignment operator (copies settings - not factorization)
+  CglTableauProvider &
+    operator=(const CglTableauProvider& rhs);
+
+  /// Destructor
+  ~CglTableauProvider ();
+  //@}
+
+private:
+
+  // Private member methods
+  /// Frees arrays
+  void gutsOfDelete();
+  /// True if same matrix and basis as last factorization
+  bool sameProblem(const CoinPackedMatrix & columnCopy,
+		   const int * columnStatus, const int * rowStatus) const;
+  /// Saves entry in cache if room
+  void saveInCache(int which, const CoinIndexedVector & array);
+  /// Saves packed entry in cache if room
+  void saveInCache(int which, int n, const int * index,
+		   const double * element);
+  /// Copies entry from cache to array
+  int copyFromCache(int which, CoinIndexedVector & array) const;
+  /// True if row of B^-1 A should be done using row copy
+  bool sparseEnough(const CoinIndexedVector & pi);
+  /// Row of B^-1 A using row copy (for very sparse row of B^-1)
+  int sparseBInvARow(const CoinIndexedVector & pi, CoinIndexedVector & array);
+
+  // Private member data
+
+  /**@name Private member data */
+  //@{
+  /// Factorization
+  CoinFactorization factorization_;
+  /// Copy of matrix factorized (by column)
+  CoinPackedMatrix columnCopy_;
+  /// Row copy of matrix (created when needed)
+  CoinPackedMatrix rowCopy_;
+  /// Work region for factorization
+  CoinIndexedVector work_;
+  /// Work region for row of B^-1
+  CoinIndexedVector array_;
+  /// Work region for row of B^-1 A
+  CoinIndexedVector row_;
+  /// Condition number
+  double conditionNumber_;
+  /// Pivot row for each row or -1
+  int * rowIsBasic_;
+  /// Pivot row for each column or -1
+  int * columnIsBasic_;
+  /** Start in cache of entries (-1 if not there).  First numberRows
+      are rows of B^-1, next numberRows rows of B^-1 A */
+  int * cacheStart_;
+  /// Length of cached entries
+  int * cacheLength_;
+  /// Indices in cache
+  int * cacheIndex_;
+  /// Elements in cache
+  double * cacheElement_;
+  /// Number of elements in cache
+  int cacheSize_;
+  /// Space allocated for cache
+  int cacheAllocated_;
+  /// Maximum number of elements in cache
+  int maximumCache_;
+  /// Number of rows
+  int numberRows_;
+  /// Number of columns
+  int numberColumns_;
+  /// Number of factorizations
+  int numberFactorizations_;
+  /// Number of rows computed
+  int numberRowsComputed_;
+  /// Number of rows reused
+  int numberRowsReused_;
+  /// True if rowCopy_ is valid
+  bool haveRowCopy_;
+  /// True if factorization valid
+  bool factorized_;
+  //@}
+};
+#endif
@@ -0,0 +1,81 @@
+// $Id$
+// Copyright (C) 2026, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CglConfig.h"
+#include "CglThreads.hpp"
+#ifdef CGL_THREAD
+#include <pthread.h>
+
+namespace {
+  // What one thread has to do
+  typedef struct {
+    CglTaskFunction function;
+    void * info;
+    int numberTasks;
+    int numberThreads;
+    int iThread;
+  } CglThreadArgument;
+
+  void * doTasks(void * voidArgument)
+  {
+    CglThreadArgument * argument =
+      reinterpret_cast<CglThreadArgument *> (voidArgument);
+    for (int iTask=argument->iThread;iTask<argument->numberTasks;
+	 iTask += argument->numberThreads)
+      argument->function(argument->info,iTask,argument->iThread);
+    return NULL;
+  }
+}
+#endif
+
+// Number of threads which will be used
+int
+CglNumberThreads(int numberThreads, int numberTasks)
+{
+  if (numberThreads>numberTasks)
+    numberThreads=numberTasks;
+  return (numberThreads>1) ? numberThreads : 1;
+}
+
+// Runs tasks and waits for them to finish
+void
+CglRunTasks(int numberThreads, int numberTasks,
+	    CglTaskFunction function, void * info)
+{
+  numberThreads = CglNumberThreads(numberThreads,numberTasks);
+#ifdef CGL_THREAD
+  if (numberThreads>1) {
+    pthread_t * threadId = new pthread_t [numberThreads];
+    CglThreadArgument * argument = new CglThreadArgument [numberThreads];
+    for (int iThread=0;iThread<numberThreads;iThread++) {
+      argument[iThread].function = function;
+      argument[iThread].info = info;
+      argument[iThread].numberTasks = numberTasks;
+      argument[iThread].numberThreads = numberThreads;
+      argument[iThread].iThread = iThread;
+    }
+    // calling thread does thread 0
+    int numberStarted=1;
+    for (int iThread=1;iThread<numberThreads;iThread++) {
+      if (pthread_create(threadId+iThread,NULL,doTasks,argument+iThread))
+	break;
+      numberStarted++;
+    }
+    if (numberStarted<numberThreads) {
+      // could not start all - do rest of tasks here (same thread numbers)
+      for (int iThread=numberStarted;iThread<numberThreads;iThread++)
+	doTasks(argument+iThread);
+    }
+    doTasks(argument);
+    for (int iThread=1;iThread<numberStarted;iThread++)
+      pthread_join(threadId[iThread],NULL);
+    delete [] argument;
+    delete [] threadId;
+    return;
+  }
+#endif
+  // in order on this thread - but same thread numbers as if parallel
+  for (int iTask=0;iTask<numberTasks;iTask++)
+    function(info,iTask,iTask%numberThreads);
+}
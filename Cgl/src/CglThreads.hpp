@@ -0,0 +1,37 @@
+// $Id$
+// Copyright (C) 2026, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CglThreads_H
+#define CglThreads_H
+
+/** Simple task runner for cut generators which can split their work
+    into independent tasks.
+
+    Threads are only used if Cgl was compiled with CGL_THREAD defined
+    and linked with pthreads (configure with --enable-cgl-threads) - as
+    for CBC_THREAD in Cbc.  Otherwise tasks are run in order on the
+    calling thread, but with the same thread numbers and the same
+    split into tasks, so that the code paths used by threads (and the
+    merging of results) are the same in a build without threads.
+
+    Task iTask is always run on thread iTask%numberThreads where
+    numberThreads is as returned by CglNumberThreads, so generators can
+    keep workspace per thread.  Results should be stored per task and
+    merged in task order so output does not depend on number of threads.
+*/
+
+/** Function run for each task.
+    info is shared by all tasks, iThread can be used to pick workspace */
+typedef void (*CglTaskFunction) (void * info, int iTask, int iThread);
+
+/** Number of threads which will be used for numberTasks tasks
+    if numberThreads asked for (if not compiled with CGL_THREAD these
+    are only thread numbers - all tasks are run by calling thread) */
+int CglNumberThreads(int numberThreads, int numberTasks);
+
+/// Runs tasks 0 through numberTasks-1 and waits for them to finish
+void CglRunTasks(int numberThreads, int numberTasks,
+		 CglTaskFunction function, void * info);
+
+#endif
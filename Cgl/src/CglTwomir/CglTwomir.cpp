@@ -22,6 +22,7 @@
 #include "OsiRowCutDebugger.hpp"
 #include "CoinWarmStartBasis.hpp"
 #include "CglTwomir.hpp"
+#include "CglTableauProvider.hpp"
 class CoinWarmStartBasis;
 #define COIN_HAS_CLP_TWOMIR
 #ifdef COIN_HAS_CLP_TWOMIR
@@ -313,7 +314,8 @@ void CglTwomir::generateCuts(const OsiSolverInterface & si, OsiCuts & cs,
   if (!do_2mir_) q_max = q_min - 1;
 
   if (do_tab_ && info.level < 1 && info.pass < 6)
-    DGG_generateTabRowCuts( &cut_list, data, reinterpret_cast<const void *> (useSolver) );
+    DGG_generateTabRowCuts( &cut_list, data, reinterpret_cast<const void *> (useSolver),
+			    tableauProvider_ );
   
   if (do_form_)
     DGG_generateFormulationCuts( &cut_list, data, reinterpret_cast<const void *> (useSolver),
@@ -503,7 +505,7 @@ CglTwomir::CglTwomir () :
   away_(0.0005),awayAtRoot_(0.0005),twomirType_(0),
   do_mir_(true), do_2mir_(true), do_tab_(true), do_form_(true),
   t_min_(1), t_max_(1), q_min_(1), q_max_(1), a_max_(2),max_elements_(50000),
-  max_elements_root_(50000),form_nrows_(0) {}
+  max_elements_root_(50000),form_nrows_(0),tableauProvider_(NULL) {}
 
 //-------------------------------------------------------------------
 // Copy constructor 
@@ -526,7 +528,8 @@ CglTwomir::CglTwomir (const CglTwomir & source) :
   a_max_(source.a_max_),
   max_elements_(source.max_elements_),
   max_elements_root_(source.max_elements_root_),
-  form_nrows_(source.form_nrows_)
+  form_nrows_(source.form_nrows_),
+  tableauProvider_(source.tableauProvider_)
 {
   probname_ = source.probname_ ;
   if (source.originalSolver_)
@@ -579,6 +582,7 @@ CglTwomir::operator=(const CglTwomir& rhs)
     max_elements_=rhs.max_elements_;
     max_elements_root_ = rhs.max_elements_root_;
     form_nrows_=rhs.form_nrows_;
+    tableauProvider_=rhs.tableauProvider_;
   }
   return *this;
 }
@@ -887,7 +891,8 @@ DGG_getTableauConstraint( int index,  const void *osi_ptr, DGG_data_t *data,
                           const int * colIsBasic,
                           const int * /*rowIsBasic*/,
                           CoinFactorization & factorization,
-                          int mode )
+                          int mode,
+                          CglTableauProvider * provider )
 {
 
 #if DGG_DEBUG_DGG
@@ -933,9 +938,14 @@ DGG_getTableauConstraint( int index,  const void *osi_ptr, DGG_data_t *data,
     work.reserve(data->nrow);
     array.reserve(data->nrow);
 
-    array.setVector(1,&colIsBasic[index],&one);
+    if (provider) {
+      /* row of basis inverse may be shared with other generators */
+      provider->getBInvRow(colIsBasic[index], array);
+    } else {
+      array.setVector(1,&colIsBasic[index],&one);
  
-    factorization.updateColumnTranspose ( &work, &array );
+      factorization.updateColumnTranspose ( &work, &array );
+    }
 
     int * arrayRows = array.getIndices();
     double *arrayElements = array.denseVector();
@@ -1401,7 +1411,8 @@ int DGG_nicefyConstraint( const void * /*solver_ptr*/,
 int
 DGG_generateTabRowCuts( DGG_list_t *cut_list,
 			    DGG_data_t *data,
-			    const void *solver_ptr )
+			    const void *solver_ptr,
+			    CglTableauProvider *provider )
 
 {
   int k, rval = 0;
@@ -1435,7 +1446,16 @@ DGG_generateTabRowCuts( DGG_list_t *cut_list,
   /* obtain address of the LP matrix */
   const OsiSolverInterface *si = reinterpret_cast<const OsiSolverInterface *> (solver_ptr);
   const CoinPackedMatrix *colMatrixPtr = si->getMatrixByCol();
-  rval = factorization.factorize(*colMatrixPtr, rowIsBasic, colIsBasic); 
+  if (provider) {
+    /* factorization only done if basis changed since other generators */
+    rval = provider->factorize(*colMatrixPtr, colIsBasic, rowIsBasic);
+    if (!rval) {
+      memcpy(colIsBasic, provider->columnIsBasic(), sizeof(int)*data->ncol);
+      memcpy(rowIsBasic, provider->rowIsBasic(), sizeof(int)*data->nrow);
+    }
+  } else {
+    rval = factorization.factorize(*colMatrixPtr, rowIsBasic, colIsBasic); 
+  }
   /* 0 = okay. -1 = singular. -2 = too many in basis. -99 = memory. */
   DGG_TEST2(rval, 1, "factorization error = %d", rval);
 
@@ -1447,7 +1467,8 @@ DGG_generateTabRowCuts( DGG_list_t *cut_list,
 
     base->nz = 0;
     rval = DGG_getTableauConstraint(k, solver_ptr, data, base, 
-                                    colIsBasic,rowIsBasic,factorization,0);
+                                    colIsBasic,rowIsBasic,factorization,0,
+                                    provider);
     DGG_CHECKRVAL(rval, rval);
 
     if (base->nz == 0){
@@ -10,6 +10,8 @@
 #include "CglCutGenerator.hpp"
 #include "CoinFactorization.hpp"
 
+class CglTableauProvider;
+
 typedef struct
 {
 
@@ -165,6 +167,12 @@ public:
   /// Return type
   inline int twomirType() const
   { return twomirType_;}
+  /// Set shared factorization and tableau rows (not owned, NULL for own)
+  inline void setTableauProvider(CglTableauProvider * provider)
+  { tableauProvider_=provider;}
+  /// Get shared factorization and tableau rows
+  inline CglTableauProvider * tableauProvider() const
+  { return tableauProvider_;}
   //@}
 
   /**@name Constructors and destructors */
@@ -216,6 +224,8 @@ private:
   int max_elements_; /// Maximum number of elements in cut
   int max_elements_root_; /// Maximum number of elements in cut at root
   int form_nrows_; //number of rows on which formulation cuts will be generated
+  /// Shared factorization and tableau rows (not owned)
+  CglTableauProvider * tableauProvider_;
   //@}
 };
 
@@ -485,13 +495,15 @@ int DGG_getTableauConstraint( int index,
                               const int * colIsBasic,
                               const int * rowIsBasic,
                               CoinFactorization & factorization,
-                              int mode );
+                              int mode,
+                              CglTableauProvider * provider=NULL );
 
 DGG_constraint_t* DGG_getSlackExpression(const void *solver_ptr, DGG_data_t* data, int row_index);
 
   int DGG_generateTabRowCuts( DGG_list_t *list,
 			      DGG_data_t *data,
-			      const void *solver_ptr );
+			      const void *solver_ptr,
+			      CglTableauProvider *provider=NULL );
 
   int DGG_generateFormulationCuts( DGG_list_t *list,
 				   DGG_data_t *data,
@@ -12,6 +12,7 @@
 #include <cassert>
 #include "CoinPragma.hpp"
 #include "CglTwomir.hpp"
+#include "CglTableauProvider.hpp"
 
 
 void
@@ -73,6 +74,21 @@ CglTwomirUnitTest(const OsiSolverInterface *baseSiP,
       int nRowCuts = cs.sizeRowCuts();
       std::cout<<"There are "<<nRowCuts<<" Twomir cuts"<<std::endl;
       assert(cs.sizeRowCuts() > 0);
+
+      // Same cuts with tableau rows from a CglTableauProvider (which
+      // factorizes basis in the same way)
+      {
+	CglTableauProvider provider;
+	CglTwomir gct2;
+	gct2.setTableauProvider(&provider);
+	OsiCuts cs2;
+	gct2.generateCuts(*siP, cs2);
+	assert(cs2.sizeRowCuts() == nRowCuts);
+	for (int i = 0; i < nRowCuts; i++)
+	  assert(cs2.rowCut(i) == cs.rowCut(i));
+	assert(provider.numberFactorizations() == 1);
+      }
+
       OsiSolverInterface::ApplyCutsReturnCode rc = siP->applyCuts(cs);
       
       siP->resolve();
@@ -3,10 +3,13 @@
 // Corporation and others.  All Rights Reserved.
 // This code is licensed under the terms of the Eclipse Public License (EPL).
 /** @file 012cut.c Definition file for C coded 0-1/2 separator */
+#include <algorithm>
 #include "CoinFinite.hpp"
 #include "CoinTime.hpp"
+#include "CoinSort.hpp"
 #include "Cgl012cut.hpp"
 #include "CglZeroHalf.hpp"
+#include "CglThreads.hpp"
 static int MAX_CUTS = 10000000;
 //#define PRINT_TABU
 //#define PRINT_CUTS
@@ -57,6 +60,9 @@ static int MAX_CUTS = 10000000;
 #define CLEAN_THRESH 0.9
 #define MANY_IT_ZERO 10
 
+#define MAX_PARITY_WORDS 4194304 /* maximum size of the packed parity rows */
+#define MAX_GAUSS_ROWS 500 /* maximum number of rows in Gaussian elimination */
+
 #define mod2(I) ( I % 2 == 0 ? 0 : 1 )
 
 
@@ -164,6 +170,20 @@ int gcd(int a,int b)
   return(a);
 }
 
+/* parity_popcount: number of 1's in a word of a packed parity row */
+
+static int parity_popcount(parity_word w)
+{
+#ifdef __GNUC__
+  return(__builtin_popcount(w));
+#else
+  int cnt = 0;
+
+  while ( w ) { w &= w - 1; cnt++; }
+  return(cnt);
+#endif
+}
+
 /* ILP data structures subroutines */
 
 /* ilp_load: load the input ILP into an internal data structure */
@@ -225,6 +245,15 @@ void Cgl012Cut::alloc_parity_ilp(
   if ( p_ilp->mtcnt == NULL ) alloc_error(const_cast<char*>("p_ilp->mtcnt"));
   p_ilp->mtind = reinterpret_cast<int *> (calloc(mnz,sizeof(int)));
   if ( p_ilp->mtind == NULL ) alloc_error(const_cast<char*>("p_ilp->mtind"));
+  /* rows are only packed if the bit matrix is not too large */
+  p_ilp->nwords = ( mc + PARITY_WORD_BITS - 1 ) / PARITY_WORD_BITS;
+  if ( static_cast<double> (mr) * p_ilp->nwords > MAX_PARITY_WORDS ) 
+    p_ilp->nwords = 0;
+  if ( p_ilp->nwords > 0 ) {
+    p_ilp->mtbit = reinterpret_cast<parity_word *> 
+      (calloc(mr*p_ilp->nwords,sizeof(parity_word)));
+    if ( p_ilp->mtbit == NULL ) alloc_error(const_cast<char*>("p_ilp->mtbit"));
+  }
   p_ilp->mrhs = reinterpret_cast<short int *> (calloc(mr,sizeof(short int)));
   if ( p_ilp->mrhs== NULL ) alloc_error(const_cast<char*>("p_ilp->mrhs"));
   p_ilp->xstar = reinterpret_cast<double *> (calloc(mc,sizeof(double)));
@@ -237,6 +266,13 @@ void Cgl012Cut::alloc_parity_ilp(
   if ( p_ilp->col_to_delete == NULL ) alloc_error(const_cast<char*>("p_ilp->col_to_delete"));
   p_ilp->gcd = reinterpret_cast<int *> (calloc(mr,sizeof(int)));
   if ( p_ilp->gcd == NULL ) alloc_error(const_cast<char*>("p_ilp->gcd"));
+  p_ilp->odd_cnt = reinterpret_cast<int *> (calloc(mr,sizeof(int)));
+  if ( p_ilp->odd_cnt == NULL ) alloc_error(const_cast<char*>("p_ilp->odd_cnt"));
+  p_ilp->odd_ind = reinterpret_cast<int *> (calloc(mnz,sizeof(int)));
+  if ( p_ilp->odd_ind == NULL ) alloc_error(const_cast<char*>("p_ilp->odd_ind"));
+  p_ilp->odd_rhs = reinterpret_cast<short int *> (calloc(mr,sizeof(short int)));
+  if ( p_ilp->odd_rhs == NULL ) alloc_error(const_cast<char*>("p_ilp->odd_rhs"));
+  p_ilp->rows_ready = FALSE;
   p_ilp->possible_weak = reinterpret_cast<short int *> (calloc(mc,sizeof(short int)));
   if ( p_ilp->possible_weak == NULL ) alloc_error(const_cast<char*>("p_ilp->possible_weak"));
   p_ilp->type_even_weak = reinterpret_cast<short int *> (calloc(mc,sizeof(short int)));
@@ -283,12 +319,16 @@ void Cgl012Cut::free_parity_ilp()
     free(p_ilp->mtbeg); 
     free(p_ilp->mtcnt); 
     free(p_ilp->mtind); 
+    free(p_ilp->mtbit); 
     free(p_ilp->mrhs); 
     free(p_ilp->xstar); 
     free(p_ilp->slack); 
     free(p_ilp->row_to_delete); 
     free(p_ilp->col_to_delete); 
     free(p_ilp->gcd); 
+    free(p_ilp->odd_cnt); 
+    free(p_ilp->odd_ind); 
+    free(p_ilp->odd_rhs); 
     free(p_ilp->possible_weak); 
     free(p_ilp->type_even_weak); 
     free(p_ilp->type_odd_weak); 
@@ -338,14 +378,49 @@ void free_info_weak(info_weak *i_weak)
   free(i_weak);
 } 
 
+/* get_parity_rows: compute the parts of the parity ILP which do not
+   depend on xstar - the GCD of each row and the odd entries and right
+   hand side parity of the row divided by its GCD */
+
+void Cgl012Cut::get_parity_rows()
+{
+  int i, ij, begi, ofsj, gcdi, cnti;
+
+  for ( i = 0; i < inp_ilp->mr; i++ ) {
+    begi = inp_ilp->mtbeg[i];
+    gcdi = inp_ilp->mrhs[i];
+    for ( ofsj = 0; ofsj < inp_ilp->mtcnt[i]; ofsj++ ) 
+      gcdi = gcd(gcdi,inp_ilp->mtval[begi+ofsj]);
+    //if ( gcdi != 1 ) 
+    //printf("Warning: constraint %d with nonprime coefficients\n",i); 
+    p_ilp->gcd[i] = gcdi;
+    p_ilp->odd_rhs[i] = mod2(( inp_ilp->mrhs[i] / gcdi ));
+    cnti = 0;
+    for ( ofsj = 0; ofsj < inp_ilp->mtcnt[i]; ofsj++ ) {
+      ij = begi + ofsj;
+      if ( mod2(( inp_ilp->mtval[ij] / gcdi )) == ODD ) {
+	p_ilp->odd_ind[begi+cnti] = inp_ilp->mtind[ij];
+	cnti++;
+      }
+    }
+    p_ilp->odd_cnt[i] = cnti;
+  }
+  p_ilp->rows_ready = TRUE;
+}
+
 /* get_parity_ilp: construct an internal data structure containing all the 
    information which can be useful for  0-1/2 cut separation */
 
 void Cgl012Cut::get_parity_ilp()
 {
-  int i, j, h, ij, aij, cnti, cnttot, begi, begh, ofsj, gcdi, ubj, lbj;
+  int i, j, h, k, l, ij, cnti, cnttot, begi, begh, ofsj, ubj, lbj, nwords;
+  int nsort, first, last;
   double slacki, xstarj, loss_upper, loss_lower;
   short int parity_col_removed, equalih;
+  parity_word *biti;
+  unsigned int hashi;
+  unsigned int *row_hash;
+  int *row_sort;
 
   /* allocate the memory for the parity ILP data structure */
 
@@ -478,23 +553,28 @@ void Cgl012Cut::get_parity_ilp()
     }
   }    
   
+  /* the gcd and the odd entries of each scaled row do not depend on
+     xstar - compute them at the first call only */
+
+  if ( ! p_ilp->rows_ready ) get_parity_rows();
+
   /* scan the constraints and delete those which are trivially useless 
      in the 0-1/2 cut separation */
 
+  nwords = p_ilp->nwords;
+  if ( nwords > 0 ) 
+    memset(p_ilp->mtbit,0,inp_ilp->mr*nwords*sizeof(parity_word));
   cnttot = 0;
   for ( i = 0; i < inp_ilp->mr; i++ ) {
     begi = inp_ilp->mtbeg[i];
     
-    /* compute the row slack and the GCD of the entries of the row */
+    /* compute the row slack */
     
     slacki = static_cast<double> (inp_ilp->mrhs[i]); 
-    gcdi = inp_ilp->mrhs[i];
     for ( ofsj = 0; ofsj < inp_ilp->mtcnt[i]; ofsj++ ) {
       ij = begi + ofsj;
-      j = inp_ilp->mtind[ij];
-      aij = inp_ilp->mtval[ij];
-      slacki -= static_cast<double> (aij ) * ( inp_ilp->xstar[j] );        
-      gcdi = gcd(gcdi,aij);
+      slacki -= static_cast<double> (inp_ilp->mtval[ij]) * 
+	( inp_ilp->xstar[inp_ilp->mtind[ij]] );        
     }
     if ( inp_ilp->msense[i] == 'G' ) slacki = -slacki;
     if ( slacki < -ZERO || ( inp_ilp->msense[i] == 'E' && slacki > ZERO ) ) {
@@ -519,28 +599,26 @@ printf("sense %c and rhs %d and slack %.5e\n",inp_ilp->msense[i],inp_ilp->mrhs[i
     if ( slacki > MAX_SLACK - EPS ) p_ilp->row_to_delete[i] = TRUE;
     else p_ilp->row_to_delete[i] = FALSE;
 
-    /* store the odd entries in the (possibly scaled) row i */
+    /* store the odd entries in the (possibly scaled) row i which are
+       not at a bound */
    
-    //if ( gcdi != 1 ) 
-    //printf("Warning: constraint %d with nonprime coefficients\n",i); 
-    p_ilp->gcd[i] = gcdi;
-    p_ilp->mrhs[i] = mod2(( inp_ilp->mrhs[i] / gcdi ));
+    p_ilp->mrhs[i] = p_ilp->odd_rhs[i];
     p_ilp->mtbeg[i] = cnttot;
     cnti = 0;
-    for ( ofsj = 0; ofsj < inp_ilp->mtcnt[i]; ofsj++ ) {
-      ij = begi + ofsj;
-      j = inp_ilp->mtind[ij];
-      aij = mod2(( inp_ilp->mtval[ij] / gcdi ));
-      if ( aij == ODD ) { 
-	if ( ! p_ilp->col_to_delete[j] ) {
-	  p_ilp->mtind[cnttot] = j;
-	  cnti++; cnttot++;       
-	}
-	else if ( p_ilp->possible_weak[j] == ODD ) {
-	  if ( p_ilp->mrhs[i] == EVEN ) p_ilp->mrhs[i] = ODD; 
-	  else p_ilp->mrhs[i] = EVEN;
+    for ( ofsj = 0; ofsj < p_ilp->odd_cnt[i]; ofsj++ ) {
+      j = p_ilp->odd_ind[begi+ofsj];
+      if ( ! p_ilp->col_to_delete[j] ) {
+	p_ilp->mtind[cnttot] = j;
+	cnti++; cnttot++;       
+	if ( nwords > 0 ) {
+	  biti = p_ilp->mtbit + i * nwords;
+	  biti[j / PARITY_WORD_BITS] ^= 1U << ( j % PARITY_WORD_BITS );
 	}
       }
+      else if ( p_ilp->possible_weak[j] == ODD ) {
+	if ( p_ilp->mrhs[i] == EVEN ) p_ilp->mrhs[i] = ODD; 
+	else p_ilp->mrhs[i] = EVEN;
+      }
     }
     p_ilp->mtcnt[i] = cnti;
     if ( cnti == 0 ) /* (scaled) row with even entries only */
@@ -558,31 +636,68 @@ printf("sense %c and rhs %d and slack %.5e\n",inp_ilp->msense[i],inp_ilp->mrhs[i
 
 #ifdef REDUCTION
   
-  /* remove identical rows in the parity matrix */
-  /* very trivial implementation */
-
-  for ( i = 0; i < p_ilp->mr; i++ ) 
-    for ( h = i+1; h < p_ilp->mr; h++ ) 
-      if ( ( p_ilp->mrhs[i] == p_ilp->mrhs[h] ) &&
-	   ( p_ilp->mtcnt[i] == p_ilp->mtcnt[h] ) && 
-	   ( ! p_ilp->row_to_delete[i] ) && 
-	   ( ! p_ilp->row_to_delete[h] ) ) {
-	begi = p_ilp->mtbeg[i]; begh = p_ilp->mtbeg[h];
-	equalih = TRUE;
-	for ( ofsj = 0; ofsj < p_ilp->mtcnt[i]; ofsj++ )
-	  /* the check assumes the indexes of the columns associated
-	     with each row are ordered in p_ilp->mtind[] ... */
-	  if ( p_ilp->mtind[begi+ofsj] != p_ilp->mtind[begh+ofsj] ) {
-	    equalih = FALSE;
-	    break;
+  /* remove identical rows in the parity matrix - the rows are sorted
+     by a hash of their odd columns so that only rows with the same hash
+     have to be compared (in the original order) */
+
+  row_hash = reinterpret_cast<unsigned int *> (calloc(p_ilp->mr,sizeof(unsigned int)));
+  if ( row_hash == NULL ) alloc_error(const_cast<char*>("row_hash"));
+  row_sort = reinterpret_cast<int *> (calloc(p_ilp->mr,sizeof(int)));
+  if ( row_sort == NULL ) alloc_error(const_cast<char*>("row_sort"));
+  nsort = 0;
+  for ( i = 0; i < p_ilp->mr; i++ ) {
+    if ( p_ilp->row_to_delete[i] ) continue;
+    /* the hash does not depend on the order of the columns */
+    hashi = 0;
+    begi = p_ilp->mtbeg[i];
+    for ( ofsj = 0; ofsj < p_ilp->mtcnt[i]; ofsj++ ) 
+      hashi += ( static_cast<unsigned int> (p_ilp->mtind[begi+ofsj]) + 1U ) * 2654435761U;
+    row_hash[nsort] = hashi * 31U + 
+      static_cast<unsigned int> (2 * p_ilp->mtcnt[i] + p_ilp->mrhs[i]);
+    row_sort[nsort] = i;
+    nsort++;
+  }
+  CoinSort_2(row_hash,row_hash+nsort,row_sort);
+  for ( first = 0; first < nsort; first = last ) {
+    for ( last = first + 1; last < nsort && row_hash[last] == row_hash[first]; last++ );
+    if ( last - first == 1 ) continue;
+    std::sort(row_sort+first,row_sort+last);
+    for ( k = first; k < last; k++ ) {
+      i = row_sort[k];
+      for ( l = k + 1; l < last; l++ ) {
+	h = row_sort[l];
+	if ( ( p_ilp->mrhs[i] == p_ilp->mrhs[h] ) &&
+	     ( p_ilp->mtcnt[i] == p_ilp->mtcnt[h] ) && 
+	     ( ! p_ilp->row_to_delete[i] ) && 
+	     ( ! p_ilp->row_to_delete[h] ) ) {
+	  equalih = TRUE;
+	  if ( nwords > 0 ) {
+	    /* word-wise comparison of the packed rows */
+	    if ( memcmp(p_ilp->mtbit + i * nwords, p_ilp->mtbit + h * nwords,
+			nwords * sizeof(parity_word)) ) equalih = FALSE;
+	  }
+	  else {
+	    begi = p_ilp->mtbeg[i]; begh = p_ilp->mtbeg[h];
+	    for ( ofsj = 0; ofsj < p_ilp->mtcnt[i]; ofsj++ )
+	      /* the check assumes the indexes of the columns associated
+		 with each row are ordered in p_ilp->mtind[] ... */
+	      if ( p_ilp->mtind[begi+ofsj] != p_ilp->mtind[begh+ofsj] ) {
+		equalih = FALSE;
+		break;
+	      }
+	  }
+	  if ( equalih ) {
+	    if ( p_ilp->slack[h] > p_ilp->slack[i] )
+	      p_ilp->row_to_delete[h] = TRUE;
+	    else 
+	      p_ilp->row_to_delete[i] = TRUE;
 	  }
-	if ( equalih ) {
-	  if ( p_ilp->slack[h] > p_ilp->slack[i] )
-	    p_ilp->row_to_delete[h] = TRUE;
-	  else 
-	    p_ilp->row_to_delete[i] = TRUE;
 	}
       }
+    }
+  }
+  free(row_sort);
+  free(row_hash);
 
   /* check for the existence of separate connected components in the 
      parity matrix row intersection graph */
@@ -1150,25 +1265,171 @@ void print_cycle_list(cycle_list *s_cycle_list)
 }
 #endif
 
+/* work space for the shortest path computations from one source
+   (one for each thread) */
+
+typedef struct {
+short_path_node *forw_arb; /* shortest path arborescence from source */
+short_path_node *backw_arb; /* shortest path anti-arborescence to sink */
+int *heap; /* binary heap of labelled nodes keyed on distance */
+int *position; /* position of each node in heap (-1 if not in heap) */
+} short_path_work;
+
+short_path_work *alloc_short_path_work(int nnodes /* nodes in auxiliary graph */)
+{
+  short_path_work *work;
+
+  work = reinterpret_cast<short_path_work *> (calloc(1,sizeof(short_path_work)));
+  if ( work == NULL ) alloc_error(const_cast<char*>("work"));
+  work->forw_arb = 
+    reinterpret_cast<short_path_node *> (calloc(nnodes,sizeof(short_path_node)));
+  if ( work->forw_arb == NULL ) alloc_error(const_cast<char*>("forw_arb"));
+  work->backw_arb = 
+    reinterpret_cast<short_path_node *> (calloc(nnodes,sizeof(short_path_node)));
+  if ( work->backw_arb == NULL ) alloc_error(const_cast<char*>("backw_arb"));
+  work->heap = reinterpret_cast<int *> (calloc(nnodes,sizeof(int)));
+  if ( work->heap == NULL ) alloc_error(const_cast<char*>("heap"));
+  work->position = reinterpret_cast<int *> (calloc(nnodes,sizeof(int)));
+  if ( work->position == NULL ) alloc_error(const_cast<char*>("position"));
+  return(work);
+}
+
+void free_short_path_work(short_path_work *work)
+{
+  free(work->forw_arb);
+  free(work->backw_arb);
+  free(work->heap);
+  free(work->position);
+  free(work);
+}
+
+/* heap_up/heap_down: restore the heap after the distance of the node
+   in position pos has decreased/increased */
+
+static void heap_up(int pos, short_path_work *work)
+{
+  int *heap = work->heap;
+  int *position = work->position;
+  short_path_node *arb = work->forw_arb;
+  int k = heap[pos];
+  long dist = arb[k].dist;
+
+  while ( pos > 0 ) {
+    int parent = (pos - 1) >> 1;
+    int kp = heap[parent];
+    if ( arb[kp].dist <= dist ) break;
+    heap[pos] = kp; position[kp] = pos;
+    pos = parent;
+  }
+  heap[pos] = k; position[k] = pos;
+}
+
+static void heap_down(int pos, int nheap, short_path_work *work)
+{
+  int *heap = work->heap;
+  int *position = work->position;
+  short_path_node *arb = work->forw_arb;
+  int k = heap[pos];
+  long dist = arb[k].dist;
+
+  for ( ; ; ) {
+    int child = 2 * pos + 1;
+    if ( child >= nheap ) break;
+    if ( child + 1 < nheap && arb[heap[child+1]].dist < arb[heap[child]].dist )
+      child++;
+    int kc = heap[child];
+    if ( arb[kc].dist >= dist ) break;
+    heap[pos] = kc; position[kc] = pos;
+    pos = child;
+  }
+  heap[pos] = k; position[k] = pos;
+}
+
+/* bounded_shortest_path: Dijkstra's algorithm with a binary heap giving
+   the shortest path arborescence rooted at source in work->forw_arb -
+   arcs leaving the twins of the separation graph nodes before first are
+   taken to have length ISCALE (as if removed by cancel_node_aux_graph)
+   and the search stops once paths are too long to be on a cycle of
+   weight less than MAX_CYCLE_WEIGHT + EPS, so that further nodes are
+   left unlabelled */
+
+static void bounded_shortest_path(
+				  int source, /* root of the arborescence */
+				  int first, /* first node not removed from separation graph */
+				  auxiliary_graph *a_graph, /* auxiliary graph - not changed */
+				  short_path_work *work /* work space for this search */
+				  )
+{
+  int k, nheap, kk, to;
+  bool removed;
+  long dist, new_dist;
+  cgl_arc *arc_ptr, *last_arc;
+  short_path_node *arb = work->forw_arb;
+  int *heap = work->heap;
+  int *position = work->position;
+  long max_dist;
+
+  /* largest distance which may be on a cycle of interest */
+  max_dist = static_cast<long> ((MAX_CYCLE_WEIGHT + EPS) * ISCALE) + 1;
+  while ( static_cast<double> (max_dist) / static_cast<double> (ISCALE) >=
+	  MAX_CYCLE_WEIGHT + EPS )
+    max_dist--;
+
+  for ( k = 0; k < a_graph->nnodes; k++ ) {
+    arb[k].dist = COIN_INT_MAX;
+    arb[k].pred = NONE;
+    position[k] = -1;
+  }
+  arb[source].dist = 0;
+  heap[0] = source; position[source] = 0;
+  nheap = 1;
+  while ( nheap > 0 ) {
+    k = heap[0];
+    position[k] = -1;
+    nheap--;
+    if ( nheap > 0 ) {
+      heap[0] = heap[nheap];
+      heap_down(0,nheap,work);
+    }
+    dist = arb[k].dist;
+    removed = SG_ORIG(k) < first;
+    last_arc = a_graph->nodes[k+1].firstArc;
+    for ( arc_ptr = a_graph->nodes[k].firstArc; arc_ptr < last_arc; arc_ptr++ ) {
+      if ( removed ) new_dist = dist + ISCALE;
+      else new_dist = dist + arc_ptr->length;
+      if ( new_dist > max_dist ) continue;
+      to = arc_ptr->to;
+      if ( new_dist < arb[to].dist ) {
+	arb[to].dist = new_dist;
+	arb[to].pred = k;
+	kk = position[to];
+	if ( kk < 0 ) {
+	  kk = nheap++;
+	  heap[kk] = to;
+	}
+	heap_up(kk,work);
+      }
+    }
+  }
+}
+
 /* get_shortest_odd_cycle_list: computation of the shortest odd cycles
    visiting a certain node in the separation graph, and each other 
    possible intermediate node, using the auxiliary graph data structure 
    for the shortest path computation - all the cycles in the list are
-   different from each other */
+   different from each other - nodes before j in the separation graph
+   are not visited (they have already been looked at) and the auxiliary
+   graph is not changed so several nodes may be done at once */
 
 cycle_list *get_shortest_odd_cycle_list(
 					int j, /* first node to be visited by the odd cycle */
 					separation_graph *s_graph, /* current separation graph */
-					auxiliary_graph *a_graph /* auxiliary graph for the shortest path computation */
+					auxiliary_graph *a_graph, /* auxiliary graph for the shortest path computation */
+					short_path_work *work /* work space for the shortest path computation */
 					)
 {
   int source, sink, curr, pred, totedges, k, t, kt;
   double weight;
-#ifndef CGL_NEW_SHORT
-  //node *source_ptr, *sink_ptr, *first_ptr; 
-#else
-  //cgl_node *source_ptr, *sink_ptr, *first_ptr; 
-#endif
   edge *curr_edge;
   short_path_node *forw_arb, *backw_arb;
   cycle *s_cycle;
@@ -1181,201 +1442,108 @@ cycle_list *get_shortest_odd_cycle_list(
   s_cycle_list = initialize_cycle_list((a_graph->nnodes)-2);
 
   source = AG_TWIN1(j); sink = AG_TWIN2(j);
-  //source_ptr = &(a_graph->nodes[source]);
-  //sink_ptr = &(a_graph->nodes[sink]);
-  //first_ptr = &(a_graph->nodes[0]);
 
   /* compute the shortest path arborescence rooted at source and
      the shortest path arborescence rooted at sink (that comes for
-     free due to symmetry) and store them (the path information is 
-     hidden into aux_graph) */
+     free due to symmetry) */
 
 #ifdef TIME
   second_(&ti);
 #endif
-#ifndef CGL_NEW_SHORT
-  {
-    int nNodes = a_graph->nnodes;
-    int nArcs = a_graph->narcs;
-    cgl_arc * arcs = new cgl_arc [nArcs];
-    for (int i=0;i<nArcs;i++) {
-      arcs[i].length=a_graph->arcs[i].len;
-      arcs[i].to=a_graph->arcs[i].head->index;
-    }
-    cgl_node * nodes = new cgl_node[nNodes+1];
-    for (int i=0;i<nNodes;i++) {
-      int iArc = a_graph->nodes[i].first-a_graph->arcs;
-      nodes[i].firstArc=arcs+iArc;
-      nodes[i].index=i;
-    }
-    int iArc = a_graph->nodes[nNodes].first-a_graph->arcs;
-    nodes[nNodes].firstArc=arcs+iArc;
-    cgl_graph graph;
-    graph.nnodes=nNodes;
-    graph.narcs=nArcs;
-    graph.nodes=nodes;
-    graph.arcs=arcs;
-    cglShortestPath(&graph,source,ISCALE);
-    dikbd(a_graph->nnodes,first_ptr,source_ptr,ISCALE);
-    for ( k = 0; k < a_graph->nnodes; k++ ) { 
-      if ( a_graph->nodes[k].parent != NULL ) {
-	int distance1 = a_graph->nodes[k].dist;
-	int distance2 = graph.nodes[k].distanceBack;
-	assert (distance1==distance2);
-      } else {
-	//
-	printf("null parent %d\n",k);
-      }
-    }
-  }
-#else
-  cglShortestPath(a_graph,source,ISCALE);
-#endif
+  bounded_shortest_path(source,j,a_graph,work);
 #ifdef TIME
   second_(&tf);
   path_time += tf - ti;
 #endif
-  forw_arb = 
-    reinterpret_cast<short_path_node *> (calloc(a_graph->nnodes,sizeof(short_path_node)));
-  if ( forw_arb == NULL ) alloc_error(const_cast<char*>("forw_arb"));
-  for ( k = 0; k < a_graph->nnodes; k++ ) { 
-#ifndef CGL_NEW_SHORT
-    if ( a_graph->nodes[k].parent != NULL ) {
-      forw_arb[k].dist = a_graph->nodes[k].dist;
-      forw_arb[k].pred = a_graph->nodes[k].parent->index;
-    }
-#else
-    if ( a_graph->nodes[k].parentNode >=0 ) {
-      forw_arb[k].dist = a_graph->nodes[k].distanceBack;
-      forw_arb[k].pred = a_graph->nodes[k].parentNode;
-    }
-#endif
-    else {
-      forw_arb[k].dist = COIN_INT_MAX;
-      forw_arb[k].pred = NONE;
-    }
-  }
-  backw_arb = 
-    reinterpret_cast<short_path_node *> (calloc(a_graph->nnodes,sizeof(short_path_node)));
-  if ( backw_arb == NULL ) alloc_error(const_cast<char*>("backw_arb"));
+  forw_arb = work->forw_arb;
+  backw_arb = work->backw_arb;
   for ( k = 0; k < a_graph->nnodes; k++ ) { 
-#ifndef CGL_NEW_SHORT
-    if ( a_graph->nodes[k].parent != NULL ) {
-      backw_arb[AG_MATE(k)].dist = a_graph->nodes[k].dist;
-      backw_arb[AG_MATE(k)].pred = AG_MATE(a_graph->nodes[k].parent->index);
-    }
-#else
-    if ( a_graph->nodes[k].parentNode >=0) {
-      backw_arb[AG_MATE(k)].dist = a_graph->nodes[k].distanceBack;
-      backw_arb[AG_MATE(k)].pred = AG_MATE(a_graph->nodes[k].parentNode);
+    if ( forw_arb[k].pred >= 0 ) {
+      backw_arb[AG_MATE(k)].dist = forw_arb[k].dist;
+      backw_arb[AG_MATE(k)].pred = AG_MATE(forw_arb[k].pred);
     }
-#endif
     else {
       backw_arb[AG_MATE(k)].dist = COIN_INT_MAX;
       backw_arb[AG_MATE(k)].pred = NONE;
     }
   }
 
-#ifdef USELESS
-  /* compute second the shortest path anti-arborescence rooted at sink 
-     (which coincides with the arborescence since aux_graph is 
-     symmetrical) and store it */
-
-#ifdef TIME
-  second_(&ti);
-#endif
-  cc = dikbd(a_graph->nnodes,first_ptr,sink_ptr,ISCALE);
-#ifdef TIME
-  second_(&tf);
-  path_time += tf - ti;
-#endif
-  backw_arb = 
-    (short_path_node *) calloc(a_graph->nnodes,sizeof(short_path_node));
-  if ( backw_arb == NULL ) alloc_error("backw_arb");
-  for ( k = 0; k < a_graph->nnodes; k++ ) { 
-    backw_arb[k].dist = a_graph->nodes[k].dist;
-    backw_arb[k].pred = a_graph->nodes[k].parent->index;
-  }
-#endif
-
   /* consider each possible intermediate node in aux_graph */
 
   for ( k = 0; k < s_graph->nnodes; k++ ) {
-    if ( k != j ) {
-      for ( t = 1; t <= 2; t++ ) {
-	if ( t == 1 ) kt = AG_TWIN1(k); 
-	else kt = AG_TWIN2(k);
-	weight = 
-	  (static_cast<double> (forw_arb[kt].dist + backw_arb[kt].dist)) / 
-	  (static_cast<double> (ISCALE));
-	if ( weight < MAX_CYCLE_WEIGHT + EPS ) {
-	  totedges = 0;
-	  /* count how many edges are in the forward path from source ... */
+    if ( k == j ) continue;
+    for ( t = 1; t <= 2; t++ ) {
+      if ( t == 1 ) kt = AG_TWIN1(k); 
+      else kt = AG_TWIN2(k);
+      if ( forw_arb[kt].pred == NONE || backw_arb[kt].pred == NONE ) continue;
+      weight = 
+	(static_cast<double> (forw_arb[kt].dist + backw_arb[kt].dist)) / 
+	(static_cast<double> (ISCALE));
+      if ( weight < MAX_CYCLE_WEIGHT + EPS ) {
+	totedges = 0;
+	/* count how many edges are in the forward path from source ... */
+	curr = kt;
+	do {
+	  if (curr<0) {
+	    totedges=-1;
+	    break;
+	  }
+	  curr = forw_arb[curr].pred; totedges++;
+	} while ( curr != source );
+	if (totedges>=0) {
+	  /* ... and in the backward path to sink */
 	  curr = kt;
 	  do {
 	    if (curr<0) {
 	      totedges=-1;
 	      break;
 	    }
-	    curr = forw_arb[curr].pred; totedges++;
+	    curr = backw_arb[curr].pred; totedges++;
+	  } while ( curr != sink );
+	}
+	if (totedges>0) {
+	  s_cycle = reinterpret_cast<cycle *> (calloc(1,sizeof(cycle)));
+	  if ( s_cycle == NULL ) alloc_error(const_cast<char*>("s_cycle"));
+	  s_cycle->weight = weight;
+	  s_cycle->length = totedges;
+	  s_cycle->edge_list = reinterpret_cast<edge **> (calloc(totedges,sizeof(edge *)));
+	  if ( s_cycle->edge_list == NULL ) alloc_error(const_cast<char*>("s_cycle->edge_list"));
+	  /* define the set of edges corresponding to the paths in sep_graph */
+	  totedges = 0;
+	  /* forward path from source ... */
+	  curr = kt;
+	  do {
+	    pred = forw_arb[curr].pred;
+	    if ( AG_TYPE(pred,curr) == EVEN ) 
+	      curr_edge = s_graph->even_adj_list
+		[SG_EDGE_INDEX(s_graph,SG_ORIG(curr),SG_ORIG(pred))]; 
+	    else
+	      curr_edge = s_graph->odd_adj_list
+		[SG_EDGE_INDEX(s_graph,SG_ORIG(curr),SG_ORIG(pred))]; 
+	    s_cycle->edge_list[totedges] = curr_edge;
+	    curr = pred; 
+	    totedges++;
 	  } while ( curr != source );
-	  if (totedges>=0) {
-	    /* ... and in the backward path to sink */
-	    curr = kt;
-	    do {
-	      if (curr<0) {
-		totedges=-1;
-		break;
-	      }
-	      curr = backw_arb[curr].pred; totedges++;
-	    } while ( curr != sink );
-	  }
-	  if (totedges>0) {
-	    s_cycle = reinterpret_cast<cycle *> (calloc(1,sizeof(cycle)));
-	    if ( s_cycle == NULL ) alloc_error(const_cast<char*>("s_cycle"));
-	    s_cycle->weight = weight;
-	    s_cycle->length = totedges;
-	    s_cycle->edge_list = reinterpret_cast<edge **> (calloc(totedges,sizeof(edge *)));
-	    if ( s_cycle->edge_list == NULL ) alloc_error(const_cast<char*>("s_cycle->edge_list"));
-	    /* define the set of edges corresponding to the paths in sep_graph */
-	    totedges = 0;
-	    /* forward path from source ... */
-	    curr = kt;
-	    do {
-	      pred = forw_arb[curr].pred;
-	      if ( AG_TYPE(pred,curr) == EVEN ) 
-		curr_edge = s_graph->even_adj_list
-		  [SG_EDGE_INDEX(s_graph,SG_ORIG(curr),SG_ORIG(pred))]; 
-	      else
-		curr_edge = s_graph->odd_adj_list
-		  [SG_EDGE_INDEX(s_graph,SG_ORIG(curr),SG_ORIG(pred))]; 
-	      s_cycle->edge_list[totedges] = curr_edge;
-	      curr = pred; 
-	      totedges++;
-	    } while ( curr != source );
-	    /* ... and backward path to sink */
-	    curr = kt;
-	    do {
-	      pred = backw_arb[curr].pred;
-	      if ( AG_TYPE(pred,curr) == EVEN ) 
-		curr_edge = s_graph->even_adj_list
-		  [SG_EDGE_INDEX(s_graph,SG_ORIG(curr),SG_ORIG(pred))]; 
-	      else
-		curr_edge = s_graph->odd_adj_list
-		  [SG_EDGE_INDEX(s_graph,SG_ORIG(curr),SG_ORIG(pred))]; 
-	      s_cycle->edge_list[totedges] = curr_edge;
-	      curr = pred; 
-	      totedges++;
-	    } while ( curr != sink );
-	    /* insert the new cycle in the list */
-	    s_cycle_list = add_cycle_to_list(s_cycle,s_cycle_list);
-	  }
+	  /* ... and backward path to sink */
+	  curr = kt;
+	  do {
+	    pred = backw_arb[curr].pred;
+	    if ( AG_TYPE(pred,curr) == EVEN ) 
+	      curr_edge = s_graph->even_adj_list
+		[SG_EDGE_INDEX(s_graph,SG_ORIG(curr),SG_ORIG(pred))]; 
+	    else
+	      curr_edge = s_graph->odd_adj_list
+		[SG_EDGE_INDEX(s_graph,SG_ORIG(curr),SG_ORIG(pred))]; 
+	    s_cycle->edge_list[totedges] = curr_edge;
+	    curr = pred; 
+	    totedges++;
+	  } while ( curr != sink );
+	  /* insert the new cycle in the list */
+	  s_cycle_list = add_cycle_to_list(s_cycle,s_cycle_list);
 	}
       }
     }
   }
-  free(forw_arb);
-  free(backw_arb);
 
 #ifdef TIME
   second_(&tsf);
@@ -1385,6 +1553,29 @@ cycle_list *get_shortest_odd_cycle_list(
   return(s_cycle_list);
 }
 
+/* information for finding the odd cycles from a block of nodes of
+   the separation graph on several threads */
+
+typedef struct {
+separation_graph *s_graph; /* current separation graph */
+auxiliary_graph *a_graph; /* auxiliary graph - shared and not changed */
+int first; /* first node of the block */
+int *task_start; /* first node (relative to first) of each task */
+cycle_list **cycles; /* shortest odd cycles from each node of the block */
+short_path_work **work; /* work space for each thread */
+} odd_cycle_info;
+
+static void odd_cycle_task(void *info, int itask, int ithread)
+{
+  odd_cycle_info *o_info = reinterpret_cast<odd_cycle_info *> (info);
+  int j;
+
+  for ( j = o_info->task_start[itask]; j < o_info->task_start[itask+1]; j++ )
+    o_info->cycles[j] = 
+      get_shortest_odd_cycle_list(o_info->first+j,o_info->s_graph,
+				  o_info->a_graph,o_info->work[ithread]);
+}
+
 /* cut management subroutines */
 
 /* initialize_cut_list: allocate and initialize the cut list data structure */
@@ -1640,21 +1831,10 @@ cut *Cgl012Cut::get_cut(
 	     cycle *s_cyc /* shortest odd cycles identified in the separation graph */
 	     )
 { 
-  int i, e, crhs;
-  short int ok;
-  /* short int original_parity; */
-  double violation;
-  /* double original_slack, best_even_slack, best_odd_slack; */
-  int *ccoef /*, *vars_to_weak */ ;  
-  /* info_weak *info_even_weak, *info_odd_weak; */
-  cut *v_cut;
+  int i, e;
   int ncomb;
   int *comb;
   short int *flag_comb;
-#ifndef CGGGGG
-  static int iter = 0;
-  static double gap, maxgap = 0.0;
-#endif
 
 #ifdef TIME
   second_(&tsi);
@@ -1664,12 +1844,6 @@ cut *Cgl012Cut::get_cut(
   /* compute the cut obtained by adding-up all the constraints 
      corresponding to edges in the cycle, in their non-weak form */
 
-#ifdef TIME
-  second_(&tii);
-#endif
-  
-  ccoef = reinterpret_cast<int *> (calloc(inp_ilp->mc,sizeof(int)));
-  if ( ccoef == NULL ) alloc_error(const_cast<char*>("ccoef"));
   ncomb = 0;
   comb = reinterpret_cast<int *> (calloc(inp_ilp->mr,sizeof(int)));
   if ( comb == NULL ) alloc_error(const_cast<char*>("comb"));
@@ -1678,11 +1852,7 @@ cut *Cgl012Cut::get_cut(
 #if 0
   // no need to as calloc used
   for ( i = 0; i < inp_ilp->mr; i++ ) flag_comb[i] = OUT;
-
-  for ( j = 0; j < inp_ilp->mc; j++ )
-    ccoef[j] = 0;
 #endif
-  crhs = 0;
   for ( e = 0; e < s_cyc->length; e++ ) {
     i = (s_cyc->edge_list[e])->constr; 
     if ( i >= 0 ) {
@@ -1690,6 +1860,58 @@ cut *Cgl012Cut::get_cut(
       comb[ncomb] = i; ncomb++; flag_comb[i] = IN;
     }
   }
+  return(comb_cut(ncomb,comb,flag_comb));
+}
+
+/* comb_cut: extract a hopefully violated cut from a combination of
+   constraints (takes over comb and flag_comb) */
+
+cut *Cgl012Cut::comb_cut(
+	      int ncomb, /* number of constraints combined */
+	      int *comb, /* list of the constraints combined */
+	      short int *flag_comb /* flag for the constraints combined */
+	      )
+{
+  int crhs;
+  short int ok;
+  double violation;
+  int *ccoef;
+  parity_word *odd_cols;
+  cut *v_cut;
+#ifndef CGGGGG
+  static int iter = 0;
+  static double gap, maxgap = 0.0;
+#endif
+
+#ifdef TIME
+  second_(&tii);
+#endif
+
+  /* quick check on the packed parity rows - no cut is possible if the
+     slack plus the loss of weakening the odd coefficients is too big */
+
+  ok = TRUE;
+  if ( p_ilp->nwords > 0 ) {
+    odd_cols = reinterpret_cast<parity_word *> 
+      (malloc(p_ilp->nwords*sizeof(parity_word)));
+    if ( odd_cols == NULL ) alloc_error(const_cast<char*>("odd_cols"));
+    if ( comb_slack_bound(ncomb,comb,odd_cols) > MAX_SLACK - EPS + ZERO ) 
+      ok = FALSE;
+    free(odd_cols);
+  }
+  if ( ! ok ) {
+    free(comb);
+    free(flag_comb);
+#ifdef TIME
+    second_(&tsf);
+    cut_time += tsf - tsi;
+#endif
+    return(NULL);
+  }
+  
+  ccoef = reinterpret_cast<int *> (calloc(inp_ilp->mc,sizeof(int)));
+  if ( ccoef == NULL ) alloc_error(const_cast<char*>("ccoef"));
+  crhs = 0;
   ok = get_ori_cut_coef(ncomb,comb,ccoef,&crhs,TRUE);
 
 #ifdef TIME
@@ -1742,6 +1964,50 @@ if ( gap > maxgap ) maxgap = gap;
   return(v_cut);
 }
 
+/* comb_slack_bound: lower bound on the slack of any 0-1/2 cut obtainable
+   from a combination of constraints, computed on the packed parity rows -
+   the rows are combined by word-wise XOR and each odd coefficient left
+   has to be weakened at a loss of at least min_loss_by_weak */
+
+double Cgl012Cut::comb_slack_bound(
+			int n_of_constr, /* number of constraints combined */
+			int *constr_list, /* list of the constraints combined */
+			parity_word *odd_cols /* work vector of p_ilp->nwords words */
+			)
+{
+  int h, i, j, w, nwords, nodd;
+  short int parity;
+  double bound;
+  parity_word *biti, word;
+
+  nwords = p_ilp->nwords;
+  memset(odd_cols,0,nwords*sizeof(parity_word));
+  bound = 0.0; parity = EVEN;
+  for ( h = 0; h < n_of_constr; h++ ) {
+    i = constr_list[h];
+    bound += p_ilp->slack[i] / static_cast<double> (p_ilp->gcd[i]);
+    if ( p_ilp->mrhs[i] == ODD ) parity = 1 - parity;
+    biti = p_ilp->mtbit + i * nwords;
+    for ( w = 0; w < nwords; w++ ) 
+      odd_cols[w] ^= biti[w];
+  }
+  if ( bound > MAX_SLACK - EPS ) return(bound);
+  nodd = 0;
+  for ( w = 0; w < nwords; w++ ) {
+    if ( odd_cols[w] == 0 ) continue;
+    nodd += parity_popcount(odd_cols[w]);
+    for ( word = odd_cols[w], j = w * PARITY_WORD_BITS; word; word >>= 1, j++ ) 
+      if ( word & 1 ) {
+	if ( p_ilp->possible_weak[j] == NONE ) return(INF);
+	bound += p_ilp->min_loss_by_weak[j];
+      }
+  }
+  /* even coefficients and even right hand side - no weakening can
+     make the right hand side odd */
+  if ( nodd == 0 && parity == EVEN ) return(INF);
+  return(bound);
+}
+
 /* cut_score: define the score of a (violated) cut */
 
 double Cgl012Cut::cut_score(
@@ -2065,6 +2331,9 @@ cut_list *Cgl012Cut::basic_separation()
   cycle_list *short_cycle_list;
   cut *violated_cut;
   cut_list *out_cuts;
+  int nthreads_used, block, first, nblock, ntasks, t;
+  short int stop;
+  odd_cycle_info o_info;
 
   /* construct the separation graph by the standard weakening procedure */
   
@@ -2229,40 +2498,66 @@ EXITJK:;  }
   printf("%d nodes on list\n",sep_graph->nnodes);
 #endif
   out_cuts = initialize_cut_list(MAX_CUTS);
-  for ( j = 0; j < sep_graph->nnodes; j++ ) {
-    short_cycle_list = get_shortest_odd_cycle_list(j,sep_graph,aux_graph);
-    if ( short_cycle_list == NULL ) goto EXIT_NODE;
+
+  /* the shortest odd cycles visiting each node are found for a block
+     of nodes at a time (split between threads if allowed) and are then
+     turned into cuts in node order - so the cuts do not depend on the
+     number of threads */
+
+  nthreads_used = CglNumberThreads(nthreads,sep_graph->nnodes);
+  block = ( nthreads_used > 1 ) ? 16 * nthreads_used : 1;
+  o_info.s_graph = sep_graph;
+  o_info.a_graph = aux_graph;
+  o_info.task_start = reinterpret_cast<int *> (calloc(block+1,sizeof(int)));
+  if ( o_info.task_start == NULL ) alloc_error(const_cast<char*>("o_info.task_start"));
+  o_info.cycles = reinterpret_cast<cycle_list **> (calloc(block,sizeof(cycle_list *)));
+  if ( o_info.cycles == NULL ) alloc_error(const_cast<char*>("o_info.cycles"));
+  o_info.work = 
+    reinterpret_cast<short_path_work **> (calloc(nthreads_used,sizeof(short_path_work *)));
+  if ( o_info.work == NULL ) alloc_error(const_cast<char*>("o_info.work"));
+  for ( t = 0; t < nthreads_used; t++ ) 
+    o_info.work[t] = alloc_short_path_work(aux_graph->nnodes);
+  stop = FALSE;
+  for ( first = 0; first < sep_graph->nnodes && ! stop; first += block ) {
+    nblock = sep_graph->nnodes - first;
+    if ( nblock > block ) nblock = block;
+    ntasks = ( nthreads_used > 1 ) ? 4 * nthreads_used : 1;
+    if ( ntasks > nblock ) ntasks = nblock;
+    for ( t = 0; t <= ntasks; t++ ) 
+      o_info.task_start[t] = (nblock * t) / ntasks;
+    o_info.first = first;
+    CglRunTasks(nthreads_used,ntasks,odd_cycle_task,&o_info);
+    for ( j = 0; j < nblock; j++ ) {
+      short_cycle_list = o_info.cycles[j];
 #ifdef PRINT
-    print_cycle_list(short_cycle_list);
+      print_cycle_list(short_cycle_list);
 #endif
-    for ( c = 0; c < short_cycle_list->cnum; c++ ) {
-      violated_cut = get_cut(short_cycle_list->list[c]);
-      if ( violated_cut == NULL ) {
-	if (!errorNo)
-	  continue;
-	else
-	  break;
-      }
+      for ( c = 0; c < short_cycle_list->cnum && ! stop; c++ ) {
+	violated_cut = get_cut(short_cycle_list->list[c]);
+	if ( violated_cut == NULL ) {
+	  if (!errorNo)
+	    continue;
+	  else
+	    break;
+	}
 #ifdef PRINT
-      print_cut(violated_cut);
-#endif
-      if ( violated_cut->violation > MIN_VIOLATION + EPS ) {
-	/* violated 0-1/2 cut found */  
-	out_cuts = add_cut_to_list(violated_cut,out_cuts);  
-	if ( out_cuts->cnum >= MAX_CUTS ) {
-	  free_cycle_list(short_cycle_list);
-	  goto EXIT_CUTS; 
+	print_cut(violated_cut);
+#endif
+	if ( violated_cut->violation > MIN_VIOLATION + EPS ) {
+	  /* violated 0-1/2 cut found */  
+	  out_cuts = add_cut_to_list(violated_cut,out_cuts);  
+	  if ( out_cuts->cnum >= MAX_CUTS ) stop = TRUE;
 	}
+	else free_cut(violated_cut);
       }
-      else free_cut(violated_cut);
+      free_cycle_list(short_cycle_list);
     }
-    /* remove the current node from the auxiliary graph */
-EXIT_NODE:
-    aux_graph = cancel_node_aux_graph(j,aux_graph); 
-    free_cycle_list(short_cycle_list);
   }
-
-EXIT_CUTS:
+  for ( t = 0; t < nthreads_used; t++ ) 
+    free_short_path_work(o_info.work[t]);
+  free(o_info.work);
+  free(o_info.cycles);
+  free(o_info.task_start);
   free_sep_graph(sep_graph);
   free_aux_graph(aux_graph);
 
@@ -2302,6 +2597,160 @@ static log_var **vlog = NULL; /* information about the value attained
 static bool aggr; /* flag saying whether as many cuts as possible are required
 		   from the separation procedure (TRUE) or not (FALSE) */
 #endif
+/* xor_words: add (mod 2) a packed vector to another */
+
+static void xor_words(
+		      parity_word *dst, /* vector to be updated */
+		      const parity_word *src, /* vector to be added */
+		      int nwords /* number of words in the vectors */
+		      )
+{
+  int w;
+
+  for ( w = 0; w < nwords; w++ ) 
+    dst[w] ^= src[w];
+}
+
+#define BIT_SET(V,J) ( ( (V)[(J) / PARITY_WORD_BITS] >> ( (J) % PARITY_WORD_BITS ) ) & 1U )
+
+/* gauss_separation: try to identify violated 0-1/2 cuts by Gaussian
+   elimination over GF(2) on the packed rows of the parity ILP - the
+   constraints are taken in increasing order of slack and the pivot of
+   each row is the odd column which is most expensive to weaken, so that
+   each row of the reduced system is a combination of constraints whose
+   odd coefficients are hopefully cheap to weaken and is tried as a cut */
+
+void Cgl012Cut::gauss_separation(cut_list *out_cuts /* list of the violated cuts found */)
+{
+  int i, j, r, p, w, h, nrow, nwords, cwords, ncomb, pivot;
+  double loss, maxloss;
+  double *slack_sort;
+  int *row_sort, *pivot_col, *comb_rows, *comb;
+  short int *rhs, *flag_comb;
+  parity_word *lhs, *rcomb, *lhsr, *odd_cols, word;
+  cut *violated_cut;
+
+  nwords = p_ilp->nwords;
+  if ( nwords == 0 ) return;
+
+  /* the constraints which may be combined, in increasing order of slack */
+
+  row_sort = reinterpret_cast<int *> (calloc(p_ilp->mr,sizeof(int)));
+  if ( row_sort == NULL ) alloc_error(const_cast<char*>("row_sort"));
+  slack_sort = reinterpret_cast<double *> (calloc(p_ilp->mr,sizeof(double)));
+  if ( slack_sort == NULL ) alloc_error(const_cast<char*>("slack_sort"));
+  nrow = 0;
+  for ( i = 0; i < p_ilp->mr; i++ ) 
+    if ( ! p_ilp->row_to_delete[i] ) {
+      row_sort[nrow] = i;
+      slack_sort[nrow] = p_ilp->slack[i];
+      nrow++;
+    }
+  CoinSort_2(slack_sort,slack_sort+nrow,row_sort);
+  free(slack_sort);
+  if ( nrow > MAX_GAUSS_ROWS ) nrow = MAX_GAUSS_ROWS;
+  if ( nrow == 0 ) {
+    free(row_sort);
+    return;
+  }
+
+  /* each row of the system keeps its odd columns, its right hand side
+     parity and the constraints combined to get it */
+
+  cwords = ( nrow + PARITY_WORD_BITS - 1 ) / PARITY_WORD_BITS;
+  lhs = reinterpret_cast<parity_word *> (calloc(nrow*nwords,sizeof(parity_word)));
+  if ( lhs == NULL ) alloc_error(const_cast<char*>("lhs"));
+  rcomb = reinterpret_cast<parity_word *> (calloc(nrow*cwords,sizeof(parity_word)));
+  if ( rcomb == NULL ) alloc_error(const_cast<char*>("rcomb"));
+  rhs = reinterpret_cast<short int *> (calloc(nrow,sizeof(short int)));
+  if ( rhs == NULL ) alloc_error(const_cast<char*>("rhs"));
+  pivot_col = reinterpret_cast<int *> (calloc(nrow,sizeof(int)));
+  if ( pivot_col == NULL ) alloc_error(const_cast<char*>("pivot_col"));
+
+  for ( r = 0; r < nrow; r++ ) {
+    i = row_sort[r];
+    lhsr = lhs + r * nwords;
+    memcpy(lhsr,p_ilp->mtbit + i * nwords,nwords*sizeof(parity_word));
+    rhs[r] = p_ilp->mrhs[i];
+    rcomb[r * cwords + r / PARITY_WORD_BITS] = 1U << ( r % PARITY_WORD_BITS );
+
+    /* reduce the row by the previous pivot rows */
+
+    for ( p = 0; p < r; p++ ) {
+      j = pivot_col[p];
+      if ( j >= 0 && BIT_SET(lhsr,j) ) {
+	xor_words(lhsr,lhs + p * nwords,nwords);
+	xor_words(rcomb + r * cwords,rcomb + p * cwords,cwords);
+	rhs[r] ^= rhs[p];
+      }
+    }
+
+    /* choose the pivot column */
+
+    pivot = -1; maxloss = -1.0;
+    for ( w = 0; w < nwords; w++ ) 
+      for ( word = lhsr[w], j = w * PARITY_WORD_BITS; word; word >>= 1, j++ ) 
+	if ( word & 1 ) {
+	  if ( p_ilp->possible_weak[j] == NONE ) loss = INF;
+	  else loss = p_ilp->min_loss_by_weak[j];
+	  if ( loss > maxloss ) {
+	    maxloss = loss;
+	    pivot = j;
+	  }
+	}
+    pivot_col[r] = pivot;
+
+    /* and eliminate it from the previous pivot rows */
+
+    if ( pivot >= 0 ) 
+      for ( p = 0; p < r; p++ ) 
+	if ( BIT_SET(lhs + p * nwords,pivot) ) {
+	  xor_words(lhs + p * nwords,lhsr,nwords);
+	  xor_words(rcomb + p * cwords,rcomb + r * cwords,cwords);
+	  rhs[p] ^= rhs[r];
+	}
+  }
+
+  /* try each row of the reduced system as a cut */
+
+  comb_rows = reinterpret_cast<int *> (calloc(nrow,sizeof(int)));
+  if ( comb_rows == NULL ) alloc_error(const_cast<char*>("comb_rows"));
+  odd_cols = reinterpret_cast<parity_word *> (calloc(nwords,sizeof(parity_word)));
+  if ( odd_cols == NULL ) alloc_error(const_cast<char*>("odd_cols"));
+  for ( r = 0; r < nrow && out_cuts->cnum < MAX_CUTS; r++ ) {
+    ncomb = 0;
+    for ( w = 0; w < cwords; w++ ) 
+      for ( word = rcomb[r * cwords + w], h = w * PARITY_WORD_BITS; word; word >>= 1, h++ ) 
+	if ( word & 1 ) {
+	  comb_rows[ncomb] = row_sort[h];
+	  ncomb++;
+	}
+    if ( comb_slack_bound(ncomb,comb_rows,odd_cols) > MAX_SLACK - EPS + ZERO ) 
+      continue;
+    comb = reinterpret_cast<int *> (calloc(inp_ilp->mr,sizeof(int)));
+    if ( comb == NULL ) alloc_error(const_cast<char*>("comb"));
+    flag_comb = reinterpret_cast<short int *> (calloc(inp_ilp->mr,sizeof(short int)));
+    if ( flag_comb == NULL ) alloc_error(const_cast<char*>("flag_comb"));
+    for ( h = 0; h < ncomb; h++ ) {
+      comb[h] = comb_rows[h];
+      flag_comb[comb_rows[h]] = IN;
+    }
+    violated_cut = comb_cut(ncomb,comb,flag_comb);
+    if ( violated_cut == NULL ) continue;
+    if ( violated_cut->violation > MIN_VIOLATION + EPS ) 
+      /* violated 0-1/2 cut found */  
+      add_cut_to_list(violated_cut,out_cuts);  
+    else free_cut(violated_cut);
+  }
+  free(odd_cols);
+  free(comb_rows);
+  free(pivot_col);
+  free(rhs);
+  free(rcomb);
+  free(lhs);
+  free(row_sort);
+}
+
 /* include the reactive local search heuristic */
 
 //was #include "Cgltabu_012.c"
@@ -2313,6 +2762,8 @@ static bool aggr; /* flag saying whether as many cuts as possible are required
 #define IN_PROHIB_PERIOD 3
 #define MAX_TIME_FACTOR 3
 
+#define TABU_SEED 1234567 /* seed for random numbers of first trajectory */
+
 /* data structure for the current local search solution */
 
 typedef struct {
@@ -2346,8 +2797,9 @@ struct h_e *next; /* pointer to the next element in the hash chain */
 
 typedef hash_element **hash_table;
 
-/* global variables for local search */
+/* state of one tabu search trajectory */
 
+struct tabu_state {
 int n; /* number of variables in the ILP */
 int m; /* number of constraints in the ILP */
 int it; /* number of tabu search iterations so far */
@@ -2361,68 +2813,77 @@ int last_prohib_period_mod; /* last iteration where prohibition period was modif
 hash_table hash_tab; /* hash table */
 int A; /* parameter A in Battiti and Protasi */
 int B; /* parameter B in Battiti and Protasi */
-float elapsed_time; /* time elapsed since the beginning of the current
-		       tabu search call */
+CoinThreadRandom random; /* random numbers for this trajectory */
+};
+
+/* random_index: random integer between 0 and n-1 from the random numbers
+   of this tabu search */
+
+int random_index(tabu_state *ts, int n)
+{
+  int i = static_cast<int> (ts->random.randomDouble() * n);
+  return ( i < n ) ? i : n - 1;
+}
 
 /* clear_cur_cut: clear the current solution (no constraint in the cut) */
 
-void clear_cur_cut()
+void clear_cur_cut(tabu_state *ts)
 {
   int i, j;
 
-  cur_cut->n_of_constr = 0;
-  cur_cut->rhs = 0;
-  cur_cut->non_weak_rhs = 0;
-  cur_cut->violation = 0.0;
-  cur_cut->slack_sum = 0.0;
-  cur_cut->min_weak_loss = 0.0;
-  cur_cut->one_norm = 0;
-  for ( j = 0; j < n; j++ ) {
-    cur_cut->coef[j] = 0;
-    cur_cut->non_weak_coef[j] = 0;
+  ts->cur_cut->n_of_constr = 0;
+  ts->cur_cut->rhs = 0;
+  ts->cur_cut->non_weak_rhs = 0;
+  ts->cur_cut->violation = 0.0;
+  ts->cur_cut->slack_sum = 0.0;
+  ts->cur_cut->min_weak_loss = 0.0;
+  ts->cur_cut->one_norm = 0;
+  for ( j = 0; j < ts->n; j++ ) {
+    ts->cur_cut->coef[j] = 0;
+    ts->cur_cut->non_weak_coef[j] = 0;
   }
-  for ( i = 0; i < m; i++ ) {
-    cur_cut->in_constr_list[i] = OUT;
+  for ( i = 0; i < ts->m; i++ ) {
+    ts->cur_cut->in_constr_list[i] = OUT;
   }
-  cur_cut->ok = FALSE;
+  ts->cur_cut->ok = FALSE;
 }
 
 /* initialize_cur_cut: allocate the memory for cur_cut */
 
-void initialize_cur_cut() 
+void initialize_cur_cut(tabu_state *ts) 
 {
-  cur_cut = reinterpret_cast<tabu_cut *> (calloc(1,sizeof(tabu_cut)));
-  if ( cur_cut == NULL ) alloc_error(const_cast<char*>("cur_cut"));
-  cur_cut->coef = reinterpret_cast<int *> (calloc(n,sizeof(int)));
-  if ( cur_cut->coef == NULL ) alloc_error(const_cast<char*>("cur_cut->coef"));
-  cur_cut->non_weak_coef = reinterpret_cast<int *> (calloc(n,sizeof(int)));
-  if ( cur_cut->non_weak_coef == NULL ) alloc_error(const_cast<char*>("cur_cut->non_weak_coef"));
-  cur_cut->in_constr_list = reinterpret_cast<short int *> (calloc(m,sizeof(short int)));
-  if ( cur_cut->in_constr_list == NULL ) alloc_error(const_cast<char*>("cur_cut->in_constr_list"));
-  clear_cur_cut();
+  ts->cur_cut = reinterpret_cast<tabu_cut *> (calloc(1,sizeof(tabu_cut)));
+  if ( ts->cur_cut == NULL ) alloc_error(const_cast<char*>("cur_cut"));
+  ts->cur_cut->coef = reinterpret_cast<int *> (calloc(ts->n,sizeof(int)));
+  if ( ts->cur_cut->coef == NULL ) alloc_error(const_cast<char*>("cur_cut->coef"));
+  ts->cur_cut->non_weak_coef = reinterpret_cast<int *> (calloc(ts->n,sizeof(int)));
+  if ( ts->cur_cut->non_weak_coef == NULL ) alloc_error(const_cast<char*>("cur_cut->non_weak_coef"));
+  ts->cur_cut->in_constr_list = reinterpret_cast<short int *> (calloc(ts->m,sizeof(short int)));
+  if ( ts->cur_cut->in_constr_list == NULL ) alloc_error(const_cast<char*>("cur_cut->in_constr_list"));
+  clear_cur_cut(ts);
 }
 
 /* free_cur_cut: free the memory for cur_cut */
 
-void free_cur_cut()
+void free_cur_cut(tabu_state *ts)
 {
-  free(cur_cut->coef);
-  free(cur_cut->non_weak_coef);
-  free(cur_cut->in_constr_list);
-  free(cur_cut);
+  free(ts->cur_cut->coef);
+  free(ts->cur_cut->non_weak_coef);
+  free(ts->cur_cut->in_constr_list);
+  free(ts->cur_cut);
 }
 
 #ifdef PRINT_TABU
 /* print_cur_cut: display cur_cut on output */
 
-void Cgl012Cut::print_cur_cut()
+void Cgl012Cut::print_cur_cut(tabu_state *ts)
 {
   int i, j; 
 
-  printf("iteration %d  prohib_period %d\n",it,prohib_period);
-  printf("\n content of cur_cut data structure: n_of_constr = %d, ok = %d\n", cur_cut->n_of_constr, cur_cut->ok);
-  for ( i = 0; i < m; i++ ) 
-    if ( cur_cut->in_constr_list[i] == IN ) 
+  printf("iteration %d  prohib_period %d\n",ts->it,ts->prohib_period);
+  printf("\n content of cur_cut data structure: n_of_constr = %d, ok = %d\n", ts->cur_cut->n_of_constr, ts->cur_cut->ok);
+  for ( i = 0; i < ts->m; i++ ) 
+    if ( ts->cur_cut->in_constr_list[i] == IN ) 
       printf("constr. %d\n",i);
   /*
   printf(" list of constraints:\n");
@@ -2434,14 +2895,14 @@ void Cgl012Cut::print_cur_cut()
   print_int_vect("coef",cur_cut->coef,n);
   printf(" rhs = %d\n",cur_cut->rhs);
   */
-  for ( j = 0 /* , viol = - (double) cur_cut->rhs */ ; j < n; j++ ) 
-    if ( ( p_ilp->xstar[j] > ZERO || p_ilp->xstar[j] < -ZERO ) && cur_cut->non_weak_coef[j] != 0 ) {
-      printf("var. %d  xstar %f  non_weak_coef %d  coef %d\n", j, p_ilp->xstar[j], cur_cut->non_weak_coef[j], cur_cut->coef[j]);
+  for ( j = 0 /* , viol = - (double) cur_cut->rhs */ ; j < ts->n; j++ ) 
+    if ( ( p_ilp->xstar[j] > ZERO || p_ilp->xstar[j] < -ZERO ) && ts->cur_cut->non_weak_coef[j] != 0 ) {
+      printf("var. %d  xstar %f  non_weak_coef %d  coef %d\n", j, p_ilp->xstar[j], ts->cur_cut->non_weak_coef[j], ts->cur_cut->coef[j]);
       /* viol += p_ilp->xstar[j] * cur_cut->coef[j]; */
     }
   printf("rhs %d  viol %f  slack_sum %f  min_weak_loss %f  one_norm %d\n", 
-	 cur_cut->rhs, cur_cut->violation, cur_cut->slack_sum,
-	 cur_cut->min_weak_loss, cur_cut->one_norm);
+	 ts->cur_cut->rhs, ts->cur_cut->violation, ts->cur_cut->slack_sum,
+	 ts->cur_cut->min_weak_loss, ts->cur_cut->one_norm);
 }  
 #endif  
 /* same_short_vect: check whether two short int vectors have the same content */
@@ -2460,41 +2921,41 @@ short int same_short_vect(
 
 /* initialize_hash_table: allocate the memory for the hash table */
 
-void initialize_hash_table()
+void initialize_hash_table(tabu_state *ts)
 {
   int i;
-  hash_tab = reinterpret_cast<hash_element **> (calloc(NUM_HASH_ENTRIES,sizeof(hash_element *)));
-  if ( hash_tab == NULL ) alloc_error(const_cast<char*>("hash_tab"));
-  for ( i = 0; i < NUM_HASH_ENTRIES; i++ ) hash_tab[i] = NULL;
+  ts->hash_tab = reinterpret_cast<hash_element **> (calloc(NUM_HASH_ENTRIES,sizeof(hash_element *)));
+  if ( ts->hash_tab == NULL ) alloc_error(const_cast<char*>("hash_tab"));
+  for ( i = 0; i < NUM_HASH_ENTRIES; i++ ) ts->hash_tab[i] = NULL;
 }
 
 /* clear_hash_table: clear the current hash table */
 
-void clear_hash_table()
+void clear_hash_table(tabu_state *ts)
 {
   int i; 
   hash_element *hash_ptr, *hash_el;
 
   for ( i = 0; i < NUM_HASH_ENTRIES; i++ ) {
-    if ( hash_tab[i] != NULL ) {
-      hash_ptr = hash_tab[i];
+    if ( ts->hash_tab[i] != NULL ) {
+      hash_ptr = ts->hash_tab[i];
       do {
 	hash_el = hash_ptr->next;
 	free(hash_ptr->flag_vect);
 	free(hash_ptr);
 	hash_ptr = hash_el;
       } while ( hash_ptr != NULL );
-      hash_tab[i] = NULL;
+      ts->hash_tab[i] = NULL;
     } 
   }
 }
 
 /* free_hash_table: deallocate the memory for the hash table */
 
-void free_hash_table()
+void free_hash_table(tabu_state *ts)
 {
-  clear_hash_table();
-  free(hash_tab);
+  clear_hash_table(ts);
+  free(ts->hash_tab);
 }
 
 /* hash_addr: compute the hash address associated with the current cut */
@@ -2516,17 +2977,17 @@ int hash_addr(
 /* hash_search: search for the current cut in the hash list of all cuts -
    if found return TRUE and update the last iteration the cut was found */
 
-short int hash_search(int *cyc_len /* length of the cycle if the current cut is found */)
+short int hash_search(tabu_state *ts, int *cyc_len /* length of the cycle if the current cut is found */)
 { 
   int addr;
   hash_element *hash_el;
 
-  addr = hash_addr(m,cur_cut->in_constr_list);
-  hash_el = hash_tab[addr];
+  addr = hash_addr(ts->m,ts->cur_cut->in_constr_list);
+  hash_el = ts->hash_tab[addr];
   while ( hash_el != NULL ) {
-    if ( same_short_vect(m,cur_cut->in_constr_list,hash_el->flag_vect) ) {
-      *cyc_len = it - hash_el->last_vis;
-      hash_el->last_vis = it;
+    if ( same_short_vect(ts->m,ts->cur_cut->in_constr_list,hash_el->flag_vect) ) {
+      *cyc_len = ts->it - hash_el->last_vis;
+      hash_el->last_vis = ts->it;
       return(TRUE);
     }
     hash_el = hash_el->next;
@@ -2536,29 +2997,29 @@ short int hash_search(int *cyc_len /* length of the cycle if the current cut is
 
 /* hash_insert: insert a new cut in the hash list of all cuts */
 
-void hash_insert()
+void hash_insert(tabu_state *ts)
 {
   int addr, i;
   hash_element *hash_el, *hash_ptr;
 
-  addr = hash_addr(m,cur_cut->in_constr_list);
+  addr = hash_addr(ts->m,ts->cur_cut->in_constr_list);
   hash_el = reinterpret_cast<hash_element *> (calloc(1,sizeof(hash_element)));
   if ( hash_el == NULL ) alloc_error(const_cast<char*>("hash_el"));
-  hash_el->n_of_el = m;
-  hash_el->last_vis = it;
+  hash_el->n_of_el = ts->m;
+  hash_el->last_vis = ts->it;
   hash_el->next = NULL;
-  hash_el->flag_vect = reinterpret_cast<short int *> (calloc(m,sizeof(short int)));
+  hash_el->flag_vect = reinterpret_cast<short int *> (calloc(ts->m,sizeof(short int)));
   if ( hash_el->flag_vect == NULL ) alloc_error(const_cast<char*>("hash_el->flag_vect"));
-  for ( i = 0; i < m; i++ )
-    hash_el->flag_vect[i] = cur_cut->in_constr_list[i];
-  if ( hash_tab[addr] == NULL ) 
-    hash_tab[addr] = hash_el;
+  for ( i = 0; i < ts->m; i++ )
+    hash_el->flag_vect[i] = ts->cur_cut->in_constr_list[i];
+  if ( ts->hash_tab[addr] == NULL ) 
+    ts->hash_tab[addr] = hash_el;
   else {
-    hash_ptr = hash_tab[addr];
+    hash_ptr = ts->hash_tab[addr];
     while ( hash_ptr->next != NULL ) {
 #if 0
       /* this check can be omitted to save time */
-      if ( same_short_vect(m,cur_cut->in_constr_list,hash_ptr->flag_vect) ) {
+      if ( same_short_vect(ts->m,ts->cur_cut->in_constr_list,hash_ptr->flag_vect) ) {
 	printf("attempt to insert in the hash an already present cut\n");
 	exit(0);
       }
@@ -2571,43 +3032,43 @@ void hash_insert()
 
 /* increase_prohib_period: implemented as in Battiti and Protasi */
 
-void increase_prohib_period()
+void increase_prohib_period(tabu_state *ts)
 {
-  if ( prohib_period * 1.1 > prohib_period + 1 ) 
-    if ( prohib_period * 1.1 < m - 2 ) prohib_period = 
-					 static_cast<int> (prohib_period*1.1);
-    else prohib_period = m - 2;
+  if ( ts->prohib_period * 1.1 > ts->prohib_period + 1 ) 
+    if ( ts->prohib_period * 1.1 < ts->m - 2 ) ts->prohib_period = 
+					 static_cast<int> (ts->prohib_period*1.1);
+    else ts->prohib_period = ts->m - 2;
   else
-    if ( prohib_period + 1 < m - 2 ) prohib_period += 1;
-    else prohib_period = m - 2;
-  last_prohib_period_mod = it;
+    if ( ts->prohib_period + 1 < ts->m - 2 ) ts->prohib_period += 1;
+    else ts->prohib_period = ts->m - 2;
+  ts->last_prohib_period_mod = ts->it;
 }
 
 /* decrease_prohib_period: implemented as in Battiti and Protasi */
 
-void decrease_prohib_period()
+void decrease_prohib_period(tabu_state *ts)
 {
-  if ( prohib_period * 0.9 < prohib_period - 1 ) 
-    if ( prohib_period * 0.9 > IN_PROHIB_PERIOD ) prohib_period = static_cast<int> (prohib_period* 0.9);
-    else prohib_period = IN_PROHIB_PERIOD;
+  if ( ts->prohib_period * 0.9 < ts->prohib_period - 1 ) 
+    if ( ts->prohib_period * 0.9 > IN_PROHIB_PERIOD ) ts->prohib_period = static_cast<int> (ts->prohib_period* 0.9);
+    else ts->prohib_period = IN_PROHIB_PERIOD;
   else
-    if ( prohib_period - 1 > IN_PROHIB_PERIOD ) prohib_period -= 1;
-    else prohib_period = IN_PROHIB_PERIOD;
-  last_prohib_period_mod = it;
+    if ( ts->prohib_period - 1 > IN_PROHIB_PERIOD ) ts->prohib_period -= 1;
+    else ts->prohib_period = IN_PROHIB_PERIOD;
+  ts->last_prohib_period_mod = ts->it;
 }
 
 /* allowed: check if moving (adding/deleting) a given constraint 
    is not a tabu move */
 
-short int allowed(int i /* constraint to be checked */)
+short int allowed(tabu_state *ts, int i /* constraint to be checked */)
 {
-  if ( last_moved[i]  < it - prohib_period ) {
-    if ( cur_cut->in_constr_list[i] == IN ) {
-      if ( cur_cut->n_of_constr > 1 ) return(TRUE);
+  if ( ts->last_moved[i]  < ts->it - ts->prohib_period ) {
+    if ( ts->cur_cut->in_constr_list[i] == IN ) {
+      if ( ts->cur_cut->n_of_constr > 1 ) return(TRUE);
       else return(FALSE);
     }
     else {
-      if ( cur_cut->n_of_constr < m - 1 ) return(TRUE);
+      if ( ts->cur_cut->n_of_constr < ts->m - 1 ) return(TRUE);
       else return(FALSE);
     }
   }
@@ -2617,9 +3078,9 @@ short int allowed(int i /* constraint to be checked */)
 /* in_cur_cut: check whether a given constraint is in the list of
    constraints defining the current cut */
 
-short int in_cur_cut(int i /* constraint to be checked */)
+short int in_cur_cut(tabu_state *ts, int i /* constraint to be checked */)
 {
-  if ( cur_cut->in_constr_list[i] == OUT ) return(FALSE);
+  if ( ts->cur_cut->in_constr_list[i] == OUT ) return(FALSE);
   else return(TRUE);
 }
 
@@ -2643,6 +3104,7 @@ double norm /* cut norm - 1-norm is used below */
    the current local search solution by inserting/deleting a constraint */
 
 double Cgl012Cut::score_by_moving(
+		       tabu_state *ts, /* state of the tabu search */
 		       int i, /* constraint to be moved */
 		       short int itype, /* type of move - ADD or DEL */
 		       double thresh /* minimum value of an interesting score */
@@ -2659,7 +3121,7 @@ double Cgl012Cut::score_by_moving(
   
   /* fast check - optimistic evaluation of the score */
 
-  slack_sum = cur_cut->slack_sum;
+  slack_sum = ts->cur_cut->slack_sum;
 
   if ( itype == ADD ) slack_sum += p_ilp->slack[i] / static_cast<double> (gcdi);
   else slack_sum -= p_ilp->slack[i] / static_cast<double> (gcdi);
@@ -2680,7 +3142,7 @@ printf("Score estimate 1 %f   Threshold %f\n",score,thresh);
   support_inter = 0;
 
   for ( ofsj = 0, ij = begi; ofsj < inp_ilp->mtcnt[i]; ofsj++, ij++ ) 
-    if ( cur_cut->non_weak_coef[inp_ilp->mtind[ij]] !=0 ) support_inter++;
+    if ( ts->cur_cut->non_weak_coef[inp_ilp->mtind[ij]] !=0 ) support_inter++;
 
   if ( support_inter == 0 ) return(-INF);
 
@@ -2696,47 +3158,47 @@ printf("Score estimate 1 %f   Threshold %f\n",score,thresh);
     if ( gcdi == 1 ) {
       for ( ofsj = 0, ij = begi; ofsj < inp_ilp->mtcnt[i]; ofsj++, ij++ ) {
 	j = inp_ilp->mtind[ij];
-	new_coef[ofsj] = cur_cut->non_weak_coef[j] + inp_ilp->mtval[ij];
+	new_coef[ofsj] = ts->cur_cut->non_weak_coef[j] + inp_ilp->mtval[ij];
       }
-      crhs = cur_cut->non_weak_rhs + inp_ilp->mrhs[i];
+      crhs = ts->cur_cut->non_weak_rhs + inp_ilp->mrhs[i];
     }
     else {
       for ( ofsj = 0, ij = begi; ofsj < inp_ilp->mtcnt[i]; ofsj++, ij++ ) {
 	j = inp_ilp->mtind[ij];
-	new_coef[ofsj] = cur_cut->non_weak_coef[j] + inp_ilp->mtval[ij] / gcdi;
+	new_coef[ofsj] = ts->cur_cut->non_weak_coef[j] + inp_ilp->mtval[ij] / gcdi;
       }
-      crhs = cur_cut->non_weak_rhs + inp_ilp->mrhs[i] / gcdi;
+      crhs = ts->cur_cut->non_weak_rhs + inp_ilp->mrhs[i] / gcdi;
     }
   }
   else {
     if ( gcdi == 1 ) {
       for ( ofsj = 0, ij= begi; ofsj < inp_ilp->mtcnt[i]; ofsj++, ij++ ) {
 	j = inp_ilp->mtind[ij];
-	new_coef[ofsj] = cur_cut->non_weak_coef[j] - inp_ilp->mtval[ij];
+	new_coef[ofsj] = ts->cur_cut->non_weak_coef[j] - inp_ilp->mtval[ij];
       }
-      crhs = cur_cut->non_weak_rhs - inp_ilp->mrhs[i];
+      crhs = ts->cur_cut->non_weak_rhs - inp_ilp->mrhs[i];
     }
     else {
       for ( ofsj = 0, ij = begi; ofsj < inp_ilp->mtcnt[i]; ofsj++, ij++ ) {
 	j = inp_ilp->mtind[ij];
-	new_coef[ofsj] = cur_cut->non_weak_coef[j] - inp_ilp->mtval[ij] / gcdi;
+	new_coef[ofsj] = ts->cur_cut->non_weak_coef[j] - inp_ilp->mtval[ij] / gcdi;
       }
-      crhs = cur_cut->non_weak_rhs - inp_ilp->mrhs[i] / gcdi;
+      crhs = ts->cur_cut->non_weak_rhs - inp_ilp->mrhs[i] / gcdi;
     }
   }
 
   /* other - relatively fast - check by optimistic evaluation of the 
      cut score */
 
-  weak_loss = cur_cut->min_weak_loss;
-  one_norm = cur_cut->one_norm;
+  weak_loss = ts->cur_cut->min_weak_loss;
+  one_norm = ts->cur_cut->one_norm;
   for ( ofsj = 0, ij = begi; ofsj < inp_ilp->mtcnt[i]; ofsj++, ij++ ) {
     j = inp_ilp->mtind[ij];
-    if ( cur_cut->coef[j] > 0 ) one_norm -= cur_cut->coef[j];
-    else one_norm += cur_cut->coef[j];
+    if ( ts->cur_cut->coef[j] > 0 ) one_norm -= ts->cur_cut->coef[j];
+    else one_norm += ts->cur_cut->coef[j];
     if ( new_coef[ofsj] >= 2 ) one_norm += new_coef[ofsj] / 2;
     else one_norm -= new_coef[ofsj] / 2;
-    if ( mod2(cur_cut->non_weak_coef[j]) == ODD ) {
+    if ( mod2(ts->cur_cut->non_weak_coef[j]) == ODD ) {
       if ( mod2(new_coef[ofsj]) == EVEN ) 
 	weak_loss -= p_ilp->min_loss_by_weak[j];
     }
@@ -2760,9 +3222,9 @@ printf("Score estimate 2 %f   Threshold %f\n",score,thresh);
   /* get the actual cut coefficients and the violation of the 
      best cut obtainable trough weakening */
 
-  ccoef = reinterpret_cast<int *> (calloc(n,sizeof(int)));
+  ccoef = reinterpret_cast<int *> (calloc(ts->n,sizeof(int)));
   if ( ccoef == NULL ) alloc_error(const_cast<char*>("ccoef"));
-  for ( j = 0; j < n; j++ ) ccoef[j] = cur_cut->non_weak_coef[j];
+  for ( j = 0; j < ts->n; j++ ) ccoef[j] = ts->cur_cut->non_weak_coef[j];
   for ( ofsj = 0; ofsj < inp_ilp->mtcnt[i]; ofsj++ ) {
     ij = begi + ofsj;
     j = inp_ilp->mtind[ij];
@@ -2789,6 +3251,7 @@ printf("Score actual %f   Threshold %f\n",score,thresh);
    deleting a constraint */
 
 void Cgl012Cut::modify_current(
+		    tabu_state *ts, /* state of the tabu search */
 		    int i, /* constraint to be moved */
 		    short int itype /* type of move - ADD or DEL */
 		    )
@@ -2797,14 +3260,14 @@ void Cgl012Cut::modify_current(
   short int flag_gt;
 
   if ( itype == ADD ) {
-    cur_cut->n_of_constr++;
-    cur_cut->in_constr_list[i] = IN;
+    ts->cur_cut->n_of_constr++;
+    ts->cur_cut->in_constr_list[i] = IN;
   }
   else {
-    cur_cut->n_of_constr--;
-    cur_cut->in_constr_list[i] = OUT;
+    ts->cur_cut->n_of_constr--;
+    ts->cur_cut->in_constr_list[i] = OUT;
   }
-  last_moved[i] = it;
+  ts->last_moved[i] = ts->it;
 
   /* compute the new cut coefficients and rhs (before weakening) */
 
@@ -2817,37 +3280,37 @@ void Cgl012Cut::modify_current(
     ij = begi + ofsj;
     j = inp_ilp->mtind[ij];
     /* the '*' and '/' operations can be saved by writing some more code ... */
-    cur_cut->non_weak_coef[j] += flag_gt * (inp_ilp->mtval[ij] / gcdi);
+    ts->cur_cut->non_weak_coef[j] += flag_gt * (inp_ilp->mtval[ij] / gcdi);
   }
-  cur_cut->non_weak_rhs += flag_gt * (inp_ilp->mrhs[i] / gcdi);
+  ts->cur_cut->non_weak_rhs += flag_gt * (inp_ilp->mrhs[i] / gcdi);
 
   if ( itype == ADD ) 
-    cur_cut->slack_sum += p_ilp->slack[i] / static_cast<double> (gcdi);
+    ts->cur_cut->slack_sum += p_ilp->slack[i] / static_cast<double> (gcdi);
   else 
-    cur_cut->slack_sum -= p_ilp->slack[i] / static_cast<double> (gcdi);
+    ts->cur_cut->slack_sum -= p_ilp->slack[i] / static_cast<double> (gcdi);
 
   /* get the best possible cut */
 
-  cur_cut->min_weak_loss = 0.0;
-  for ( j = 0; j < n; j++ ) {
-    cur_cut->coef[j] = cur_cut->non_weak_coef[j];
-    if ( mod2(cur_cut->coef[j]) == ODD ) 
-      cur_cut->min_weak_loss += p_ilp->min_loss_by_weak[j];
+  ts->cur_cut->min_weak_loss = 0.0;
+  for ( j = 0; j < ts->n; j++ ) {
+    ts->cur_cut->coef[j] = ts->cur_cut->non_weak_coef[j];
+    if ( mod2(ts->cur_cut->coef[j]) == ODD ) 
+      ts->cur_cut->min_weak_loss += p_ilp->min_loss_by_weak[j];
   }
-  cur_cut->rhs = cur_cut->non_weak_rhs;
-  cur_cut->ok = 
-    best_cut(cur_cut->coef,&cur_cut->rhs,&cur_cut->violation,TRUE,FALSE);
-  cur_cut->one_norm = 0;
-  for ( j = 0; j < n; j++ ) {
-    if ( cur_cut->coef[j] > 0 ) cur_cut->one_norm += cur_cut->coef[j];
-    else cur_cut->one_norm -= cur_cut->coef[j];
+  ts->cur_cut->rhs = ts->cur_cut->non_weak_rhs;
+  ts->cur_cut->ok = 
+    best_cut(ts->cur_cut->coef,&ts->cur_cut->rhs,&ts->cur_cut->violation,TRUE,FALSE);
+  ts->cur_cut->one_norm = 0;
+  for ( j = 0; j < ts->n; j++ ) {
+    if ( ts->cur_cut->coef[j] > 0 ) ts->cur_cut->one_norm += ts->cur_cut->coef[j];
+    else ts->cur_cut->one_norm -= ts->cur_cut->coef[j];
   }
 }
 
 /* get_current_cut: return a cut data type with the information about
    the current cut of the search procedure */
 
-cut *Cgl012Cut::get_current_cut()
+cut *Cgl012Cut::get_current_cut(tabu_state *ts)
 {
   int i, j, nz;
   /*double viol;*/
@@ -2855,34 +3318,34 @@ cut *Cgl012Cut::get_current_cut()
 
   cut_ptr = reinterpret_cast<cut *> (calloc(1,sizeof(cut)));
   if ( cut_ptr == NULL ) alloc_error(const_cast<char*>("cut_ptr"));  
-  cut_ptr->crhs = cur_cut->rhs;
+  cut_ptr->crhs = ts->cur_cut->rhs;
   cut_ptr->csense = 'L';
   /* count the number of nonzeroes in the cut */
-  for ( j = 0, nz = 0; j < n; j++ ) if ( cur_cut->coef[j] != 0 ) nz++;
+  for ( j = 0, nz = 0; j < ts->n; j++ ) if ( ts->cur_cut->coef[j] != 0 ) nz++;
   cut_ptr->cnzcnt = nz; 
   cut_ptr->cind = reinterpret_cast<int *> (calloc(nz,sizeof(int)));
   if ( cut_ptr->cind == NULL ) alloc_error(const_cast<char*>("cut_ptr->cind"));
   cut_ptr->cval = reinterpret_cast<int *> (calloc(nz,sizeof(int)));
   if ( cut_ptr->cval == NULL ) alloc_error(const_cast<char*>("cut_ptr->cval"));
   nz = 0; /*viol = 0.0;*/
-  for ( j = 0; j < n; j++ ) {
-    if ( cur_cut->coef[j] != 0 ) {
+  for ( j = 0; j < ts->n; j++ ) {
+    if ( ts->cur_cut->coef[j] != 0 ) {
       cut_ptr->cind[nz] = j;
-      cut_ptr->cval[nz] = cur_cut->coef[j];
+      cut_ptr->cval[nz] = ts->cur_cut->coef[j];
       nz++;
       /* viol += p_ilp->xstar[j] * (double) cur_cut->coef[j]; */
     }
   }
   /* viol -= (double) cur_cut->rhs; */
   /* cut_ptr->violation = viol; */
-  cut_ptr->violation = cur_cut->violation;
+  cut_ptr->violation = ts->cur_cut->violation;
   cut_ptr->n_of_constr = 0;
   cut_ptr->constr_list = reinterpret_cast<int *> (calloc(inp_ilp->mr,sizeof(int)));
   if ( cut_ptr->constr_list == NULL ) alloc_error(const_cast<char*>("cut_ptr->constr_list"));
   cut_ptr->in_constr_list = reinterpret_cast<short int *> (calloc(inp_ilp->mr,sizeof(short int)));
   if ( cut_ptr->in_constr_list == NULL ) alloc_error(const_cast<char*>("cut_ptr->in_constr_list"));
-  for ( i = 0; i < m; i++ ) {
-    if ( cur_cut->in_constr_list[i] == IN ) {
+  for ( i = 0; i < ts->m; i++ ) {
+    if ( ts->cur_cut->in_constr_list[i] == IN ) {
       cut_ptr->in_constr_list[i] = IN;
       cut_ptr->constr_list[cut_ptr->n_of_constr] = i;
       (cut_ptr->n_of_constr)++;
@@ -2895,7 +3358,7 @@ cut *Cgl012Cut::get_current_cut()
 /* best neighbour: find the cut to be added/deleted from the current
    solution among those allowed by the tabu rules */
 
-short int Cgl012Cut::best_neighbour(cut_list *out_cuts /* list of the violated cuts found */)
+short int Cgl012Cut::best_neighbour(tabu_state *ts, cut_list *out_cuts /* list of the violated cuts found */)
 {
   int i, ibest;
   short int itype, itypebest=-1;
@@ -2906,9 +3369,9 @@ short int Cgl012Cut::best_neighbour(cut_list *out_cuts /* list of the violated c
 
   max_score = -INF;  
   ibest = NONE;
-  for ( i = 0; i < m; i++ ) {
-    if ( ! p_ilp->row_to_delete[i] && allowed(i) ) {
-      if ( in_cur_cut(i) ) {
+  for ( i = 0; i < ts->m; i++ ) {
+    if ( ! p_ilp->row_to_delete[i] && allowed(ts,i) ) {
+      if ( in_cur_cut(ts,i) ) {
 	/* constraint i is in the current set of constraints  
 	   (those defining the current cut) */
 	itype = DEL;
@@ -2918,7 +3381,7 @@ short int Cgl012Cut::best_neighbour(cut_list *out_cuts /* list of the violated c
 	   (those defining the current cut) */
 	itype = ADD;
       } 
-      score = score_by_moving(i,itype,max_score); 
+      score = score_by_moving(ts,i,itype,max_score); 
       if ( score > max_score ) {
 	/* best cut found in this iteration: store it */
 	ibest = i;
@@ -2934,14 +3397,14 @@ short int Cgl012Cut::best_neighbour(cut_list *out_cuts /* list of the violated c
 #endif
     return(TRUE);
   }
-  modify_current(ibest,itypebest);  
-  if ( cur_cut->violation > MIN_VIOLATION + EPS ) {
+  modify_current(ts,ibest,itypebest);  
+  if ( ts->cur_cut->violation > MIN_VIOLATION + EPS ) {
 #ifdef PRINT_TABU
-    printf("... adding the current cut to the output list - it = %d viol = %f\n",it, cur_cut->violation);
+    printf("... adding the current cut to the output list - it = %d viol = %f\n",ts->it, ts->cur_cut->violation);
 #endif
-    new_cut = get_current_cut();
+    new_cut = get_current_cut(ts);
     out_cuts = add_cut_to_list(new_cut,out_cuts);
-    last_it_add = it;
+    ts->last_it_add = ts->it;
   }
   return(FALSE);
 }
@@ -2950,37 +3413,36 @@ short int Cgl012Cut::best_neighbour(cut_list *out_cuts /* list of the violated c
    current solution has already been visited or the best solution has not 
    been updated for too many iterations */
 
-void memory_reaction()
+void memory_reaction(tabu_state *ts)
 {
   int cycle_length;
 
-  if ( hash_search(&cycle_length) ) {
-    if ( cycle_length < 2 * ( m - 1 ) ) {
-      increase_prohib_period();
+  if ( hash_search(ts,&cycle_length) ) {
+    if ( cycle_length < 2 * ( ts->m - 1 ) ) {
+      increase_prohib_period(ts);
       return;
     }
   }
-  else hash_insert();
-  if ( it - last_prohib_period_mod > B ) 
-    decrease_prohib_period();
+  else hash_insert(ts);
+  if ( ts->it - ts->last_prohib_period_mod > ts->B ) 
+    decrease_prohib_period(ts);
 }
 
 /* add_tight_constraint: initialize the current cut by adding a tight 
    constraint to it */
        
-void Cgl012Cut::add_tight_constraint()
+void Cgl012Cut::add_tight_constraint(tabu_state *ts)
 {
   int i, ntight;
   double smin=COIN_DBL_MAX;
-  abort();
   int *tight;
     
   ntight = 0;
-  tight = reinterpret_cast<int *> (calloc(m,sizeof(int)));
+  tight = reinterpret_cast<int *> (calloc(ts->m,sizeof(int)));
   if ( tight == NULL ) alloc_error(const_cast<char*>("tight"));
-  for ( i = 0; i < m; i++ ) {
+  for ( i = 0; i < ts->m; i++ ) {
     /* search for the tightest constraint never added to cut */
-    if ( last_moved[i] < 0 && p_ilp->slack[i] < smin ) {
+    if ( ts->last_moved[i] < 0 && p_ilp->slack[i] < smin ) {
       if ( p_ilp->slack[i] < ZERO ) {
 	/* tight constraint */
 	smin = ZERO;
@@ -2995,92 +3457,143 @@ void Cgl012Cut::add_tight_constraint()
       }
     }
   }
-  if ( ntight > 0 ) i = tight[rand() % ntight];
+  if ( ntight > 0 ) i = tight[random_index(ts,ntight)];
   /* if all constraints have already been in cur_cut choose first at random */
-  else i = rand() % m;
+  else i = random_index(ts,ts->m);
   free(tight);
-  modify_current(i,ADD);
+  modify_current(ts,i,ADD);
 }    
 
 /* initialize: initialize the data structures for local search */
 
-void Cgl012Cut::initialize()
+void Cgl012Cut::initialize(tabu_state *ts)
 {
   int i;
 
-  m = inp_ilp->mr;
-  n = inp_ilp->mc;
-  it = 0;
-  last_it_add = 0;
-  last_it_restart = 0;
-  last_prohib_period_mod = 0;
-  prohib_period = IN_PROHIB_PERIOD; 
-  initialize_cur_cut();
-  last_moved = reinterpret_cast<int *> (calloc(m,sizeof(int)));
-  if ( last_moved == NULL ) alloc_error(const_cast<char*>("last_moved"));
-  for ( i = 0; i < m; i++ ) {
-    last_moved[i] = -COIN_INT_MAX;
-  }
-  initialize_hash_table();
-  add_tight_constraint();
-  A = m;
-  B = 10 * m;
+  ts->m = inp_ilp->mr;
+  ts->n = inp_ilp->mc;
+  ts->it = 0;
+  ts->last_it_add = 0;
+  ts->last_it_restart = 0;
+  ts->last_prohib_period_mod = 0;
+  ts->prohib_period = IN_PROHIB_PERIOD; 
+  initialize_cur_cut(ts);
+  ts->last_moved = reinterpret_cast<int *> (calloc(ts->m,sizeof(int)));
+  if ( ts->last_moved == NULL ) alloc_error(const_cast<char*>("last_moved"));
+  for ( i = 0; i < ts->m; i++ ) {
+    ts->last_moved[i] = -COIN_INT_MAX;
+  }
+  initialize_hash_table(ts);
+  add_tight_constraint(ts);
+  ts->A = ts->m;
+  ts->B = 10 * ts->m;
 }
 
 /* restart: perform a restart of the search - IMPORTANT: in the current
    implementation vector last_moved is not cleared at restart */
        
-void Cgl012Cut::restart(short int failure /* flag forcing the restart if some trouble occurred */)
+void Cgl012Cut::restart(tabu_state *ts, short int failure /* flag forcing the restart if some trouble occurred */)
 {
-  if ( failure || ( it - last_it_add > A && it - last_it_restart > A ) ) {
+  if ( failure || ( ts->it - ts->last_it_add > ts->A && ts->it - ts->last_it_restart > ts->A ) ) {
     /* perform restart */
-    last_it_restart = it;
-    prohib_period = IN_PROHIB_PERIOD;
-    last_prohib_period_mod = it;
-    clear_hash_table();
-    clear_cur_cut();
-    add_tight_constraint();
+    ts->last_it_restart = ts->it;
+    ts->prohib_period = IN_PROHIB_PERIOD;
+    ts->last_prohib_period_mod = ts->it;
+    clear_hash_table(ts);
+    clear_cur_cut(ts);
+    add_tight_constraint(ts);
   }
 }
 
 /* free_memory: free the memory used by local search */
 
-void free_memory()
+void free_memory(tabu_state *ts)
 {
-  free_cur_cut();
-  free(last_moved);
-  free_hash_table();
+  free_cur_cut(ts);
+  free(ts->last_moved);
+  free_hash_table(ts);
 }
 
-/* tabu_012: try to identify violated 0-1/2 cuts by a simple tabu search
-   procedure adapted from that used by Battiti and Protasi for finding
-   large cliques */
+/* tabu_search: one tabu search trajectory using its own state and
+   random numbers - stops after MAX_TABU_ITER iterations, so at most
+   MAX_TABU_ITER cuts are found (at most one per iteration) */
 
-cut_list *Cgl012Cut::tabu_012()
+cut_list *Cgl012Cut::tabu_search(int seed /* seed for random numbers */)
 {
   short int failure;
   cut_list *out_cuts;
+  tabu_state state;
+  tabu_state *ts = &state;
 
-  out_cuts = initialize_cut_list(MAX_CUTS);
-  initialize();
+  ts->random.setSeed(seed);
+  out_cuts = initialize_cut_list(MAX_TABU_ITER);
+  initialize(ts);
  
-  it = 0; 
+  ts->it = 0; 
   do {
-    memory_reaction();
-    failure = best_neighbour(out_cuts);
+    memory_reaction(ts);
+    failure = best_neighbour(ts,out_cuts);
 #ifdef PRINT_TABU
-    print_cur_cut();
+    print_cur_cut(ts);
 #endif
-    it++;
-    restart(failure);
+    ts->it++;
+    restart(ts,failure);
 
   }
-  while ( out_cuts->cnum < MAX_CUTS && it < MAX_TABU_ITER );
-  free_memory();
+  while ( ts->it < MAX_TABU_ITER );
+  free_memory(ts);
 #ifdef PRINT_TABU
     printf("Number of violated cuts found by Tabu Search %d\n",out_cuts->cnum);
-    printf("Tabu Search timings: best_neighbour %f  score_by_moving %f coefficient %f  best_cut %f\n",
-	   time_best_neigh, time_scor_by_mov, time_coef, time_best_cut);
+#endif
+  return(out_cuts);
+}
+
+/* information for running tabu search trajectories on several threads */
+
+typedef struct {
+Cgl012Cut *cut012; /* separator (only read by the trajectories) */
+cut_list **cuts; /* cuts found by each trajectory */
+} tabu_info;
+
+void Cgl012Cut::tabu_task(void *info, int itask, int /*ithread*/)
+{
+  tabu_info *t_info = reinterpret_cast<tabu_info *> (info);
+
+  t_info->cuts[itask] = t_info->cut012->tabu_search(TABU_SEED + itask);
+}
+
+/* tabu_012: try to identify violated 0-1/2 cuts by a simple tabu search
+   procedure adapted from that used by Battiti and Protasi for finding
+   large cliques - ntabu independent trajectories (with different random
+   seeds) are run, on different threads if allowed, and their cuts are
+   merged in trajectory order so that the cuts found do not depend on
+   the number of threads */
+
+cut_list *Cgl012Cut::tabu_012()
+{
+  int ntraj, nthreads_used, k, c, ncuts;
+  cut_list *out_cuts;
+  tabu_info t_info;
+
+  ntraj = ( ntabu > 1 ) ? ntabu : 1;
+  t_info.cut012 = this;
+  t_info.cuts = reinterpret_cast<cut_list **> (calloc(ntraj,sizeof(cut_list *)));
+  if ( t_info.cuts == NULL ) alloc_error(const_cast<char*>("t_info.cuts"));
+  nthreads_used = CglNumberThreads(nthreads,ntraj);
+  CglRunTasks(nthreads_used,ntraj,tabu_task,&t_info);
+  ncuts = 0;
+  for ( k = 0; k < ntraj; k++ ) 
+    ncuts += t_info.cuts[k]->cnum;
+  out_cuts = initialize_cut_list(ncuts > 0 ? ncuts : 1);
+  for ( k = 0; k < ntraj; k++ ) {
+    for ( c = 0; c < t_info.cuts[k]->cnum; c++ ) 
+      out_cuts = add_cut_to_list(t_info.cuts[k]->list[c],out_cuts);
+    free(t_info.cuts[k]->list);
+    free(t_info.cuts[k]);
+  }
+  free(t_info.cuts);
+#ifdef PRINT_TABU
+    printf("Number of violated cuts found by %d Tabu Search trajectories %d\n",ntraj,out_cuts->cnum);
 #endif
   return(out_cuts);
 }
@@ -3635,12 +4148,14 @@ print_parity_ilp();
   avg_basic_sep_time = tot_basic_sep_time / (float) sep_iter;
 #endif
 
-//#define TABU_SEARCH 
-#ifdef TABU_SEARCH
+  /* try to identify further violated cuts by Gaussian elimination */
+
+  if ( gauss && out_cuts->cnum < MAX_CUTS ) 
+    gauss_separation(out_cuts);
 
   /* try to identify violated cuts by tabu search if none was found */
 
-  if ( out_cuts->cnum == 0 ) {
+  if ( out_cuts->cnum == 0 && ntabu > 0 ) {
     free_cut_list(out_cuts); 
 
 #ifdef TIME
@@ -3656,8 +4171,6 @@ print_parity_ilp();
 
   }
 
-#endif
-
 #ifdef POOL
 
   /* add the cuts separated to the pool */
@@ -3730,7 +4243,10 @@ Cgl012Cut::Cgl012Cut () :
   errorNo(0),
   sep_iter(0),
   vlog(NULL),
-  aggr(true)
+  aggr(true),
+  nthreads(1),
+  ntabu(0),
+  gauss(false)
 {
   // nothing to do here
 }
@@ -3746,7 +4262,10 @@ Cgl012Cut::Cgl012Cut (const Cgl012Cut & rhs) :
   errorNo(rhs.errorNo),
   sep_iter(rhs.sep_iter),
   vlog(NULL),
-  aggr(rhs.aggr)
+  aggr(rhs.aggr),
+  nthreads(rhs.nthreads),
+  ntabu(rhs.ntabu),
+  gauss(rhs.gauss)
 {
   if (rhs.p_ilp||rhs.vlog||inp_ilp)
     abort();  
@@ -3792,6 +4311,9 @@ Cgl012Cut::operator=(
     errorNo = rhs.errorNo;
     sep_iter = rhs.sep_iter;
     aggr = rhs.aggr;
+    nthreads = rhs.nthreads;
+    ntabu = rhs.ntabu;
+    gauss = rhs.gauss;
   }
   return *this;
 }
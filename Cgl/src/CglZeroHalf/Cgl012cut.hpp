@@ -8,6 +8,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cmath>
+#include "CoinHelperFunctions.hpp"
 
 #define CGL_NEW_SHORT
 #ifndef CGL_NEW_SHORT
@@ -72,6 +73,9 @@ char *msense; /* senses of the constraints: 'L', 'G' or 'E' */
 const double *xstar; /* current optimal solution of the LP relaxation */
 } ilp; 
 
+typedef unsigned int parity_word; /* word of a packed parity row */
+#define PARITY_WORD_BITS 32 /* number of bits in a parity_word */
+
 typedef struct {
 int mr; /* number of rows in the parity ILP matrix */
 int mc; /* number of columns in the parity ILP matrix */
@@ -79,12 +83,22 @@ int mnz; /* number of 1's in the parity ILP matrix */
 int *mtbeg; /* starting position of each row in arrays mtind and mtval */
 int *mtcnt; /* number of entries of each row in arrays mtind and mtval */
 int *mtind; /* column indices of the 1's of the parity ILP matrix */
+int nwords; /* number of words in each packed row (0 if rows not packed) */
+parity_word *mtbit; /* 1's of each row of the parity ILP matrix packed
+                       as bits (nwords words per row) */
 short int *mrhs; /* right hand side parity of the constraints */
 double *xstar; /* current optimal solution of the LP relaxation */
 double *slack; /* slack of the constraints w.r.t. xstar */
 short int *row_to_delete; /* flag for marking rows not to be considered */
 short int *col_to_delete; /* flag for marking columns not to be considered */
 int *gcd; /* greatest common divisor of each row in the input ILP matrix */
+int *odd_cnt; /* number of odd entries in each scaled row of the input ILP */
+int *odd_ind; /* column indices of the odd entries of each scaled row 
+                 (stored from the row start in the input ILP matrix) */
+short int *odd_rhs; /* right hand side parity of each scaled row */
+short int rows_ready; /* flag saying whether gcd, odd_cnt, odd_ind and
+                         odd_rhs are set - they do not depend on xstar
+                         so are kept across separation calls */
 short int *possible_weak; /* possible weakening types of each column */
 short int *type_even_weak; /* type of even weakening of each column 
                               (lower or upper bound weakening) */
@@ -199,6 +213,10 @@ int n_it_zero; /* number of consecutive iterations (starting from the
                    last and going backward) in which each variable took
                    the value 0 in the LP solution */
 } log_var;
+
+/* state of one tabu search trajectory (only used in Cgl012cut.cpp) */
+
+struct tabu_state;
 /** 012Cut Generator Class
 
  This class is to make Cgl01cut thread safe etc
@@ -316,6 +334,26 @@ short int best_cut(
 cut *get_cut(
 	     cycle *s_cyc /* shortest odd cycles identified in the separation graph */
 	     );
+/* comb_cut: extract a hopefully violated cut from a combination of
+   constraints (takes over comb and flag_comb) */
+
+cut *comb_cut(
+	      int ncomb, /* number of constraints combined */
+	      int *comb, /* list of the constraints combined */
+	      short int *flag_comb /* flag for the constraints combined */
+	      );
+/* comb_slack_bound: lower bound on the slack of any 0-1/2 cut obtainable
+   from a combination of constraints, computed on the packed parity rows */
+
+double comb_slack_bound(
+			int n_of_constr, /* number of constraints combined */
+			int *constr_list, /* list of the constraints combined */
+			parity_word *odd_cols /* work vector of p_ilp->nwords words */
+			);
+/* gauss_separation: try to identify violated 0-1/2 cuts by Gaussian
+   elimination over GF(2) on the packed rows of the parity ILP */
+
+  void gauss_separation(cut_list *out_cuts /* list of the violated cuts found */);
 
 /* update_log_var: update the log information for the problem variables */
   void update_log_var();
@@ -329,6 +367,7 @@ cut *get_cut(
    the current local search solution by inserting/deleting a constraint */
 
 double score_by_moving(
+		       tabu_state *ts, /* state of the tabu search */
 		       int i, /* constraint to be moved */
 		       short int itype, /* type of move - ADD or DEL */
 		       double thresh /* minimum value of an interesting score */
@@ -337,6 +376,7 @@ double score_by_moving(
    deleting a constraint */
 
 void modify_current(
+		    tabu_state *ts, /* state of the tabu search */
 		    int i, /* constraint to be moved */
 		    short int itype /* type of move - ADD or DEL */
 		    );
@@ -344,25 +384,34 @@ void modify_current(
 /* best neighbour: find the cut to be added/deleted from the current
    solution among those allowed by the tabu rules */
 
-  short int best_neighbour(cut_list *out_cuts /* list of the violated cuts found */);
+  short int best_neighbour(tabu_state *ts, /* state of the tabu search */
+			   cut_list *out_cuts /* list of the violated cuts found */);
 
 /* add_tight_constraint: initialize the current cut by adding a tight 
    constraint to it */
        
-  void add_tight_constraint();
+  void add_tight_constraint(tabu_state *ts /* state of the tabu search */);
 
 /* tabu_012: try to identify violated 0-1/2 cuts by a simple tabu search
    procedure adapted from that used by Battiti and Protasi for finding
    large cliques */
 
   cut_list *tabu_012();
+/* tabu_search: one tabu search trajectory using its own state and
+   random numbers */
+
+  cut_list *tabu_search(int seed /* seed for random numbers */);
+/* tabu_task: runs one trajectory for tabu_012 (may be on a thread) */
+
+  static void tabu_task(void *info, int itask, int ithread);
 /* initialize: initialize the data structures for local search */
 
-  void initialize();
+  void initialize(tabu_state *ts /* state of the tabu search */);
 /* restart: perform a restart of the search - IMPORTANT: in the current
    implementation vector last_moved is not cleared at restart */
        
-  void restart(short int failure /* flag forcing the restart if some trouble occurred */);
+  void restart(tabu_state *ts, /* state of the tabu search */
+	       short int failure /* flag forcing the restart if some trouble occurred */);
   void print_constr(int i /* constraint to be printed */);
   void print_parity_ilp();
 
@@ -370,6 +419,10 @@ void modify_current(
    information which can be useful for  0-1/2 cut separation */
 
   void get_parity_ilp();
+/* get_parity_rows: compute the parts of the parity ILP which do not
+   depend on xstar (only done at the first separation call) */
+
+  void get_parity_rows();
 /* initialize_sep_graph: allocate and initialize the data structure
    to contain the information associated with a separation graph */
 
@@ -409,10 +462,10 @@ double cut_score(
 /* get_current_cut: return a cut data type with the information about
    the current cut of the search procedure */
 
-  cut *get_current_cut();
+  cut *get_current_cut(tabu_state *ts /* state of the tabu search */);
 /* print_cur_cut: display cur_cut on output */
 
-  void print_cur_cut();
+  void print_cur_cut(tabu_state *ts /* state of the tabu search */);
   void print_cut_list(cut_list *cuts);
   //@}
 public:
@@ -434,6 +487,32 @@ public:
   virtual ~Cgl012Cut ();
   //@}
 
+  /**@name Gets and sets */
+  //@{
+  /** Set number of threads which may be used to find the shortest
+      odd cycles in basic_separation (default 1) */
+  inline void setNumberThreads(int value)
+  { nthreads = value;}
+  /// Get number of threads
+  inline int numberThreads() const
+  { return nthreads;}
+  /** Set number of independent tabu search trajectories to run if
+      basic separation finds no cuts (default 0 - no tabu search).
+      They may be run on different threads */
+  inline void setTabuTrajectories(int value)
+  { ntabu = value;}
+  /// Get number of tabu search trajectories
+  inline int tabuTrajectories() const
+  { return ntabu;}
+  /** Set whether Gaussian elimination over GF(2) is used as an
+      additional separation heuristic (default false) */
+  inline void setGaussianElimination(bool yesNo)
+  { gauss = yesNo;}
+  /// Get whether Gaussian elimination is used
+  inline bool gaussianElimination() const
+  { return gauss;}
+  //@}
+
 private:
   
   // Private member methods
@@ -459,6 +538,10 @@ log_var **vlog; /* information about the value attained
 				  > 0 in a cut to be added */ 
 bool aggr; /* flag saying whether as many cuts as possible are required
 		   from the separation procedure (TRUE) or not (FALSE) */
+int nthreads; /* number of threads which may be used */
+int ntabu; /* number of tabu search trajectories (0 if no tabu search) */
+bool gauss; /* flag saying whether Gaussian elimination over GF(2) is
+	       used as an additional separation heuristic */
   //@}
 };
 #endif
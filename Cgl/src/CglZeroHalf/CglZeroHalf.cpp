@@ -189,6 +189,9 @@ CglZeroHalf::CglZeroHalf (
   }
   //cutInfo_ = Cgl012Cut(source.cutInfo_);
   cutInfo_ = Cgl012Cut();
+  cutInfo_.setNumberThreads(source.cutInfo_.numberThreads());
+  cutInfo_.setTabuTrajectories(source.cutInfo_.tabuTrajectories());
+  cutInfo_.setGaussianElimination(source.cutInfo_.gaussianElimination());
 }
 
 
@@ -258,6 +261,9 @@ CglZeroHalf::operator=(
     }
     //cutInfo_=Cgl012Cut(rhs.cutInfo_);
     cutInfo_=Cgl012Cut();
+    cutInfo_.setNumberThreads(rhs.cutInfo_.numberThreads());
+    cutInfo_.setTabuTrajectories(rhs.cutInfo_.tabuTrajectories());
+    cutInfo_.setGaussianElimination(rhs.cutInfo_.gaussianElimination());
   }
   return *this;
 }
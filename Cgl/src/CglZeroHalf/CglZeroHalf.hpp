@@ -46,6 +46,26 @@ public:
   /// Set flags
   inline void setFlags(int value)
   { flags_ = value;}
+  /// Set number of threads to use for finding odd cycles (default 1)
+  inline void setNumberThreads(int value)
+  { cutInfo_.setNumberThreads(value);}
+  /// Get number of threads
+  inline int numberThreads() const
+  { return cutInfo_.numberThreads();}
+  /** Set number of independent tabu search trajectories to try if
+      no cuts found by basic separation (default 0 - no tabu search) */
+  inline void setTabuTrajectories(int value)
+  { cutInfo_.setTabuTrajectories(value);}
+  /// Get number of tabu search trajectories
+  inline int tabuTrajectories() const
+  { return cutInfo_.tabuTrajectories();}
+  /** Set whether Gaussian elimination over GF(2) on the packed parity
+      rows is used as an additional separation heuristic (default false) */
+  inline void setGaussianElimination(bool yesNo)
+  { cutInfo_.setGaussianElimination(yesNo);}
+  /// Get whether Gaussian elimination is used
+  inline bool gaussianElimination() const
+  { return cutInfo_.gaussianElimination();}
   //@}
 
   /**@name Constructors and destructors */
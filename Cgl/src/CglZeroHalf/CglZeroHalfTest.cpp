@@ -7,12 +7,82 @@
 #endif
 
 #include <cassert>
+#include <vector>
+#include <algorithm>
 
 #include "CoinPragma.hpp"
 #include "CglZeroHalf.hpp" 
 //#include "CglKnapsackCover.hpp" 
 #include <stdio.h>
 
+// Small problem for testing Cgl012Cut directly (all rows <=, x binary)
+static int mtbeg[5]={0,2,4,8,11};
+static int mtcnt[5]={2,2,4,3,4};
+static int mtind[15]={0,2, 2,3, 0,1,2,3, 0,1,2, 0,1,2,3};
+static int mtval[15]={1,1, 1,1, 1,3,1,3, 3,2,1, 3,1,1,1};
+static int vlb[4]={0,0,0,0};
+static int vub[4]={1,1,1,1};
+static int mrhs[5]={1,1,4,3,3};
+static char msense[5]={'L','L','L','L','L'};
+
+// Separates xstar on small problem.  Checks every cut is violated by
+// xstar and valid for all feasible 0-1 points, and appends cuts to found
+static void separate012(const double * xstar, int tabu, int threads,
+			bool gauss, std::vector<int> & found)
+{
+  Cgl012Cut sep;
+  sep.setTabuTrajectories(tabu);
+  sep.setNumberThreads(threads);
+  sep.setGaussianElimination(gauss);
+  sep.ilp_load(5,4,15,mtbeg,mtcnt,mtind,mtval,vlb,vub,mrhs,msense);
+  sep.alloc_parity_ilp(5,4,15);
+  sep.initialize_log_var();
+  int cnum=0,cnzcnt=0;
+  int *cbeg=NULL,*ccnt=NULL,*cind=NULL,*cval=NULL,*crhs=NULL;
+  char *csense=NULL;
+  sep.sep_012_cut(5,4,15,mtbeg,mtcnt,mtind,mtval,vlb,vub,mrhs,msense,
+		  const_cast<double *>(xstar),true,&cnum,&cnzcnt,&cbeg,&ccnt,
+		  &cind,&cval,&crhs,&csense);
+  for (int iCut=0;iCut<cnum;iCut++) {
+    assert (csense[iCut]=='L');
+    found.push_back(crhs[iCut]);
+    double lhs=0.0;
+    for (int k=cbeg[iCut];k<cbeg[iCut]+ccnt[iCut];k++) {
+      found.push_back(cind[k]);
+      found.push_back(cval[k]);
+      lhs += cval[k]*xstar[cind[k]];
+    }
+    assert (lhs>crhs[iCut]+1.0e-3);
+    // no feasible 0-1 point is cut off
+    for (int point=0;point<16;point++) {
+      bool feasible=true;
+      for (int iRow=0;iRow<5&&feasible;iRow++) {
+	int sum=0;
+	for (int k=mtbeg[iRow];k<mtbeg[iRow]+mtcnt[iRow];k++)
+	  sum += mtval[k]*((point>>mtind[k])&1);
+	feasible = (sum<=mrhs[iRow]);
+      }
+      if (feasible) {
+	int sum=0;
+	for (int k=cbeg[iCut];k<cbeg[iCut]+ccnt[iCut];k++)
+	  sum += cval[k]*((point>>cind[k])&1);
+	assert (sum<=crhs[iCut]);
+      }
+    }
+  }
+  if (cnum) {
+    free(cbeg);
+    free(ccnt);
+    free(cind);
+    free(cval);
+    free(crhs);
+    free(csense);
+  }
+  sep.free_log_var();
+  sep.free_parity_ilp();
+  sep.free_ilp();
+}
+
 //--------------------------------------------------------------------------
 // test the zero half cut generators methods.
 void
@@ -36,7 +106,67 @@ CglZeroHalfUnitTest(
     }
   }
 
+  // Test get/set methods
+  {
+    CglZeroHalf getset;
+    assert (getset.numberThreads() == 1);
+    getset.setNumberThreads(4);
+    assert (getset.numberThreads() == 4);
+    assert (!getset.tabuTrajectories());
+    getset.setTabuTrajectories(3);
+    assert (getset.tabuTrajectories() == 3);
+    assert (!getset.gaussianElimination());
+    getset.setGaussianElimination(true);
+    assert (getset.gaussianElimination());
+    CglZeroHalf copy(getset);
+    assert (copy.numberThreads() == 4);
+    assert (copy.tabuTrajectories() == 3);
+    assert (copy.gaussianElimination());
+  }
+
+
+  // Test basic separation on a small problem - cuts must be valid,
+  // violated and the same whatever the number of threads (without
+  // CGL_THREAD odd cycle search is still split into tasks)
+  {
+    double xstar[4]={0.5,0.13,0.04,0.95};
+    std::vector<int> found1,found4;
+    separate012(xstar,0,1,false,found1);
+    separate012(xstar,0,4,false,found4);
+    assert (!found1.empty());
+    assert (found4==found1);
+  }
+
+  // Test tabu search on same problem.  With this solution basic
+  // separation finds no cut (so tabu search is tried) - cuts must
+  // be valid, violated and the same whatever the number of threads
+  {
+    double xstar[4]={0.46,0.46,0.5,0.42};
+    // no tabu search, then 4 trajectories on 1 and 4 threads
+    int tabu[3]={0,4,4};
+    int threads[3]={1,1,4};
+    std::vector<int> found[3];
+    for (int iRun=0;iRun<3;iRun++)
+      separate012(xstar,tabu[iRun],threads[iRun],false,found[iRun]);
+    assert (found[0].empty());
+    assert (!found[1].empty());
+    assert (found[2]==found[1]);
+  }
 
+  // Test Gaussian elimination on same problem.  With this solution
+  // it adds cuts to those found by basic separation - all must be
+  // valid, violated and the same whatever the number of threads
+  {
+    double xstar[4]={0.71,0.4,0.02,0.42};
+    std::vector<int> basic,gauss1,gauss4;
+    separate012(xstar,0,1,false,basic);
+    separate012(xstar,0,1,true,gauss1);
+    separate012(xstar,0,4,true,gauss4);
+    assert (!basic.empty());
+    assert (gauss1.size()>basic.size());
+    assert (std::equal(basic.begin(),basic.end(),gauss1.begin()));
+    assert (gauss4==gauss1);
+  }
 
   // Test generate cuts method on lseu
   {
@@ -55,6 +185,39 @@ CglZeroHalfUnitTest(
     cg.refreshSolver(siP);
     OsiCuts cuts;
     cg.generateCuts(*siP,cuts);
+    // same cuts from second call (parity rows kept from first)
+    {
+      OsiCuts cuts2;
+      cg.generateCuts(*siP,cuts2);
+      assert (cuts2.sizeRowCuts() == cuts.sizeRowCuts());
+    }
+    // same cuts whatever number of threads
+    {
+      CglZeroHalf threaded;
+      threaded.setNumberThreads(4);
+      threaded.refreshSolver(siP);
+      OsiCuts cuts2;
+      threaded.generateCuts(*siP,cuts2);
+      assert (cuts2.sizeRowCuts() == cuts.sizeRowCuts());
+      for (int i=0;i<cuts.sizeRowCuts();i++)
+	assert (cuts2.rowCut(i) == cuts.rowCut(i));
+    }
+    // tabu trajectories give same cuts whatever number of threads
+    {
+      CglZeroHalf tabu1;
+      tabu1.setTabuTrajectories(4);
+      tabu1.refreshSolver(siP);
+      OsiCuts cuts1;
+      tabu1.generateCuts(*siP,cuts1);
+      CglZeroHalf tabu4(tabu1);
+      tabu4.setNumberThreads(4);
+      tabu4.refreshSolver(siP);
+      OsiCuts cuts4;
+      tabu4.generateCuts(*siP,cuts4);
+      assert (cuts4.sizeRowCuts() == cuts1.sizeRowCuts());
+      for (int i=0;i<cuts1.sizeRowCuts();i++)
+	assert (cuts4.rowCut(i) == cuts1.rowCut(i));
+    }
 
     // lseu is the optimal solution to lseu
     // Optimal IP solution to lseu    
@@ -75,6 +238,22 @@ CglZeroHalfUnitTest(
       assert (lseuSum <= rcutub);
     }
 
+    // Gaussian elimination only adds cuts and they do not
+    // chop off the optimal solution either
+    {
+      CglZeroHalf gauss;
+      gauss.setGaussianElimination(true);
+      gauss.refreshSolver(siP);
+      OsiCuts cuts2;
+      gauss.generateCuts(*siP,cuts2);
+      assert (cuts2.sizeRowCuts() >= nRowCuts);
+      for (i=0; i<cuts2.sizeRowCuts(); i++){
+	rcut = cuts2.rowCut(i);
+	rpv = rcut.row();
+	assert ((rpv*lseu).sum() <= rcut.ub());
+      }
+    }
+
     // test that the cuts improve the 
     // lp objective function value
     double lpRelaxBefore=siP->getObjValue();
@@ -15,3 +15,7 @@
 
 /* Release Version number of project */
 #define CGL_VERSION_RELEASE 9999
+
+/* Define to 1 if tasks of cut generators are run in parallel threads
+   (then link with pthreads) */
+/* #define CGL_THREAD 1 */
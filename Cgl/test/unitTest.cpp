@@ -39,7 +39,9 @@
 #include "CglOddHole.hpp"
 #include "CglProbing.hpp"
 #include "CglGomory.hpp"
+#include "CglGMI.hpp"
 #include "CglLandP.hpp"
+#include "CglLiftAndProject.hpp"
 #include "CglMixedIntegerRounding.hpp"
 #include "CglMixedIntegerRounding2.hpp"
 #include "CglResidualCapacity.hpp"
@@ -49,6 +51,9 @@
 #include "CglClique.hpp"
 #include "CglFlowCover.hpp"
 #include "CglZeroHalf.hpp"
+#include "CglReducedCostFixing.hpp"
+#include "CglDuplicateRow.hpp"
+#include "CglPreProcess.hpp"
 
 // Function Prototypes. Function definitions is in this file.
 void testingMessage( const char * const msg );
@@ -160,6 +165,11 @@ int main (int argc, const char *argv[])
     testingMessage( "Testing CglFlowCover with OsiCpxSolverInterface\n" );
     CglFlowCoverUnitTest(&cpxSi, testDir);
   }
+  {
+    OsiCpxSolverInterface cpxSi;
+    testingMessage( "Testing CglReducedCostFixing with OsiCpxSolverInterface\n" );
+    CglReducedCostFixingUnitTest(&cpxSi, mpsDir);
+  }
 
 #endif
 
@@ -226,6 +236,11 @@ int main (int argc, const char *argv[])
     testingMessage( "Testing CglZeroHalf with OsiXprSolverInterface\n" );
     CglZeroHalfUnitTest(&xprSi, testDir);
   }
+  {
+    OsiXprSolverInterface xprSi;
+    testingMessage( "Testing CglReducedCostFixing with OsiXprSolverInterface\n" );
+    CglReducedCostFixingUnitTest(&xprSi, mpsDir);
+  }
 
 #endif
 #ifdef COIN_HAS_OSICLP
@@ -234,11 +249,21 @@ int main (int argc, const char *argv[])
     testingMessage( "Testing CglGomory with OsiClpSolverInterface\n" );
     CglGomoryUnitTest(&clpSi,mpsDir);
   }
+  {
+    OsiClpSolverInterface clpSi;
+    testingMessage( "Testing CglGMI with OsiClpSolverInterface\n" );
+    CglGMIUnitTest(&clpSi,mpsDir);
+  }
   {
     OsiClpSolverInterface clpSi;
     testingMessage( "Testing CglLandp with OsiClpSolverInterface\n" );
     CglLandPUnitTest(&clpSi,mpsDir);
   }
+  {
+    OsiClpSolverInterface clpSi;
+    testingMessage( "Testing CglLiftAndProject with OsiClpSolverInterface\n" );
+    CglLiftAndProjectUnitTest(&clpSi,mpsDir);
+  }
   {
     OsiClpSolverInterface clpSi;
     testingMessage( "Testing CglSimpleRounding with OsiClpSolverInterface\n" );
@@ -304,6 +329,21 @@ int main (int argc, const char *argv[])
     testingMessage( "Testing CglZeroHalf with OsiClpSolverInterface\n" );
     CglZeroHalfUnitTest(&clpSi, testDir);
   }
+  {
+    OsiClpSolverInterface clpSi;
+    testingMessage( "Testing CglReducedCostFixing with OsiClpSolverInterface\n" );
+    CglReducedCostFixingUnitTest(&clpSi, mpsDir);
+  }
+  {
+    OsiClpSolverInterface clpSi;
+    testingMessage( "Testing CglDuplicateRow with OsiClpSolverInterface\n" );
+    CglDuplicateRowUnitTest(&clpSi, mpsDir);
+  }
+  {
+    OsiClpSolverInterface clpSi;
+    testingMessage( "Testing CglPreProcess with OsiClpSolverInterface\n" );
+    CglPreProcessUnitTest(&clpSi, mpsDir);
+  }
 
 #endif
 #ifdef COIN_HAS_OSIDYLP
@@ -373,6 +413,11 @@ int main (int argc, const char *argv[])
     testingMessage( "Testing CglZeroHalf with OsiDylpSolverInterface\n" );
     CglZeroHalfUnitTest(&dylpSi, testDir);
   }
+  {
+    OsiDylpSolverInterface dylpSi;
+    testingMessage( "Testing CglReducedCostFixing with OsiDylpSolverInterface\n" );
+    CglReducedCostFixingUnitTest(&dylpSi, mpsDir);
+  }
 
 #endif
 #ifdef COIN_HAS_OSIGLPK
@@ -442,6 +487,11 @@ int main (int argc, const char *argv[])
     testingMessage( "Testing CglZeroHalf with OsiGlpkSolverInterface\n" );
     CglZeroHalfUnitTest(&glpkSi, testDir);
   }
+  {
+    OsiGlpkSolverInterface glpkSi;
+    testingMessage( "Testing CglReducedCostFixing with OsiGlpkSolverInterface\n" );
+    CglReducedCostFixingUnitTest(&glpkSi, mpsDir);
+  }
 
 #endif
 